@@ -11,6 +11,7 @@ from AthenaConfiguration.ComponentFactory import CompFactory
 from OutputStreamAthenaPool.OutputStreamConfig import OutputStreamCfg
 
 from CaloRecTools.CaloRecToolConfig import CaloRecToolCfg
+from WaveformConditionsTools.WaveformCalibConfig import WaveformCalibCfg
 
 # One stop shopping for normal FASER data
 def CalorimeterReconstructionCfg(flags, **kwargs):
@@ -26,6 +27,10 @@ def CalorimeterReconstructionCfg(flags, **kwargs):
     kwargs.setdefault("PreshowerHitContainerKey", "PreshowerHits")
 
     acc.merge(CaloRecToolCfg(flags, **kwargs))
+    # Calibration table with the HV gain ratio and reference MIP charge evaluated per IOV
+    acc.merge(WaveformCalibCfg(flags,
+                               PMT_HV_ReadKey="/WAVE/Calibration/HV",
+                               MIP_ref_ReadKey="/WAVE/Calibration/MIP_ref"))
     kwargs.pop("MC_calibTag")  # Remove this if it is specified so it does not get pased to CaloRecAlg
 
     recoAlg = CompFactory.CaloRecAlg("CaloRecAlg", isMC = flags.Input.isMC, **kwargs)
@@ -1,4 +1,5 @@
 #include "CaloRecAlg.h"
+#include "StoreGate/ReadCondHandle.h"
 #include <math.h>
 
 CaloRecAlg::CaloRecAlg(const std::string& name, 
@@ -22,6 +23,9 @@ StatusCode CaloRecAlg::initialize() {
   ATH_CHECK( m_calo2HitContainerKey.initialize() );
   ATH_CHECK( m_preshowerHitContainerKey.initialize() );
 
+  // Set key to read calibration table
+  ATH_CHECK( m_calibKey.initialize() );
+
   // Initalize tools
   ATH_CHECK( m_recoCalibTool.retrieve() );
 
@@ -61,6 +65,11 @@ StatusCode CaloRecAlg::execute(const EventContext& ctx) const {
     ATH_MSG_DEBUG("Preshower Waveform Hit container found with zero length!");
   }
 
+  // Calibration constants for this IOV
+  SG::ReadCondHandle<WaveformCalibCondData> calibHandle(m_calibKey, ctx);
+  ATH_CHECK( calibHandle.isValid() );
+  const WaveformCalibCondData& calib = **calibHandle;
+
   // Only correct gain in real data
   bool correct_gain = !m_isMC;
   
@@ -76,7 +85,7 @@ StatusCode CaloRecAlg::execute(const EventContext& ctx) const {
     xAOD::CalorimeterHit* calo_hit = new xAOD::CalorimeterHit();
     caloHitContainerHandle->push_back(calo_hit);
     calo_hit->addHit(caloWaveHitHandle.get(), hit);
-    m_recoCalibTool->reconstruct(ctx, calo_hit, correct_gain);
+    m_recoCalibTool->reconstruct(calo_hit, correct_gain, calib);
   }
   ATH_MSG_DEBUG("CaloHitContainer '" << caloHitContainerHandle.name() << "' filled with "<< caloHitContainerHandle->size() <<" items");
 
@@ -91,7 +100,7 @@ StatusCode CaloRecAlg::execute(const EventContext& ctx) const {
     xAOD::CalorimeterHit* calo_hit = new xAOD::CalorimeterHit();
     preshowerHitContainerHandle->push_back(calo_hit);
     calo_hit->addHit(preshowerWaveHitHandle.get(), hit);
-    m_recoCalibTool->reconstruct(ctx, calo_hit, correct_gain=false);
+    m_recoCalibTool->reconstruct(calo_hit, correct_gain=false, calib);
   }  
   ATH_MSG_DEBUG("PreshowerHitContainer '" << preshowerHitContainerHandle.name() << "' filled with "<< preshowerHitContainerHandle->size() <<" items");
   
@@ -115,7 +124,7 @@ StatusCode CaloRecAlg::execute(const EventContext& ctx) const {
       xAOD::CalorimeterHit* calo_hit = new xAOD::CalorimeterHit();
       calo2HitContainerHandle->push_back(calo_hit);    
       calo_hit->addHit(calo2WaveHitHandle.get(), hit);
-      m_recoCalibTool->reconstruct(ctx, calo_hit, correct_gain=false);
+      m_recoCalibTool->reconstruct(calo_hit, correct_gain=false, calib);
     }
     ATH_MSG_DEBUG("Calo2HitContainer '" << calo2HitContainerHandle.name() << "' filled with "<< calo2HitContainerHandle->size() <<" items");
     
@@ -17,6 +17,7 @@
 // Include Athena stuff for Conditions db reading
 #include "AthenaPoolUtilities/CondAttrListCollection.h"
 #include "StoreGate/ReadCondHandleKey.h"
+#include "WaveformConditionsTools/WaveformCalibCondData.h"
 
 // Handles
 #include "StoreGate/ReadHandleKey.h"
@@ -79,6 +80,13 @@ class CaloRecAlg : public AthReentrantAlgorithm {
   SG::ReadHandleKey<xAOD::WaveformHitContainer> m_preshowerWaveHitContainerKey {this, "PreshowerWaveHitContainerKey", "PreshowerWaveformHits"};
   //@}
 
+  /**
+   * @name Per-IOV calibration table using SG::ReadCondHandleKey
+   */
+  //@{
+  SG::ReadCondHandleKey<WaveformCalibCondData> m_calibKey {this, "CalibKey", "WaveformCalibCondData"};
+  //@}
+
   /**
    * @name Output data using SG::WriteHandleKey
    */
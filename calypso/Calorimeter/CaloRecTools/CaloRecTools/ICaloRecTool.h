@@ -23,6 +23,8 @@
 
 #include "TF1.h"
 
+class WaveformCalibCondData;
+
 ///Interface for Calo reco algorithms
 class ICaloRecTool : virtual public IAlgTool 
 {
@@ -49,6 +51,11 @@ class ICaloRecTool : virtual public IAlgTool
   virtual void reconstruct(const EventContext& ctx,
 			   xAOD::CalorimeterHit* hit,
 			   bool correct_gain) const = 0;
+
+  // As above, taking the calibration constants from the per-IOV table
+  virtual void reconstruct(xAOD::CalorimeterHit* hit,
+			   bool correct_gain,
+			   const WaveformCalibCondData& calib) const = 0;
 };
 
 #endif // CALORECTOOL_ICALORECTOOL_H
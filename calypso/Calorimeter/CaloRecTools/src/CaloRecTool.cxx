@@ -238,15 +238,40 @@ CaloRecTool::reconstruct(const EventContext& ctx,
   
   float MIPcharge_ref = getMIPcharge_ref(ctx, wave_hit->channel()); // get reference MIP charge from database
 
-  float charge = wave_hit->integral()/50.0; // divide by 50 ohms to get charge
-  ATH_MSG_DEBUG("calo_hit filled has charge of " << charge << " pC");
-
   float gainRatio = 1.0;
   if (correct_gain) { // MC already has correct MIP charge stored in MIPcharge_ref, so only need to to HV extrapolation with reral data
     gainRatio = extrapolateHVgain(ctx, wave_hit->channel());
   }
   ATH_MSG_DEBUG("HV gain ratio = " << gainRatio );
 
+  fillHit(calo_hit, MIPcharge_ref, gainRatio);
+}
+
+//----------------------------------------------------------------------
+// Same as above, with the calibration constants already compiled for this IOV
+void
+CaloRecTool::reconstruct(xAOD::CalorimeterHit* calo_hit,
+			 bool correct_gain,
+			 const WaveformCalibCondData& calib) const {
+
+  const xAOD::WaveformHit* wave_hit = calo_hit->Hit(0);
+  ATH_MSG_DEBUG("calo_hit in channel " << wave_hit->channel() );
+
+  float gainRatio = correct_gain ? calib.gainRatio(wave_hit->channel()) : 1.0;
+  ATH_MSG_DEBUG("HV gain ratio = " << gainRatio );
+
+  fillHit(calo_hit, calib.MIPcharge_ref(wave_hit->channel()), gainRatio);
+}
+
+//----------------------------------------------------------------------
+void
+CaloRecTool::fillHit(xAOD::CalorimeterHit* calo_hit, float MIPcharge_ref, float gainRatio) const {
+
+  const xAOD::WaveformHit* wave_hit = calo_hit->Hit(0);
+
+  float charge = wave_hit->integral()/50.0; // divide by 50 ohms to get charge
+  ATH_MSG_DEBUG("calo_hit filled has charge of " << charge << " pC");
+
   float Nmip = (charge * gainRatio) / MIPcharge_ref;
   ATH_MSG_DEBUG("Nmip = " << Nmip );
   calo_hit->set_Nmip(Nmip); // set Nmip value
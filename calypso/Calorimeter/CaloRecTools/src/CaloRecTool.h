@@ -28,6 +28,7 @@
 // Data Classes
 #include "xAODFaserWaveform/WaveformHit.h"
 #include "xAODFaserCalorimeter/CalorimeterHit.h"
+#include "WaveformConditionsTools/WaveformCalibCondData.h"
 
 // Include ROOT classes
 #include "TF1.h"
@@ -66,6 +67,10 @@ class CaloRecTool: public extends<AthAlgTool, ICaloRecTool> {
 			   xAOD::CalorimeterHit* hit,
 			   bool correct_gain) const override;
 
+  virtual void reconstruct(xAOD::CalorimeterHit* hit,
+			   bool correct_gain,
+			   const WaveformCalibCondData& calib) const override;
+
   TFile* HVgaincurves_rootFile;
 
   TF1* chan0_HVgaincurve_pntr;
@@ -101,6 +106,9 @@ class CaloRecTool: public extends<AthAlgTool, ICaloRecTool> {
 
   float extrapolateHVgain(const EventContext& ctx, int channel) const;
 
+  // Fill the calibrated quantities of the calo hit
+  void fillHit(xAOD::CalorimeterHit* calo_hit, float MIPcharge_ref, float gainRatio) const;
+
 };
 
 #endif // CALORECTOOLS_CALORECTOOL_H
@@ -46,6 +46,8 @@ parser.add_argument("--isOverlay", action='store_true',
                     help="Set overlaid data input")
 parser.add_argument("--noTracking", action='store_true',
                     help="Turn off tracking (for R24 debugging)")
+parser.add_argument("--threads", type=int, default=0,
+                    help="Number of threads (0 runs serially)")
 
 args = parser.parse_args()
 
@@ -193,10 +195,9 @@ configFlags.addFlag("Output.xAODFileName", f"{filestem}-xAOD.root")
 configFlags.Output.ESDFileName = f"{filestem}-ESD.root"
 configFlags.Output.doWriteESD = False
 
-#
-# Play around with this?
-# configFlags.Concurrency.NumThreads = 2
-# configFlags.Concurrency.NumConcurrentEvents = 2
+if args.threads > 0:
+    configFlags.Concurrency.NumThreads = args.threads
+    configFlags.Concurrency.NumConcurrentEvents = args.threads
 configFlags.lock()
 
 #
@@ -22,10 +22,12 @@
 #include "GaudiKernel/ServiceHandle.h"
 
 #include "EventFormats/DAQFormats.hpp"
+#include "EventFormats/EventIndex.hpp"
 #include <exception>
 
 class StoreGateSvc;
 class DataHeaderElement;
+class EventPrefetcher;
 
 /** @class ByteStreamFaserInputSvc
  *  @brief This class is the ByteStreamInputSvc for reading events written by Faser.
@@ -67,6 +69,14 @@ public:
    bool         ready() const;
    StatusCode   generateDataHeader();
 
+   /// Sidecar event index of the current file, nullptr if none was loaded
+   const DAQFormats::EventIndex* eventIndex() const;
+   bool         hasEventIndex() const { return m_indexLoaded; }
+   /// Position on (selected) event evtInFile of the current file without reading, requires an event index
+   bool         seekInBlock(long evtInFile);
+   /// Skip up to nEvents (selected) events without reading them, requires an event index
+   long         skipInBlock(long nEvents);
+
 private: // data
    std::mutex m_readerMutex;
 
@@ -80,6 +90,7 @@ private: // data
 
    SG::SlotSpecificObj<EventCache> m_eventsCache;
    std::unique_ptr<FaserEventStorage::DataReader>  m_reader; //!< DataReader from EventStorage
+   std::unique_ptr<EventPrefetcher>  m_prefetcher; //!< read-ahead, owns m_reader access while it exists
 
    mutable std::vector<long long int> m_evtOffsets;  //!< offset for event i in that file
    unsigned int                 m_evtInFile;
@@ -87,6 +98,13 @@ private: // data
    // Event back navigation info
    std::string        m_fileGUID;      //!< current file GUID
 
+   // Sidecar event index
+   DAQFormats::EventIndex m_index;                 //!< index loaded for, or collected from, the current file
+   bool               m_indexLoaded = false;       //!< m_evtOffsets filled from a sidecar index
+   bool               m_indexComplete = false;     //!< m_index collected without gaps while reading
+   std::string        m_indexFileName;             //!< sidecar index of the current file
+   uint64_t           m_rawFileSize = 0;           //!< size of the current file, 0 if not known
+
 
 private: // properties
    ServiceHandle<StoreGateSvc>                m_storeGate;     //!< StoreGateSvc
@@ -99,12 +117,23 @@ private: // properties
    Gaudi::Property<float>                     m_wait;
    Gaudi::Property<bool>                      m_valEvent;
    Gaudi::Property<std::string>               m_eventInfoKey;
+   Gaudi::Property<bool>                      m_useMmap;       //!< read local files through fReadMmap
+   Gaudi::Property<bool>                      m_useIndex;      //!< use sidecar event index if present
+   Gaudi::Property<bool>                      m_writeIndex;    //!< write sidecar event index for completely read files
+   Gaudi::Property<std::string>               m_indexDir;      //!< directory for sidecar event indices
+   Gaudi::Property<unsigned int>              m_triggerMask;   //!< only read events with (trigger_bits & mask), needs index
+   Gaudi::Property<unsigned int>              m_prefetchEvents; //!< number of events read ahead, 0 disables
+   Gaudi::Property<unsigned int>              m_decompressThreads; //!< worker threads decoding read-ahead events
 
 private: // internal helper functions
 
    // void buildFragment( EventCache* cache, void* data, uint32_t eventSize, bool validate ) const;
    void buildEvent( EventCache* cache, DAQFormats::EventFull* theEvent, bool validate ) const;
    bool readerReady() const;
+   bool loadEventIndex(const std::string& fileName);
+   void writeEventIndex();
+   void recordIndexEntry(long long endOffset, const DAQFormats::EventFull* theEvent);
+   bool readPrefetched(DAQFormats::EventFull*& theEvent);
    unsigned validateEvent( const DAQFormats::EventFull* rawEvent ) const;
    void setEvent( const EventContext& context, void* data, unsigned int eventStatus );
    
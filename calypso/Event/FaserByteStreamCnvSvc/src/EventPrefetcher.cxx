@@ -0,0 +1,164 @@
+/*
+  Copyright (C) 2022 CERN for the benefit of the FASER collaboration
+*/
+
+#include "EventPrefetcher.h"
+
+#include "FaserEventStorage/EventStorageIssues.h"
+
+EventPrefetcher::EventPrefetcher(FaserEventStorage::DataReader& reader, size_t depth, size_t nWorkers)
+  : m_reader(reader)
+  , m_depth(depth > 0 ? depth : 1)
+{
+  // Known before the reader thread starts, so that more() is right from the beginning
+  // Same condition as FaserByteStreamInputSvc::readerReady()
+  m_readerDone = m_reader.endOfFile() || !m_reader.good();
+
+  if (nWorkers == 0) nWorkers = 1;
+  for (size_t i = 0; i < nWorkers; i++) {
+    m_workThreads.emplace_back(&EventPrefetcher::workLoop, this);
+  }
+  m_readThread = std::thread(&EventPrefetcher::readLoop, this);
+}
+
+EventPrefetcher::~EventPrefetcher()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_readerCond.notify_all();
+  m_workerCond.notify_all();
+  m_readThread.join();
+  for (std::thread& worker : m_workThreads) worker.join();
+}
+
+bool EventPrefetcher::next(Item& item)
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_consumerCond.wait(lock, [this]{
+      return (!m_queue.empty() && m_queue.front()->status != Pending) || (m_queue.empty() && m_readerDone);
+    });
+  if (m_queue.empty()) return false;
+
+  item = std::move(*m_queue.front());
+  m_queue.pop_front();
+  lock.unlock();
+  m_readerCond.notify_one();
+  return true;
+}
+
+bool EventPrefetcher::more() const
+{
+  // The reader sets m_readerDone as soon as it reaches the end of the file,
+  // until then there is at least one more event (or error) to come
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return !m_queue.empty() || !m_readerDone;
+}
+
+void EventPrefetcher::readLoop()
+{
+  bool done;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    done = m_readerDone;
+  }
+  unsigned int fileNumber = m_reader.currentFileNumber();
+  bool newFile = false;
+
+  while (!done) {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_readerCond.wait(lock, [this, newFile]{
+	  return m_stop || (m_queue.size() < m_depth && (!newFile || (m_work.empty() && m_decoding == 0)));
+	});
+      if (m_stop) break;
+    }
+    newFile = false;
+
+    auto item = std::make_unique<Item>();
+    item->offset = static_cast<long long>(m_reader.getPosition());
+    item->guid = m_reader.GUID();
+
+    // Only the on-disk bytes are read here, decoding happens on the workers
+    try {
+      m_reader.getDataView(item->data, item->raw);
+      item->size = static_cast<uint32_t>(item->data.size());
+    } catch (const FaserEventStorage::ES_OutOfFileBoundary& e) {
+      item->status = Truncated;
+      item->error = "DataReader reports FaserEventStorage::ES_OutOfFileBoundary";
+    } catch (const DAQFormats::EFormatException& e) {
+      item->status = FormatError;
+      item->error = e.what();
+    } catch (const std::exception& e) {
+      item->status = ReadError;
+      item->error = e.what();
+    }
+    done = (item->status != Pending) || m_reader.endOfFile() || !m_reader.good();
+
+    // Events of the previous file have to be decoded before its mapping can go away
+    if (m_reader.currentFileNumber() != fileNumber) {
+      fileNumber = m_reader.currentFileNumber();
+      newFile = true;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (item->status == Pending) m_work.push_back(item.get());
+      m_queue.push_back(std::move(item));
+      m_readerDone = done;
+    }
+    m_workerCond.notify_one();
+    m_consumerCond.notify_all();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_readerDone = true;
+  }
+  m_consumerCond.notify_all();
+}
+
+void EventPrefetcher::workLoop()
+{
+  for (;;) {
+    Item* item = nullptr;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_workerCond.wait(lock, [this]{ return m_stop || !m_work.empty(); });
+      if (m_stop) break;
+      item = m_work.front();
+      m_work.pop_front();
+      m_decoding++;
+    }
+
+    // Decompression happens in the EventFull constructor
+    Status status = Ready;
+    std::string error;
+    std::unique_ptr<DAQFormats::EventFull> event;
+    try {
+      event = std::make_unique<DAQFormats::EventFull>(item->data.data(), item->data.size());
+    } catch (const DAQFormats::EFormatException& e) {
+      status = FormatError;
+      error = e.what();
+    } catch (const DAQFormats::CompressionDataException& e) {
+      status = FormatError;
+      error = e.what();
+    } catch (const std::exception& e) {
+      status = ReadError;
+      error = e.what();
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      item->event = std::move(event);
+      item->error = std::move(error);
+      item->data = std::span<const uint8_t>();
+      item->raw = std::vector<uint8_t>();
+      item->status = status;
+      m_decoding--;
+    }
+    m_consumerCond.notify_all();
+    m_readerCond.notify_one();
+  }
+}
@@ -0,0 +1,85 @@
+/*
+  Copyright (C) 2022 CERN for the benefit of the FASER collaboration
+*/
+
+#ifndef FASERBYTESTREAMCNVSVC_EVENTPREFETCHER_H
+#define FASERBYTESTREAMCNVSVC_EVENTPREFETCHER_H
+
+/** @file EventPrefetcher.h
+ *  @brief Bounded read-ahead of raw events with decompression on a small worker pool
+ *
+ *  A reader thread pulls the raw (possibly compressed) bytes of the next
+ *  events from the DataReader, worker threads decode and decompress them
+ *  into EventFull objects, and next() hands them out in file order.
+ *  While the prefetcher exists it is the only user of the DataReader.
+ *
+ *  The bytes are not copied: they either stay in the mapped file or are
+ *  read straight into a buffer owned by the event. Mapped events must be
+ *  decoded before the file after the next one is opened, so the reader
+ *  waits for all outstanding events when it moves on to another file.
+ **/
+
+#include "FaserEventStorage/DataReader.h"
+#include "EventFormats/DAQFormats.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+class EventPrefetcher {
+
+public:
+  enum Status { Pending, Ready, Truncated, FormatError, ReadError };
+
+  struct Item {
+    long long          offset = -1;   //!< event offset within the file
+    uint32_t           size = 0;      //!< on-disk event size
+    std::string        guid;          //!< GUID of the file holding the event
+    Status             status = Pending;
+    std::string        error;         //!< reason if status is not Ready
+    std::span<const uint8_t> data;    //!< on-disk bytes, in raw or in the mapped file
+    std::vector<uint8_t> raw;         //!< owns the bytes if the file is not mapped
+    std::unique_ptr<DAQFormats::EventFull> event;
+  };
+
+  /// depth is the maximum number of events held ahead of the consumer
+  EventPrefetcher(FaserEventStorage::DataReader& reader, size_t depth, size_t nWorkers);
+  ~EventPrefetcher();
+
+  EventPrefetcher(const EventPrefetcher&) = delete;
+  EventPrefetcher& operator=(const EventPrefetcher&) = delete;
+
+  /// Next event in file order, blocks until it is decoded. Returns false at end of file
+  bool next(Item& item);
+
+  /// True if next() will return an event, does not block
+  bool more() const;
+
+private:
+  void readLoop();
+  void workLoop();
+
+  FaserEventStorage::DataReader& m_reader;
+  size_t m_depth;
+
+  mutable std::mutex m_mutex;
+  std::condition_variable m_readerCond;   //!< space in queue, events decoded or stop requested
+  std::condition_variable m_workerCond;   //!< work available or stop requested
+  std::condition_variable m_consumerCond; //!< event decoded or reader done
+
+  std::deque<std::unique_ptr<Item>> m_queue;  //!< events in file order
+  std::deque<Item*> m_work;                   //!< events waiting to be decoded
+  size_t m_decoding = 0;                      //!< events being decoded by the workers
+  bool m_readerDone = false;                  //!< no further events will be queued
+  bool m_stop = false;
+
+  std::thread m_readThread;
+  std::vector<std::thread> m_workThreads;
+};
+
+#endif
@@ -5,6 +5,7 @@
 #include "FaserByteStreamCnvSvc/FaserByteStreamInputSvc.h"
 
 #include "DumpFrags.h"
+#include "EventPrefetcher.h"
 
 //#include "ByteStreamData/ByteStreamMetadataContainer.h"
 #include "FaserByteStreamCnvSvcBase/FaserByteStreamAddress.h"
@@ -34,7 +35,9 @@
 #include <cstdio>
 #include <string>
 #include <vector>
+#include <algorithm>
 #include <unistd.h>
+#include <sys/stat.h>
 
 using DAQFormats::EventFull;
 
@@ -45,6 +48,7 @@ FaserByteStreamInputSvc::FaserByteStreamInputSvc(
   , m_readerMutex()
   , m_eventsCache()
   , m_reader()
+  , m_prefetcher()
   , m_evtOffsets()
   , m_evtInFile(0)
   , m_evtFileOffset(0)
@@ -57,6 +61,13 @@ FaserByteStreamInputSvc::FaserByteStreamInputSvc(
   , m_wait         (this, "WaitSecs",              0., "Seconds to wait if input is in wait state")
   , m_valEvent     (this, "ValidateEvent",       true, "switch on check_tree when reading events")
   , m_eventInfoKey (this, "EventInfoKey", "EventInfo", "Key of EventInfo in metadata store")
+  , m_useMmap      (this, "UseMemoryMap",       false, "Memory-map local input files instead of reading them")
+  , m_useIndex     (this, "UseEventIndex",      false, "Use sidecar event index (<file>.idx) if present to seek and skip without reading")
+  , m_writeIndex   (this, "WriteEventIndex",    false, "Write sidecar event index for input files that were read completely")
+  , m_indexDir     (this, "EventIndexDirectory",   "", "Directory for sidecar event indices, default is next to the input file")
+  , m_triggerMask  (this, "TriggerMask",            0, "Only read events with (trigger_bits & mask), requires UseEventIndex")
+  , m_prefetchEvents (this, "PrefetchEvents",       0, "Number of events read ahead and decompressed in the background, 0 disables")
+  , m_decompressThreads (this, "DecompressionThreads", 2, "Number of threads decompressing read-ahead events")
 
 {
   assert(svcloc != nullptr);
@@ -93,6 +104,8 @@ StatusCode FaserByteStreamInputSvc::finalize() {
 //------------------------------------------------------------------------------
 long FaserByteStreamInputSvc::positionInBlock()
 {
+  // With an index all offsets are known up front
+  if (m_indexLoaded) return m_evtInFile+1;
   return m_evtOffsets.size();
 }
 
@@ -120,30 +133,48 @@ const EventFull* FaserByteStreamInputSvc::nextEvent() {
       // get current event position (cast to long long until native tdaq implementation)
       // This is the usual situation, reading past previous point in file
       ATH_MSG_DEBUG("nextEvent _above_ high water mark");
-      m_evtFileOffset = (long long)m_reader->getPosition();
-      m_evtOffsets.push_back(m_evtFileOffset);
-
-      // Catch truncated events
-      try {
-	m_reader->getData(theEvent);
-      } catch (const FaserEventStorage::ES_OutOfFileBoundary& e) {
-	// Attempt to read beyond end of file, likely truncated event
-	ATH_MSG_WARNING("DataReader reports FaserEventStorage::ES_OutOfFileBoundary, stop reading file!");
-	return NULL;
-      } catch (const DAQFormats::EFormatException& e) {
-	// Format error
-	ATH_MSG_WARNING("DataReader reports DAQFormats::EFormatException, stop reading file!");
-	ATH_MSG_WARNING(e.what());
-	return NULL;
-      } catch (...) {
-	// rethrow any other exceptions
-	throw;
+      if (m_prefetcher) {
+	if (!readPrefetched(theEvent)) return NULL;
+      } else {
+        m_evtFileOffset = (long long)m_reader->getPosition();
+        m_evtOffsets.push_back(m_evtFileOffset);
+
+        // Catch truncated events
+        try {
+	  m_reader->getData(theEvent);
+        } catch (const FaserEventStorage::ES_OutOfFileBoundary& e) {
+	  // Attempt to read beyond end of file, likely truncated event
+	  ATH_MSG_WARNING("DataReader reports FaserEventStorage::ES_OutOfFileBoundary, stop reading file!");
+	  m_indexComplete = false;
+	  return NULL;
+        } catch (const DAQFormats::EFormatException& e) {
+	  // Format error
+	  ATH_MSG_WARNING("DataReader reports DAQFormats::EFormatException, stop reading file!");
+	  ATH_MSG_WARNING(e.what());
+	  m_indexComplete = false;
+	  return NULL;
+        } catch (...) {
+	  // rethrow any other exceptions
+	  throw;
+        }
+
+        // The on-disk size is needed for the index as the event may have been decompressed
+        if (m_indexComplete) {
+	  long long endOffset = (long long)m_reader->getPosition();
+	  // File is already closed after the last event
+	  if (endOffset < m_evtFileOffset) endOffset = m_rawFileSize;
+	  recordIndexEntry(endOffset, theEvent);
+        }
       }
     }
 
     else {
       // Load from previous offset
       ATH_MSG_DEBUG("nextEvent below high water mark");
+      if (m_prefetcher) {
+	ATH_MSG_ERROR("Re-reading events is not supported with PrefetchEvents");
+	return NULL;
+      }
       m_evtFileOffset = m_evtOffsets.at( m_evtInFile-1 );
       m_reader->getData( theEvent, m_evtFileOffset );
     }
@@ -250,8 +281,8 @@ StatusCode FaserByteStreamInputSvc::generateDataHeader()
 {
   ATH_MSG_DEBUG("FaserByteStreamInputSvc::generateDataHeader() called");
 
-  // get file GUID
-  m_fileGUID = m_reader->GUID();
+  // get file GUID, while reading ahead it is taken from the prefetched event
+  if (!m_prefetcher) m_fileGUID = m_reader->GUID();
 
   // reader returns -1 when end of the file is reached
   if (m_evtFileOffset != -1) {
@@ -346,8 +377,15 @@ FaserByteStreamInputSvc::closeBlockIterator(bool clearMetadata)
   if (!readerReady()) {
     ATH_MSG_INFO("No more events in this run, high water mark for this file = "
 		 << m_evtOffsets.size()-1);
+    // Only fully read files get an index
+    if (m_indexComplete) writeEventIndex();
   }
 
+  // Stop read-ahead before the reader goes away
+  m_prefetcher.reset();
+  m_indexComplete = false;
+  m_indexLoaded = false;
+  m_index.clear();
   m_reader.reset();
 }
 
@@ -376,7 +414,13 @@ FaserByteStreamInputSvc::getBlockIterator(const std::string fileName)
   // open the file
   if(m_reader != 0) closeBlockIterator();
 
-  m_reader = std::unique_ptr<FaserEventStorage::DataReader>(pickFaserDataReader(fileName));
+  // Files without an explicit access prefix are local, these can be mapped
+  std::string readerName = fileName;
+  if (m_useMmap && fileName.find(':') == std::string::npos) {
+    readerName = "mmap:" + fileName;
+  }
+
+  m_reader = std::unique_ptr<FaserEventStorage::DataReader>(pickFaserDataReader(readerName));
 
   if(m_reader == nullptr) {
     ATH_MSG_ERROR("Failed to open file " << fileName);
@@ -397,15 +441,182 @@ FaserByteStreamInputSvc::getBlockIterator(const std::string fileName)
   }
 
   ATH_MSG_INFO("Picked valid file: " << m_reader->fileName());
+
+  // Sidecar event index, the raw file size is used to detect stale indices
+  m_index.clear();
+  m_indexLoaded = false;
+  m_indexComplete = m_writeIndex && !m_sequential;
+  m_rawFileSize = 0;
+  struct stat fileStat;
+  if (fileName.find(':') == std::string::npos && ::stat(fileName.c_str(), &fileStat) == 0) {
+    m_rawFileSize = fileStat.st_size;
+  }
+  if (m_indexDir.value().empty()) {
+    m_indexFileName = DAQFormats::EventIndex::indexFileName(fileName);
+  } else {
+    m_indexFileName = m_indexDir.value() + "/" + DAQFormats::EventIndex::indexFileName(fileName.substr(fileName.find_last_of('/')+1));
+  }
+
+  if (m_useIndex && loadEventIndex(fileName)) {
+    // Number of selected events is known exactly
+    return std::make_pair(static_cast<long>(m_evtOffsets.size())-1, m_reader->GUID());
+  }
+  if (m_triggerMask != 0) {
+    ATH_MSG_WARNING("TriggerMask requires an event index, reading all events of " << fileName);
+  }
+
   // initialize offsets and counters
   m_evtOffsets.push_back(static_cast<long long>(m_reader->getPosition()));
-  return std::make_pair(m_reader->eventsInFile(), m_reader->GUID());
+  std::pair<long,std::string> nevguid(m_reader->eventsInFile(), m_reader->GUID());
+
+  // From here on only the prefetcher touches the reader
+  if (m_prefetchEvents > 0) {
+    ATH_MSG_DEBUG("Reading " << m_prefetchEvents << " events ahead with "
+		  << m_decompressThreads << " decompression threads");
+    m_prefetcher = std::make_unique<EventPrefetcher>(*m_reader, m_prefetchEvents, m_decompressThreads);
+  }
+  return nevguid;
+}
+
+//__________________________________________________________________________
+bool FaserByteStreamInputSvc::loadEventIndex(const std::string& fileName)
+{
+  if (m_sequential) {
+    ATH_MSG_WARNING("Event index can not be used with sequential reading");
+    return false;
+  }
+
+  if (!m_index.read(m_indexFileName, m_rawFileSize)) {
+    ATH_MSG_INFO("No valid event index " << m_indexFileName << " for " << fileName);
+    m_index.clear();
+    return false;
+  }
+
+  // Offsets of the selected events, followed by the end of the last event
+  // which acts as the high water mark
+  uint16_t mask = static_cast<uint16_t>(m_triggerMask.value());
+  long long endOffset = static_cast<long long>(m_reader->getPosition());
+  for (size_t pos = m_index.next_triggered(0, mask); pos < m_index.size(); pos = m_index.next_triggered(pos+1, mask)) {
+    m_evtOffsets.push_back(static_cast<long long>(m_index[pos].offset));
+  }
+  if (!m_index.empty()) {
+    const DAQFormats::EventIndexEntry& last = m_index[m_index.size()-1];
+    endOffset = static_cast<long long>(last.offset + last.size);
+  }
+  m_evtOffsets.push_back(endOffset);
+
+  m_indexLoaded = true;
+  m_indexComplete = false;
+  ATH_MSG_INFO("Using event index " << m_indexFileName << " with " << m_evtOffsets.size()-1
+	       << " of " << m_index.size() << " events selected");
+  return true;
+}
+
+//__________________________________________________________________________
+void FaserByteStreamInputSvc::recordIndexEntry(long long endOffset, const EventFull* theEvent)
+{
+  if (m_evtFileOffset < 0 || endOffset <= m_evtFileOffset) {
+    ATH_MSG_DEBUG("Unable to determine event size, no event index will be written");
+    m_indexComplete = false;
+    return;
+  }
+  m_index.add(m_evtFileOffset, static_cast<uint32_t>(endOffset - m_evtFileOffset), *theEvent);
+}
+
+//__________________________________________________________________________
+bool FaserByteStreamInputSvc::readPrefetched(EventFull*& theEvent)
+{
+  EventPrefetcher::Item item;
+  if (!m_prefetcher->next(item)) {
+    ATH_MSG_WARNING("No more events read ahead, stop reading file!");
+    m_indexComplete = false;
+    return false;
+  }
+
+  m_evtFileOffset = item.offset;
+  m_evtOffsets.push_back(m_evtFileOffset);
+  m_fileGUID = item.guid;
+
+  switch (item.status) {
+  case EventPrefetcher::Ready:
+    break;
+  case EventPrefetcher::Truncated:
+    // Attempt to read beyond end of file, likely truncated event
+    ATH_MSG_WARNING("DataReader reports FaserEventStorage::ES_OutOfFileBoundary, stop reading file!");
+    m_indexComplete = false;
+    return false;
+  case EventPrefetcher::FormatError:
+    ATH_MSG_WARNING("DataReader reports DAQFormats::EFormatException, stop reading file!");
+    ATH_MSG_WARNING(item.error);
+    m_indexComplete = false;
+    return false;
+  default:
+    ATH_MSG_ERROR("Error reading ahead: " << item.error);
+    m_indexComplete = false;
+    return false;
+  }
+
+  theEvent = item.event.release();
+  if (m_indexComplete) recordIndexEntry(item.offset + item.size, theEvent);
+  return true;
+}
+
+//__________________________________________________________________________
+void FaserByteStreamInputSvc::writeEventIndex()
+{
+  if (m_index.empty()) return;
+
+  // For remote files the size follows from the events themselves
+  if (m_rawFileSize == 0) {
+    const DAQFormats::EventIndexEntry& last = m_index[m_index.size()-1];
+    m_rawFileSize = last.offset + last.size;
+  }
+
+  if (m_index.write(m_indexFileName, m_rawFileSize)) {
+    ATH_MSG_INFO("Wrote event index " << m_indexFileName << " with " << m_index.size() << " events");
+  } else {
+    ATH_MSG_WARNING("Unable to write event index " << m_indexFileName);
+  }
+}
+
+//__________________________________________________________________________
+const DAQFormats::EventIndex* FaserByteStreamInputSvc::eventIndex() const
+{
+  return m_indexLoaded ? &m_index : nullptr;
+}
+
+//__________________________________________________________________________
+bool FaserByteStreamInputSvc::seekInBlock(long evtInFile)
+{
+  std::lock_guard<std::mutex> lock( m_readerMutex );
+  if (!m_indexLoaded) {
+    ATH_MSG_ERROR("seekInBlock requires an event index");
+    return false;
+  }
+  // Seeking to one past the last event is allowed, the file is then done
+  if (evtInFile < 0 || evtInFile >= static_cast<long>(m_evtOffsets.size())) return false;
+  m_evtInFile = evtInFile;
+  return true;
+}
+
+//__________________________________________________________________________
+long FaserByteStreamInputSvc::skipInBlock(long nEvents)
+{
+  std::lock_guard<std::mutex> lock( m_readerMutex );
+  if (!m_indexLoaded) return 0;
+  long left = static_cast<long>(m_evtOffsets.size()) - 1 - m_evtInFile;
+  long skipped = std::clamp(nEvents, 0L, left);
+  m_evtInFile += skipped;
+  return skipped;
 }
 
 
 //__________________________________________________________________________
 bool FaserByteStreamInputSvc::readerReady() const
 {
+  // The reader is busy reading ahead, ask the prefetcher instead
+  if (m_prefetcher) return m_prefetcher->more();
+
   bool eofFlag(false);
   if (m_reader!=0) eofFlag = m_reader->endOfFile();
   else {
@@ -413,6 +624,9 @@ bool FaserByteStreamInputSvc::readerReady() const
     return false;
   }
   bool moreEvent = m_reader->good();
+
+  // With an index, stop after the last selected event
+  if (m_indexLoaded && m_evtInFile+1 >= m_evtOffsets.size()) moreEvent = false;
   
   return (!eofFlag)&&moreEvent;
 }
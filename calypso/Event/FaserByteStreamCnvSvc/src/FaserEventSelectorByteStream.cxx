@@ -399,6 +399,16 @@ StatusCode FaserEventSelectorByteStream::next(IEvtSelector::Context& it) const {
 	return StatusCode::FAILURE; 
       }
     }
+    // With an event index, events to be skipped are not read at all
+    if (m_NumEvents < m_SkipEvents && m_eventSource->hasEventIndex()) {
+      long skipped = m_eventSource->skipInBlock(m_SkipEvents - m_NumEvents);
+      m_NumEvents += skipped;
+      while (!m_skipEventSequence.empty() && m_skipEventSequence.front() <= m_NumEvents) {
+	m_skipEventSequence.erase(m_skipEventSequence.begin());
+      }
+      ATH_MSG_DEBUG("Skipped " << skipped << " events using event index");
+      if (!m_eventSource->ready()) continue;
+    }
     try { 
       ATH_MSG_DEBUG("Call eventSource->nextEvent()");
       pre = m_eventSource->nextEvent(); 
@@ -646,7 +656,11 @@ StatusCode FaserEventSelectorByteStream::seek(Context& it, int evtNum) const {
       return StatusCode::FAILURE;
     }
     int delta = evtNum - m_firstEvt[m_fileCount];
-    if (delta > 0) {
+    if (delta > 0 && m_eventSource->hasEventIndex()) {
+      if (!m_eventSource->seekInBlock(delta)) return StatusCode::FAILURE;
+      m_NumEvents += delta;
+    }
+    else if (delta > 0) {
       if (next(*m_beginIter,delta).isFailure()) return StatusCode::FAILURE;
     }
     else return this->seek(it, evtNum);
@@ -657,6 +671,10 @@ StatusCode FaserEventSelectorByteStream::seek(Context& it, int evtNum) const {
     if ( delta == 0 ) { // current event
       // nothing to do
     } 
+    else if ( m_eventSource->hasEventIndex() ) { // either direction without reading
+      if ( !m_eventSource->seekInBlock(evtNum - m_firstEvt[m_fileCount]) ) return StatusCode::FAILURE;
+      if ( delta > 0 ) m_NumEvents += delta;
+    }
     else if ( delta > 0 ) { // forward
       if ( this->next(*m_beginIter, delta).isFailure() ) return StatusCode::FAILURE;
     } 
@@ -0,0 +1,189 @@
+/*
+  Copyright (C) 2024 CERN for the benefit of the FASER collaboration
+*/
+
+#include "ers/ers.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <string.h>
+
+#include "fReadMmap.h"
+#include "EventStorage/EventStorageIssues.h"
+
+fReadMmap::fReadMmap() :
+  m_data(NULL), m_size(0), m_pos(0), m_open(false), m_eof(false),
+  m_retired(NULL), m_retiredSize(0)
+{
+} 
+
+fReadMmap::~fReadMmap() 
+{
+  this->closeFile();
+  this->unmap(m_retired, m_retiredSize);
+}
+
+void fReadMmap::unmap(const char*& data, int64_t& size)
+{
+  if (data != NULL) ::munmap(const_cast<char*>(data), size);
+  data = NULL;
+  size = 0;
+}
+
+bool fReadMmap::isOpen() 
+{
+  return m_open;
+}
+
+bool fReadMmap::isEoF() 
+{
+  if(this->isOpen()) {
+    return m_eof;
+  } else {
+    return false;
+  }
+}
+
+bool fReadMmap::fileExists(std::string fName) const
+{
+  struct stat st;
+  if (::stat(fName.c_str(), &st) != 0) return false;
+  return S_ISREG(st.st_mode);
+}
+
+void fReadMmap::openFile(std::string fName) 
+{
+  if(this->isOpen()) this->closeFile();
+
+  // Only regular local files can be mapped, leave anything else to the other plugins
+  int fd = ::open(fName.c_str(), O_RDONLY);
+  if (fd < 0) return;
+
+  struct stat st;
+  if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+    ::close(fd);
+    return;
+  }
+
+  m_size = st.st_size;
+  m_pos = 0;
+  m_eof = false;
+
+  if (m_size > 0) {
+    void* addr = ::mmap(NULL, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED) {
+      ERS_DEBUG(1, "mmap of " << fName << " failed: " << strerror(errno));
+      ::close(fd);
+      m_size = 0;
+      return;
+    }
+    // Events are read front to back, let the kernel read ahead aggressively
+    ::madvise(addr, m_size, MADV_SEQUENTIAL);
+    ::madvise(addr, m_size, MADV_WILLNEED);
+    m_data = static_cast<const char*>(addr);
+  }
+
+  // The mapping stays valid after the descriptor is closed
+  ::close(fd);
+  m_open = true;
+}  
+
+void fReadMmap::closeFile() 
+{
+  if (!m_open) return;
+
+  // Keep the mapping alive until the next close, pointers into it may still be in use
+  this->unmap(m_retired, m_retiredSize);
+  m_retired = m_data;
+  m_retiredSize = m_size;
+
+  m_data = NULL;
+  m_size = 0;
+  m_pos = 0;
+  m_open = false;
+  m_eof = false;
+}
+
+void fReadMmap::readData(char *buffer, unsigned int sizeBytes) 
+{
+  if (sizeBytes==0) return;
+
+  const char* data = this->mapData(sizeBytes);
+  if (data == NULL) {
+    // Copy whatever is left, as an ifstream would
+    if (m_open && m_pos < m_size) {
+      memcpy(buffer, m_data + m_pos, m_size - m_pos);
+      m_pos = m_size;
+    }
+    m_eof = true;
+
+    std::stringstream mystream;
+    mystream << "error reading data from disk. "
+	     <<"fReadMmap finds EOF after trying to read "
+	     <<sizeBytes<<" bytes.";
+    std::string err = mystream.str();
+    EventStorage::ReadingIssue ci(ERS_HERE, err.c_str());
+    ers::warning(ci);
+    return;
+  }
+
+  memcpy(buffer, data, sizeBytes);
+}
+
+const char * fReadMmap::mapData(unsigned int sizeBytes)
+{
+  if(!m_open) {
+    std::stringstream mystream;
+    mystream << "an attempt to read from a file that is not open. "
+	     <<"fReadMmap::mapData called to read "
+	     <<sizeBytes<<" bytes.";
+    std::string err = mystream.str();
+    EventStorage::ReadingIssue ci(ERS_HERE, err.c_str());
+    ers::warning(ci);
+    return NULL;
+  }
+
+  if (m_pos + static_cast<int64_t>(sizeBytes) > m_size) return NULL;
+
+  const char* data = m_data + m_pos;
+  m_pos += sizeBytes;
+  return data;
+}
+
+int64_t fReadMmap::getPosition() 
+{
+  if(this->isOpen()) return m_pos;
+  return -1;
+}
+
+void fReadMmap::setPosition(int64_t p) 
+{  
+  if(this->isOpen()) {
+    m_pos = p;
+    m_eof = false;
+  }
+}
+ 
+void fReadMmap::setPositionFromEnd(int64_t p)
+{  
+  if(this->isOpen()) {
+    m_pos = m_size + p;
+    m_eof = false;
+  }
+}
+ 
+fRead * fReadMmap::newReader() const
+{
+  fReadMmap * nfr = new fReadMmap();
+  return (fRead *)nfr;
+}
+
+extern "C" {
+  fRead *fReadFactory() 
+  {
+    fReadMmap * nfr = new fReadMmap();
+    return (fRead *)nfr;
+  }
+}
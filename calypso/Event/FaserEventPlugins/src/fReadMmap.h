@@ -0,0 +1,52 @@
+/*
+  Copyright (C) 2024 CERN for the benefit of the FASER collaboration
+*/
+
+#ifndef FREADMMAP_H
+#define FREADMMAP_H
+
+#include <string>
+
+#include "FaserEventStorage/fRead.h"
+
+/**
+   fRead implementation which maps the whole file read-only into memory.
+   readData() copies out of the mapping, while mapData() hands out
+   pointers into it, so events can be decoded without any copy.
+   Pointers stay valid until the file after the next one is opened
+   (the previous mapping is retired rather than unmapped on close,
+   so the last event of a file survives the switch to the next file
+   in a sequence) or the reader is destroyed.
+*/
+class fReadMmap : public fRead
+{
+ public:
+  fReadMmap();
+  ~fReadMmap();
+
+  bool isOpen();
+  bool isEoF();
+  bool fileExists(std::string fName) const;
+  void openFile(std::string fName);
+  void closeFile();
+  void readData(char *buffer, unsigned int sizeBytes);
+  const char * mapData(unsigned int sizeBytes);
+  int64_t getPosition();
+  void setPosition(int64_t p);
+  void setPositionFromEnd(int64_t p);
+  fRead * newReader() const;
+
+ private:
+  void unmap(const char*& data, int64_t& size);
+
+  const char* m_data;     // current mapping
+  int64_t m_size;         // size of current mapping
+  int64_t m_pos;          // current position in file
+  bool m_open;
+  bool m_eof;
+
+  const char* m_retired;  // previous mapping, kept alive for outstanding pointers
+  int64_t m_retiredSize;
+};
+
+#endif 
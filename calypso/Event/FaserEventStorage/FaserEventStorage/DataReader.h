@@ -14,6 +14,7 @@
 
 #include <vector>
 #include <string>
+#include <span>
 #include <stdint.h>
 #include <bitset>
 #include "FaserEventStorage/DRError.h"
@@ -73,6 +74,30 @@ namespace FaserEventStorage {
     */
     virtual DRError getData(DAQFormats::EventFull*& theEvent, int64_t pos) = 0;
     virtual DRError getData(DAQFormats::EventFull*& theEvent) = 0; 
+
+    /**
+	  read the raw event bytes without decoding them into an EventFull
+	    \param &theEvent set to the event (header and payload) on return
+	      \param pos if you give this parameter, you are trying to get an event from the offset pos
+
+		  With a memory-mapping fRead plugin the span points directly into
+		  the mapped file, otherwise into a buffer owned by the reader.
+		  Either way it is only valid until the next call to getData/getDataView.
+		  Use DAQFormats::EventView to decode it in place.
+    */
+    virtual DRError getDataView(std::span<const uint8_t>& theEvent, int64_t pos) = 0;
+    virtual DRError getDataView(std::span<const uint8_t>& theEvent) = 0;
+
+    /**
+	  read the raw event bytes into storage owned by the caller
+	    \param &theEvent set to the event (header and payload) on return
+	      \param &buffer the event is read into this buffer if the file can't be mapped
+
+		  If the span points into the buffer it is valid as long as the buffer.
+		  Otherwise it points into the mapped file, and stays valid until the file
+		  after the next one of a sequence is opened or the reader is destroyed.
+    */
+    virtual DRError getDataView(std::span<const uint8_t>& theEvent, std::vector<uint8_t>& buffer) = 0;
     //    virtual DRError getDataPreAlloced(unsigned int &eventSize, char **event, int64_t allocSizeInBytes) = 0;
  
     //    virtual DRError getDataPreAllocedWitPos(unsigned int &eventSize, char **event,  int64_t allocSizeInBytes, int64_t pos = -1) = 0; 
@@ -44,6 +44,14 @@ class fRead
   virtual int64_t getPosition() = 0;
   virtual void setPosition(int64_t p) = 0;
   virtual void setPositionFromEnd(int64_t p) = 0;
+
+  /**
+     Zero-copy access to the next sizeBytes of the file.
+     Returns a pointer to the data and advances the position, or NULL
+     (without moving) if this implementation cannot hand out pointers,
+     in which case readData() must be used instead.
+  */
+  virtual const char * mapData(unsigned int /*sizeBytes*/) { return NULL; }
   
   void setCurrentEndOfFile(int64_t p)
   {
@@ -132,6 +132,34 @@ bool DataReaderController::endOfFileSequence() const
 
 //DRError DataReaderController::getData(unsigned int &eventSize, char **event, int64_t pos = -1 , bool memAlreadyAlloc = false, int64_t allocSizeInBytes = -1)
 DRError DataReaderController::getData(DAQFormats::EventFull*& theEvent, int64_t pos)
+{
+  int64_t oldpos = startRead(pos);
+  DRError res =  m_stack.top()->getData(theEvent, -1);
+  finishRead(pos, oldpos);
+  return res;
+}
+
+DRError DataReaderController::getDataView(std::span<const uint8_t>& theEvent, int64_t pos)
+{
+  int64_t oldpos = startRead(pos);
+  DRError res =  m_stack.top()->getDataView(theEvent, m_viewBuffer, -1);
+  finishRead(pos, oldpos);
+  return res;
+}
+
+DRError DataReaderController::getDataView(std::span<const uint8_t>& theEvent) {
+  return getDataView(theEvent, -1);
+}
+
+DRError DataReaderController::getDataView(std::span<const uint8_t>& theEvent, std::vector<uint8_t>& buffer)
+{
+  int64_t oldpos = startRead(-1);
+  DRError res =  m_stack.top()->getDataView(theEvent, buffer, -1);
+  finishRead(-1, oldpos);
+  return res;
+}
+
+int64_t DataReaderController::startRead(int64_t pos)
 {
 
   int64_t oldpos = 0;
@@ -152,11 +180,11 @@ DRError DataReaderController::getData(DAQFormats::EventFull*& theEvent, int64_t
       this->setPosition(pos);
     }
 
+  return oldpos;
+}
 
-  DRError res =  m_stack.top()->getData(theEvent, -1);
-
-
-
+void DataReaderController::finishRead(int64_t pos, int64_t oldpos)
+{
   //if position was defined, we need to jump back to the old position BEFORE checking for more events. Else if we are reading by offset, the program will crash.
   if ( pos != -1) 
     {
@@ -234,9 +262,6 @@ DRError DataReaderController::getData(DAQFormats::EventFull*& theEvent, int64_t
 
   //now everything should be in order, so let's read data
   
-
-  return res;
-
 }
 
 DRError DataReaderController::getData(DAQFormats::EventFull*& theEvent) {
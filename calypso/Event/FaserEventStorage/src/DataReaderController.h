@@ -43,6 +43,9 @@ namespace FaserEventStorage
     //    DRError getData(unsigned int &eventSize, char **event, int64_t pos , bool memAlreadyAlloc, int64_t allocSizeInBytes );
     DRError getData(DAQFormats::EventFull*& theEvent);
     DRError getData(DAQFormats::EventFull*& theEvent, int64_t pos);
+    DRError getDataView(std::span<const uint8_t>& theEvent);
+    DRError getDataView(std::span<const uint8_t>& theEvent, int64_t pos);
+    DRError getDataView(std::span<const uint8_t>& theEvent, std::vector<uint8_t>& buffer);
 
     //    DRError getDataPreAlloced(unsigned int &eventSize, char **event, int64_t allocSizeInBytes);
 
@@ -95,6 +98,8 @@ namespace FaserEventStorage
   private:
     std::string nextInContinuation(unsigned int expected);
     std::string sequenceFileName(bool isReady) const;
+    int64_t startRead(int64_t pos); //jumps to pos if given, returns position to restore
+    void finishRead(int64_t pos, int64_t oldpos); //restores position and moves on to the next file if needed
 
 
   private:
@@ -111,6 +116,7 @@ namespace FaserEventStorage
     unsigned int m_cFileNumber;
     std::string m_fileNameCore;
     std::string m_fileName;
+    std::vector<uint8_t> m_viewBuffer; //backing store for getDataView if the file can't be mapped
   };
   
   // fRead *fReadFactory();
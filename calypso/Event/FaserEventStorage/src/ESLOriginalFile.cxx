@@ -57,80 +57,86 @@ DRError FESLOriginalFile::getData(DAQFormats::EventFull*& theEvent, int64_t pos)
 
   // Read data header
   size_t sizeofHeader = theEvent->header_size();
-  char* buffer = new char[sizeofHeader];
+  checkRemaining(sizeofHeader, "header");
+  theEvent->loadHeader(readBlock(sizeofHeader, m_buffer, 0), sizeofHeader);
 
-  if (NULL == buffer) {
-    ERS_DEBUG(1, " tried to allocate " << theEvent->header_size() << " bytes for header but failed!");
-    FaserEventStorage::ES_AllocatingMemoryFailed ci(ERS_HERE, "FESLOriginalFile tried to allocate memory for header but failed. Abort.");
-      throw ci;
-  }
+  ERS_DEBUG(2,"DATA HEADER: Expected event size " << theEvent->size());
 
-  // Check if we will read beyond the end of the file
-  uint64_t cpos = m_fR->getPosition();
-  uint64_t remaining = m_cfilesize - cpos;
-  ERS_DEBUG(3, "current position before header " << cpos << " with " << remaining << " remaining") ;
+  // Now we have the event length, read the payload
+  // If the fRead plugin maps the file this points straight into the mapping
+  size_t sizeofPayload = theEvent->payload_size();
+  checkRemaining(sizeofPayload, "payload");
+  theEvent->loadPayload(readBlock(sizeofPayload, m_buffer, 0), sizeofPayload);
 
-  if (remaining < sizeofHeader) {
-    ERS_DEBUG(1, "Requested" << sizeofHeader
-	      << " bytes for header but only " << remaining << " remain in file!");
+  ERS_DEBUG(2, "Event:\n" << *theEvent);
+  
+  ERS_DEBUG(3,"Finished reading the event.");
 
-    FaserEventStorage::ES_OutOfFileBoundary ci(ERS_HERE, "Trying to read more data for header than remains in the file. This likely means your event is truncated. If you still want to read the data, catch this exception and proceed. The data block contains the rest of the data. ");
-    throw ci;
+  checkEndOfFile();
 
-    // In case this gets caught, but won't work well
-    m_fR->readData(buffer, remaining);
-    theEvent->loadHeader((uint8_t*)buffer, remaining);
-    delete[] buffer;
-    return DRNOOK;
-  }
+  return DROK;
+}
 
-  m_fR->readData(buffer, sizeofHeader);
-  theEvent->loadHeader((uint8_t*)buffer, sizeofHeader);
+DRError FESLOriginalFile::getDataView(std::span<const uint8_t>& theEvent, std::vector<uint8_t>& buffer, int64_t pos)
+{
+  ERS_DEBUG(2,"Entered FESLOriginalFile::getDataView().");
+  
+  if(pos>0) m_fR->setPosition(pos);
 
-  delete[] buffer;
+  // Only used to decode the header
+  DAQFormats::EventFull header;
 
-  ERS_DEBUG(2,"DATA HEADER: Expected event size " << theEvent->size());
+  size_t sizeofHeader = header.header_size();
+  checkRemaining(sizeofHeader, "header");
+  const uint8_t* start = readBlock(sizeofHeader, buffer, 0);
+  header.loadHeader(start, sizeofHeader);
 
-  // Now we have the event length, create buffer to store this
-  size_t sizeofPayload = theEvent->payload_size();
-  buffer = new char[sizeofPayload];
+  ERS_DEBUG(2,"DATA HEADER: Expected event size " << header.size());
 
-  if (NULL == buffer) {
-    ERS_DEBUG(1, "Tried to allocate " << sizeofPayload << " bytes for payload but failed!");    
-    FaserEventStorage::ES_AllocatingMemoryFailed ci(ERS_HERE, "FESLOriginalFile tried to allocate memory for payload but failed. Abort.");
-    throw ci;
-  }
+  size_t sizeofPayload = header.payload_size();
+  checkRemaining(sizeofPayload, "payload");
+  const uint8_t* payload = readBlock(sizeofPayload, buffer, sizeofHeader);
 
-  // Check if we will read beyond the end of the file
-  cpos = m_fR->getPosition();
-  ERS_DEBUG(3, "current position before payload " << cpos << " with " << remaining << " remaining");
-  remaining = m_cfilesize - cpos;
+  // Mapped blocks are contiguous in the file, copied ones in the buffer
+  if (payload != start + sizeofHeader) start = buffer.data();
+  theEvent = std::span<const uint8_t>(start, sizeofHeader + sizeofPayload);
+
+  ERS_DEBUG(3,"Finished reading the event.");
 
-  if (remaining < sizeofPayload) {
-    ERS_DEBUG(1, "Requested " << sizeofPayload 
-	      << " bytes for payload but only " << remaining << " remain in file ");
+  checkEndOfFile();
 
-    FaserEventStorage::ES_OutOfFileBoundary ci(ERS_HERE, "Trying to read more data than remains in the file. This could mean that either your event is truncated, or that the event size record of this event is corrupted. If you still want to read the data, catch this exception and proceed. The data block contains the rest of the data. ");
-    throw ci;
+  return DROK;
+}
 
-    // In case this gets caught, although thee loadPayload will throw its own error
-    m_fR->readData(buffer, remaining);
-    theEvent->loadPayload((uint8_t*)buffer, remaining);
-    delete[] buffer;
+const uint8_t* FESLOriginalFile::readBlock(size_t size, std::vector<uint8_t>& buffer, size_t offset)
+{
+  const char* data = m_fR->mapData(size);
+  if (data != NULL) return reinterpret_cast<const uint8_t*>(data);
 
-    return DRNOOK;
+  // Plugin can't hand out pointers, copy into the (reused) buffer
+  if (buffer.size() < offset + size) buffer.resize(offset + size);
+  m_fR->readData(reinterpret_cast<char*>(buffer.data() + offset), size);
+  return buffer.data() + offset;
+}
 
-  } else {
+void FESLOriginalFile::checkRemaining(size_t size, const std::string& what)
+{
+  // Check if we will read beyond the end of the file
+  uint64_t cpos = m_fR->getPosition();
+  uint64_t remaining = m_cfilesize - cpos;
+  ERS_DEBUG(3, "current position before " << what << " " << cpos << " with " << remaining << " remaining") ;
 
-    // OK, read event
-    m_fR->readData(buffer, sizeofPayload);
-    theEvent->loadPayload((uint8_t*)buffer, sizeofPayload);
-  
+  if (remaining < size) {
+    ERS_DEBUG(1, "Requested " << size
+	      << " bytes for " << what << " but only " << remaining << " remain in file!");
+
+    FaserEventStorage::ES_OutOfFileBoundary ci(ERS_HERE, "Trying to read more data than remains in the file. This could mean that either your event is truncated, or that the event size record of this event is corrupted. If you still want to read the data, catch this exception and proceed. The data block contains the rest of the data. ");
+    throw ci;
   }
-  ERS_DEBUG(2, "Event:\n" << *theEvent);
-  
-  ERS_DEBUG(3,"Finished reading the event.");
+}
 
+void FESLOriginalFile::checkEndOfFile()
+{
   // CHECK FOR END OF FILE REACHED
   // This is not an error
   if( /*m_fR->isEoF()*/  m_cfilesize<=m_fR->getPosition()) {
@@ -141,8 +147,6 @@ DRError FESLOriginalFile::getData(DAQFormats::EventFull*& theEvent, int64_t pos)
     m_finished = true;
     
   }
-
-  return DROK;
 }
 
 
@@ -27,6 +27,7 @@ class FESLOriginalFile : public EventStackLayer
 
   //DRError getData(unsigned int &eventSize, char **event, int64_t pos, bool memAlreadyAlloc, int64_t allocSizeInBytes);
   DRError getData(DAQFormats::EventFull*& theEvent, int64_t pos);
+  DRError getDataView(std::span<const uint8_t>& theEvent, std::vector<uint8_t>& buffer, int64_t pos);
   
   bool moreEvents() ;
   //bool handlesOffset() ;
@@ -76,6 +77,9 @@ class FESLOriginalFile : public EventStackLayer
 
   
  private:
+  const uint8_t* readBlock(size_t size, std::vector<uint8_t>& buffer, size_t offset);
+  void checkRemaining(size_t size, const std::string& what);
+  void checkEndOfFile();
   void readOptionalFreeMetaDataStrings();
   void checkCompression();
   file_end_record currentFileFER();
@@ -103,6 +107,7 @@ class FESLOriginalFile : public EventStackLayer
   std::string extractFromMetaData(std::string token);
   
   FaserEventStorage::CompressionType m_compression;
+  std::vector<uint8_t> m_buffer; // reused read buffer if the file isn't memory-mapped
   //compression::DataBuffer * m_uncompressed;
 };
 
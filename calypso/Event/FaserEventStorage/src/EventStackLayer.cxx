@@ -46,6 +46,19 @@ DRError EventStackLayer::getData(DAQFormats::EventFull*& theEvent, int64_t pos)
   return DRNOOK;
 }
 
+DRError EventStackLayer::getDataView(std::span<const uint8_t>& /*theEvent*/, std::vector<uint8_t>& /*buffer*/, int64_t pos)
+{
+  std::ostringstream os;
+  os << "EventStackLayerinterface::getDataView() was called, "
+     << " but should not have been called for this type of file!" 
+     << " position: " << pos ;  
+  
+  FaserEventStorage::ES_InternalError ci(ERS_HERE, os.str().c_str());
+  throw ci;
+
+  return DRNOOK;
+}
+
 EventStackLayer* EventStackLayer::openNext() 
 { 
   return 0; 
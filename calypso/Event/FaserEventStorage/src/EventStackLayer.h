@@ -4,6 +4,7 @@
 #include "ers/ers.h"
 #include <fstream>
 #include <vector>
+#include <span>
 #include <stack>
 #include <bitset>
 #include "FaserEventStorage/DRError.h"
@@ -39,6 +40,9 @@ class EventStackLayer //=ESL henceforward
   
   //virtual DRError getData(unsigned int &eventSize, char **event, int64_t pos, bool memAlreadyAlloc, int64_t allocSizeInBytes);
   virtual DRError getData(DAQFormats::EventFull*& theEvent, int64_t pos);
+
+  //raw bytes of the next event, either pointing into a mapped file or copied into buffer
+  virtual DRError getDataView(std::span<const uint8_t>& theEvent, std::vector<uint8_t>& buffer, int64_t pos);
   
   //the interface to instantiate a son-ESL instance.
   //e.g. MergeFileReader Instantiates an Originalfilereader
@@ -20,6 +20,11 @@ DataReader * pickFaserDataReader(std::string fileName) {
   } else if(fileName.find("disk:")==0) {
     fileName.erase(0,std::string("disk:").size()); 
     fReadLibs.push_back("fReadPlain"); 
+  } else if(fileName.find("mmap:")==0) {
+    // Memory-mapped local file, fall back to plain reading if it can't be mapped
+    fileName.erase(0,std::string("mmap:").size()); 
+    fReadLibs.push_back("fReadMmap"); 
+    fReadLibs.push_back("fReadPlain"); 
   } else if(fileName.find("https:")==0) {
     // Leave the prefix in the file name in this case.
     fReadLibs.push_back("fReadDavix");
@@ -14,6 +14,7 @@
 #include "xAODEventInfo/EventInfo.h"
 
 #include "LHCDataTools/ILHCDataTool.h"
+#include "LHCDataTools/LHCBunchPatternCondData.h"
 
 class LHCDataAlg : public AthReentrantAlgorithm {
  public:
@@ -30,18 +31,6 @@ class LHCDataAlg : public AthReentrantAlgorithm {
   SG::ReadHandleKey<xAOD::EventInfo> m_eventInfo{ this, "EventInfoKey", "EventInfo", "ReadHandleKey for xAOD::EventInfo"};
   SG::WriteHandleKey<xAOD::FaserLHCData> m_lhcDataKey
     {this, "FaserLHCDataKey", "FaserLHCData"};
-
-  // Utility function to find nearest BCID
-  int findNearest(unsigned int bcid, const std::vector<unsigned char>& bcid_mask, 
-		  unsigned char mask) const;
-
-  unsigned int 
-    previousColliding(unsigned int bcid, const std::vector<unsigned char>& bcid_mask) const;
-
-  // Find the distance to the first BCID of the previous train
-  unsigned int 
-    previousTrain(unsigned int bcid, const std::vector<unsigned char>& bcid_mask) const;
-
 };
 
 #endif // LHCDATAALG_H
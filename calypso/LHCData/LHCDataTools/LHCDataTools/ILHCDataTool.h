@@ -11,11 +11,15 @@
 
 //STL includes
 #include <map>
+#include <string>
+#include <vector>
 
 //Gaudi Includes
 #include "GaudiKernel/IAlgTool.h"
 #include "GaudiKernel/EventContext.h"
 
+class LHCBunchPatternCondData;
+
 class ILHCDataTool: virtual public IAlgTool {
 
  public:
@@ -69,6 +73,10 @@ class ILHCDataTool: virtual public IAlgTool {
   virtual std::vector<unsigned char> getBCIDMasks(const EventContext& ctx) const = 0;
   virtual std::vector<unsigned char> getBCIDMasks(void) const = 0;
 
+  // Decoded bunch pattern with per-BCID distance tables
+  virtual const LHCBunchPatternCondData* getBunchPatternData(const EventContext& ctx) const = 0;
+  virtual const LHCBunchPatternCondData* getBunchPatternData(void) const = 0;
+
 };
 
 //---------------------------------------------------------------------- 
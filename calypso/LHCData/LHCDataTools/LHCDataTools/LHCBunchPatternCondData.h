@@ -0,0 +1,104 @@
+/*
+  Copyright (C) 2022 CERN for the benefit of the FASER collaboration
+*/
+
+/** @file LHCBunchPatternCondData.h
+    Decoded LHC bunch pattern with per-BCID distance tables,
+    filled once per IOV by LHCBunchPatternCondAlg
+*/
+
+#ifndef LHCBUNCHPATTERNCONDDATA_H
+#define LHCBUNCHPATTERNCONDDATA_H
+
+#include <vector>
+
+/** Indices into the tables are BCID numbers modulo 3564, so BCID 3564
+    shares index 0, which never holds a bunch in the real machine.
+    All distances are in units of BCIDs.
+*/
+class LHCBunchPatternCondData {
+
+ public:
+  // Number of BCIDs in one LHC turn
+  static constexpr unsigned int nBCID = 3564;
+
+  // Values of the BCID mask
+  enum BunchClass : unsigned char { EMPTY = 0, UNPAIRED_B1 = 1, UNPAIRED_B2 = 2, COLLIDING = 3 };
+
+  // Returned by the nearest-bunch lookups if nothing is found within half a turn
+  static constexpr int NO_NEAREST = -3565;
+  // Returned by the previous-bunch lookups if nothing is found within a full turn
+  static constexpr unsigned int NO_PREVIOUS = 9999;
+
+  LHCBunchPatternCondData();
+  virtual ~LHCBunchPatternCondData() = default;
+
+  // Filling, used by LHCBunchPatternCondAlg
+  void setBunchCounts(unsigned int beam1, unsigned int beam2, unsigned int colliding);
+  // Copies the masks (at most nBCID entries) and fills the distance tables
+  void setMasks(const unsigned char* masks, unsigned int size);
+
+  // Bunch counts from the BCID data folder
+  unsigned int beam1Bunches() const { return m_beam1Bunches; }
+  unsigned int beam2Bunches() const { return m_beam2Bunches; }
+  unsigned int collidingBunches() const { return m_collidingBunches; }
+
+  // One mask per BCID, as returned by ILHCDataTool::getBCIDMasks
+  const std::vector<unsigned char>& masks() const { return m_masks; }
+
+  // BCIDs count from 1 to nBCID
+  static bool validBCID(unsigned int bcid) { return (bcid > 0) && (bcid <= nBCID); }
+
+  BunchClass bunchClass(unsigned int bcid) const { return static_cast<BunchClass>(m_masks[bcid % nBCID]); }
+
+  // Signed distance to the nearest bunch of a given class, positive for later BCIDs
+  // Ties are resolved towards later BCIDs
+  int distanceToColliding(unsigned int bcid) const { return lookup(m_nearestColliding, bcid); }
+  int distanceToUnpairedB1(unsigned int bcid) const { return lookup(m_nearestUnpairedB1, bcid); }
+  int distanceToUnpairedB2(unsigned int bcid) const { return lookup(m_nearestUnpairedB2, bcid); }
+
+  // Distance from BCID+127 to the nearest B1 bunch (unpaired or colliding),
+  // to check for B1 bunches passing FASER on their way to IP1
+  int distanceToInboundB1(unsigned int bcid) const { return lookup(m_nearestInboundB1, bcid); }
+
+  // Distance back to the previous colliding bunch (0 if this BCID is colliding)
+  unsigned int distanceToPreviousColliding(unsigned int bcid) const { return lookup(m_previousColliding, bcid); }
+  // Distance back to the first bunch of the train holding the previous colliding bunch
+  unsigned int distanceToTrainStart(unsigned int bcid) const { return lookup(m_previousTrainStart, bcid); }
+
+ private:
+  unsigned int m_beam1Bunches{0};
+  unsigned int m_beam2Bunches{0};
+  unsigned int m_collidingBunches{0};
+
+  std::vector<unsigned char> m_masks;
+
+  std::vector<int> m_nearestColliding;
+  std::vector<int> m_nearestUnpairedB1;
+  std::vector<int> m_nearestUnpairedB2;
+  std::vector<int> m_nearestInboundB1;
+  std::vector<unsigned int> m_previousColliding;
+  std::vector<unsigned int> m_previousTrainStart;
+
+  // Distances to the next (forward) and previous (backward) BCID with the given mask
+  // nBCID if there is none
+  void findDistances(unsigned char mask, std::vector<unsigned int>& forward, std::vector<unsigned int>& backward) const;
+  void fillNearest(unsigned char mask, std::vector<int>& nearest) const;
+
+  static int lookup(const std::vector<int>& table, unsigned int bcid) {
+    return validBCID(bcid) ? table[bcid % nBCID] : NO_NEAREST;
+  }
+  static unsigned int lookup(const std::vector<unsigned int>& table, unsigned int bcid) {
+    return validBCID(bcid) ? table[bcid % nBCID] : NO_PREVIOUS;
+  }
+};
+
+// Class definition for StoreGate
+#include "AthenaKernel/CLASS_DEF.h"
+CLASS_DEF( LHCBunchPatternCondData , 141587249 , 1 )
+
+// Condition container definition for CondInputLoader
+#include "AthenaKernel/CondCont.h"
+CONDCONT_DEF( LHCBunchPatternCondData, 52083171 );
+
+#endif // LHCBUNCHPATTERNCONDDATA_H
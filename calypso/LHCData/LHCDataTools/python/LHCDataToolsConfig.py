@@ -15,5 +15,8 @@ def LHCDataCfg(flags, **kwargs):
     for folder_name in folder_list:
         folder_string = f"<db>{dbInstance}/{dbName}</db> {folder_name}"
         acc.merge(addFolders(flags, folder_string, className="AthenaAttributeList"))
+
+    # Bunch pattern decoded once per IOV
+    acc.addCondAlgo(CompFactory.LHCBunchPatternCondAlg(ReadKey="/LHC/BCIDData"))
     return acc
 
@@ -0,0 +1,102 @@
+/*
+  Copyright (C) 2022 CERN for the benefit of the FASER collaboration
+*/
+
+/** @file LHCBunchPatternCondAlg.cxx
+    Based on LHCDataTool::getBCIDMasks
+*/
+
+#include "LHCBunchPatternCondAlg.h"
+
+#include "CoralBase/Blob.h"
+#include "GaudiKernel/EventIDRange.h"
+
+#include <memory>
+
+LHCBunchPatternCondAlg::LHCBunchPatternCondAlg(const std::string& name, ISvcLocator* pSvcLocator)
+  : ::AthReentrantAlgorithm(name, pSvcLocator)
+{
+}
+
+//----------------------------------------------------------------------
+StatusCode
+LHCBunchPatternCondAlg::initialize() {
+  ATH_MSG_DEBUG("initialize " << name());
+
+  ATH_CHECK(m_condSvc.retrieve());
+
+  ATH_CHECK(m_readKey.initialize());
+  ATH_CHECK(m_writeKey.initialize());
+  if (m_condSvc->regHandle(this, m_writeKey).isFailure()) {
+    ATH_MSG_FATAL("unable to register WriteCondHandle " << m_writeKey.fullKey() << " with CondSvc");
+    return StatusCode::FAILURE;
+  }
+
+  return StatusCode::SUCCESS;
+}
+
+//----------------------------------------------------------------------
+StatusCode
+LHCBunchPatternCondAlg::execute(const EventContext& ctx) const {
+  ATH_MSG_DEBUG("execute " << name());
+
+  // Write Cond Handle
+  SG::WriteCondHandle<LHCBunchPatternCondData> writeHandle{m_writeKey, ctx};
+  // Do we have a valid Write Cond Handle for current time?
+  if (writeHandle.isValid()) {
+    ATH_MSG_DEBUG("CondHandle " << writeHandle.fullKey() << " is already valid."
+                  << ". In theory this should not be called, but may happen"
+                  << " if multiple concurrent events are being processed out of order.");
+    return StatusCode::SUCCESS;
+  }
+
+  // Read Cond Handle
+  SG::ReadCondHandle<AthenaAttributeList> readHandle{m_readKey, ctx};
+  const AthenaAttributeList* readCdo{*readHandle};
+  if (readCdo==nullptr) {
+    ATH_MSG_FATAL("Null pointer to the read conditions object");
+    return StatusCode::FAILURE;
+  }
+  // Get the validitiy range
+  EventIDRange rangeW;
+  if (not readHandle.range(rangeW)) {
+    ATH_MSG_FATAL("Failed to retrieve validity range for " << readHandle.key());
+    return StatusCode::FAILURE;
+  }
+  ATH_MSG_DEBUG("Range of input is " << rangeW);
+
+  std::unique_ptr<LHCBunchPatternCondData> writeCdo{std::make_unique<LHCBunchPatternCondData>()};
+
+  const AthenaAttributeList& payload{*readCdo};
+  writeCdo->setBunchCounts(payload["Beam1Bunches"].data<unsigned int>(),
+                           payload["Beam2Bunches"].data<unsigned int>(),
+                           payload["CollidingBunches"].data<unsigned int>());
+
+  const coral::Blob& blob = payload["BCIDmasks"].data<coral::Blob>();
+  // Should always be 3564 BCIDs
+  if (blob.size() != LHCBunchPatternCondData::nBCID) {
+    ATH_MSG_WARNING("Found BCID blob with size " << blob.size() << "!");
+  }
+  writeCdo->setMasks(static_cast<const unsigned char*>(blob.startingAddress()), blob.size());
+
+  ATH_MSG_DEBUG("Decoded bunch pattern with B1: " << writeCdo->beam1Bunches()
+                << " B2: " << writeCdo->beam2Bunches()
+                << " Coll: " << writeCdo->collidingBunches());
+
+  if (writeHandle.record(rangeW, std::move(writeCdo)).isFailure()) {
+    ATH_MSG_FATAL("Could not record LHCBunchPatternCondData " << writeHandle.key()
+                  << " with EventRange " << rangeW
+                  << " into Conditions Store");
+    return StatusCode::FAILURE;
+  }
+  ATH_MSG_INFO("recorded new CDO " << writeHandle.key() << " with range " << rangeW << " into Conditions Store");
+
+  return StatusCode::SUCCESS;
+}
+
+//----------------------------------------------------------------------
+StatusCode
+LHCBunchPatternCondAlg::finalize() {
+  ATH_MSG_DEBUG("finalize " << name());
+  return StatusCode::SUCCESS;
+}
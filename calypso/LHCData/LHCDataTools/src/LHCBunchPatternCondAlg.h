@@ -0,0 +1,39 @@
+// -*- C++ -*-
+
+/*
+  Copyright (C) 2022 CERN for the benefit of the FASER collaboration
+*/
+
+/** @file LHCBunchPatternCondAlg.h
+    Decodes the BCID mask blob once per IOV into LHCBunchPatternCondData
+*/
+
+#ifndef LHCBUNCHPATTERN_COND_ALG
+#define LHCBUNCHPATTERN_COND_ALG
+
+#include "AthenaBaseComps/AthReentrantAlgorithm.h"
+
+#include "AthenaPoolUtilities/AthenaAttributeList.h"
+#include "StoreGate/ReadCondHandleKey.h"
+#include "StoreGate/WriteCondHandleKey.h"
+#include "LHCDataTools/LHCBunchPatternCondData.h"
+
+#include "GaudiKernel/ICondSvc.h"
+
+class LHCBunchPatternCondAlg : public AthReentrantAlgorithm {
+
+ public:
+  LHCBunchPatternCondAlg(const std::string& name, ISvcLocator* pSvcLocator);
+  virtual ~LHCBunchPatternCondAlg() = default;
+  virtual StatusCode initialize() override;
+  virtual StatusCode execute(const EventContext& ctx) const override;
+  virtual StatusCode finalize() override;
+  virtual bool isClonable() const override { return true; };
+
+ private:
+  SG::ReadCondHandleKey<AthenaAttributeList> m_readKey{this, "ReadKey", "/LHC/BCIDData", "Key of BCID data folder"};
+  SG::WriteCondHandleKey<LHCBunchPatternCondData> m_writeKey{this, "WriteKey", "LHCBunchPatternCondData", "Key of decoded bunch pattern"};
+  ServiceHandle<ICondSvc> m_condSvc{this, "CondSvc", "CondSvc"};
+};
+
+#endif // LHCBUNCHPATTERN_COND_ALG
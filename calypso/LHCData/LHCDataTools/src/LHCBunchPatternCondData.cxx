@@ -0,0 +1,123 @@
+/*
+  Copyright (C) 2022 CERN for the benefit of the FASER collaboration
+*/
+
+/** @file LHCBunchPatternCondData.cxx
+    Distance tables follow the searches previously done per event in LHCDataAlg
+*/
+
+#include "LHCDataTools/LHCBunchPatternCondData.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+LHCBunchPatternCondData::LHCBunchPatternCondData() :
+  m_masks(nBCID, EMPTY),
+  m_nearestColliding(nBCID, NO_NEAREST),
+  m_nearestUnpairedB1(nBCID, NO_NEAREST),
+  m_nearestUnpairedB2(nBCID, NO_NEAREST),
+  m_nearestInboundB1(nBCID, NO_NEAREST),
+  m_previousColliding(nBCID, NO_PREVIOUS),
+  m_previousTrainStart(nBCID, NO_PREVIOUS)
+{
+}
+
+//----------------------------------------------------------------------
+void
+LHCBunchPatternCondData::setBunchCounts(unsigned int beam1, unsigned int beam2, unsigned int colliding) {
+  m_beam1Bunches = beam1;
+  m_beam2Bunches = beam2;
+  m_collidingBunches = colliding;
+}
+
+//----------------------------------------------------------------------
+void
+LHCBunchPatternCondData::findDistances(unsigned char mask,
+                                       std::vector<unsigned int>& forward,
+                                       std::vector<unsigned int>& backward) const {
+  forward.assign(nBCID, nBCID);
+  backward.assign(nBCID, nBCID);
+
+  // Two passes in each direction to wrap around the turn
+  // Index 0 (BCID 0 or 3564) never holds a bunch
+  unsigned int dist = nBCID;
+  for (unsigned int i = 2*nBCID; i-- > 0;) {
+    unsigned int index = i % nBCID;
+    if (index != 0 && m_masks[index] == mask) dist = 0;
+    forward[index] = std::min(forward[index], dist);
+    if (dist < nBCID) dist++;
+  }
+
+  dist = nBCID;
+  for (unsigned int i = 0; i < 2*nBCID; i++) {
+    unsigned int index = i % nBCID;
+    if (index != 0 && m_masks[index] == mask) dist = 0;
+    backward[index] = std::min(backward[index], dist);
+    if (dist < nBCID) dist++;
+  }
+}
+
+//----------------------------------------------------------------------
+void
+LHCBunchPatternCondData::fillNearest(unsigned char mask, std::vector<int>& nearest) const {
+  std::vector<unsigned int> forward;
+  std::vector<unsigned int> backward;
+  findDistances(mask, forward, backward);
+
+  // Search is limited to half a turn, later BCIDs win ties
+  const unsigned int half = nBCID/2;
+  nearest.assign(nBCID, NO_NEAREST);
+  for (unsigned int index = 0; index < nBCID; index++) {
+    if (forward[index] < half && forward[index] <= backward[index]) {
+      nearest[index] = forward[index];
+    } else if (backward[index] < half) {
+      nearest[index] = -static_cast<int>(backward[index]);
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+void
+LHCBunchPatternCondData::setMasks(const unsigned char* masks, unsigned int size) {
+  m_masks.assign(nBCID, EMPTY);
+  std::copy(masks, masks + std::min(size, nBCID), m_masks.begin());
+
+  fillNearest(COLLIDING, m_nearestColliding);
+  fillNearest(UNPAIRED_B1, m_nearestUnpairedB1);
+  fillNearest(UNPAIRED_B2, m_nearestUnpairedB2);
+
+  // Inbound B1 is looked up 127 BCIDs later, either unpaired or colliding
+  // The unpaired bunch is kept unless the colliding one is strictly closer
+  m_nearestInboundB1.assign(nBCID, NO_NEAREST);
+  for (unsigned int index = 0; index < nBCID; index++) {
+    unsigned int offset = (index + 127) % nBCID;
+    int nearest = m_nearestUnpairedB1[offset];
+    int nearest2 = m_nearestColliding[offset];
+    if (std::abs(nearest2) < std::abs(nearest)) nearest = nearest2;
+    m_nearestInboundB1[index] = nearest;
+  }
+
+  // Previous colliding bunch and the start of its train
+  std::vector<unsigned int> forward;
+  std::vector<unsigned int> backward;
+  findDistances(COLLIDING, forward, backward);
+
+  // Length of the colliding run ending at each index, index 0 always breaks a run
+  std::vector<unsigned int> run(nBCID, 0);
+  for (unsigned int index = 1; index < nBCID; index++) {
+    if (m_masks[index] == COLLIDING) run[index] = run[index-1] + 1;
+  }
+
+  m_previousColliding.assign(nBCID, NO_PREVIOUS);
+  m_previousTrainStart.assign(nBCID, NO_PREVIOUS);
+  for (unsigned int index = 0; index < nBCID; index++) {
+    unsigned int previous = backward[index];
+    if (previous >= nBCID) continue;
+    m_previousColliding[index] = previous;
+
+    unsigned int last = (index + nBCID - previous) % nBCID;
+    unsigned int start = previous + run[last] - 1;
+    // The BCID before the train must also be within one turn
+    if (start + 1 < nBCID) m_previousTrainStart[index] = start;
+  }
+}
@@ -7,7 +7,6 @@
 */
 
 #include "LHCDataTool.h"
-#include "CoralBase/Blob.h"
 
 //----------------------------------------------------------------------
 LHCDataTool::LHCDataTool (const std::string& type, const std::string& name, const IInterface* parent) :
@@ -25,6 +24,7 @@ LHCDataTool::initialize() {
   //ATH_CHECK(m_fillDataKey.initialize());
   ATH_CHECK(m_beamDataKey.initialize());
   ATH_CHECK(m_bcidDataKey.initialize());
+  ATH_CHECK(m_bunchPatternKey.initialize());
 
   return StatusCode::SUCCESS;
 }
@@ -197,34 +197,12 @@ LHCDataTool::getCollidingBunches(void) const {
 
 
 //----------------------------------------------------------------------
-// This function unpacks the blob every time this is accesed
-// Should probably cache this using a callback
+// The blob is unpacked once per IOV by LHCBunchPatternCondAlg
 std::vector<unsigned char>
 LHCDataTool::getBCIDMasks(const EventContext& ctx) const {
-
-  SG::ReadCondHandle<AthenaAttributeList> bcidHandle{m_bcidDataKey, ctx};
-  const coral::Blob& blob = (**bcidHandle)["BCIDmasks"].data<coral::Blob>();
-  const unsigned char* p = static_cast<const unsigned char*>(blob.startingAddress());
-
-  // Should always be 3564 BCIDs
-  if (blob.size() != 3564) {
-    ATH_MSG_WARNING("Found BCID blob with size " << blob.size() << "!");
-  }
-
-  std::vector<unsigned char> bcid_vector(3564);
-
-  bool first = true;
-  for (int i=0; i<blob.size(); i++) {
-    // First BCID is 1, but this is stored at location i=1
-    // So you can index this vector as bcid_vector[bcid_number]
-    bcid_vector[i] = *p++;  
-    if (first && (bcid_vector[i] == 3)) {
-      first = false;
-      ATH_MSG_DEBUG("Found first colliding BCID at " << i);
-    }
-  }
-
-  return bcid_vector;
+  const LHCBunchPatternCondData* pattern{getBunchPatternData(ctx)};
+  if (pattern==nullptr) return std::vector<unsigned char>(LHCBunchPatternCondData::nBCID);
+  return pattern->masks();
 }
 
 std::vector<unsigned char>
@@ -233,5 +211,19 @@ LHCDataTool::getBCIDMasks(void) const {
   return getBCIDMasks(ctx);
 }
 
+//----------------------------------------------------------------------
+const LHCBunchPatternCondData*
+LHCDataTool::getBunchPatternData(const EventContext& ctx) const {
+  SG::ReadCondHandle<LHCBunchPatternCondData> condData{m_bunchPatternKey, ctx};
+  if (not condData.isValid()) {
+    ATH_MSG_FATAL("Failed to retrieve " << m_bunchPatternKey.key());
+    return nullptr;
+  }
+  return *condData;
+}
 
-
+const LHCBunchPatternCondData*
+LHCDataTool::getBunchPatternData(void) const {
+  const EventContext& ctx{Gaudi::Hive::currentContext()};
+  return getBunchPatternData(ctx);
+}
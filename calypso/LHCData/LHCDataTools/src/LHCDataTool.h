@@ -15,6 +15,7 @@
 // Include interface class
 #include "AthenaBaseComps/AthAlgTool.h"
 #include "LHCDataTools/ILHCDataTool.h"
+#include "LHCDataTools/LHCBunchPatternCondData.h"
 
 // Include Athena stuff
 #include "AthenaPoolUtilities/CondAttrListCollection.h"
@@ -87,11 +88,15 @@ class LHCDataTool: public extends<AthAlgTool, ILHCDataTool> {
   virtual std::vector<unsigned char> getBCIDMasks(const EventContext& ctx) const override;
   virtual std::vector<unsigned char> getBCIDMasks(void) const override;
 
+  virtual const LHCBunchPatternCondData* getBunchPatternData(const EventContext& ctx) const override;
+  virtual const LHCBunchPatternCondData* getBunchPatternData(void) const override;
+
  private:
   // Read Cond Handles
   //SG::ReadCondHandleKey<AthenaAttributeList> m_fillDataKey{this, "FillDataKey", "/LHC/FillData", "Key of fill data folder"};
   SG::ReadCondHandleKey<AthenaAttributeList> m_beamDataKey{this, "BeamDataKey", "/LHC/BeamData", "Key of fill data folder"};
   SG::ReadCondHandleKey<AthenaAttributeList> m_bcidDataKey{this, "BcidDataKey", "/LHC/BCIDData", "Key of fill data folder"};
+  SG::ReadCondHandleKey<LHCBunchPatternCondData> m_bunchPatternKey{this, "BunchPatternKey", "LHCBunchPatternCondData", "Key of decoded bunch pattern"};
 
   ServiceHandle<ICondSvc> m_condSvc{this, "CondSvc", "CondSvc"};
 
@@ -1,3 +1,5 @@
 #include "../LHCDataTool.h"
+#include "../LHCBunchPatternCondAlg.h"
 
 DECLARE_COMPONENT( LHCDataTool )
+DECLARE_COMPONENT( LHCBunchPatternCondAlg )
@@ -0,0 +1,191 @@
+/*
+  Copyright (C) 2022 CERN for the benefit of the FASER collaboration
+*/
+
+/** @file LHCBunchPatternCondData_test.cxx
+    Unit test of the BCID distance tables of the decoded LHC bunch pattern
+*/
+
+#undef NDEBUG
+#include "LHCDataTools/LHCBunchPatternCondData.h"
+
+#include <cassert>
+#include <initializer_list>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+  typedef LHCBunchPatternCondData Pattern;
+
+  // bunch pattern with the given BCIDs of one class
+  void setBunches(std::vector<unsigned char>& masks, std::initializer_list<unsigned int> bcids, unsigned char mask) {
+    for (unsigned int bcid : bcids) masks[bcid % Pattern::nBCID] = mask;
+  }
+
+  void testEmpty() {
+    std::cout << "testEmpty\n";
+    Pattern pattern;
+    std::vector<unsigned char> masks(Pattern::nBCID, Pattern::EMPTY);
+    pattern.setMasks(masks.data(), masks.size());
+    for (unsigned int bcid : {1u, 1782u, 3564u}) {
+      assert(pattern.distanceToColliding(bcid) == Pattern::NO_NEAREST);
+      assert(pattern.distanceToUnpairedB1(bcid) == Pattern::NO_NEAREST);
+      assert(pattern.distanceToInboundB1(bcid) == Pattern::NO_NEAREST);
+      assert(pattern.distanceToPreviousColliding(bcid) == Pattern::NO_PREVIOUS);
+      assert(pattern.distanceToTrainStart(bcid) == Pattern::NO_PREVIOUS);
+    }
+  }
+
+  void testInvalidBCID() {
+    std::cout << "testInvalidBCID\n";
+    Pattern pattern;
+    std::vector<unsigned char> masks(Pattern::nBCID, Pattern::COLLIDING);
+    pattern.setMasks(masks.data(), masks.size());
+    assert(Pattern::validBCID(1) && Pattern::validBCID(3564));
+    assert(!Pattern::validBCID(0) && !Pattern::validBCID(3565));
+    assert(pattern.distanceToColliding(1) == 0);
+    assert(pattern.distanceToColliding(0) == Pattern::NO_NEAREST);
+    assert(pattern.distanceToColliding(3565) == Pattern::NO_NEAREST);
+    assert(pattern.distanceToPreviousColliding(0) == Pattern::NO_PREVIOUS);
+    assert(pattern.distanceToTrainStart(3565) == Pattern::NO_PREVIOUS);
+  }
+
+  void testNearest() {
+    std::cout << "testNearest\n";
+    Pattern pattern;
+    std::vector<unsigned char> masks(Pattern::nBCID, Pattern::EMPTY);
+    setBunches(masks, {10, 20}, Pattern::COLLIDING);
+    setBunches(masks, {500}, Pattern::UNPAIRED_B1);
+    setBunches(masks, {600}, Pattern::UNPAIRED_B2);
+    pattern.setMasks(masks.data(), masks.size());
+    assert(pattern.bunchClass(10) == Pattern::COLLIDING);
+    assert(pattern.bunchClass(11) == Pattern::EMPTY);
+    assert(pattern.distanceToColliding(10) == 0);
+    assert(pattern.distanceToColliding(12) == -2);
+    assert(pattern.distanceToColliding(18) == 2);
+    // ties go to the later bunch
+    assert(pattern.distanceToColliding(15) == 5);
+    assert(pattern.distanceToUnpairedB1(400) == 100);
+    assert(pattern.distanceToUnpairedB1(600) == -100);
+    assert(pattern.distanceToUnpairedB2(600) == 0);
+    assert(pattern.distanceToUnpairedB2(500) == 100);
+  }
+
+  void testWrapAround() {
+    std::cout << "testWrapAround\n";
+    Pattern pattern;
+    std::vector<unsigned char> masks(Pattern::nBCID, Pattern::EMPTY);
+    setBunches(masks, {1}, Pattern::COLLIDING);
+    setBunches(masks, {3563}, Pattern::UNPAIRED_B1);
+    pattern.setMasks(masks.data(), masks.size());
+    // forward across the end of the turn
+    assert(pattern.distanceToColliding(3564) == 1);
+    assert(pattern.distanceToColliding(3563) == 2);
+    // backward across the start of the turn
+    assert(pattern.distanceToUnpairedB1(2) == -3);
+    assert(pattern.distanceToUnpairedB1(3564) == -1);
+    // the search stops after half a turn
+    assert(pattern.distanceToColliding(1000) == -999);
+    assert(pattern.distanceToColliding(1782) == -1781);
+    assert(pattern.distanceToColliding(1783) == Pattern::NO_NEAREST);
+    assert(pattern.distanceToColliding(1784) == 1781);
+    // the previous colliding bunch may be almost a full turn back
+    assert(pattern.distanceToPreviousColliding(1) == 0);
+    assert(pattern.distanceToPreviousColliding(3564) == 3563);
+    assert(pattern.distanceToPreviousColliding(3563) == 3562);
+  }
+
+  void testIndexZero() {
+    std::cout << "testIndexZero\n";
+    // BCID 3564 shares index 0, which never holds a bunch
+    Pattern pattern;
+    std::vector<unsigned char> masks(Pattern::nBCID, Pattern::EMPTY);
+    masks[0] = Pattern::COLLIDING;
+    pattern.setMasks(masks.data(), masks.size());
+    assert(pattern.distanceToColliding(3564) == Pattern::NO_NEAREST);
+    assert(pattern.distanceToColliding(1) == Pattern::NO_NEAREST);
+    assert(pattern.distanceToPreviousColliding(1) == Pattern::NO_PREVIOUS);
+  }
+
+  void testTrains() {
+    std::cout << "testTrains\n";
+    Pattern pattern;
+    std::vector<unsigned char> masks(Pattern::nBCID, Pattern::EMPTY);
+    setBunches(masks, {100, 101, 102, 103}, Pattern::COLLIDING);
+    // a train across the end of the turn is split by index 0
+    setBunches(masks, {3562, 3563, 1, 2}, Pattern::COLLIDING);
+    pattern.setMasks(masks.data(), masks.size());
+    assert(pattern.distanceToPreviousColliding(110) == 7);
+    assert(pattern.distanceToTrainStart(110) == 10);
+    assert(pattern.distanceToPreviousColliding(102) == 0);
+    assert(pattern.distanceToTrainStart(102) == 2);
+    assert(pattern.distanceToTrainStart(100) == 0);
+    assert(pattern.distanceToPreviousColliding(5) == 3);
+    assert(pattern.distanceToTrainStart(5) == 4);
+    assert(pattern.distanceToPreviousColliding(3564) == 1);
+    assert(pattern.distanceToTrainStart(3564) == 2);
+  }
+
+  void testFullTrain() {
+    std::cout << "testFullTrain\n";
+    // every BCID colliding, the train start is index 1
+    Pattern pattern;
+    std::vector<unsigned char> masks(Pattern::nBCID, Pattern::COLLIDING);
+    pattern.setMasks(masks.data(), masks.size());
+    assert(pattern.distanceToTrainStart(1) == 0);
+    assert(pattern.distanceToTrainStart(3563) == 3562);
+    assert(pattern.distanceToPreviousColliding(3564) == 1);
+    // the BCID before the train would be more than a turn back
+    assert(pattern.distanceToTrainStart(3564) == Pattern::NO_PREVIOUS);
+  }
+
+  void testInboundB1() {
+    std::cout << "testInboundB1\n";
+    Pattern pattern;
+    std::vector<unsigned char> masks(Pattern::nBCID, Pattern::EMPTY);
+    setBunches(masks, {200}, Pattern::UNPAIRED_B1);
+    setBunches(masks, {60}, Pattern::COLLIDING);
+    pattern.setMasks(masks.data(), masks.size());
+    // looked up at BCID+127
+    assert(pattern.distanceToInboundB1(73) == 0);
+    assert(pattern.distanceToInboundB1(80) == -7);
+    // colliding bunches count when strictly closer, also across the end of the turn
+    assert(pattern.distanceToInboundB1(3500) == -3);
+    assert(pattern.distanceToInboundB1(3497) == 0);
+    // BCID 3437 is looked up at index 0
+    assert(pattern.distanceToInboundB1(3437) == 60);
+  }
+
+  void testTruncation() {
+    std::cout << "testTruncation\n";
+    Pattern pattern;
+    std::vector<unsigned char> masks(4000, Pattern::EMPTY);
+    masks[3600] = Pattern::COLLIDING;
+    pattern.setMasks(masks.data(), masks.size());
+    assert(pattern.masks().size() == Pattern::nBCID);
+    assert(pattern.distanceToColliding(36) == Pattern::NO_NEAREST);
+
+    // a short blob leaves the remaining BCIDs empty
+    std::vector<unsigned char> shortMasks(10, Pattern::COLLIDING);
+    pattern.setMasks(shortMasks.data(), shortMasks.size());
+    assert(pattern.bunchClass(9) == Pattern::COLLIDING);
+    assert(pattern.bunchClass(10) == Pattern::EMPTY);
+    assert(pattern.distanceToColliding(12) == -3);
+  }
+
+}
+
+int main() {
+  std::cout << "LHCBunchPatternCondData_test\n";
+  testEmpty();
+  testInvalidBCID();
+  testNearest();
+  testWrapAround();
+  testIndexZero();
+  testTrains();
+  testFullTrain();
+  testInboundB1();
+  testTruncation();
+  return 0;
+}
@@ -9,6 +9,10 @@
 #include "AthenaKernel/CondCont.h" 
 #include "GaudiKernel/ServiceHandle.h"
 #include "MagFieldElements/FaserFieldCache.h"
+#include "MagFieldElements/FaserFieldGrid.h"
+#include "MagFieldElements/FaserFieldRegions.h"
+
+#include <memory>
 
 // forward declarations
 namespace MagField {
@@ -33,10 +37,26 @@ public:
     bool initialize(double dipoleFieldScale,  
                     const MagField::FaserFieldMap* fieldMap);
 
+    /** resample the scaled map on a uniform grid with the given spacing (mm), which all
+        caches handed out afterwards use instead of the map. Call after initialize() **/
+    bool initializeGrid(double spacing);
+
+    /** resampled field, nullptr if initializeGrid() was not called **/
+    const MagField::FaserFieldGrid* fieldGrid() const { return m_fieldGrid.get(); }
+
+    /** find the field-free and uniform z ranges of the scaled map inside radius (mm), which
+        all caches handed out afterwards return without a map lookup. Call after initialize() **/
+    bool initializeRegions(double radius, double step, double fieldFreeTolerance, double uniformTolerance);
+
+    /** field region classification, nullptr if initializeRegions() was not called **/
+    const MagField::FaserFieldRegions* fieldRegions() const { return m_fieldRegions.get(); }
+
 private:
     /// Temporary flag for switching between 'old' and 'new' magField usage
     double                           m_dipoleFieldScale{1};
     const MagField::FaserFieldMap*   m_fieldMap{nullptr};
+    std::unique_ptr<MagField::FaserFieldGrid> m_fieldGrid;
+    std::unique_ptr<MagField::FaserFieldRegions> m_fieldRegions;
 };
 
 // inline function(s)
@@ -46,7 +66,7 @@ FaserFieldCacheCondObj::getInitializedCache (MagField::FaserFieldCache& cache) c
 {
 
     // setup with field scale and magnetic field service for first access to field */
-    cache = MagField::FaserFieldCache(m_dipoleFieldScale, m_fieldMap);
+    cache = MagField::FaserFieldCache(m_dipoleFieldScale, m_fieldMap, m_fieldGrid.get(), m_fieldRegions.get());
 }
 
 
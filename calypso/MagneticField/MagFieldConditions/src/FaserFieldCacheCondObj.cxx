@@ -18,3 +18,22 @@ FaserFieldCacheCondObj::initialize(double dipFieldScale,
     return (m_fieldMap) != nullptr; // return false if cast failed
 }
 
+bool
+FaserFieldCacheCondObj::initializeGrid(double spacing)
+{
+    if (m_fieldMap == nullptr) return false;
+    auto fieldGrid = std::make_unique<MagField::FaserFieldGrid>();
+    if (!fieldGrid->initialize(*m_fieldMap, m_dipoleFieldScale, spacing)) return false;
+    m_fieldGrid = std::move(fieldGrid);
+    return true;
+}
+
+bool
+FaserFieldCacheCondObj::initializeRegions(double radius, double step, double fieldFreeTolerance, double uniformTolerance)
+{
+    if (m_fieldMap == nullptr) return false;
+    auto fieldRegions = std::make_unique<MagField::FaserFieldRegions>();
+    if (!fieldRegions->classify(*m_fieldMap, m_dipoleFieldScale, radius, step, fieldFreeTolerance, uniformTolerance)) return false;
+    m_fieldRegions = std::move(fieldRegions);
+    return true;
+}
@@ -28,6 +28,12 @@ public:
                 double bscale )
         : m_scale(bscale), m_nomScale(bscale)
         { m_min[0] = xmin; m_max[0] = xmax; m_min[1] = ymin; m_max[1] = ymax; m_min[2] = zmin; m_max[2] = zmax; }
+    // copies look up their own field values, external ones are shared
+    BFieldMesh( const BFieldMesh& other ) { copy( other ); }
+    BFieldMesh& operator=( const BFieldMesh& other ) { if ( this != &other ) copy( other ); return *this; }
+    // moving the vector keeps its storage, so the lookups stay valid
+    BFieldMesh( BFieldMesh&& other ) = default;
+    BFieldMesh& operator=( BFieldMesh&& other ) = default;
     // set ranges
     void setRange( double xmin, double xmax, double ymin, double ymax, double zmin, double zmax )
         { m_min[0] = xmin; m_max[0] = xmax; m_min[1] = ymin; m_max[1] = ymax; m_min[2] = zmin; m_max[2] = zmax; }
@@ -41,6 +47,10 @@ public:
     // add elements to vectors
     void appendMesh( int i, double mesh ) { m_mesh[i].push_back(mesh); }
     void appendField( const BFieldVector<T> & field ) { m_field.push_back(field); }
+    // use field values owned elsewhere (e.g. a memory-mapped file) instead of appending them;
+    // the storage must outlive the mesh
+    void setExternalField( const BFieldVector<T> * field, unsigned nfield )
+        { m_field.clear(); m_fieldData = field; m_nfield = nfield; }
     // build LUT
     void buildLUT();
     // test if a point is inside this zone
@@ -60,21 +70,24 @@ public:
     double zmax() const { return m_max[2]; }
     unsigned nmesh( int i ) const { return m_mesh[i].size(); }
     double mesh( int i, int j ) const { return m_mesh[i][j]; }
-    unsigned nfield() const { return m_field.size(); }
-    const BFieldVector<T> & field( int i ) const { return m_field[i]; }
+    unsigned nfield() const { return m_fieldData ? m_nfield : m_field.size(); }
+    const BFieldVector<T> & field( int i ) const { return m_fieldData ? m_fieldData[i] : m_field[i]; }
     double bscale() const { return m_scale; }
     int memSize() const;
 protected:
     double m_min[3], m_max[3];
     std::vector<double> m_mesh[3];
 private:
+    void copy( const BFieldMesh& other );
     std::vector< BFieldVector<T> > m_field;
+    const BFieldVector<T> * m_fieldData{nullptr}; // field values used for lookups, set by buildLUT()
+    unsigned m_nfield{0};
     double m_scale;
-    double m_nomScale;  // nominal m_scale from the map
+    double m_nomScale{1.0};  // nominal m_scale from the map
     // look-up table and related variables
     std::vector<int> m_LUT[3];
-    double m_invUnit[3];     // inverse unit size in the LUT
-    int m_xoff, m_yoff;
+    double m_invUnit[3]{0, 0, 0};     // inverse unit size in the LUT
+    int m_xoff{0}, m_yoff{0};
 };
 
 //
@@ -137,14 +150,14 @@ void BFieldMesh<T>::getCache( double x, double y, double z, BFieldCache & cache,
     // cache.setField( 5, m_field[im0+m_zoff      +1] ); // z+1,r,phi+1 => x+1,y,z+1
     // cache.setField( 6, m_field[im0+m_zoff+m_roff  ] );// z+1,r+1,phi => x+1,y+1,z
     // cache.setField( 7, m_field[im0+m_zoff+m_roff+1] );// z+1,r+1,phi+1 => x+1,y+1,z+1
-    cache.setField( 0, m_field[im0                ], scaleFactor ); // z,r,phi  => x,y,z
-    cache.setField( 1, m_field[im0              +1], scaleFactor ); // z,r,phi+1 => x,y,z+1
-    cache.setField( 2, m_field[im0       +m_yoff  ], scaleFactor ); // z,r+1,phi => x,y+1,z
-    cache.setField( 3, m_field[im0       +m_yoff+1], scaleFactor ); // z,r+1,phi+1 => x,y+1,z+1
-    cache.setField( 4, m_field[im0+m_xoff         ], scaleFactor ); // z+1,r,phi => x+1,y,z
-    cache.setField( 5, m_field[im0+m_xoff       +1], scaleFactor ); // z+1,r,phi+1 => x+1,y,z+1
-    cache.setField( 6, m_field[im0+m_xoff+m_yoff  ], scaleFactor ); // z+1,r+1,phi => x+1,y+1,z
-    cache.setField( 7, m_field[im0+m_xoff+m_yoff+1], scaleFactor ); // z+1,r+1,phi+1 => x+1,y+1,z+1
+    cache.setField( 0, m_fieldData[im0                ], scaleFactor ); // z,r,phi  => x,y,z
+    cache.setField( 1, m_fieldData[im0              +1], scaleFactor ); // z,r,phi+1 => x,y,z+1
+    cache.setField( 2, m_fieldData[im0       +m_yoff  ], scaleFactor ); // z,r+1,phi => x,y+1,z
+    cache.setField( 3, m_fieldData[im0       +m_yoff+1], scaleFactor ); // z,r+1,phi+1 => x,y+1,z+1
+    cache.setField( 4, m_fieldData[im0+m_xoff         ], scaleFactor ); // z+1,r,phi => x+1,y,z
+    cache.setField( 5, m_fieldData[im0+m_xoff       +1], scaleFactor ); // z+1,r,phi+1 => x+1,y,z+1
+    cache.setField( 6, m_fieldData[im0+m_xoff+m_yoff  ], scaleFactor ); // z+1,r+1,phi => x+1,y+1,z
+    cache.setField( 7, m_fieldData[im0+m_xoff+m_yoff+1], scaleFactor ); // z+1,r+1,phi+1 => x+1,y+1,z+1
     // store the B scale
     cache.setBscale( m_scale );
 }
@@ -184,14 +197,14 @@ void BFieldMesh<T>::getB( const double *xyz, double *B, double* deriv ) const
     // get the B field at the 8 corners
     int im0 = ix*m_xoff+iy*m_yoff+iz; // index of the first corner
     BFieldVector<T> field[8];
-    field[0] = m_field[im0                ];
-    field[1] = m_field[im0              +1];
-    field[2] = m_field[im0       +m_yoff  ];
-    field[3] = m_field[im0       +m_yoff+1];
-    field[4] = m_field[im0+m_xoff         ];
-    field[5] = m_field[im0+m_xoff       +1];
-    field[6] = m_field[im0+m_xoff+m_yoff  ];
-    field[7] = m_field[im0+m_xoff+m_yoff+1];
+    field[0] = m_fieldData[im0                ];
+    field[1] = m_fieldData[im0              +1];
+    field[2] = m_fieldData[im0       +m_yoff  ];
+    field[3] = m_fieldData[im0       +m_yoff+1];
+    field[4] = m_fieldData[im0+m_xoff         ];
+    field[5] = m_fieldData[im0+m_xoff       +1];
+    field[6] = m_fieldData[im0+m_xoff+m_yoff  ];
+    field[7] = m_fieldData[im0+m_xoff+m_yoff+1];
     // fractional position inside this mesh
     double fx = (x-mx[ix]) / (mx[ix+1]-mx[ix]);
     double gx = 1.0 - fx;
@@ -261,10 +274,37 @@ void BFieldMesh<T>::buildLUT()
             m_LUT[j].push_back(m);
         }
     }
+    // point the lookups at the appended values, unless external ones were given
+    if ( !m_field.empty() ) {
+        m_fieldData = m_field.data();
+        m_nfield = m_field.size();
+    }
     m_yoff = m_mesh[2].size();       // index offset for incrementing y by 1
     m_xoff = m_yoff*m_mesh[1].size(); // index offset for incrementing x by 1
 }
 
+//
+// Copy all members, pointing the lookups at the copied field values.
+//
+template <class T>
+void BFieldMesh<T>::copy( const BFieldMesh& other )
+{
+    for ( int j = 0; j < 3; j++ ) {
+        m_min[j] = other.m_min[j];
+        m_max[j] = other.m_max[j];
+        m_mesh[j] = other.m_mesh[j];
+        m_LUT[j] = other.m_LUT[j];
+        m_invUnit[j] = other.m_invUnit[j];
+    }
+    m_field = other.m_field;
+    m_fieldData = ( other.m_fieldData == other.m_field.data() ) ? m_field.data() : other.m_fieldData;
+    m_nfield = other.m_nfield;
+    m_scale = other.m_scale;
+    m_nomScale = other.m_nomScale;
+    m_xoff = other.m_xoff;
+    m_yoff = other.m_yoff;
+}
+
 template <class T>
 int BFieldMesh<T>::memSize() const
 {
@@ -13,6 +13,8 @@
 
 // MagField includes
 #include "MagFieldElements/FaserFieldMap.h"
+#include "MagFieldElements/FaserFieldGrid.h"
+#include "MagFieldElements/FaserFieldRegions.h"
 #include "MagFieldElements/BFieldCache.h"
 // #include "MagFieldElements/BFieldCacheZR.h"
 // #include "MagFieldElements/BFieldCond.h"
@@ -40,7 +42,9 @@ namespace MagField {
         FaserFieldCache() = default;
         // ** constructor to setup with field scale and magnetic field service for first access to field */
         FaserFieldCache(double fieldScale,
-                        const FaserFieldMap* fieldMap);
+                        const FaserFieldMap* fieldMap,
+                        const FaserFieldGrid* fieldGrid = nullptr,
+                        const FaserFieldRegions* fieldRegions = nullptr);
         FaserFieldCache& operator= (FaserFieldCache&& other) = default;
         FaserFieldCache(FaserFieldCache&& other) = default;
         ~FaserFieldCache() = default; 
@@ -74,6 +78,13 @@ namespace MagField {
         /// handle to the magnetic field service - not owner
         const FaserFieldMap* m_fieldMap;
 
+        /// Resampled field with the scale factor applied, used instead of the map if set.
+        /// Owned by FaserFieldCacheCondObj.
+        const FaserFieldGrid* m_fieldGrid{nullptr};
+
+        /// Field-free and uniform z ranges, where the field is constant. Owned by FaserFieldCacheCondObj.
+        const FaserFieldRegions* m_fieldRegions{nullptr};
+
         /// Pointer to the conductors in the current field zone (to compute Biot-Savart component)
         /// Owned by AtlasFieldMap. 
         // const std::vector<BFieldCond>* m_cond{nullptr};
@@ -151,6 +162,26 @@ MagField::FaserFieldCache::getField(const double* ATH_RESTRICT xyz,
     // double r = std::sqrt(x * x + y * y);
     // double phi = std::atan2(y, x);
 
+    if ( m_fieldRegions ) {
+        const FaserFieldRegions::Region* region = m_fieldRegions->find(x, y, z);
+        if ( region != nullptr && region->type != FaserFieldRegions::Type::Mapped ) {
+            bxyz[0] = region->field[0];
+            bxyz[1] = region->field[1];
+            bxyz[2] = region->field[2];
+            if ( deriv ) {
+                for ( int i = 0; i < 9; i++ ) {
+                    deriv[i] = 0.;
+                }
+            }
+            return;
+        }
+    }
+
+    if ( m_fieldGrid ) {
+        m_fieldGrid->getField(xyz, bxyz, deriv);
+        return;
+    }
+
     // test if initialised and the cache is valid
     if ( !m_cache3d.inside(x, y, z) ) {
         // cache is invalid -> refresh cache
@@ -0,0 +1,158 @@
+/*
+  Copyright (C) 2022 CERN for the benefit of the FASER collaboration
+*/
+
+/**
+ * @brief Magnetic field map resampled on a uniform grid
+ */
+
+#ifndef MAGFIELDELEMENTS_FASERFIELDGRID_H
+#define MAGFIELDELEMENTS_FASERFIELDGRID_H 1
+
+#include "CxxUtils/restrict.h"
+// CLHEP
+#include "CLHEP/Units/SystemOfUnits.h"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <vector>
+
+namespace MagField {
+
+    class FaserFieldMap;
+
+/** @class FaserFieldGrid
+ *
+ *  @brief Field map resampled on a uniform grid of float (Bx, By, Bz) nodes
+ *
+ *  The grid is filled once from the zones of a FaserFieldMap, with the field
+ *  scale factor already applied. A lookup needs no zone search and no cell
+ *  cache: the cell follows from the position, and the 8 corners are
+ *  interpolated with 4 float lanes per node, which the compiler vectorizes.
+ *  Between the original mesh points the result differs from the map by the
+ *  resampling error, which is controlled by the grid spacing.
+ */
+    class FaserFieldGrid
+    {
+    public:
+        FaserFieldGrid() = default;
+
+        /** field at (x, y, z) in mm, returned in B in kT */
+        typedef std::function<void(double x, double y, double z, double* B)> FieldFunction;
+
+        /** resample fieldMap with the given spacing (mm) and scale factor */
+        bool initialize(const FaserFieldMap& fieldMap, double scale, double spacing);
+
+        /** sample fieldAt inside the box from mapMin[3] to mapMax[3] with the given spacing (mm) */
+        bool initialize(const FieldFunction& fieldAt, const double* mapMin, const double* mapMax, double spacing);
+
+        /** get B field value at given position */
+        /** xyz[3] is in mm, bxyz[3] is in kT */
+        /** if deriv[9] is given, field derivatives are returned in kT/mm */
+        inline void getField(const double* ATH_RESTRICT xyz,
+                             double* ATH_RESTRICT bxyz,
+                             double* ATH_RESTRICT deriv = nullptr) const;
+
+        /** get B field values at several positions, xyz and bxyz hold 3 values per position */
+        void getField(std::span<const double> xyz, std::span<double> bxyz) const;
+
+        bool inside(double x, double y, double z) const
+        { return ( x >= m_min[0] && x <= m_max[0] && y >= m_min[1] && y <= m_max[1] && z >= m_min[2] && z <= m_max[2] ); }
+
+        /** number of grid nodes along axis i */
+        int nodes(int i) const { return m_n[i]; }
+
+        /** approximate memory footprint in bytes */
+        size_t memSize() const { return sizeof(Node) * m_field.capacity(); }
+
+    private:
+        // Bx, By, Bz and one padding lane
+        struct alignas(16) Node {
+            float b[4];
+        };
+
+        double            m_min[3] {0, 0, 0};
+        double            m_max[3] {-1, -1, -1}; // nothing is inside before initialize()
+        double            m_invStep[3] {0, 0, 0};
+        int               m_n[3] {0, 0, 0};
+        int               m_off[3] {0, 0, 0};    // index offset for incrementing x, y, z by 1
+        std::vector<Node> m_field;
+    };
+
+}  // namespace MagField
+
+
+void
+MagField::FaserFieldGrid::getField(const double* ATH_RESTRICT xyz,
+                                   double* ATH_RESTRICT bxyz,
+                                   double* ATH_RESTRICT deriv) const
+{
+    if ( !inside(xyz[0], xyz[1], xyz[2]) ) {
+        // outside the grid -> same default field (0.1 gauss) as FaserFieldCache
+        const double defaultB(0.1*CLHEP::gauss);
+        bxyz[0] = bxyz[1] = bxyz[2] = defaultB;
+        if ( deriv ) {
+            for ( int i = 0; i < 9; i++ ) {
+                deriv[i] = 0.;
+            }
+        }
+        return;
+    }
+
+    // cell and fractional position inside the cell; the upper edge belongs to the last cell
+    int   cell[3];
+    float f[3];
+    for ( int j = 0; j < 3; j++ ) {
+        double u = (xyz[j] - m_min[j]) * m_invStep[j];
+        cell[j] = std::min( static_cast<int>(u), m_n[j] - 2 );
+        f[j] = u - cell[j];
+    }
+    const float fx = f[0], gx = 1.0f - fx;
+    const float fy = f[1], gy = 1.0f - fy;
+    const float fz = f[2], gz = 1.0f - fz;
+
+    const Node* c = &m_field[cell[0]*m_off[0] + cell[1]*m_off[1] + cell[2]];
+    const Node* corner[8] = { c,                        c                     + 1,
+                              c            + m_off[1],  c            + m_off[1] + 1,
+                              c + m_off[0],             c + m_off[0]            + 1,
+                              c + m_off[0] + m_off[1],  c + m_off[0] + m_off[1] + 1 };
+    const float w[8] = { gx*gy*gz, gx*gy*fz, gx*fy*gz, gx*fy*fz,
+                         fx*gy*gz, fx*gy*fz, fx*fy*gz, fx*fy*fz };
+
+    float b[4] = { 0, 0, 0, 0 };
+    for ( int k = 0; k < 8; k++ ) {
+        for ( int l = 0; l < 4; l++ ) b[l] += w[k] * corner[k]->b[l];
+    }
+    bxyz[0] = b[0];
+    bxyz[1] = b[1];
+    bxyz[2] = b[2];
+
+    if ( deriv ) {
+        // derivatives of the corner weights with respect to x, y and z
+        const float sx = m_invStep[0], sy = m_invStep[1], sz = m_invStep[2];
+        const float wx[8] = { -sx*gy*gz, -sx*gy*fz, -sx*fy*gz, -sx*fy*fz,
+                               sx*gy*gz,  sx*gy*fz,  sx*fy*gz,  sx*fy*fz };
+        const float wy[8] = { -sy*gx*gz, -sy*gx*fz,  sy*gx*gz,  sy*gx*fz,
+                              -sy*fx*gz, -sy*fx*fz,  sy*fx*gz,  sy*fx*fz };
+        const float wz[8] = { -sz*gx*gy,  sz*gx*gy, -sz*gx*fy,  sz*gx*fy,
+                              -sz*fx*gy,  sz*fx*gy, -sz*fx*fy,  sz*fx*fy };
+        float dBdx[4] = { 0, 0, 0, 0 };
+        float dBdy[4] = { 0, 0, 0, 0 };
+        float dBdz[4] = { 0, 0, 0, 0 };
+        for ( int k = 0; k < 8; k++ ) {
+            for ( int l = 0; l < 4; l++ ) {
+                dBdx[l] += wx[k] * corner[k]->b[l];
+                dBdy[l] += wy[k] * corner[k]->b[l];
+                dBdz[l] += wz[k] * corner[k]->b[l];
+            }
+        }
+        for ( int j = 0; j < 3; j++ ) {
+            deriv[3*j]   = dBdx[j];
+            deriv[3*j+1] = dBdy[j];
+            deriv[3*j+2] = dBdz[j];
+        }
+    }
+}
+
+#endif  // MAGFIELDELEMENTS_FASERFIELDGRID_H
@@ -23,6 +23,7 @@
 #include "CLHEP/Units/SystemOfUnits.h"
 #include<iostream>
 #include <memory>
+#include <string>
 
 // forward declarations
 class TFile;
@@ -45,6 +46,17 @@ namespace MagField {
         // initialize map from root file
         bool initializeMap( TFile* rootfile );
 
+        // initialize map by memory-mapping a binary cache written by writeCache().
+        // Fails if the cache is missing, of another format version, or was written
+        // from a different version (size, modification time) of sourceFile
+        bool initializeMapFromCache( const std::string& cacheFile, const std::string& sourceFile );
+
+        // write the map to a binary cache for sourceFile, to be shared by later jobs
+        bool writeCache( const std::string& cacheFile, const std::string& sourceFile ) const;
+
+        // true if the field values are read from a memory-mapped cache
+        bool isMapped() const { return m_mappedData != nullptr; }
+
         // Functions used by getField[ZR] in FaserFieldCache
         // search for a "zone" to which the point (z,r,phi) belongs
         const BFieldZone* findBFieldZone( double z, double r, double phi ) const;
@@ -59,6 +71,13 @@ namespace MagField {
         // float solenoidCurrent() const { return m_solenoidCurrent; }
         // float toroidCurrent() const   { return m_toroidCurrent;   }
         int   dipoleZoneId() const  { return m_dipoleZoneId;  }
+        // bounding box of all zones
+        double xmin() const { return m_xmin; }
+        double xmax() const { return m_xmax; }
+        double ymin() const { return m_ymin; }
+        double ymax() const { return m_ymax; }
+        double zmin() const { return m_zmin; }
+        double zmax() const { return m_zmax; }
     private:
     
         FaserFieldMap& operator= (FaserFieldMap&& other)      = delete;
@@ -83,6 +102,10 @@ namespace MagField {
         // field map name
         std::string m_filename; 
 
+        // read-only mapping of the binary cache, holding the field values of all zones
+        void*                          m_mappedData{nullptr};
+        size_t                         m_mappedSize{0};
+
         // currents read in with map
         // float m_solenoidCurrent{0}; // solenoid current in ampere
         // float m_toroidCurrent{0};   // toroid current in ampere
@@ -0,0 +1,85 @@
+/*
+  Copyright (C) 2022 CERN for the benefit of the FASER collaboration
+*/
+
+/**
+ * @brief Classification of the field map into field-free, uniform and mapped z ranges
+ */
+
+#ifndef MAGFIELDELEMENTS_FASERFIELDREGIONS_H
+#define MAGFIELDELEMENTS_FASERFIELDREGIONS_H 1
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+namespace MagField {
+
+    class FaserFieldMap;
+
+/** @class FaserFieldRegions
+ *
+ *  @brief z ranges of the FASER magnets and the gaps between them
+ *
+ *  Inside a transverse aperture (a cylinder around the beam axis) the map is
+ *  sampled in z slices. Slices where the field stays below a tolerance are
+ *  field-free; slices where it stays within a tolerance of one vector are
+ *  uniform; everything else is mapped. Neighbouring slices of the same kind
+ *  are merged. Inside a field-free or uniform region the field is the
+ *  constant of the region and the gradient is zero.
+ */
+    class FaserFieldRegions
+    {
+    public:
+        enum class Type { FieldFree, Uniform, Mapped };
+
+        struct Region {
+            double zmin;
+            double zmax;
+            Type   type;
+            double field[3];  // in kT, for field-free and uniform regions
+        };
+
+        FaserFieldRegions() = default;
+
+        /** field at (x, y, z) in mm, returned in B in kT */
+        typedef std::function<void(double x, double y, double z, double* B)> FieldFunction;
+
+        /** classify fieldMap (with the scale factor applied) inside radius (mm), in slices of step (mm).
+            Tolerances are on the field magnitude (field-free) and on the deviation from the mean (uniform), in kT */
+        bool classify(const FaserFieldMap& fieldMap, double scale, double radius, double step,
+                      double fieldFreeTolerance, double uniformTolerance);
+
+        /** classify the field given by fieldAt between zmin and zmax, as above */
+        bool classify(const FieldFunction& fieldAt, double zmin, double zmax, double radius, double step,
+                      double fieldFreeTolerance, double uniformTolerance);
+
+        /** region containing (x, y, z), nullptr outside the aperture or the map */
+        inline const Region* find(double x, double y, double z) const;
+
+        /** true if the z range between z0 and z1 lies inside a single field-free region */
+        bool fieldFree(double z0, double z1) const;
+
+        double radius() const { return m_radius; }
+        const std::vector<Region>& regions() const { return m_regions; }
+
+    private:
+        double              m_radius{0};
+        std::vector<Region> m_regions;  // ordered and contiguous in z
+    };
+
+}  // namespace MagField
+
+
+const MagField::FaserFieldRegions::Region*
+MagField::FaserFieldRegions::find(double x, double y, double z) const
+{
+    if ( x*x + y*y > m_radius*m_radius ) return nullptr;
+    if ( m_regions.empty() || !(z >= m_regions.front().zmin && z <= m_regions.back().zmax) ) return nullptr;
+    // first region starting above z, the one before contains z
+    auto it = std::upper_bound( m_regions.begin(), m_regions.end(), z,
+                                [](double value, const Region& region) { return value < region.zmin; } );
+    return &*(it - 1);
+}
+
+#endif  // MAGFIELDELEMENTS_FASERFIELDREGIONS_H
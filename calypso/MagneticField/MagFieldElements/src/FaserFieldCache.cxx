@@ -13,12 +13,18 @@
 
 /// Constructor
 MagField::FaserFieldCache::FaserFieldCache(double scale,
-                                           const FaserFieldMap* fieldMap)
+                                           const FaserFieldMap* fieldMap,
+                                           const FaserFieldGrid* fieldGrid,
+                                           const FaserFieldRegions* fieldRegions)
     :
     // temporary flag
     m_scale(scale),
     // set field service
-    m_fieldMap(fieldMap)
+    m_fieldMap(fieldMap),
+    // optional resampled field
+    m_fieldGrid(fieldGrid),
+    // optional constant field regions
+    m_fieldRegions(fieldRegions)
 
 {
 
@@ -0,0 +1,84 @@
+/*
+  Copyright (C) 2022 CERN for the benefit of the FASER collaboration
+*/
+
+//
+// FaserFieldGrid.cxx
+//
+// Magnetic field map resampled on a uniform grid
+//
+#include "MagFieldElements/FaserFieldGrid.h"
+#include "MagFieldElements/FaserFieldMap.h"
+
+#include <algorithm>
+#include <cmath>
+
+bool
+MagField::FaserFieldGrid::initialize(const FaserFieldMap& fieldMap, double scale, double spacing)
+{
+    const double mapMin[3] { fieldMap.xmin(), fieldMap.ymin(), fieldMap.zmin() };
+    const double mapMax[3] { fieldMap.xmax(), fieldMap.ymax(), fieldMap.zmax() };
+    const double defaultB(0.1*CLHEP::gauss);
+    FieldFunction fieldAt = [&](double x, double y, double z, double* B) {
+        const BFieldZone* zone = fieldMap.findBFieldZone( x, y, z );
+        if ( zone == nullptr ) {
+            // gap between zones
+            B[0] = B[1] = B[2] = defaultB;
+            return;
+        }
+        double xyz[3] { x, y, z };
+        zone->getB( xyz, B );
+        for ( int j = 0; j < 3; j++ ) B[j] *= scale;
+    };
+
+    return initialize( fieldAt, mapMin, mapMax, spacing );
+}
+
+bool
+MagField::FaserFieldGrid::initialize(const FieldFunction& fieldAt, const double* mapMin, const double* mapMax, double spacing)
+{
+    if ( !(spacing > 0.) ) return false;
+
+    double step[3];
+    for ( int j = 0; j < 3; j++ ) {
+        double width = mapMax[j] - mapMin[j];
+        if ( !(width > 0.) ) return false;
+        // at least one cell, and the nodes span the map exactly
+        m_n[j] = std::max( 2, static_cast<int>(std::ceil(width/spacing)) + 1 );
+        step[j] = width/(m_n[j] - 1);
+        m_invStep[j] = 1.0/step[j];
+        m_min[j] = mapMin[j];
+        m_max[j] = mapMax[j];
+    }
+    m_off[2] = 1;
+    m_off[1] = m_n[2];
+    m_off[0] = m_n[1]*m_n[2];
+
+    m_field.assign( static_cast<size_t>(m_n[0])*m_n[1]*m_n[2], Node{ {0, 0, 0, 0} } );
+    for ( int ix = 0; ix < m_n[0]; ix++ ) {
+        for ( int iy = 0; iy < m_n[1]; iy++ ) {
+            for ( int iz = 0; iz < m_n[2]; iz++ ) {
+                const int index[3] { ix, iy, iz };
+                double xyz[3];
+                for ( int j = 0; j < 3; j++ ) {
+                    // avoid stepping out of the map by rounding on the last node
+                    xyz[j] = (index[j] == m_n[j] - 1) ? m_max[j] : m_min[j] + index[j]*step[j];
+                }
+                Node& node = m_field[ix*m_off[0] + iy*m_off[1] + iz];
+                double B[3];
+                fieldAt( xyz[0], xyz[1], xyz[2], B );
+                for ( int j = 0; j < 3; j++ ) node.b[j] = B[j];
+            }
+        }
+    }
+    return true;
+}
+
+void
+MagField::FaserFieldGrid::getField(std::span<const double> xyz, std::span<double> bxyz) const
+{
+    const size_t n = std::min( xyz.size(), bxyz.size() )/3;
+    for ( size_t i = 0; i < n; i++ ) {
+        getField( xyz.data() + 3*i, bxyz.data() + 3*i );
+    }
+}
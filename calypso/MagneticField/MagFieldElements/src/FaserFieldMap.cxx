@@ -19,13 +19,78 @@
 #include "TFile.h"
 #include "TTree.h"
 
+// mmap
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+namespace {
+    //
+    // Layout of the binary cache, in native byte order:
+    //   CacheHeader
+    //   CacheZone for each zone
+    //   mesh values (double) of all zones, x, y then z for each zone in turn
+    //   field values (BFieldVector<short>) of all zones, starting at fieldOffset
+    // The zone and edge LUTs hold pointers and are rebuilt when the cache is read.
+    //
+    constexpr char     cacheMagic[8] { 'F', 'A', 'S', 'E', 'R', 'B', 'M', 'P' };
+    constexpr uint32_t cacheVersion { 1 };
+    constexpr uint32_t cacheByteOrder { 0x01020304 };
+
+    struct CacheHeader {
+        char     magic[8];
+        uint32_t version;
+        uint32_t byteOrder;
+        uint64_t sourceSize;    // size of the ROOT map the cache was written from
+        int64_t  sourceMTime;   // and its modification time
+        uint32_t nZones;
+        int32_t  dipoleZoneId;
+        uint64_t fieldOffset;
+        uint64_t totalSize;
+    };
+
+    struct CacheZone {
+        int32_t  id;
+        uint32_t nmesh[3];
+        uint32_t nfield;
+        uint32_t padding;
+        double   min[3];
+        double   max[3];
+        double   bscale;
+    };
+
+    static_assert( sizeof(BFieldVector<short>) == 3*sizeof(short), "field values must be stored without padding" );
+    static_assert( sizeof(CacheHeader) % alignof(double) == 0 && sizeof(CacheZone) % alignof(double) == 0,
+                   "mesh values must be aligned in the cache" );
+
+    bool sourceStamp( const std::string& file, uint64_t& size, int64_t& mtime )
+    {
+        struct stat st;
+        if ( ::stat( file.c_str(), &st ) != 0 ) return false;
+        size = st.st_size;
+        mtime = st.st_mtime;
+        return true;
+    }
+}
+
 /** Constructor **/
 MagField::FaserFieldMap::FaserFieldMap() 
 {}
 
 
 MagField::FaserFieldMap::~FaserFieldMap()
-{}
+{
+    // the zones only point into the mapping, they are destroyed with the map
+    if ( m_mappedData != nullptr ) {
+        ::munmap( m_mappedData, m_mappedSize );
+    }
+}
 
 // Search for the zone that contains a point (z, r, phi)
 // Fast version utilizing the LUT.
@@ -174,6 +239,156 @@ MagField::FaserFieldMap::initializeMap( TFile* rootfile )
     return true;
 }
 
+//
+// memory-map the binary cache written by writeCache().
+// returns true if successful; on failure the map is left empty.
+//
+bool
+MagField::FaserFieldMap::initializeMapFromCache( const std::string& cacheFile, const std::string& sourceFile )
+{
+    if ( !m_zone.empty() ) return false;
+
+    uint64_t sourceSize { 0 };
+    int64_t sourceMTime { 0 };
+    if ( !sourceStamp( sourceFile, sourceSize, sourceMTime ) ) return false;
+
+    int fd = ::open( cacheFile.c_str(), O_RDONLY );
+    if ( fd < 0 ) return false;
+    struct stat st;
+    if ( ::fstat( fd, &st ) != 0 || static_cast<size_t>(st.st_size) < sizeof(CacheHeader) ) {
+        ::close( fd );
+        return false;
+    }
+    const size_t size = st.st_size;
+    // shared and read-only: all jobs on the node use the same pages
+    void* addr = ::mmap( nullptr, size, PROT_READ, MAP_SHARED, fd, 0 );
+    ::close( fd );
+    if ( addr == MAP_FAILED ) return false;
+    const char* base = static_cast<const char*>( addr );
+
+    // validate the header and all sizes before using any of the data
+    CacheHeader header;
+    std::memcpy( &header, base, sizeof(header) );
+    bool valid = std::memcmp( header.magic, cacheMagic, sizeof(cacheMagic) ) == 0 &&
+                 header.version == cacheVersion && header.byteOrder == cacheByteOrder &&
+                 header.sourceSize == sourceSize && header.sourceMTime == sourceMTime &&
+                 header.totalSize == size && header.fieldOffset <= size;
+    const size_t meshOffset = sizeof(CacheHeader) + sizeof(CacheZone)*static_cast<size_t>(header.nZones);
+    valid = valid && header.nZones > 0 && meshOffset <= header.fieldOffset;
+    const CacheZone* zones = reinterpret_cast<const CacheZone*>( base + sizeof(CacheHeader) );
+    uint64_t nmeshTotal { 0 };
+    uint64_t nfieldTotal { 0 };
+    for ( uint32_t i = 0; valid && i < header.nZones; i++ ) {
+        const CacheZone& zone = zones[i];
+        uint64_t nnodes { 1 };
+        for ( int j = 0; j < 3; j++ ) {
+            valid = valid && zone.nmesh[j] >= 2;
+            nmeshTotal += zone.nmesh[j];
+            nnodes *= zone.nmesh[j];
+        }
+        valid = valid && zone.nfield == nnodes;
+        nfieldTotal += zone.nfield;
+    }
+    valid = valid && meshOffset + sizeof(double)*nmeshTotal == header.fieldOffset &&
+            header.fieldOffset + sizeof(BFieldVector<short>)*nfieldTotal == size;
+    if ( !valid ) {
+        ::munmap( addr, size );
+        return false;
+    }
+
+    // zones take copies of their (small) meshes and point at the field values in the mapping
+    const double* mesh = reinterpret_cast<const double*>( base + meshOffset );
+    const BFieldVector<short>* field = reinterpret_cast<const BFieldVector<short>*>( base + header.fieldOffset );
+    m_zone.reserve( header.nZones );
+    for ( uint32_t i = 0; i < header.nZones; i++ ) {
+        const CacheZone& zone = zones[i];
+        m_zone.emplace_back( zone.id, zone.min[0], zone.max[0], zone.min[1], zone.max[1],
+                             zone.min[2], zone.max[2], zone.bscale );
+        m_zone.back().reserve( zone.nmesh[0], zone.nmesh[1], zone.nmesh[2], 0 );
+        for ( int j = 0; j < 3; j++ ) {
+            for ( unsigned k = 0; k < zone.nmesh[j]; k++ ) {
+                m_zone.back().appendMesh( j, *mesh++ );
+            }
+        }
+        m_zone.back().setExternalField( field, zone.nfield );
+        field += zone.nfield;
+    }
+    m_mappedData = addr;
+    m_mappedSize = size;
+    m_dipoleZoneId = header.dipoleZoneId;
+    m_filename = sourceFile;
+
+    // build the LUTs
+    buildLUT();
+
+    return true;
+}
+
+//
+// write the map to a binary cache for sourceFile.
+// returns true if successful.
+//
+bool
+MagField::FaserFieldMap::writeCache( const std::string& cacheFile, const std::string& sourceFile ) const
+{
+    if ( m_zone.empty() ) return false;
+
+    CacheHeader header;
+    std::memset( &header, 0, sizeof(header) );
+    std::memcpy( header.magic, cacheMagic, sizeof(cacheMagic) );
+    header.version = cacheVersion;
+    header.byteOrder = cacheByteOrder;
+    if ( !sourceStamp( sourceFile, header.sourceSize, header.sourceMTime ) ) return false;
+    header.nZones = m_zone.size();
+    header.dipoleZoneId = m_dipoleZoneId;
+
+    std::vector<CacheZone> zones( m_zone.size() );
+    uint64_t nmeshTotal { 0 };
+    uint64_t nfieldTotal { 0 };
+    for ( unsigned i = 0; i < m_zone.size(); i++ ) {
+        const BFieldZone& zone = m_zone[i];
+        CacheZone& cacheZone = zones[i];
+        std::memset( &cacheZone, 0, sizeof(cacheZone) );
+        cacheZone.id = zone.id();
+        for ( int j = 0; j < 3; j++ ) {
+            cacheZone.nmesh[j] = zone.nmesh(j);
+            cacheZone.min[j] = zone.min(j);
+            cacheZone.max[j] = zone.max(j);
+            nmeshTotal += zone.nmesh(j);
+        }
+        cacheZone.nfield = zone.nfield();
+        cacheZone.bscale = zone.bscale();
+        nfieldTotal += zone.nfield();
+    }
+    header.fieldOffset = sizeof(CacheHeader) + sizeof(CacheZone)*zones.size() + sizeof(double)*nmeshTotal;
+    header.totalSize = header.fieldOffset + sizeof(BFieldVector<short>)*nfieldTotal;
+
+    // write to a temporary file and rename it, so that other jobs never see a partial cache
+    const std::string tmpFile = cacheFile + ".tmp." + std::to_string( ::getpid() );
+    std::ofstream out( tmpFile, std::ios::binary | std::ios::trunc );
+    if ( !out ) return false;
+    out.write( reinterpret_cast<const char*>( &header ), sizeof(header) );
+    out.write( reinterpret_cast<const char*>( zones.data() ), sizeof(CacheZone)*zones.size() );
+    for ( const BFieldZone& zone : m_zone ) {
+        for ( int j = 0; j < 3; j++ ) {
+            for ( unsigned k = 0; k < zone.nmesh(j); k++ ) {
+                double mesh = zone.mesh( j, k );
+                out.write( reinterpret_cast<const char*>( &mesh ), sizeof(mesh) );
+            }
+        }
+    }
+    for ( const BFieldZone& zone : m_zone ) {
+        if ( zone.nfield() == 0 ) continue;
+        out.write( reinterpret_cast<const char*>( &zone.field(0) ), sizeof(BFieldVector<short>)*zone.nfield() );
+    }
+    out.close();
+    if ( !out || std::rename( tmpFile.c_str(), cacheFile.c_str() ) != 0 ) {
+        std::remove( tmpFile.c_str() );
+        return false;
+    }
+    return true;
+}
+
 //
 // Search for the zone that contains a point (x, y, z)
 // This is a linear-search version, used only to construct the LUT.
@@ -0,0 +1,112 @@
+/*
+  Copyright (C) 2022 CERN for the benefit of the FASER collaboration
+*/
+
+//
+// FaserFieldRegions.cxx
+//
+// Classification of the field map into field-free, uniform and mapped z ranges
+//
+#include "MagFieldElements/FaserFieldRegions.h"
+#include "MagFieldElements/FaserFieldMap.h"
+
+// CLHEP
+#include "CLHEP/Units/SystemOfUnits.h"
+
+#include <array>
+#include <cmath>
+
+bool
+MagField::FaserFieldRegions::classify(const FaserFieldMap& fieldMap, double scale, double radius, double step,
+                                      double fieldFreeTolerance, double uniformTolerance)
+{
+    FieldFunction fieldAt = [&](double x, double y, double z, double* B) {
+        double xyz[3] { x, y, z };
+        const BFieldZone* zone = fieldMap.findBFieldZone( x, y, z );
+        if ( zone == nullptr ) {
+            // outside all zones, as FaserFieldCache
+            B[0] = B[1] = B[2] = 0.1*CLHEP::gauss;
+            return;
+        }
+        zone->getB( xyz, B );
+        for ( int j = 0; j < 3; j++ ) B[j] *= scale;
+    };
+
+    return classify( fieldAt, fieldMap.zmin(), fieldMap.zmax(), radius, step, fieldFreeTolerance, uniformTolerance );
+}
+
+bool
+MagField::FaserFieldRegions::classify(const FieldFunction& fieldAt, double zmin, double zmax, double radius, double step,
+                                      double fieldFreeTolerance, double uniformTolerance)
+{
+    m_regions.clear();
+    m_radius = radius;
+    if ( !(step > 0.) || !(radius >= 0.) || !(zmax > zmin) ) return false;
+
+    // transverse sample points: the axis and two rings of 8 points
+    std::vector<std::pair<double, double> > points { {0., 0.} };
+    for ( double r : { 0.5*radius, radius } ) {
+        if ( !(r > 0.) ) continue;
+        for ( int i = 0; i < 8; i++ ) {
+            double phi = i*M_PI/4;
+            points.emplace_back( r*std::cos(phi), r*std::sin(phi) );
+        }
+    }
+
+    const int nSlices = std::max( 1, static_cast<int>(std::ceil((zmax - zmin)/step)) );
+    const double sliceStep = (zmax - zmin)/nSlices;
+    for ( int i = 0; i < nSlices; i++ ) {
+        Region slice { zmin + i*sliceStep, (i == nSlices - 1) ? zmax : zmin + (i + 1)*sliceStep, Type::Mapped, {0, 0, 0} };
+
+        // sample both edges and the middle of the slice
+        std::vector<std::array<double, 3> > samples;
+        for ( double z : { slice.zmin, 0.5*(slice.zmin + slice.zmax), slice.zmax } ) {
+            for ( const auto& point : points ) {
+                std::array<double, 3> B;
+                fieldAt( point.first, point.second, z, B.data() );
+                samples.push_back( B );
+            }
+        }
+        double mean[3] { 0, 0, 0 };
+        double maxField { 0 };
+        for ( const auto& B : samples ) {
+            for ( int j = 0; j < 3; j++ ) mean[j] += B[j]/samples.size();
+            maxField = std::max( maxField, std::sqrt(B[0]*B[0] + B[1]*B[1] + B[2]*B[2]) );
+        }
+        double maxDeviation { 0 };
+        for ( const auto& B : samples ) {
+            double d[3] { B[0] - mean[0], B[1] - mean[1], B[2] - mean[2] };
+            maxDeviation = std::max( maxDeviation, std::sqrt(d[0]*d[0] + d[1]*d[1] + d[2]*d[2]) );
+        }
+        if ( maxField < fieldFreeTolerance ) {
+            slice.type = Type::FieldFree;
+        }
+        else if ( maxDeviation < uniformTolerance ) {
+            slice.type = Type::Uniform;
+            for ( int j = 0; j < 3; j++ ) slice.field[j] = mean[j];
+        }
+
+        // extend the previous region if this slice is of the same kind (and field, if uniform)
+        if ( !m_regions.empty() ) {
+            Region& last = m_regions.back();
+            bool same = last.type == slice.type;
+            if ( same && slice.type == Type::Uniform ) {
+                double d[3] { slice.field[0] - last.field[0], slice.field[1] - last.field[1], slice.field[2] - last.field[2] };
+                same = std::sqrt(d[0]*d[0] + d[1]*d[1] + d[2]*d[2]) < uniformTolerance;
+            }
+            if ( same ) {
+                last.zmax = slice.zmax;
+                continue;
+            }
+        }
+        m_regions.push_back( slice );
+    }
+    return true;
+}
+
+bool
+MagField::FaserFieldRegions::fieldFree(double z0, double z1) const
+{
+    const Region* region = find( 0., 0., std::min(z0, z1) );
+    return region != nullptr && region->type == Type::FieldFree && std::max(z0, z1) <= region->zmax;
+}
@@ -0,0 +1,138 @@
+/*
+  Copyright (C) 2022 CERN for the benefit of the FASER collaboration
+*/
+
+/** @file FaserFieldGrid_test.cxx
+    Unit test of the field map resampled on a uniform grid
+*/
+
+#undef NDEBUG
+#include "MagFieldElements/FaserFieldGrid.h"
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+  typedef MagField::FaserFieldGrid Grid;
+
+  // field in kT and its gradient dB_j/dx_k in kT/mm
+  const double B0[3] = { 0.1e-3, 0.55e-3, -0.2e-3 };
+  const double G[3][3] = { {  1e-6, -2e-6,  3e-7 },
+                           {  4e-7,  2e-6, -1e-6 },
+                           { -3e-6,  5e-7,  1e-6 } };
+
+  // trilinear interpolation reproduces a linear field exactly
+  void linearField(double x, double y, double z, double* B) {
+    const double xyz[3] = { x, y, z };
+    for (int j = 0; j < 3; j++) {
+      B[j] = B0[j];
+      for (int k = 0; k < 3; k++) B[j] += G[j][k]*xyz[k];
+    }
+  }
+
+  const double gridMin[3] = { -100., -100., 0. };
+  const double gridMax[3] = { 100., 100., 1000. };
+
+  // the nodes are stored as float
+  bool nearField(double a, double b) { return std::abs(a - b) < 1e-9; }
+  bool nearGradient(double a, double b) { return std::abs(a - b) < 1e-10; }
+
+  // points inside the grid, including its edges and corners
+  std::vector<double> points() {
+    std::vector<double> xyz;
+    for (double x : {-100., -73.3, 0., 12.5, 100.}) {
+      for (double y : {-100., -0.1, 49.9, 100.}) {
+        for (double z : {0., 17., 500., 999.9, 1000.}) {
+          xyz.insert(xyz.end(), {x, y, z});
+        }
+      }
+    }
+    return xyz;
+  }
+
+  void testInitialize() {
+    std::cout << "testInitialize\n";
+    Grid grid;
+    assert(!grid.inside(0., 0., 0.));
+    assert(!grid.initialize(linearField, gridMin, gridMax, 0.));
+    const double flat[3] = { 100., -100., 1000. };
+    assert(!grid.initialize(linearField, gridMin, flat, 50.));
+
+    assert(grid.initialize(linearField, gridMin, gridMax, 50.));
+    assert(grid.nodes(0) == 5 && grid.nodes(1) == 5 && grid.nodes(2) == 21);
+    // the spacing is reduced so that the nodes span the box
+    assert(grid.initialize(linearField, gridMin, gridMax, 30.));
+    assert(grid.nodes(0) == 8 && grid.nodes(2) == 35);
+    assert(grid.inside(100., -100., 1000.));
+    assert(!grid.inside(100.1, 0., 500.));
+  }
+
+  void testField() {
+    std::cout << "testField\n";
+    Grid grid;
+    assert(grid.initialize(linearField, gridMin, gridMax, 30.));
+    const std::vector<double> xyz = points();
+    for (size_t i = 0; i < xyz.size(); i += 3) {
+      double expected[3];
+      linearField(xyz[i], xyz[i+1], xyz[i+2], expected);
+      double B[3];
+      double deriv[9];
+      grid.getField(&xyz[i], B, deriv);
+      for (int j = 0; j < 3; j++) {
+        assert(nearField(B[j], expected[j]));
+        // deriv[3*j+k] is dB_j/dx_k
+        for (int k = 0; k < 3; k++) assert(nearGradient(deriv[3*j+k], G[j][k]));
+      }
+      // the field alone is the same
+      double B2[3];
+      grid.getField(&xyz[i], B2);
+      for (int j = 0; j < 3; j++) assert(B2[j] == B[j]);
+    }
+  }
+
+  void testOutside() {
+    std::cout << "testOutside\n";
+    Grid grid;
+    assert(grid.initialize(linearField, gridMin, gridMax, 50.));
+    const double xyz[3] = { 0., 0., 1000.1 };
+    double B[3];
+    double deriv[9];
+    grid.getField(xyz, B, deriv);
+    for (int j = 0; j < 3; j++) assert(B[j] == 0.1*CLHEP::gauss);
+    for (int j = 0; j < 9; j++) assert(deriv[j] == 0.);
+  }
+
+  void testBatch() {
+    std::cout << "testBatch\n";
+    Grid grid;
+    assert(grid.initialize(linearField, gridMin, gridMax, 30.));
+    std::vector<double> xyz = points();
+    // one point outside the grid
+    xyz.insert(xyz.end(), {0., 200., 500.});
+    std::vector<double> B(xyz.size(), 0.);
+    grid.getField(std::span<const double>(xyz), std::span<double>(B));
+    for (size_t i = 0; i < xyz.size(); i += 3) {
+      double single[3];
+      grid.getField(&xyz[i], single);
+      for (int j = 0; j < 3; j++) assert(B[i+j] == single[j]);
+    }
+
+    // only complete positions that fit in the output are filled
+    std::vector<double> partial(4, -1.);
+    grid.getField(std::span<const double>(xyz), std::span<double>(partial));
+    assert(partial[0] != -1. && partial[3] == -1.);
+  }
+
+}
+
+int main() {
+  std::cout << "FaserFieldGrid_test\n";
+  testInitialize();
+  testField();
+  testOutside();
+  testBatch();
+  return 0;
+}
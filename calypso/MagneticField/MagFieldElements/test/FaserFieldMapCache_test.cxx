@@ -0,0 +1,226 @@
+/*
+  Copyright (C) 2022 CERN for the benefit of the FASER collaboration
+*/
+
+/** @file FaserFieldMapCache_test.cxx
+    Unit test of the binary cache of the field map and of copying field meshes
+*/
+
+#undef NDEBUG
+#include "MagFieldElements/FaserFieldMap.h"
+
+#include "TFile.h"
+#include "TTree.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+  const std::string mapFile = "FaserFieldMapCache_test.root";
+  const std::string cacheFile = "FaserFieldMapCache_test.cache";
+  const std::string staleCacheFile = "FaserFieldMapCache_test_stale.cache";
+
+  const double bscale = 1e-6;
+
+  // mesh of the two zones, split in z at 500 mm
+  const std::vector<double> meshX = { -100., 0., 100. };
+  const std::vector<double> meshY = { -100., -20., 100. };
+  const std::vector<double> meshZ[2] = { { 0., 200., 500. }, { 500., 600., 800., 1000. } };
+
+  // field at a mesh node, in units of bscale
+  short nodeField(int zone, int ix, int iy, int iz, int j) {
+    return static_cast<short>(1000*zone + 100*ix - 50*iy + 7*iz + 13*j);
+  }
+
+  // a small map in the format of the ROOT field maps
+  void writeMap() {
+    TFile file(mapFile.c_str(), "RECREATE");
+    TTree* tree = new TTree("BFieldMap", "BFieldMap");
+    int id;
+    double xmin, xmax, ymin, ymax, zmin, zmax, scale;
+    int nmeshx, nmeshy, nmeshz, nfield;
+    double meshx[8], meshy[8], meshz[8];
+    short fieldx[128], fieldy[128], fieldz[128];
+    tree->Branch("id", &id, "id/I");
+    tree->Branch("xmin", &xmin, "xmin/D");
+    tree->Branch("xmax", &xmax, "xmax/D");
+    tree->Branch("ymin", &ymin, "ymin/D");
+    tree->Branch("ymax", &ymax, "ymax/D");
+    tree->Branch("zmin", &zmin, "zmin/D");
+    tree->Branch("zmax", &zmax, "zmax/D");
+    tree->Branch("bscale", &scale, "bscale/D");
+    tree->Branch("nmeshx", &nmeshx, "nmeshx/I");
+    tree->Branch("nmeshy", &nmeshy, "nmeshy/I");
+    tree->Branch("nmeshz", &nmeshz, "nmeshz/I");
+    tree->Branch("nfield", &nfield, "nfield/I");
+    tree->Branch("meshx", meshx, "meshx[nmeshx]/D");
+    tree->Branch("meshy", meshy, "meshy[nmeshy]/D");
+    tree->Branch("meshz", meshz, "meshz[nmeshz]/D");
+    tree->Branch("fieldx", fieldx, "fieldx[nfield]/S");
+    tree->Branch("fieldy", fieldy, "fieldy[nfield]/S");
+    tree->Branch("fieldz", fieldz, "fieldz[nfield]/S");
+    for (int zone = 0; zone < 2; zone++) {
+      id = zone + 1;
+      xmin = meshX.front();
+      xmax = meshX.back();
+      ymin = meshY.front();
+      ymax = meshY.back();
+      zmin = meshZ[zone].front();
+      zmax = meshZ[zone].back();
+      scale = bscale;
+      nmeshx = meshX.size();
+      nmeshy = meshY.size();
+      nmeshz = meshZ[zone].size();
+      std::copy(meshX.begin(), meshX.end(), meshx);
+      std::copy(meshY.begin(), meshY.end(), meshy);
+      std::copy(meshZ[zone].begin(), meshZ[zone].end(), meshz);
+      // z changes most rapidly, then y, then x
+      nfield = 0;
+      for (int ix = 0; ix < nmeshx; ix++) {
+        for (int iy = 0; iy < nmeshy; iy++) {
+          for (int iz = 0; iz < nmeshz; iz++) {
+            fieldx[nfield] = nodeField(zone, ix, iy, iz, 0);
+            fieldy[nfield] = nodeField(zone, ix, iy, iz, 1);
+            fieldz[nfield] = nodeField(zone, ix, iy, iz, 2);
+            nfield++;
+          }
+        }
+      }
+      tree->Fill();
+    }
+    file.Write();
+    file.Close();
+  }
+
+  bool readMap(MagField::FaserFieldMap& map) {
+    std::unique_ptr<TFile> file(TFile::Open(mapFile.c_str()));
+    if (!file) return false;
+    bool ok = map.initializeMap(file.get());
+    file->Close();
+    return ok;
+  }
+
+  // points inside the map, including the mesh nodes and the zone boundary
+  std::vector<std::array<double, 3> > points() {
+    std::vector<std::array<double, 3> > xyz;
+    for (double x : {-100., -37.5, 0., 99.}) {
+      for (double y : {-100., -20., 3.25, 100.}) {
+        for (double z : {0., 150., 499.9, 500., 500.1, 777., 1000.}) {
+          xyz.push_back({x, y, z});
+        }
+      }
+    }
+    return xyz;
+  }
+
+  void getField(const MagField::FaserFieldMap& map, const std::array<double, 3>& xyz, double* B, double* deriv) {
+    const BFieldZone* zone = map.findBFieldZone(xyz[0], xyz[1], xyz[2]);
+    assert(zone != nullptr);
+    zone->getB(xyz.data(), B, deriv);
+  }
+
+  void testRoundTrip() {
+    std::cout << "testRoundTrip\n";
+    MagField::FaserFieldMap map;
+    assert(!map.writeCache(cacheFile, mapFile));
+    assert(readMap(map));
+    assert(!map.isMapped());
+    assert(map.writeCache(cacheFile, mapFile));
+
+    MagField::FaserFieldMap cached;
+    assert(cached.initializeMapFromCache(cacheFile, mapFile));
+    assert(cached.isMapped());
+    // only an empty map can be filled from the cache
+    assert(!cached.initializeMapFromCache(cacheFile, mapFile));
+    assert(cached.xmin() == map.xmin() && cached.xmax() == map.xmax());
+    assert(cached.zmin() == map.zmin() && cached.zmax() == map.zmax());
+
+    for (const auto& xyz : points()) {
+      double B[3], deriv[9];
+      double cachedB[3], cachedDeriv[9];
+      getField(map, xyz, B, deriv);
+      getField(cached, xyz, cachedB, cachedDeriv);
+      for (int j = 0; j < 3; j++) assert(cachedB[j] == B[j]);
+      for (int j = 0; j < 9; j++) assert(cachedDeriv[j] == deriv[j]);
+    }
+
+    // mesh nodes hold the stored values
+    const double node[3] = { 0., -20., 800. };
+    double B[3];
+    cached.findBFieldZone(node[0], node[1], node[2])->getB(node, B);
+    for (int j = 0; j < 3; j++) assert(std::abs(B[j] - bscale*nodeField(1, 1, 1, 2, j)) < 1e-12);
+  }
+
+  void testInvalidCache() {
+    std::cout << "testInvalidCache\n";
+    MagField::FaserFieldMap map;
+    assert(readMap(map));
+    assert(map.writeCache(cacheFile, mapFile));
+
+    // written for another source file
+    MagField::FaserFieldMap other;
+    assert(!other.initializeMapFromCache(cacheFile, cacheFile));
+    assert(!other.isMapped());
+    // missing cache
+    assert(!other.initializeMapFromCache(cacheFile + ".missing", mapFile));
+
+    // truncated cache
+    {
+      std::ifstream in(cacheFile, std::ios::binary);
+      std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+      std::ofstream out(staleCacheFile, std::ios::binary | std::ios::trunc);
+      out.write(bytes.data(), bytes.size() - 6);
+    }
+    assert(!other.initializeMapFromCache(staleCacheFile, mapFile));
+    assert(other.findBFieldZone(0., 0., 100.) == nullptr);
+    // and the map can still be filled afterwards
+    assert(other.initializeMapFromCache(cacheFile, mapFile));
+  }
+
+  void testCopyZone() {
+    std::cout << "testCopyZone\n";
+    const std::array<double, 3> xyz = { 12.5, -40., 300. };
+    double B[3], deriv[9];
+    std::unique_ptr<BFieldZone> copy;
+    std::unique_ptr<BFieldZone> assigned;
+    {
+      MagField::FaserFieldMap map;
+      assert(readMap(map));
+      getField(map, xyz, B, deriv);
+      const BFieldZone* zone = map.findBFieldZone(xyz[0], xyz[1], xyz[2]);
+      copy = std::make_unique<BFieldZone>(*zone);
+      assigned = std::make_unique<BFieldZone>(0, 0., 1., 0., 1., 0., 1., 1.);
+      *assigned = *zone;
+    }
+    // the copies must not look at the field values of the destroyed map
+    for (const BFieldZone* zone : {copy.get(), assigned.get()}) {
+      double copyB[3], copyDeriv[9];
+      zone->getB(xyz.data(), copyB, copyDeriv);
+      for (int j = 0; j < 3; j++) assert(copyB[j] == B[j]);
+      for (int j = 0; j < 9; j++) assert(copyDeriv[j] == deriv[j]);
+    }
+  }
+
+}
+
+int main() {
+  std::cout << "FaserFieldMapCache_test\n";
+  writeMap();
+  testRoundTrip();
+  testInvalidCache();
+  testCopyZone();
+  std::remove(mapFile.c_str());
+  std::remove(cacheFile.c_str());
+  std::remove(staleCacheFile.c_str());
+  return 0;
+}
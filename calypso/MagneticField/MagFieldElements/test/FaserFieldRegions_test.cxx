@@ -0,0 +1,115 @@
+/*
+  Copyright (C) 2022 CERN for the benefit of the FASER collaboration
+*/
+
+/** @file FaserFieldRegions_test.cxx
+    Unit test of the classification of the field into field-free, uniform and mapped regions
+*/
+
+#undef NDEBUG
+#include "MagFieldElements/FaserFieldRegions.h"
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+
+namespace {
+
+  typedef MagField::FaserFieldRegions Regions;
+
+  // 0.55 T in kT
+  const double B0 = 0.55e-3;
+  const double fieldFreeTolerance = 1e-7;
+  const double uniformTolerance = 1e-6;
+
+  // no field up to z = 1000 mm, a uniform field up to 2000 mm, which then
+  // turns around linearly to the opposite uniform field at 2500 mm
+  void field(double /*x*/, double /*y*/, double z, double* B) {
+    B[0] = B[2] = 0;
+    if (z < 1000) B[1] = 0;
+    else if (z < 2000) B[1] = B0;
+    else if (z < 2500) B[1] = B0*(1 - 2*(z - 2000)/500);
+    else B[1] = -B0;
+  }
+
+  bool near(double a, double b) { return std::abs(a - b) < 1e-9; }
+
+  void testClassify() {
+    std::cout << "testClassify\n";
+    Regions regions;
+    assert(regions.classify(field, 0., 3000., 100., 100., fieldFreeTolerance, uniformTolerance));
+    const std::vector<Regions::Region>& r = regions.regions();
+    assert(r.size() == 5);
+    // the slice ending on the step at 1000 mm sees both fields
+    assert(r[0].type == Regions::Type::FieldFree && near(r[0].zmin, 0) && near(r[0].zmax, 900));
+    assert(r[1].type == Regions::Type::Mapped && near(r[1].zmin, 900) && near(r[1].zmax, 1000));
+    assert(r[2].type == Regions::Type::Uniform && near(r[2].zmin, 1000) && near(r[2].zmax, 2000));
+    assert(near(r[2].field[0], 0) && near(r[2].field[1], B0) && near(r[2].field[2], 0));
+    assert(r[3].type == Regions::Type::Mapped && near(r[3].zmin, 2000) && near(r[3].zmax, 2500));
+    assert(r[4].type == Regions::Type::Uniform && near(r[4].zmin, 2500) && near(r[4].zmax, 3000));
+    assert(near(r[4].field[1], -B0));
+  }
+
+  void testFind() {
+    std::cout << "testFind\n";
+    Regions regions;
+    assert(regions.classify(field, 0., 3000., 100., 100., fieldFreeTolerance, uniformTolerance));
+    const std::vector<Regions::Region>& r = regions.regions();
+    assert(regions.find(0., 0., 0.) == &r[0]);
+    assert(regions.find(50., 50., 1500.) == &r[2]);
+    // boundaries belong to the region above, the last one includes its end
+    assert(regions.find(0., 0., 2000.) == &r[3]);
+    assert(regions.find(0., 0., 3000.) == &r[4]);
+    // outside the aperture or the map
+    assert(regions.find(80., 80., 1500.) == nullptr);
+    assert(regions.find(0., 0., -1.) == nullptr);
+    assert(regions.find(0., 0., 3001.) == nullptr);
+  }
+
+  void testFieldFree() {
+    std::cout << "testFieldFree\n";
+    Regions regions;
+    assert(regions.classify(field, 0., 3000., 100., 100., fieldFreeTolerance, uniformTolerance));
+    assert(regions.fieldFree(100., 800.));
+    assert(regions.fieldFree(800., 100.));
+    assert(!regions.fieldFree(100., 950.));
+    assert(!regions.fieldFree(1200., 1300.));
+  }
+
+  void testAperture() {
+    std::cout << "testAperture\n";
+    // uniform on the axis, but growing with the distance from it
+    auto radial = [](double x, double y, double /*z*/, double* B) {
+      B[0] = B[2] = 0;
+      B[1] = B0*(1 + 1e-4*(x*x + y*y));
+    };
+    Regions narrow;
+    assert(narrow.classify(radial, 0., 1000., 1., 100., fieldFreeTolerance, uniformTolerance));
+    assert(narrow.regions().size() == 1);
+    assert(narrow.regions()[0].type == Regions::Type::Uniform);
+    Regions wide;
+    assert(wide.classify(radial, 0., 1000., 100., 100., fieldFreeTolerance, uniformTolerance));
+    assert(wide.regions().size() == 1);
+    assert(wide.regions()[0].type == Regions::Type::Mapped);
+  }
+
+  void testInvalid() {
+    std::cout << "testInvalid\n";
+    Regions regions;
+    assert(!regions.classify(field, 0., 3000., 100., 0., fieldFreeTolerance, uniformTolerance));
+    assert(!regions.classify(field, 3000., 0., 100., 100., fieldFreeTolerance, uniformTolerance));
+    assert(regions.regions().empty());
+    assert(regions.find(0., 0., 0.) == nullptr);
+  }
+
+}
+
+int main() {
+  std::cout << "FaserFieldRegions_test\n";
+  testClassify();
+  testFind();
+  testFieldFree();
+  testAperture();
+  testInvalid();
+  return 0;
+}
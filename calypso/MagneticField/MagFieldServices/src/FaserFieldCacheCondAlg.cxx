@@ -107,6 +107,30 @@ MagField::FaserFieldCacheCondAlg::execute(const EventContext& ctx) const {
         return StatusCode::FAILURE;
     }
 
+    if (m_useFieldGrid) {
+        if (!fieldCondObj->initializeGrid(m_fieldGridSpacing)) {
+            ATH_MSG_ERROR("execute: Could not resample the field map with spacing " << m_fieldGridSpacing << " mm");
+            return StatusCode::FAILURE;
+        }
+        const MagField::FaserFieldGrid* fieldGrid = fieldCondObj->fieldGrid();
+        ATH_MSG_INFO ( "execute: resampled field map on a " << fieldGrid->nodes(0) << " x " << fieldGrid->nodes(1)
+                       << " x " << fieldGrid->nodes(2) << " grid (" << fieldGrid->memSize()/1024 << " kB)" );
+    }
+
+    if (m_classifyFieldRegions) {
+        if (!fieldCondObj->initializeRegions(m_fieldRegionRadius, m_fieldRegionStep, m_fieldFreeTolerance, m_uniformFieldTolerance)) {
+            ATH_MSG_ERROR("execute: Could not classify the field regions");
+            return StatusCode::FAILURE;
+        }
+        for (const MagField::FaserFieldRegions::Region& region : fieldCondObj->fieldRegions()->regions()) {
+            if (region.type == MagField::FaserFieldRegions::Type::Mapped) continue;
+            ATH_MSG_INFO ( "execute: " << (region.type == MagField::FaserFieldRegions::Type::FieldFree ? "field-free" : "uniform")
+                           << " region from z = " << region.zmin << " to " << region.zmax << " mm, B = ("
+                           << region.field[0]/CLHEP::tesla << ", " << region.field[1]/CLHEP::tesla << ", "
+                           << region.field[2]/CLHEP::tesla << ") T" );
+        }
+    }
+
     // Record in conditions store the conditions object with scale factors and map pointer for cache
     if(writeHandle.record(cache.m_condObjOutputRange, std::move(fieldCondObj)).isFailure()) {
         ATH_MSG_ERROR("execute: Could not record FaserFieldCacheCondObj object with " 
@@ -78,6 +78,24 @@ namespace MagField {
         Gaudi::Property<double> m_useDipoScale {this, 
                                                   "UseDipoScale", 1.0,  "Set actual dipole scale factor"};
 
+        // resampled field grid for faster lookups
+        Gaudi::Property<bool> m_useFieldGrid {this, 
+                                              "UseFieldGrid", false, "Resample the field map on a uniform grid and use it for all field lookups"};
+        Gaudi::Property<double> m_fieldGridSpacing {this, 
+                                                    "FieldGridSpacing", 10.0, "Spacing of the resampled field grid in mm"};
+
+        // field-free and uniform z ranges
+        Gaudi::Property<bool> m_classifyFieldRegions {this, 
+                                                      "ClassifyFieldRegions", false, "Find field-free and uniform z ranges and return their constant field without a map lookup"};
+        Gaudi::Property<double> m_fieldRegionRadius {this, 
+                                                     "FieldRegionRadius", 100.0, "Radius in mm of the aperture in which the field regions are classified"};
+        Gaudi::Property<double> m_fieldRegionStep {this, 
+                                                   "FieldRegionStep", 10.0, "Length in mm of the z slices that are classified"};
+        Gaudi::Property<double> m_fieldFreeTolerance {this, 
+                                                      "FieldFreeTolerance", 1.0*CLHEP::gauss, "Largest field in a field-free region"};
+        Gaudi::Property<double> m_uniformFieldTolerance {this, 
+                                                         "UniformFieldTolerance", 10.0*CLHEP::gauss, "Largest deviation from the mean field in a uniform region"};
+
         ServiceHandle<ICondSvc> m_condSvc { this, 
                                             "CondSvc", "CondSvc", "conditions service" };
 
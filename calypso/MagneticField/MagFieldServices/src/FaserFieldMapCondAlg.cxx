@@ -175,6 +175,16 @@ MagField::FaserFieldMapCondAlg::updateFieldMap(const EventContext& ctx, Cache& c
         ATH_MSG_ERROR( "updateFieldMap: Field map file " << mapFile << " not found" );
         return StatusCode::FAILURE;
     }
+    // use the binary cache if it was written from this map file
+    if ( !m_mapCacheFile.empty() ) {
+        cache.m_fieldMap = std::make_unique<MagField::FaserFieldMap>();
+        if ( cache.m_fieldMap->initializeMapFromCache( m_mapCacheFile, resolvedMapFile ) ) {
+            ATH_MSG_INFO( "updateFieldMap: Initialized the field map from cache " << m_mapCacheFile.value()
+                          << " of " << resolvedMapFile );
+            return StatusCode::SUCCESS;
+        }
+        ATH_MSG_INFO( "updateFieldMap: no valid cache " << m_mapCacheFile.value() << ", reading " << resolvedMapFile );
+    }
     // Do checks and extract root file to initialize the map
     if ( resolvedMapFile.find(".root") == std::string::npos ) {
         ATH_MSG_ERROR("updateFieldMap: input file name '" << resolvedMapFile << "' does not end with .root");
@@ -220,6 +230,15 @@ MagField::FaserFieldMapCondAlg::updateFieldMap(const EventContext& ctx, Cache& c
 
     ATH_MSG_INFO( "updateFieldMap: Initialized the field map from " << resolvedMapFile );
 
+    if ( !m_mapCacheFile.empty() ) {
+        if ( cache.m_fieldMap->writeCache( m_mapCacheFile, resolvedMapFile ) ) {
+            ATH_MSG_INFO( "updateFieldMap: Wrote field map cache " << m_mapCacheFile.value() );
+        }
+        else {
+            ATH_MSG_WARNING( "updateFieldMap: unable to write field map cache " << m_mapCacheFile.value() );
+        }
+    }
+
     return StatusCode::SUCCESS;
 }
     
@@ -55,6 +55,11 @@ namespace MagField {
                                                         "FullMapFile", "data/FaserFieldTable.root",
                                                         "File storing the full magnetic field map"};
 
+        /// binary cache of the map - memory-mapped if valid for the map file, otherwise written after reading it
+        Gaudi::Property<std::string> m_mapCacheFile {this,
+                                                     "MapCacheFile", "",
+                                                     "Binary cache of the field map shared between jobs; empty to always read the ROOT file"};
+
         // flag to read magnet map filenames from COOL
         Gaudi::Property<bool> m_useMapsFromCOOL {this,
                                                  "UseMapsFromCOOL", true , "Get magnetic field map filenames from COOL"};
@@ -1319,9 +1319,29 @@ StatusCode NtupleDumperAlg::execute(const EventContext &ctx) const
     auto startSurface_down = Acts::Surface::makeShared<Acts::PlaneSurface>(Acts::Vector3(0, 0, position_down.z()), Acts::Vector3(0, 0, 1));
     Acts::BoundTrackParameters startParameters_down(std::move(startSurface_down), params_down, cov, Acts::ParticleHypothesis::muon());
 
-    // Extrapolate track to scintillators
+    // Extrapolate track to scintillators, one propagation per direction through the
+    // target planes in the order they are crossed
     auto targetSurface_VetoNu = Acts::Surface::makeShared<Acts::PlaneSurface>(Acts::Vector3(0, 0, -3112.0), Acts::Vector3(0, 0, 1)); // -3112 mm is z position of VetoNu planes touching
-    std::optional<const Acts::BoundTrackParameters> targetParameters_VetoNu =m_extrapolationTool->propagate(ctx, startParameters_up, *targetSurface_VetoNu, Acts::Direction::Backward);
+    auto targetSurface_Veto1 = Acts::Surface::makeShared<Acts::PlaneSurface>(Acts::Vector3(0, 0, -1769.65), Acts::Vector3(0, 0, 1)); // -1769.65 mm is z position of center of operational layer in Veto station 1
+    auto targetSurface_Veto2 = Acts::Surface::makeShared<Acts::PlaneSurface>(Acts::Vector3(0, 0, -1609.65), Acts::Vector3(0, 0, 1)); // -1609.65 mm is z position of where planes touch in Veto station 2
+    auto targetSurface_Trig = Acts::Surface::makeShared<Acts::PlaneSurface>(Acts::Vector3(0, 0, 0.0), Acts::Vector3(0, 0, 1)); // 0 mm is z position of Trig planes overlapping
+    auto upstreamParameters_scint = m_extrapolationTool->propagateToSurfaces(ctx, startParameters_up,
+        {targetSurface_Trig.get(), targetSurface_Veto2.get(), targetSurface_Veto1.get(), targetSurface_VetoNu.get()},
+        Acts::Direction::Backward); // must extrapolate backwards to trig plane if track starts in station 1
+    const std::optional<Acts::BoundTrackParameters>& targetParameters_Trig = upstreamParameters_scint[0];
+    const std::optional<Acts::BoundTrackParameters>& targetParameters_Veto2 = upstreamParameters_scint[1];
+    const std::optional<Acts::BoundTrackParameters>& targetParameters_Veto1 = upstreamParameters_scint[2];
+    const std::optional<Acts::BoundTrackParameters>& targetParameters_VetoNu = upstreamParameters_scint[3];
+
+    auto targetSurface_Preshower1 = Acts::Surface::makeShared<Acts::PlaneSurface>(Acts::Vector3(0, 0, 2582.68), Acts::Vector3(0, 0, 1)); // 2582.68  mm is z position of center of upstream preshower layer
+    auto targetSurface_Preshower2 = Acts::Surface::makeShared<Acts::PlaneSurface>(Acts::Vector3(0, 0, 2657.68), Acts::Vector3(0, 0, 1)); // 2657.68  mm is z position of center of downstream preshower layer
+    auto targetSurface_Calo = Acts::Surface::makeShared<Acts::PlaneSurface>(Acts::Vector3(0, 0, 2760.0), Acts::Vector3(0, 0, 1)); // 2760  mm is estimated z position of calorimeter face
+    auto downstreamParameters_scint = m_extrapolationTool->propagateToSurfaces(ctx, startParameters_down,
+        {targetSurface_Preshower1.get(), targetSurface_Preshower2.get(), targetSurface_Calo.get()},
+        Acts::Direction::Forward);
+    const std::optional<Acts::BoundTrackParameters>& targetParameters_Preshower1 = downstreamParameters_scint[0];
+    const std::optional<Acts::BoundTrackParameters>& targetParameters_Preshower2 = downstreamParameters_scint[1];
+    const std::optional<Acts::BoundTrackParameters>& targetParameters_Calo = downstreamParameters_scint[2];
 
     if (targetParameters_VetoNu) {
       auto targetPosition_VetoNu = targetParameters_VetoNu->position(gctx);
@@ -1334,9 +1354,6 @@ StatusCode NtupleDumperAlg::execute(const EventContext &ctx) const
       ATH_MSG_INFO("vetoNu null targetParameters");
     }
 
-    auto targetSurface_Veto1 = Acts::Surface::makeShared<Acts::PlaneSurface>(Acts::Vector3(0, 0, -1769.65), Acts::Vector3(0, 0, 1)); // -1769.65 mm is z position of center of operational layer in Veto station 1
-    std::optional<const Acts::BoundTrackParameters> targetParameters_Veto1 =m_extrapolationTool->propagate(ctx, startParameters_up, *targetSurface_Veto1, Acts::Direction::Backward);
-    
     if (targetParameters_Veto1) {
       auto targetPosition_Veto1 = targetParameters_Veto1->position(gctx);
       auto targetMomentum_Veto1 = targetParameters_Veto1->momentum();
@@ -1348,9 +1365,6 @@ StatusCode NtupleDumperAlg::execute(const EventContext &ctx) const
       ATH_MSG_INFO("veto1 null targetParameters");
     }
 
-    auto targetSurface_Veto2 = Acts::Surface::makeShared<Acts::PlaneSurface>(Acts::Vector3(0, 0, -1609.65), Acts::Vector3(0, 0, 1)); // -1609.65 mm is z position of where planes touch in Veto station 2
-    std::optional<const Acts::BoundTrackParameters> targetParameters_Veto2 =m_extrapolationTool->propagate(ctx, startParameters_up, *targetSurface_Veto2, Acts::Direction::Backward);
-    
     if (targetParameters_Veto2) {
       auto targetPosition_Veto2 = targetParameters_Veto2->position(gctx);
       auto targetMomentum_Veto2 = targetParameters_Veto2->momentum();
@@ -1362,9 +1376,6 @@ StatusCode NtupleDumperAlg::execute(const EventContext &ctx) const
       ATH_MSG_INFO("veto2 null targetParameters");
     }
 
-    auto targetSurface_Trig = Acts::Surface::makeShared<Acts::PlaneSurface>(Acts::Vector3(0, 0, 0.0), Acts::Vector3(0, 0, 1)); // 0 mm is z position of Trig planes overlapping
-    std::optional<const Acts::BoundTrackParameters> targetParameters_Trig =m_extrapolationTool->propagate(ctx, startParameters_up, *targetSurface_Trig, Acts::Direction::Backward); // must extrapolate backsards to trig plane if track starts in station 1
-    
     if (targetParameters_Trig) {
       auto targetPosition_Trig = targetParameters_Trig->position(gctx);
       auto targetMomentum_Trig = targetParameters_Trig->momentum();
@@ -1376,9 +1387,6 @@ StatusCode NtupleDumperAlg::execute(const EventContext &ctx) const
       ATH_MSG_INFO("Trig null targetParameters");
     }
 
-    auto targetSurface_Preshower1 = Acts::Surface::makeShared<Acts::PlaneSurface>(Acts::Vector3(0, 0, 2582.68), Acts::Vector3(0, 0, 1)); // 2582.68  mm is z position of center of upstream preshower layer
-    std::optional<const Acts::BoundTrackParameters> targetParameters_Preshower1 =m_extrapolationTool->propagate(ctx, startParameters_down, *targetSurface_Preshower1, Acts::Direction::Forward);
-    
     if (targetParameters_Preshower1) {
       auto targetPosition_Preshower1 = targetParameters_Preshower1->position(gctx);
       auto targetMomentum_Preshower1 = targetParameters_Preshower1->momentum();
@@ -1390,9 +1398,6 @@ StatusCode NtupleDumperAlg::execute(const EventContext &ctx) const
       ATH_MSG_INFO("Preshower1 null targetParameters");
     }
 
-    auto targetSurface_Preshower2 = Acts::Surface::makeShared<Acts::PlaneSurface>(Acts::Vector3(0, 0, 2657.68), Acts::Vector3(0, 0, 1)); // 2657.68  mm is z position of center of downstream preshower layer
-    std::optional<const Acts::BoundTrackParameters> targetParameters_Preshower2 =m_extrapolationTool->propagate(ctx, startParameters_down, *targetSurface_Preshower2, Acts::Direction::Forward);
-    
     if (targetParameters_Preshower2) {
       auto targetPosition_Preshower2 = targetParameters_Preshower2->position(gctx);
       auto targetMomentum_Preshower2 = targetParameters_Preshower2->momentum();
@@ -1404,9 +1409,6 @@ StatusCode NtupleDumperAlg::execute(const EventContext &ctx) const
       ATH_MSG_INFO("Preshower2 null targetParameters");
     }
 
-    auto targetSurface_Calo = Acts::Surface::makeShared<Acts::PlaneSurface>(Acts::Vector3(0, 0, 2760.0), Acts::Vector3(0, 0, 1)); // 2760  mm is estimated z position of calorimeter face
-    std::optional<const Acts::BoundTrackParameters> targetParameters_Calo =m_extrapolationTool->propagate(ctx, startParameters_down, *targetSurface_Calo, Acts::Direction::Forward);
-    
     if (targetParameters_Calo) {
       auto targetPosition_Calo = targetParameters_Calo->position(gctx);
       auto targetMomentum_Calo = targetParameters_Calo->momentum();
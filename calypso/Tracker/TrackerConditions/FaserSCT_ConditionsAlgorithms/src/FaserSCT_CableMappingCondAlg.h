@@ -0,0 +1,45 @@
+// -*- C++ -*-
+
+/*
+  Copyright (C) 2022 CERN for the benefit of the FASER collaboration
+*/
+
+#ifndef FASERSCT_CABLEMAPPINGCONDALG_H
+#define FASERSCT_CABLEMAPPINGCONDALG_H
+
+// Include parent class
+#include "AthenaBaseComps/AthReentrantAlgorithm.h"
+
+// Include Gaudi classes
+#include "GaudiKernel/ICondSvc.h"
+#include "Gaudi/Property.h"
+
+// Include Athena classes
+#include "StoreGate/ReadCondHandleKey.h"
+#include "StoreGate/WriteCondHandleKey.h"
+#include "AthenaPoolUtilities/CondAttrListCollection.h"
+#include "FaserSCT_ConditionsData/FaserSCT_CableMappingCondData.h"
+
+/**
+ * @class FaserSCT_CableMappingCondAlg
+ * Decodes the TRB to station/plane mapping of /SCT/DAQ/CableMapping once per IOV
+ * into FaserSCT_CableMappingCondData.
+ **/
+class FaserSCT_CableMappingCondAlg : public AthReentrantAlgorithm
+{
+ public:
+  FaserSCT_CableMappingCondAlg(const std::string& name, ISvcLocator* pSvcLocator);
+  virtual ~FaserSCT_CableMappingCondAlg() = default;
+  virtual StatusCode initialize() override;
+  virtual StatusCode execute(const EventContext& ctx) const override;
+  virtual StatusCode finalize() override;
+  /** Make this algorithm clonable. */
+  virtual bool isClonable() const override { return true; };
+
+ private:
+  SG::ReadCondHandleKey<CondAttrListCollection> m_readKey{this, "ReadKey", "/SCT/DAQ/CableMapping", "Key of input cabling folder"};
+  SG::WriteCondHandleKey<FaserSCT_CableMappingCondData> m_writeKey{this, "WriteKey", "FaserSCT_CableMappingCondData", "Key of output decoded cable mapping"};
+  ServiceHandle<ICondSvc> m_condSvc{this, "CondSvc", "CondSvc"};
+};
+
+#endif // FASERSCT_CABLEMAPPINGCONDALG_H
@@ -0,0 +1,120 @@
+/*
+  Copyright (C) 2022 CERN for the benefit of the FASER collaboration
+*/
+
+#include "FaserSCT_StripStatusCondAlg.h"
+
+#include "Identifier/Identifier.h"
+#include "Identifier/IdentifierHash.h"
+#include "TrackerIdentifier/FaserSCT_ID.h"
+
+#include <algorithm>
+#include <memory>
+
+
+FaserSCT_StripStatusCondAlg::FaserSCT_StripStatusCondAlg(const std::string& name, ISvcLocator* pSvcLocator) :
+    ::AthReentrantAlgorithm(name, pSvcLocator) {}
+
+StatusCode FaserSCT_StripStatusCondAlg::initialize() {
+  ATH_MSG_DEBUG("initialize " << name());
+
+  // CondSvc
+  ATH_CHECK(m_condSvc.retrieve());
+
+  ATH_CHECK(detStore()->retrieve(m_idHelper, "FaserSCT_ID"));
+
+  ATH_CHECK(m_summaryTool.retrieve());
+
+  // Read Cond Handles
+  if (m_configKey.empty() and m_stateKey.empty()) {
+    ATH_MSG_FATAL("At least one of CondKeyConfig and CondKeyState is needed for the validity of " << m_writeKey.key());
+    return StatusCode::FAILURE;
+  }
+  ATH_CHECK(m_configKey.initialize(not m_configKey.empty()));
+  ATH_CHECK(m_stateKey.initialize(not m_stateKey.empty()));
+
+  // Write Cond Handle
+  ATH_CHECK(m_writeKey.initialize());
+  if (m_condSvc->regHandle(this, m_writeKey).isFailure()) {
+    ATH_MSG_FATAL("unable to register WriteCondHandle " << m_writeKey.fullKey() << " with CondSvc");
+    return StatusCode::FAILURE;
+  }
+
+  return StatusCode::SUCCESS;
+}
+
+StatusCode FaserSCT_StripStatusCondAlg::execute(const EventContext& ctx) const {
+  ATH_MSG_DEBUG("execute " << name());
+
+  // Write Cond Handle
+  SG::WriteCondHandle<FaserSCT_StripStatusCondData> writeHandle{m_writeKey, ctx};
+  // Do we have a valid Write Cond Handle for current time?
+  if (writeHandle.isValid()) {
+    ATH_MSG_DEBUG("CondHandle " << writeHandle.fullKey() << " is already valid. "
+                  << "In theory this should not be called, but may happen"
+                  << " if multiple concurrent events are being processed out of order.");
+    return StatusCode::SUCCESS;
+  }
+
+  // The validity of the output follows the conditions the summary tool reads
+  if (not m_configKey.empty()) {
+    SG::ReadCondHandle<FaserSCT_ConfigurationCondData> readHandle{m_configKey, ctx};
+    if (*readHandle == nullptr) {
+      ATH_MSG_FATAL("Null pointer to the read conditions object " << m_configKey.key());
+      return StatusCode::FAILURE;
+    }
+    writeHandle.addDependency(readHandle);
+  }
+  if (not m_stateKey.empty()) {
+    SG::ReadCondHandle<FaserSCT_DCSStatCondData> readHandle{m_stateKey, ctx};
+    if (*readHandle == nullptr) {
+      ATH_MSG_FATAL("Null pointer to the read conditions object " << m_stateKey.key());
+      return StatusCode::FAILURE;
+    }
+    writeHandle.addDependency(readHandle);
+  }
+
+  // Size the bitmap for the largest wafer
+  const unsigned int nWafers{static_cast<unsigned int>(m_idHelper->wafer_hash_max())};
+  int nStrips{0};
+  for (unsigned int hash{0}; hash < nWafers; ++hash) {
+    nStrips = std::max(nStrips, m_idHelper->strip_max(m_idHelper->wafer_id(IdentifierHash(hash))) + 1);
+  }
+
+  std::unique_ptr<FaserSCT_StripStatusCondData> writeCdo{std::make_unique<FaserSCT_StripStatusCondData>()};
+  writeCdo->reset(nWafers, nStrips);
+
+  unsigned int nBadWafers{0};
+  for (unsigned int hash{0}; hash < nWafers; ++hash) {
+    const IdentifierHash waferHash{hash};
+    // a bad wafer or module makes all its strips bad, no need to ask for each of them
+    if (not m_summaryTool->isGood(waferHash, ctx)) {
+      writeCdo->setBadWafer(waferHash);
+      ++nBadWafers;
+      continue;
+    }
+    const Identifier waferId{m_idHelper->wafer_id(waferHash)};
+    const int stripMax{m_idHelper->strip_max(waferId)};
+    for (int strip{0}; strip <= stripMax; ++strip) {
+      if (not m_summaryTool->isGood(m_idHelper->strip_id(waferId, strip), ctx, InDetConditions::SCT_STRIP)) {
+        writeCdo->setBadStrip(waferHash, strip);
+      }
+    }
+  }
+  ATH_MSG_INFO("found " << writeCdo->numberOfBadStrips() << " bad strips, including " << nBadWafers << " bad wafers");
+
+  if (writeHandle.record(std::move(writeCdo)).isFailure()) {
+    ATH_MSG_FATAL("Could not record FaserSCT_StripStatusCondData " << writeHandle.key()
+                  << " with EventRange " << writeHandle.getRange()
+                  << " into Conditions Store");
+    return StatusCode::FAILURE;
+  }
+  ATH_MSG_INFO("recorded new CDO " << writeHandle.key() << " with range " << writeHandle.getRange() << " into Conditions Store");
+
+  return StatusCode::SUCCESS;
+}
+
+StatusCode FaserSCT_StripStatusCondAlg::finalize() {
+  ATH_MSG_DEBUG("finalize " << name());
+  return StatusCode::SUCCESS;
+}
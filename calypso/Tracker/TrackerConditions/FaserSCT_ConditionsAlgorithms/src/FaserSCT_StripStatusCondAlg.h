@@ -0,0 +1,49 @@
+/*
+  Copyright (C) 2022 CERN for the benefit of the FASER collaboration
+*/
+
+#ifndef FASERSCT_STRIPSTATUSCONDALG_H
+#define FASERSCT_STRIPSTATUSCONDALG_H
+
+#include "AthenaBaseComps/AthReentrantAlgorithm.h"
+
+#include "StoreGate/ReadCondHandleKey.h"
+#include "StoreGate/WriteCondHandleKey.h"
+
+#include "GaudiKernel/ICondSvc.h"
+#include "GaudiKernel/ServiceHandle.h"
+#include "GaudiKernel/ToolHandle.h"
+
+#include "FaserSCT_ConditionsData/FaserSCT_ConfigurationCondData.h"
+#include "FaserSCT_ConditionsData/FaserSCT_DCSStatCondData.h"
+#include "FaserSCT_ConditionsData/FaserSCT_StripStatusCondData.h"
+#include "FaserSCT_ConditionsTools/ISCT_ConditionsSummaryTool.h"
+
+class FaserSCT_ID;
+
+/**
+ * @class FaserSCT_StripStatusCondAlg
+ * Compiles the answer of the conditions summary tool for every strip into a
+ * FaserSCT_StripStatusCondData bitmap. The output is valid for the intersection
+ * of the conditions read by the summary tool, which have to be declared here
+ * through CondKeyConfig and CondKeyState (an empty key is not used).
+ **/
+class FaserSCT_StripStatusCondAlg : public AthReentrantAlgorithm {
+ public:
+  FaserSCT_StripStatusCondAlg(const std::string& name, ISvcLocator* pSvcLocator);
+  virtual ~FaserSCT_StripStatusCondAlg() = default;
+  virtual StatusCode initialize() override;
+  virtual StatusCode execute(const EventContext& ctx) const override;
+  virtual StatusCode finalize() override;
+  virtual bool isClonable() const override { return true; };
+
+ private:
+  SG::ReadCondHandleKey<FaserSCT_ConfigurationCondData> m_configKey{this, "CondKeyConfig", "FaserSCT_ConfigurationCondData", "SCT DAQ configuration used by the summary tool"};
+  SG::ReadCondHandleKey<FaserSCT_DCSStatCondData> m_stateKey{this, "CondKeyState", "", "SCT DCS state used by the summary tool"};
+  SG::WriteCondHandleKey<FaserSCT_StripStatusCondData> m_writeKey{this, "WriteKey", "FaserSCT_StripStatusCondData", "Key of output bad strip bitmap"};
+  ToolHandle<ISCT_ConditionsSummaryTool> m_summaryTool{this, "ConditionsSummaryTool", "FaserSCT_ConditionsSummaryTool", "Tool providing the status of wafers and strips"};
+  ServiceHandle<ICondSvc> m_condSvc{this, "CondSvc", "CondSvc"};
+  const FaserSCT_ID* m_idHelper{nullptr};
+};
+
+#endif // FASERSCT_STRIPSTATUSCONDALG_H
@@ -1,4 +1,5 @@
 #include "../FaserSCT_AlignCondAlg.h"
+#include "../FaserSCT_CableMappingCondAlg.h"
 // #include "../SCT_ByteStreamErrorsTestAlg.h"
 // #include "../SCT_ConditionsParameterCondAlg.h"
 // #include "../SCT_ConditionsParameterTestAlg.h"
@@ -35,8 +36,10 @@
 // #include "../SCT_TdaqEnabledCondAlg.h"
 // #include "../SCT_TdaqEnabledTestAlg.h"
 #include "../FaserSCT_ConfigurationCondAlg.h"
+#include "../FaserSCT_StripStatusCondAlg.h"
 
 DECLARE_COMPONENT( FaserSCT_AlignCondAlg )
+DECLARE_COMPONENT( FaserSCT_CableMappingCondAlg )
 // DECLARE_COMPONENT( SCT_ByteStreamErrorsTestAlg )
 // DECLARE_COMPONENT( SCT_ConditionsParameterCondAlg )
 // DECLARE_COMPONENT( SCT_ConditionsParameterTestAlg )
@@ -73,3 +76,4 @@ DECLARE_COMPONENT( FaserSCT_SiliconTempCondAlg )
 // DECLARE_COMPONENT( SCT_TdaqEnabledCondAlg )
 // DECLARE_COMPONENT( SCT_TdaqEnabledTestAlg )
 DECLARE_COMPONENT( FaserSCT_ConfigurationCondAlg )
+DECLARE_COMPONENT( FaserSCT_StripStatusCondAlg )
@@ -0,0 +1,76 @@
+/*
+  Copyright (C) 2022 CERN for the benefit of the FASER collaboration
+*/
+
+/**
+ * FaserSCT_CableMappingCondData.h
+ * @file header file for the decoded SCT cable mapping
+ **/
+
+#ifndef FASERSCT_CABLEMAPPINGCONDDATA_H
+#define FASERSCT_CABLEMAPPINGCONDDATA_H
+
+#include <map>
+#include <utility>
+#include <vector>
+
+/**
+ * @class FaserSCT_CableMappingCondData
+ * @brief Station and plane of each TRB, in flat arrays indexed by TRB number.
+ *
+ * Filled once per IOV by FaserSCT_CableMappingCondAlg from /SCT/DAQ/CableMapping.
+ * TRBs without a valid entry in the folder are not mapped.
+ **/
+class FaserSCT_CableMappingCondData {
+public:
+  /// Constructor
+  FaserSCT_CableMappingCondData() = default;
+
+  /// Destructor
+  virtual ~FaserSCT_CableMappingCondData() = default;
+
+  /// Set the station and plane of a TRB
+  void setMapping(unsigned int trb, int station, int plane) {
+    if (trb >= m_station.size()) {
+      m_station.resize(trb + 1, -1);
+      m_plane.resize(trb + 1, -1);
+    }
+    if (m_station[trb] < 0) ++m_nMapped;
+    m_station[trb] = station;
+    m_plane[trb] = plane;
+  }
+
+  /// Check if a TRB is mapped
+  bool hasTrb(unsigned int trb) const { return trb < m_station.size() and m_station[trb] >= 0; }
+  /// Station of a TRB, -1 if it is not mapped
+  int station(unsigned int trb) const { return trb < m_station.size() ? m_station[trb] : -1; }
+  /// Plane of a TRB, -1 if it is not mapped
+  int plane(unsigned int trb) const { return trb < m_plane.size() ? m_plane[trb] : -1; }
+
+  /// Number of mapped TRBs
+  unsigned int size() const { return m_nMapped; }
+
+  /// Mapping as returned by ISCT_CableMappingTool::getCableMapping
+  std::map<int, std::pair<int, int> > getMap() const {
+    std::map<int, std::pair<int, int> > mapping;
+    for (unsigned int trb{0}; trb < m_station.size(); ++trb) {
+      if (hasTrb(trb)) mapping.emplace(trb, std::make_pair(m_station[trb], m_plane[trb]));
+    }
+    return mapping;
+  }
+
+private:
+  std::vector<int> m_station;  //!< station per TRB, -1 if not mapped
+  std::vector<int> m_plane;    //!< plane per TRB, -1 if not mapped
+  unsigned int m_nMapped{0};
+};
+
+// Class definition for StoreGate
+#include "AthenaKernel/CLASS_DEF.h"
+CLASS_DEF( FaserSCT_CableMappingCondData , 217046519 , 1 )
+
+// Condition container definition for CondInputLoader
+#include "AthenaKernel/CondCont.h"
+CONDCONT_DEF( FaserSCT_CableMappingCondData, 97531164 );
+
+#endif // FASERSCT_CABLEMAPPINGCONDDATA_H
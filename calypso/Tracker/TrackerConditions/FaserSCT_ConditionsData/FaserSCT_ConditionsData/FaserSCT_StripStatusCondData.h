@@ -0,0 +1,80 @@
+/*
+  Copyright (C) 2022 CERN for the benefit of the FASER collaboration
+*/
+
+/**
+ * FaserSCT_StripStatusCondData.h
+ * @file header file for the bad strip bitmap
+ **/
+
+#ifndef FASERSCT_STRIPSTATUSCONDDATA_H
+#define FASERSCT_STRIPSTATUSCONDDATA_H
+
+#include "Identifier/IdentifierHash.h"
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class FaserSCT_StripStatusCondData
+ * @brief Bad strips of all wafers, as one bit per (wafer hash, strip).
+ *
+ * Filled by FaserSCT_StripStatusCondAlg from the SCT conditions tools, so that
+ * clustering and digitization test a bit instead of asking every tool per strip.
+ **/
+class FaserSCT_StripStatusCondData {
+public:
+  /// Constructor
+  FaserSCT_StripStatusCondData() = default;
+
+  /// Destructor
+  virtual ~FaserSCT_StripStatusCondData() = default;
+
+  /// Allocate the bitmap for nWafers wafers of nStrips strips, all good
+  void reset(unsigned int nWafers, unsigned int nStrips);
+  /// Set a bad strip
+  void setBadStrip(const IdentifierHash& hash, unsigned int strip);
+  /// Set all strips of a wafer bad
+  void setBadWafer(const IdentifierHash& hash);
+
+  /// Check if a strip is bad; strips outside the bitmap are good
+  bool isBadStrip(const IdentifierHash& hash, unsigned int strip) const {
+    if (hash >= m_nWafers or strip >= m_nStrips) return false;
+    return (m_bits[hash*m_wordsPerWafer + strip/64] >> (strip%64)) & 1;
+  }
+  /// Bad strips of a wafer as one word of 64 strips, starting at strip 64*word
+  uint64_t badStripWord(const IdentifierHash& hash, unsigned int word) const {
+    if (hash >= m_nWafers or word >= m_wordsPerWafer) return 0;
+    return m_bits[hash*m_wordsPerWafer + word];
+  }
+  /// Check if a wafer has any bad strip
+  bool hasBadStrips(const IdentifierHash& hash) const {
+    return hash < m_nWafers and m_nBad[hash] != 0;
+  }
+  /// Number of bad strips of a wafer
+  unsigned int numberOfBadStrips(const IdentifierHash& hash) const {
+    return hash < m_nWafers ? m_nBad[hash] : 0;
+  }
+  /// Number of bad strips of all wafers
+  unsigned int numberOfBadStrips() const;
+
+  unsigned int numberOfWafers() const { return m_nWafers; }
+  unsigned int numberOfStrips() const { return m_nStrips; }
+
+private:
+  unsigned int m_nWafers{0};
+  unsigned int m_nStrips{0};
+  unsigned int m_wordsPerWafer{0};
+  std::vector<uint64_t> m_bits;       //!< m_wordsPerWafer words per wafer, one bit per strip
+  std::vector<unsigned int> m_nBad;   //!< number of bad strips per wafer
+};
+
+// Class definition for StoreGate
+#include "AthenaKernel/CLASS_DEF.h"
+CLASS_DEF( FaserSCT_StripStatusCondData , 108325671 , 1 )
+
+// Condition container definition for CondInputLoader
+#include "AthenaKernel/CondCont.h"
+CONDCONT_DEF( FaserSCT_StripStatusCondData, 226419837 );
+
+#endif // FASERSCT_STRIPSTATUSCONDDATA_H
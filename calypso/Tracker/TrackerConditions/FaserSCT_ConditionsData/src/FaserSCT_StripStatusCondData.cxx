@@ -0,0 +1,42 @@
+/*
+  Copyright (C) 2022 CERN for the benefit of the FASER collaboration
+*/
+
+#include "FaserSCT_ConditionsData/FaserSCT_StripStatusCondData.h"
+
+#include <cstddef>
+#include <numeric>
+
+//----------------------------------------------------------------------
+// Allocate the bitmap, all strips good
+void FaserSCT_StripStatusCondData::reset(unsigned int nWafers, unsigned int nStrips) {
+  m_nWafers = nWafers;
+  m_nStrips = nStrips;
+  m_wordsPerWafer = (nStrips + 63)/64;
+  m_bits.assign(static_cast<size_t>(m_nWafers)*m_wordsPerWafer, 0);
+  m_nBad.assign(m_nWafers, 0);
+}
+
+//----------------------------------------------------------------------
+// Set a bad strip
+void FaserSCT_StripStatusCondData::setBadStrip(const IdentifierHash& hash, unsigned int strip) {
+  if (hash >= m_nWafers or strip >= m_nStrips) return;
+  uint64_t& word{m_bits[hash*m_wordsPerWafer + strip/64]};
+  const uint64_t bit{uint64_t{1} << (strip%64)};
+  if (word & bit) return;
+  word |= bit;
+  ++m_nBad[hash];
+}
+
+//----------------------------------------------------------------------
+// Set all strips of a wafer bad
+void FaserSCT_StripStatusCondData::setBadWafer(const IdentifierHash& hash) {
+  if (hash >= m_nWafers) return;
+  for (unsigned int strip{0}; strip < m_nStrips; ++strip) setBadStrip(hash, strip);
+}
+
+//----------------------------------------------------------------------
+// Number of bad strips of all wafers
+unsigned int FaserSCT_StripStatusCondData::numberOfBadStrips() const {
+  return std::accumulate(m_nBad.begin(), m_nBad.end(), 0u);
+}
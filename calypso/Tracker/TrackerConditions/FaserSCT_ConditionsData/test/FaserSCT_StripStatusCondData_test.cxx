@@ -0,0 +1,113 @@
+/*
+  Copyright (C) 2022 CERN for the benefit of the FASER collaboration
+*/
+
+/** @file FaserSCT_StripStatusCondData_test.cxx
+    Unit test of the bad strip bitmap
+*/
+
+#undef NDEBUG
+#include "FaserSCT_ConditionsData/FaserSCT_StripStatusCondData.h"
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+
+namespace {
+
+  void testEmpty() {
+    std::cout << "testEmpty\n";
+    FaserSCT_StripStatusCondData data;
+    assert(data.numberOfWafers() == 0);
+    assert(!data.isBadStrip(IdentifierHash(0), 0));
+    assert(data.badStripWord(IdentifierHash(0), 0) == 0);
+    assert(!data.hasBadStrips(IdentifierHash(0)));
+    assert(data.numberOfBadStrips() == 0);
+
+    data.reset(4, 768);
+    assert(data.numberOfWafers() == 4);
+    assert(data.numberOfStrips() == 768);
+    for (unsigned int strip = 0; strip < 768; ++strip) {
+      assert(!data.isBadStrip(IdentifierHash(3), strip));
+    }
+    assert(data.numberOfBadStrips() == 0);
+  }
+
+  void testWordBoundaries() {
+    std::cout << "testWordBoundaries\n";
+    FaserSCT_StripStatusCondData data;
+    data.reset(4, 768);
+    const IdentifierHash hash(2);
+    for (unsigned int strip : {0u, 63u, 64u, 767u}) data.setBadStrip(hash, strip);
+    assert(data.isBadStrip(hash, 0));
+    assert(data.isBadStrip(hash, 63));
+    assert(data.isBadStrip(hash, 64));
+    assert(data.isBadStrip(hash, 767));
+    assert(!data.isBadStrip(hash, 1));
+    assert(!data.isBadStrip(hash, 62));
+    assert(!data.isBadStrip(hash, 65));
+    assert(!data.isBadStrip(hash, 766));
+    assert(data.badStripWord(hash, 0) == ((uint64_t{1} << 63) | 1));
+    assert(data.badStripWord(hash, 1) == 1);
+    assert(data.badStripWord(hash, 11) == uint64_t{1} << 63);
+    assert(data.badStripWord(hash, 12) == 0);
+    // the neighbouring wafers are not touched
+    for (unsigned int word = 0; word < 12; ++word) {
+      assert(data.badStripWord(IdentifierHash(1), word) == 0);
+      assert(data.badStripWord(IdentifierHash(3), word) == 0);
+    }
+    assert(data.hasBadStrips(hash));
+    assert(!data.hasBadStrips(IdentifierHash(1)));
+  }
+
+  void testCounting() {
+    std::cout << "testCounting\n";
+    FaserSCT_StripStatusCondData data;
+    data.reset(4, 768);
+    data.setBadStrip(IdentifierHash(0), 10);
+    data.setBadStrip(IdentifierHash(0), 10);
+    data.setBadStrip(IdentifierHash(0), 11);
+    data.setBadStrip(IdentifierHash(3), 500);
+    assert(data.numberOfBadStrips(IdentifierHash(0)) == 2);
+    assert(data.numberOfBadStrips(IdentifierHash(3)) == 1);
+    assert(data.numberOfBadStrips() == 3);
+
+    // out of range strips and wafers are ignored
+    data.setBadStrip(IdentifierHash(0), 768);
+    data.setBadStrip(IdentifierHash(4), 0);
+    assert(data.numberOfBadStrips() == 3);
+    assert(!data.isBadStrip(IdentifierHash(0), 768));
+    assert(!data.isBadStrip(IdentifierHash(4), 0));
+    assert(data.numberOfBadStrips(IdentifierHash(4)) == 0);
+
+    data.reset(4, 768);
+    assert(data.numberOfBadStrips() == 0);
+    assert(!data.isBadStrip(IdentifierHash(0), 10));
+  }
+
+  void testBadWafer() {
+    std::cout << "testBadWafer\n";
+    // the last word of a wafer is only partially used
+    FaserSCT_StripStatusCondData data;
+    data.reset(2, 100);
+    data.setBadStrip(IdentifierHash(1), 5);
+    data.setBadWafer(IdentifierHash(1));
+    assert(data.numberOfBadStrips(IdentifierHash(1)) == 100);
+    assert(data.badStripWord(IdentifierHash(1), 0) == ~uint64_t{0});
+    assert(data.badStripWord(IdentifierHash(1), 1) == (uint64_t{1} << 36) - 1);
+    assert(data.badStripWord(IdentifierHash(1), 2) == 0);
+    assert(!data.hasBadStrips(IdentifierHash(0)));
+    assert(data.badStripWord(IdentifierHash(0), 0) == 0);
+    assert(data.badStripWord(IdentifierHash(0), 1) == 0);
+  }
+
+}
+
+int main() {
+  std::cout << "FaserSCT_StripStatusCondData_test\n";
+  testEmpty();
+  testWordBoundaries();
+  testCounting();
+  testBadWafer();
+  return 0;
+}
@@ -10,12 +10,15 @@
 #define ISCT_CABLE_MAPPING_TOOL
 
 //STL includes
+#include <map>
 #include <vector>
 
 //Gaudi Includes
 #include "GaudiKernel/IAlgTool.h"
 #include "GaudiKernel/EventContext.h"
 
+class FaserSCT_CableMappingCondData;
+
 class ISCT_CableMappingTool: virtual public IAlgTool {
 
  public:
@@ -31,6 +34,10 @@ class ISCT_CableMappingTool: virtual public IAlgTool {
   virtual std::map<int, std::pair<int,int> > getCableMapping(const EventContext& ctx) const = 0;
   virtual std::map<int, std::pair<int,int> > getCableMapping(void) const = 0;
 
+  // Decoded mapping of the current IOV, indexed by TRB (nullptr if unavailable)
+  virtual const FaserSCT_CableMappingCondData* getCableMappingData(const EventContext& ctx) const = 0;
+  virtual const FaserSCT_CableMappingCondData* getCableMappingData(void) const = 0;
+
 };
 
 //---------------------------------------------------------------------- 
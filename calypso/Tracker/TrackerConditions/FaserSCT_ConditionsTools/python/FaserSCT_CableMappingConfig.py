@@ -6,6 +6,7 @@ from AthenaConfiguration.ComponentAccumulator import ComponentAccumulator
 from AthenaConfiguration.ComponentFactory import CompFactory
 from IOVDbSvc.IOVDbSvcConfig import addFolders
 FaserSCT_CableMappingTool=CompFactory.FaserSCT_CableMappingTool
+FaserSCT_CableMappingCondAlg=CompFactory.FaserSCT_CableMappingCondAlg
 
 def FaserSCT_CableMappingToolCfg(flags, name="CableMappingTool", **kwargs):
     """Return a configured FaserSCT_CableMappingTool"""
@@ -22,6 +23,8 @@ def FaserSCT_CableMappingCfg(flags, **kwargs):
     dbInstance = kwargs.get("dbInstance", "TDAQ_OFL")
     dbFolder = kwargs.get("dbFolder", "/SCT/DAQ/CableMapping")
     acc.merge(addFolders(flags, dbFolder, dbInstance, className="CondAttrListCollection"))
+    # decode the folder once per IOV
+    acc.addCondAlgo(FaserSCT_CableMappingCondAlg(ReadKey=dbFolder))
     # acc.addPublicTool(tool)
     return acc
 
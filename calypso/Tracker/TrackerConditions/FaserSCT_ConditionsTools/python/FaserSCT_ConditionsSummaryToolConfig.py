@@ -32,3 +32,10 @@ def FaserSCT_ConditionsSummaryToolCfg(flags, name="FaserSCT_ConditionsSummaryToo
     kwargs.setdefault("ConditionsTools", ConditionsTools)
     acc.setPrivateTools(CompFactory.FaserSCT_ConditionsSummaryTool(name=name, **kwargs))
     return acc
+
+
+def FaserSCT_StripStatusCondAlgCfg(flags, name="FaserSCT_StripStatusCondAlg", **kwargs):
+    acc = ComponentAccumulator()
+    kwargs.setdefault("ConditionsSummaryTool", acc.popToolsAndMerge(FaserSCT_ConditionsSummaryToolCfg(flags)))
+    acc.addCondAlgo(CompFactory.FaserSCT_StripStatusCondAlg(name, **kwargs))
+    return acc
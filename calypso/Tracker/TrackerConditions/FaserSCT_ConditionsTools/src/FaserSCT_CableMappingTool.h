@@ -17,7 +17,7 @@
 #include "FaserSCT_ConditionsTools/ISCT_CableMappingTool.h"
 
 // Include Athena stuff
-#include "AthenaPoolUtilities/CondAttrListCollection.h"
+#include "FaserSCT_ConditionsData/FaserSCT_CableMappingCondData.h"
 #include "StoreGate/ReadCondHandleKey.h"
 
 #include "GaudiKernel/ICondSvc.h"
@@ -31,7 +31,8 @@
 #include "GaudiKernel/EventContext.h"
 
 /** This class contains a Tool that reads SCT cable mapping data and makes it available to 
-    other algorithms. The current implementation reads the data from a COOL database. 
+    other algorithms. The data are decoded from the COOL database once per IOV by
+    FaserSCT_CableMappingCondAlg.
 */
 
 class FaserSCT_CableMappingTool: public extends<AthAlgTool, ISCT_CableMappingTool> {
@@ -50,9 +51,12 @@ class FaserSCT_CableMappingTool: public extends<AthAlgTool, ISCT_CableMappingToo
   virtual std::map<int, std::pair<int, int> > getCableMapping(const EventContext& ctx) const override;
   virtual std::map<int, std::pair<int, int> > getCableMapping(void) const override;
 
+  virtual const FaserSCT_CableMappingCondData* getCableMappingData(const EventContext& ctx) const override;
+  virtual const FaserSCT_CableMappingCondData* getCableMappingData(void) const override;
+
  private:
   // Read Cond Handle
-  SG::ReadCondHandleKey<CondAttrListCollection> m_readKey{this, "ReadKey", "/SCT/DAQ/CableMapping", "Key of input cabling folder"};
+  SG::ReadCondHandleKey<FaserSCT_CableMappingCondData> m_condKey{this, "CondKey", "FaserSCT_CableMappingCondData", "Key of decoded cable mapping"};
 
   ServiceHandle<ICondSvc> m_condSvc{this, "CondSvc", "CondSvc"};
 
@@ -59,6 +59,8 @@ StatusCode FaserSCT_FrontEnd::initialize() {
     m_ReadCalibChipDataTool.disable();
   }
 
+  ATH_CHECK(m_stripStatusKey.initialize(not m_stripStatusKey.empty()));
+
   // Get the maximum number of strips of any module
   m_strip_max = m_SCTdetMgr->numerology().maxNumStrips();
 
@@ -648,6 +650,17 @@ void FaserSCT_FrontEnd::process(SiChargedDiodeCollection& collection, CLHEP::Hep
     }
   }
 
+  // Drop strips flagged as bad in conditions
+  if (not m_stripStatusKey.empty()) {
+    SG::ReadCondHandle<FaserSCT_StripStatusCondData> stripStatusHandle{m_stripStatusKey};
+    const FaserSCT_StripStatusCondData* stripStatus{*stripStatusHandle};
+    if (stripStatus == nullptr) {
+      ATH_MSG_ERROR("\tCan't retrieve " << m_stripStatusKey.fullKey());
+    } else if (StatusCode::SUCCESS != doMaskBadStrips(collection, *stripStatus, data)) {
+      ATH_MSG_ERROR("\tCan't mask bad strips");
+    }
+  }
+
   // Check for strips above threshold and do clustering
   if (StatusCode::SUCCESS != doClustering(collection, data)) {
     ATH_MSG_ERROR("\tCan't cluster the hits?!");
@@ -914,6 +927,23 @@ StatusCode FaserSCT_FrontEnd::doThresholdCheckForCrosstalkHits(SiChargedDiodeCol
   return StatusCode::SUCCESS;
 }
 
+// ----------------------------------------------------------------------
+// remove hits on bad strips, before they are clustered into RDOs
+// ----------------------------------------------------------------------
+StatusCode FaserSCT_FrontEnd::doMaskBadStrips(SiChargedDiodeCollection& collection, const FaserSCT_StripStatusCondData& stripStatus, SCT_FrontEndData& data) const {
+  const IdentifierHash waferHash{m_sct_id->wafer_hash(collection.identify())};
+  if (not stripStatus.hasBadStrips(waferHash)) return StatusCode::SUCCESS;
+
+  for (int strip = 0; strip < m_strip_max; ++strip) {
+    if (data.m_StripHitsOnWafer[strip] > 0 and stripStatus.isBadStrip(waferHash, strip)) {
+      data.m_StripHitsOnWafer[strip] = 0;
+      SiChargedDiode* diode = collection.find(m_sct_id->strip_id(collection.identify(), strip));
+      if (diode) SiHelper::disabled(*diode, true, true);
+    }
+  }
+  return StatusCode::SUCCESS;
+}
+
 StatusCode FaserSCT_FrontEnd::doClustering(SiChargedDiodeCollection& collection, SCT_FrontEndData& data) const {
   // ********************************
   // now do clustering
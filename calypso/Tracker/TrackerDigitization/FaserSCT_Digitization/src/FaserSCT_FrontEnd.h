@@ -34,6 +34,8 @@
 // Athena
 #include "FaserSiDigitization/SiChargedDiodeCollection.h"
 #include "FaserSCT_ConditionsTools/ISCT_ReadCalibChipDataTool.h"
+#include "FaserSCT_ConditionsData/FaserSCT_StripStatusCondData.h"
+#include "StoreGate/ReadCondHandleKey.h"
 
 // Gaudi
 #include "GaudiKernel/ToolHandle.h"
@@ -95,6 +97,7 @@ class  FaserSCT_FrontEnd : public extends<AthAlgTool, ISCT_FrontEnd> {
   StatusCode doThresholdCheckForRealHits(SiChargedDiodeCollection& collectione, SCT_FrontEndData& data) const;
   StatusCode doThresholdCheckForCrosstalkHits(SiChargedDiodeCollection& collection, SCT_FrontEndData& data) const;
   StatusCode doClustering(SiChargedDiodeCollection& collection, SCT_FrontEndData& data) const;
+  StatusCode doMaskBadStrips(SiChargedDiodeCollection& collection, const FaserSCT_StripStatusCondData& stripStatus, SCT_FrontEndData& data) const;
   StatusCode prepareGainAndOffset(SiChargedDiodeCollection& collection, /*const Identifier& moduleId,*/ CLHEP::HepRandomEngine* rndmEngine, SCT_FrontEndData& data) const;
   StatusCode prepareGainAndOffset(SiChargedDiodeCollection& collection, int side, const Identifier& moduleId, CLHEP::HepRandomEngine* rndmEngine, SCT_FrontEndData& data) const;
   StatusCode randomNoise(SiChargedDiodeCollection& collection, /*const Identifier& moduleId,*/ CLHEP::HepRandomEngine* rndmEngine, SCT_FrontEndData& data) const;
@@ -129,6 +132,8 @@ class  FaserSCT_FrontEnd : public extends<AthAlgTool, ISCT_FrontEnd> {
   BooleanProperty m_useCalibData{this, "UseCalibData", false, "Flag to set the use of calibration data for noise, Gain,offset etc."}; // was true in ATLAS
 
   ToolHandle<ISCT_Amp> m_sct_amplifier{this, "SCT_Amp", "FaserSCT_Amp", "Handle the Amplifier tool"}; //!< Handle the Amplifier tool
+  SG::ReadCondHandleKey<FaserSCT_StripStatusCondData> m_stripStatusKey{this, "StripStatusKey", "", "Bad strip bitmap; hits on bad strips are dropped if set"};
+
   ToolHandle<ISCT_ReadCalibChipDataTool> m_ReadCalibChipDataTool{this, "SCT_ReadCalibChipDataTool", "SCT_ReadCalibChipDataTool", "Tool to retrieve chip calibration information"}; //!< Handle to the Calibration ConditionsTool
 
   const TrackerDD::SCT_DetectorManager* m_SCTdetMgr{nullptr}; //!< Handle to SCT detector manager
@@ -10,6 +10,7 @@
 #include "EventFormats/DAQFormats.hpp"
 
 #include "TrackerIdentifier/FaserSCT_ID.h"
+#include "FaserSCT_ConditionsData/FaserSCT_CableMappingCondData.h"
 
 #include "AthenaKernel/errorcheck.h"
 #include "GaudiKernel/MsgStream.h"
@@ -96,12 +97,18 @@ StatusCode TrackerByteStreamCnv::createObj(IOpaqueAddress* pAddr, DataObject*& p
   FaserSCT_RDO_Container* cont = new FaserSCT_RDO_Container(max);
   ATH_MSG_DEBUG("New FaserSCT_RDO_Container created of size="<<cont->size());
 
-  auto mapping = m_mappingTool->getCableMapping();
-  ATH_MSG_DEBUG("Cable mapping contains " << mapping.size() << " entries");
+  // Mapping decoded once per IOV by FaserSCT_CableMappingCondAlg
+  const FaserSCT_CableMappingCondData* mapping = m_mappingTool->getCableMappingData();
+  if (!mapping) {
+    ATH_MSG_ERROR("Cannot get SCT cable mapping!");
+    delete cont;
+    return StatusCode::FAILURE;
+  }
+  ATH_MSG_DEBUG("Cable mapping contains " << mapping->size() << " entries");
 
   // Convert raw data into this container
 
-  CHECK( m_tool->convert(re, cont, key, mapping) );
+  CHECK( m_tool->convert(re, cont, key, *mapping) );
   
   pObj = SG::asStorable(cont);
 
@@ -7,6 +7,7 @@
 
 #include "TrackerRawData/FaserSCT3_RawData.h"
 #include "EventFormats/TrackerDataFragment.hpp"
+#include "EventFormats/TrackerDataDecoder.hpp"
 
 #include "TrackerReadoutGeometry/SiDetectorElement.h"
 #include "TrackerReadoutGeometry/SiDetectorElementCollection.h"
@@ -41,7 +42,10 @@ TrackerDataDecoderTool::initialize()
 {
   ATH_MSG_DEBUG("initialize()");
 
-  if (msgStream().level() >= MSG::WARNING ) TrackerDataFragment::set_debug_on(true);
+  if (msgStream().level() >= MSG::WARNING ) {
+    TrackerDataFragment::set_debug_on(true);
+    TrackerDataDecoder::set_debug_on(true);
+  }
 
   ATH_CHECK(detStore()->retrieve(m_sctID, "FaserSCT_ID"));
 
@@ -81,16 +85,38 @@ StatusCode
 TrackerDataDecoderTool::convert(const DAQFormats::EventFull* re, 
     FaserSCT_RDO_Container* container,
     std::string key,
-    const std::map<int, std::pair<int, int> >& cableMapping)
+    const FaserSCT_CableMappingCondData& cableMapping)
 
 {
-  ATH_MSG_DEBUG("TrackerDataDecoderTool::convert()");
-
   if (!re) {
     ATH_MSG_ERROR("EventFull passed to convert() is null!");
     return StatusCode::FAILURE;
   }
 
+  // View onto the fragments owned by the EventFull. They were already copied
+  // out of the raw buffer by EventFull::loadPayload, the view only avoids a second copy
+  DAQFormats::EventView view;
+  try
+  {
+    view.load(*re);
+  }
+  catch (const DAQFormats::EFormatException& exc)
+  {
+    ATH_MSG_ERROR("EFormatException: " << exc.what());
+    return StatusCode::FAILURE;
+  }
+  return convert(view, container, key, cableMapping);
+}
+
+StatusCode
+TrackerDataDecoderTool::convert(const DAQFormats::EventView& view, 
+    FaserSCT_RDO_Container* container,
+    std::string key,
+    const FaserSCT_CableMappingCondData& cableMapping)
+
+{
+  ATH_MSG_DEBUG("TrackerDataDecoderTool::convert()");
+
   if (!container) {
     ATH_MSG_ERROR("TrackerDataContainer passed to convert() is null!");
     return StatusCode::FAILURE;
@@ -110,15 +136,17 @@ TrackerDataDecoderTool::convert(const DAQFormats::EventFull* re,
 
   std::map<IdentifierHash, std::unique_ptr<FaserSCT_RDO_Collection>>  collectionMap;
 
-  const DAQFormats::EventFragment* frag = NULL;
+  // Decoder scratch space and hit buffer are reused for all tracker fragments of the event
+  TrackerDataDecoder decoder;
+  TrackerHitBuffer hits;
+
   size_t validFragments = 0;
-  for(const auto &id : re->getFragmentIDs()) {
-    frag=re->find_fragment(id);
+  for(const DAQFormats::FragmentView& frag : view) {
 
-    if ((frag->source_id()&0xFFFF0000) != DAQFormats::SourceIDs::TrackerSourceID) continue;
-    ATH_MSG_DEBUG("Fragment:\n" << *frag);
-    uint32_t trb = frag->source_id() & 0x0000FFFF;
-    if (cableMapping.count(trb) == 0)
+    if ((frag.source_id()&0xFFFF0000) != DAQFormats::SourceIDs::TrackerSourceID) continue;
+    ATH_MSG_DEBUG("Fragment:\n" << frag);
+    uint32_t trb = frag.source_id() & 0x0000FFFF;
+    if (!cableMapping.hasTrb(trb))
     {
       ATH_MSG_ERROR("Invalid trb number " << trb << " not in mapping DB");
       return StatusCode::FAILURE;
@@ -126,127 +154,112 @@ TrackerDataDecoderTool::convert(const DAQFormats::EventFull* re,
     // FIXME: 1 by default; needs to be 0 for IFT
     // int station = m_trb0Station + trb / TrackerDataFragment::PLANES_PER_STATION; 
     // int plane = trb % TrackerDataFragment::PLANES_PER_STATION;
-    int station = cableMapping.at(trb).first;
-    int plane   = cableMapping.at(trb).second;
+    int station = cableMapping.station(trb);
+    int plane   = cableMapping.plane(trb);
 
     // Exceptions are a no-no in Athena/Calypso, so catch any thrown by faser-common
     try
     {
-      TrackerDataFragment trackFrag{ frag->payload<const uint32_t*>(), frag->payload_size() };
+      decoder.decode(frag.payload<const uint32_t*>(), frag.payload_size(), hits);
 
-      if (!trackFrag.valid())
+      if (!hits.valid())
       {
         ATH_MSG_WARNING("Invalid tracker data fragment for TRB " << trb);
         // FIXME: What else to do if error?  Return FAILURE?
         // FIXME: Validity checking in TrackerDataFragment is a placeholder
         continue;
       }
-      if (trackFrag.event_id() != re->event_id())
+      if (hits.event_id() != view.event_id())
       {
         ATH_MSG_ERROR("Event ID mismatch for tracker data fragment from trb " << trb << 
-                      "; found " << trackFrag.event_id() << " but expected " << re->event_id());
+                      "; found " << hits.event_id() << " but expected " << view.event_id());
         // FIXME: Is returning FAILURE the right thing to do here?
         return StatusCode::FAILURE;
       }
       validFragments++;
-      // auto bcid = trackFrag.bc_id();
       ATH_MSG_DEBUG("Processing tracker data fragment for TRB " << trb);
 
-      for (auto sctEvent : trackFrag)
+      for (unsigned short onlineModuleID = 0; onlineModuleID < TrackerDataFragment::MODULES_PER_FRAGMENT; onlineModuleID++)
       {
-        if (sctEvent != nullptr)
+        if (!hits.hasData(onlineModuleID)) continue;
+        const TrackerHitBuffer::Module& module = hits.modules[onlineModuleID];
+        if (module.bcidMismatch)
         {
-          unsigned short onlineModuleID = sctEvent->GetModuleID(); 
-          // if (plane == 2) onlineModuleID = (onlineModuleID + 4) % 8;
-          if (onlineModuleID >= TrackerDataFragment::MODULES_PER_FRAGMENT)
-          {
-            // FIXME: Should we return failure here?
-            ATH_MSG_ERROR("Invalid module ID (" << onlineModuleID << ") from trb " << trb);
-            continue;
-          }
-          if (sctEvent->BCIDMismatch())
-          {
-            // FIXME: Should we return failure here?
-            ATH_MSG_ERROR("Module data BCID mismatch between sides for online module " << onlineModuleID);
-            continue;
-          }
-          else if (sctEvent->HasError())
-          {
-            // FIXME: Should we return failure here?
-            ATH_MSG_ERROR("Online module " << onlineModuleID << " reports one or more errors.");
-            continue;
-          }
-          else if (sctEvent->MissingData())
-          {
-            // FIXME: Should we return failure here?
-            ATH_MSG_ERROR("Online module " << onlineModuleID << " reports missing data.");
-            continue;
-          }
-          else if (!sctEvent->IsComplete())
-          {
-            // FIXME: Should we return failure here?
-            ATH_MSG_ERROR("Online module " << onlineModuleID << " reports not complete.");
-            continue;
-          }
-          // Not satisfied, at least for cosmics data
-          // else if (sctEvent->GetBCID() != bcid)
-          // {
-          //   // FIXME: Should we return failure here?
-          //   ATH_MSG_ERROR("Module data BCID (" << sctEvent->GetBCID() << ")for online module " << 
-          //                  onlineModuleID << " differs from TrackerDataFragment (" << bcid << ")");
-          //   continue;
-          // }
-          ATH_MSG_DEBUG("Processing online module #" << onlineModuleID);
-          size_t chipIndex{0};
-          for (auto hitVector : sctEvent->GetHits())
+          // FIXME: Should we return failure here?
+          ATH_MSG_ERROR("Module data BCID mismatch between sides for online module " << onlineModuleID);
+          continue;
+        }
+        else if (module.hasError)
+        {
+          // FIXME: Should we return failure here?
+          ATH_MSG_ERROR("Online module " << onlineModuleID << " reports one or more errors.");
+          continue;
+        }
+        else if (module.missingData)
+        {
+          // FIXME: Should we return failure here?
+          ATH_MSG_ERROR("Online module " << onlineModuleID << " reports missing data.");
+          continue;
+        }
+        else if (!module.complete)
+        {
+          // FIXME: Should we return failure here?
+          ATH_MSG_ERROR("Online module " << onlineModuleID << " reports not complete.");
+          continue;
+        }
+        ATH_MSG_DEBUG("Processing online module #" << onlineModuleID);
+
+        int phiModule = 3 - (onlineModuleID % 4); // 0 to 3 from bottom to top: (module#,Phi#) =  (0,3),(1,2),(2,1),(3,0),(4,3),(5,2),(6,1),(7,0)
+        int etaModule = -2*(onlineModuleID/4) + 1; // eta = +1 for modules 0,1,2,3 and eta = -1 for 4,5,6,7 
+        for (int side = 0; side < static_cast<int>(TrackerDataFragment::SIDES_PER_MODULE); side++)
+        {
+          uint32_t sideBegin = hits.chipBegin(onlineModuleID, side * TrackerDataFragment::CHIPS_PER_SIDE);
+          uint32_t sideEnd = hits.chipBegin(onlineModuleID, (side + 1) * TrackerDataFragment::CHIPS_PER_SIDE);
+          if (sideBegin == sideEnd) continue;
+
+          // Wafer lookups are done once per side rather than once per hit
+          Identifier id = m_sctID->wafer_id(station, plane, phiModule, etaModule, side);
+          IdentifierHash waferHash = m_sctID->wafer_hash(id);  // this will be the collection number in the container
+          bool phiReversed = m_phiReversed[waferHash];
+          FaserSCT_RDO_Collection* collection{nullptr};
+
+          for (uint32_t i = sideBegin; i < sideEnd; i++)
           {
-            if (hitVector.size() > 0)
+            uint32_t chipOnSide = hits.chip[i] % TrackerDataFragment::CHIPS_PER_SIDE;
+            uint32_t stripOnChip = hits.strip[i];
+            if (stripOnChip >= TrackerDataFragment::STRIPS_PER_CHIP)
+            {
+              // FIXME: Return failure?
+              ATH_MSG_ERROR("Invalid strip number on chip: " << stripOnChip );
+              continue;
+            }
+            uint32_t hitPattern  = hits.pattern[i];
+            if (hitMode == HitMode::EDGE && (((hitPattern & 0x2) == 0 ) || ((hitPattern & 0x4) != 0) ) ) continue; // 01X
+            if (hitMode == HitMode::LEVEL && ((hitPattern & 0x2) == 0)) continue; // X1X
+            int stripOnSide = chipOnSide * TrackerDataFragment::STRIPS_PER_CHIP + stripOnChip;
+            if (phiReversed) stripOnSide = TrackerDataFragment::STRIPS_PER_SIDE - stripOnSide - 1;
+            if (stripOnSide < 0 || static_cast<uint32_t>(stripOnSide) >= TrackerDataFragment::STRIPS_PER_SIDE)
+            {
+              // FIXME: Return failure?
+              ATH_MSG_ERROR("Invalid strip number on side: " << stripOnSide);
+              continue;
+            }
+            Identifier digitID {m_sctID->strip_id(id, stripOnSide)};
+            int errors{0};
+            int groupSize{1};
+            unsigned int rawDataWord{static_cast<unsigned int>(groupSize | (stripOnSide << 11) | (hitPattern <<22) | (errors << 25))};
+
+            if (collection == nullptr)
             {
-              int side = chipIndex / TrackerDataFragment::CHIPS_PER_SIDE;
-              uint32_t chipOnSide = chipIndex % TrackerDataFragment::CHIPS_PER_SIDE;
-              for (auto hit : hitVector)
+              std::unique_ptr<FaserSCT_RDO_Collection>& current_collection = collectionMap[waferHash];
+              if (current_collection == nullptr)
               {
-                uint32_t stripOnChip = hit.first;
-                if (stripOnChip >= TrackerDataFragment::STRIPS_PER_CHIP)
-                {
-                  // FIXME: Return failure?
-                  ATH_MSG_ERROR("Invalid strip number on chip: " << stripOnChip );
-                  continue;
-                }
-                uint32_t hitPattern  = hit.second;
-                if (hitMode == HitMode::EDGE && (((hitPattern & 0x2) == 0 ) || ((hitPattern & 0x4) != 0) ) ) continue; // 01X
-                if (hitMode == HitMode::LEVEL && ((hitPattern & 0x2) == 0)) continue; // X1X
-                int phiModule = 3 - (onlineModuleID % 4); // 0 to 3 from bottom to top: (module#,Phi#) =  (0,3),(1,2),(2,1),(3,0),(4,3),(5,2),(6,1),(7,0)
-                int etaModule = -2*(onlineModuleID/4) + 1; // eta = +1 for modules 0,1,2,3 and eta = -1 for 4,5,6,7 
-                // ATH_MSG_DEBUG("Getting wafer_id for station, plane, phi, eta, side = " << station << " " << plane << " " << phiModule << " " << etaModule << " " << side);
-                Identifier id = m_sctID->wafer_id(station, plane, phiModule, etaModule, side);
-                IdentifierHash waferHash = m_sctID->wafer_hash(id);  // this will be the collection number in the container
-                int stripOnSide = chipOnSide * TrackerDataFragment::STRIPS_PER_CHIP + stripOnChip;
-                // ATH_MSG_DEBUG("Checking phi reversal for waferhash = " << waferHash << "(" << waferHash.value() << ") strip on side = " << stripOnSide);
-                if (m_phiReversed[waferHash]) stripOnSide = TrackerDataFragment::STRIPS_PER_SIDE - stripOnSide - 1;
-                if (stripOnSide < 0 || static_cast<uint32_t>(stripOnSide) >= TrackerDataFragment::STRIPS_PER_SIDE)
-                {
-                  // FIXME: Return failure?
-                  ATH_MSG_ERROR("Invalid strip number on side: " << stripOnSide);
-                  continue;
-                }
-                Identifier digitID {m_sctID->strip_id(id, stripOnSide)};
-                int errors{0};
-                int groupSize{1};
-                unsigned int rawDataWord{static_cast<unsigned int>(groupSize | (stripOnSide << 11) | (hitPattern <<22) | (errors << 25))};
-
-                if (collectionMap.count(waferHash) == 0)
-                {
-                  {
-                    std::unique_ptr<FaserSCT_RDO_Collection> current_collection = std::make_unique<FaserSCT_RDO_Collection>(waferHash);
-                    current_collection->setIdentifier(id);
-                    collectionMap[waferHash] = std::move(current_collection);
-                  }
-                }
-                collectionMap[waferHash]->emplace_back(new FaserSCT3_RawData(digitID, rawDataWord, std::vector<int>() ));
+                current_collection = std::make_unique<FaserSCT_RDO_Collection>(waferHash);
+                current_collection->setIdentifier(id);
               }
+              collection = current_collection.get();
             }
-            chipIndex++;
+            collection->emplace_back(new FaserSCT3_RawData(digitID, rawDataWord, std::vector<int>() ));
           }
         }
       }
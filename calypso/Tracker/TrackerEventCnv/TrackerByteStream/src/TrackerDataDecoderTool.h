@@ -14,6 +14,7 @@
 #include "TrackerRawData/FaserSCT_RDO_Container.h"
 
 #include "TrackerIdentifier/FaserSCT_ID.h"
+#include "FaserSCT_ConditionsData/FaserSCT_CableMappingCondData.h"
 
 
 // This class provides conversion between bytestream and Tracker RDOs
@@ -32,7 +33,12 @@ class TrackerDataDecoderTool : public AthAlgTool {
   virtual StatusCode finalize();
 
   StatusCode convert(const DAQFormats::EventFull* re, FaserSCT_RDO_Container* cont, std::string key,
-                     const std::map<int, std::pair<int, int> >& cableMapping);
+                     const FaserSCT_CableMappingCondData& cableMapping);
+
+  // Decode from a non-owning view of the event. The byte stream input still
+  // delivers EventFull, so for now this is only reached through the overload above
+  StatusCode convert(const DAQFormats::EventView& view, FaserSCT_RDO_Container* cont, std::string key,
+                     const FaserSCT_CableMappingCondData& cableMapping);
 
 private:
   const FaserSCT_ID*                      m_sctID{nullptr};
@@ -0,0 +1,328 @@
+/*
+  Copyright (C) 2022 CERN for the benefit of the FASER collaboration
+*/
+
+/** @file TrackerDataDecoder_test.cxx
+    Unit test of TrackerDataDecoder, checking it against TrackerDataFragment
+    on synthetic and corrupted tracker data fragments
+*/
+
+#undef NDEBUG
+#include "EventFormats/TrackerDataFragment.hpp"
+#include "EventFormats/TrackerDataDecoder.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+  // Bits of one module side, most significant bit first
+  class BitWriter {
+  public:
+    void add(uint32_t value, int nBits) {
+      for (int i = nBits-1; i >= 0; i--) m_bits.push_back((value >> i) & 1);
+    }
+    void flip(size_t bit) { m_bits[bit] ^= 1; }
+    size_t size() const { return m_bits.size(); }
+    // 24 bits per data word, zero padded
+    std::vector<uint32_t> words() const {
+      std::vector<uint32_t> result;
+      for (size_t i = 0; i < m_bits.size(); i += 24) {
+        uint32_t word = 0;
+        for (size_t j = 0; j < 24; j++) {
+          word <<= 1;
+          if (i+j < m_bits.size()) word |= m_bits[i+j];
+        }
+        result.push_back(word);
+      }
+      return result;
+    }
+  private:
+    std::vector<uint32_t> m_bits;
+  };
+
+  void addHeader(BitWriter& bits, uint32_t l1id, uint32_t bcid) {
+    bits.add(0x3A, 6);
+    bits.add(l1id, 4);
+    bits.add(bcid, 8);
+    bits.add(1, 1);
+  }
+
+  void addHits(BitWriter& bits, uint32_t chip, uint32_t strip, const std::vector<uint32_t>& patterns) {
+    bits.add(1, 2);
+    bits.add(chip, 4);
+    bits.add(strip, 7);
+    for (uint32_t pattern : patterns) {
+      bits.add(1, 1);
+      bits.add(pattern, 3);
+    }
+  }
+
+  void addError(BitWriter& bits, uint32_t chip, uint32_t error) {
+    bits.add(0, 3);
+    bits.add(chip, 4);
+    bits.add(error, 3);
+    bits.add(1, 1);
+  }
+
+  void addTrailer(BitWriter& bits) {
+    bits.add(0x8000, 16);
+  }
+
+  // TRB words with running frame counter, module streams interleaved as read out
+  class FragmentWriter {
+  public:
+    void add(uint32_t word) {
+      m_data.push_back((word & ~0x38000000u) | ((m_frame++ % 8) << 27));
+    }
+    void addStreams(const std::vector<std::vector<uint32_t> >& streams) {
+      for (size_t pos = 0; ; pos++) {
+        bool any = false;
+        for (uint32_t k = 0; k < streams.size(); k++) {
+          if (pos >= streams[k].size()) continue;
+          add(0x80000000 | ((k & 1) << 30) | ((k >> 1) << 24) | streams[k][pos]);
+          any = true;
+        }
+        if (!any) break;
+      }
+    }
+    std::vector<uint32_t>& data() { return m_data; }
+    // CRC word over everything before it, keeping its frame counter
+    void finish() {
+      add(TrackerDataFragment::TRBDATATYPE_CRC);
+      uint32_t crc = FletcherChecksum::ReturnFletcherChecksum(m_data.data(), m_data.size()*4);
+      m_data.back() = (m_data.back() & 0xFF000000u) | (crc & 0x00FFFFFFu);
+      m_data.back() = (m_data.back() & ~0x38000000u) | (((m_frame-1) % 8) << 27);
+    }
+  private:
+    std::vector<uint32_t> m_data;
+    uint32_t m_frame{0};
+  };
+
+  void compare(const std::vector<uint32_t>& data, TrackerDataDecoder& decoder, TrackerHitBuffer& hits) {
+    const size_t size = data.size()*4;
+    TrackerDataFragment fragment(data.data(), size);
+    decoder.decode(data.data(), size, hits);
+
+    assert(hits.valid() == fragment.valid());
+    assert(hits.size() == fragment.size());
+    assert(hits.event_id() == fragment.event_id());
+    assert(hits.bc_id() == fragment.bc_id());
+    assert(hits.missing_event_id() == fragment.missing_event_id());
+    assert(hits.missing_bcid() == fragment.missing_bcid());
+    assert(hits.missing_crc() == fragment.missing_crc());
+    assert(hits.missing_frames() == fragment.missing_frames());
+    assert(hits.unrecognized_frames() == fragment.unrecognized_frames());
+    assert(hits.has_crc_error() == fragment.has_crc_error());
+    assert(hits.has_trb_error() == fragment.has_trb_error());
+    assert(hits.trb_error_id() == fragment.trb_error_id());
+    assert(hits.module_error_id() == fragment.module_error_id());
+
+    for (size_t module = 0; module < TrackerHitBuffer::MODULES; module++) {
+      assert(hits.hasData(module) == fragment.hasData(module));
+      if (!fragment.hasData(module)) {
+        assert(hits.moduleBegin(module) == hits.moduleEnd(module));
+        continue;
+      }
+      const TrackerHitBuffer::Module& mod = hits.modules[module];
+      const SCTEvent& event = fragment[module];
+      assert(mod.l1id == event.GetL1ID());
+      assert(mod.bcid == event.GetBCID());
+      assert(mod.complete == event.IsComplete());
+      assert(mod.missingData == event.MissingData());
+      assert(mod.bcidMismatch == event.BCIDMismatch());
+      assert(mod.hasError == event.HasError());
+      for (size_t chip = 0; chip < TrackerHitBuffer::CHIPS; chip++) {
+        const auto& chipHits = event.GetHits()[chip];
+        assert(hits.chipBegin(module, chip+1) - hits.chipBegin(module, chip) == chipHits.size());
+        for (size_t k = 0; k < chipHits.size(); k++) {
+          size_t i = hits.chipBegin(module, chip) + k;
+          assert(hits.chip[i] == chip);
+          assert(hits.strip[i] == chipHits[k].first);
+          assert(hits.pattern[i] == chipHits[k].second);
+        }
+        std::vector<uint8_t> errors;
+        for (uint32_t i = mod.errorBegin; i < mod.errorEnd; i++) {
+          if (hits.errorChip[i] == chip) errors.push_back(hits.errorCode[i]);
+        }
+        assert(errors == event.GetErrors()[chip]);
+      }
+    }
+  }
+
+  // Random fragments, optionally with bit flips and stray words
+  class FragmentGenerator {
+  public:
+    explicit FragmentGenerator(bool corrupt) : m_corrupt(corrupt) {}
+
+    std::vector<uint32_t> next() {
+      FragmentWriter writer;
+      writer.add(rnd(0x1000000));
+      writer.add(0x40000000 | rnd(4096));
+      if (m_corrupt && rnd(20) == 0) writer.add(0x40000000 | TrackerDataFragment::TRBDATATYPE_TRBERROR | rnd(16));
+      if (m_corrupt && rnd(20) == 0) writer.add(0x40000000 | TrackerDataFragment::TRBDATATYPE_MODULEERROR_LED | rnd(0x1000000));
+
+      std::vector<std::vector<uint32_t> > streams(TrackerHitBuffer::MODULES*2);
+      for (uint32_t module = 0; module < TrackerHitBuffer::MODULES; module++) {
+        if (rnd(4) == 0) continue;
+        uint32_t l1id = rnd(16);
+        uint32_t bcid = rnd(256);
+        for (uint32_t side = 0; side < 2; side++) {
+          if (m_corrupt && rnd(10) == 0) continue;
+          BitWriter bits = moduleStream(module, side, l1id, bcid);
+          if (m_corrupt && rnd(4) == 0) {
+            for (int k = 0; k < 3; k++) bits.flip(rnd(bits.size()));
+          }
+          streams[module*2+side] = bits.words();
+        }
+      }
+      writer.addStreams(streams);
+
+      if (m_corrupt && rnd(30) == 0) writer.add(rnd(0xFFFFFFFF));
+      if (m_corrupt && rnd(30) == 0) {
+        std::vector<uint32_t>& data = writer.data();
+        data[rnd(data.size())] ^= 1u << rnd(32);
+      }
+      writer.finish();
+      return writer.data();
+    }
+
+  private:
+    uint32_t rnd(size_t n) { return static_cast<uint32_t>(m_rng() % n); }
+
+    BitWriter moduleStream(uint32_t module, uint32_t side, uint32_t l1id, uint32_t bcid) {
+      BitWriter bits;
+      // a few idle bits before the header, which the decoders skip
+      if (m_corrupt && rnd(5)) bits.add(0, rnd(3));
+      if (m_corrupt && rnd(20) == 0) l1id = rnd(16);
+      if (m_corrupt && rnd(20) == 0) bcid = rnd(256);
+      addHeader(bits, l1id, bcid);
+      int nPackets = rnd(8);
+      for (int p = 0; p < nPackets; p++) {
+        uint32_t chip = (side == 0 ? 0 : 8) + rnd(6);
+        if (m_corrupt && rnd(10) == 0) chip = rnd(16);
+        uint32_t type = rnd(10);
+        if (type < 6) {
+          std::vector<uint32_t> patterns(1 + rnd(4));
+          for (uint32_t& pattern : patterns) pattern = 1 + rnd(7);
+          addHits(bits, chip, rnd(128 - patterns.size()), patterns);
+        } else if (type < 8) {
+          // no data packet
+          bits.add(1, 3);
+        } else if (type < 9) {
+          addError(bits, chip, rnd(8));
+        } else if (m_corrupt) {
+          bits.add(rnd(4096), 12);
+        }
+      }
+      addTrailer(bits);
+      // occasionally a second event on the same line
+      if (module == 3 && rnd(3) == 0) {
+        addHeader(bits, l1id, bcid);
+        addHits(bits, side == 0 ? 2 : 10, 3, {1});
+        addTrailer(bits);
+      }
+      return bits;
+    }
+
+    std::mt19937 m_rng{1};
+    bool m_corrupt;
+  };
+
+  void testKnownHits() {
+    std::cout << "testKnownHits\n";
+    BitWriter side0;
+    addHeader(side0, 3, 0x55);
+    addHits(side0, 1, 10, {3, 5});
+    addTrailer(side0);
+    BitWriter side1;
+    addHeader(side1, 3, 0x55);
+    addHits(side1, 9, 100, {1});
+    addError(side1, 12, 2);
+    addTrailer(side1);
+
+    std::vector<std::vector<uint32_t> > streams(TrackerHitBuffer::MODULES*2);
+    streams[2*2+0] = side0.words();
+    streams[2*2+1] = side1.words();
+    FragmentWriter writer;
+    writer.add(0x123456);
+    writer.add(0x40000000 | 0x789);
+    writer.addStreams(streams);
+    writer.finish();
+
+    TrackerDataDecoder decoder;
+    TrackerHitBuffer hits;
+    compare(writer.data(), decoder, hits);
+
+    assert(hits.valid());
+    assert(hits.event_id() == 0x123456);
+    assert(hits.bc_id() == 0x789);
+    for (size_t module = 0; module < TrackerHitBuffer::MODULES; module++) {
+      assert(hits.hasData(module) == (module == 2));
+    }
+    const TrackerHitBuffer::Module& mod = hits.modules[2];
+    assert(mod.l1id == 3);
+    assert(mod.bcid == 0x55);
+    assert(mod.complete);
+    assert(mod.hasError);
+
+    // chip 1 is index 1, chip 9 index 7
+    assert(hits.nHits() == 3);
+    assert(hits.chipBegin(2, 1) == 0 && hits.chipBegin(2, 2) == 2);
+    assert(hits.chipBegin(2, 7) == 2 && hits.chipBegin(2, 8) == 3);
+    assert(hits.chip[0] == 1 && hits.strip[0] == 10 && hits.pattern[0] == 3);
+    assert(hits.chip[1] == 1 && hits.strip[1] == 11 && hits.pattern[1] == 5);
+    assert(hits.chip[2] == 7 && hits.strip[2] == 100 && hits.pattern[2] == 1);
+    assert(mod.errorEnd - mod.errorBegin == 1);
+    assert(hits.errorChip[mod.errorBegin] == 10 && hits.errorCode[mod.errorBegin] == 2);
+
+    // the same buffer is cleared by the next fragment
+    FragmentWriter empty;
+    empty.add(0x123457);
+    empty.add(0x40000000 | 0x78a);
+    empty.finish();
+    compare(empty.data(), decoder, hits);
+    assert(hits.valid());
+    assert(hits.nHits() == 0);
+    assert(!hits.hasData(2));
+  }
+
+  void testSynthetic() {
+    std::cout << "testSynthetic\n";
+    FragmentGenerator generator(false);
+    TrackerDataDecoder decoder;
+    TrackerHitBuffer hits;
+    size_t nHits = 0;
+    for (int i = 0; i < 2000; i++) {
+      compare(generator.next(), decoder, hits);
+      assert(hits.valid());
+      nHits += hits.nHits();
+    }
+    assert(nHits > 0);
+  }
+
+  void testCorrupted() {
+    std::cout << "testCorrupted\n";
+    FragmentGenerator generator(true);
+    TrackerDataDecoder decoder;
+    TrackerHitBuffer hits;
+    // both decoders log every problem they find, keep the output short
+    for (int i = 0; i < 500; i++) {
+      compare(generator.next(), decoder, hits);
+    }
+  }
+
+}
+
+int main() {
+  std::cout << "TrackerDataDecoder_test\n";
+  TrackerDataFragment::set_debug_on(false);
+  TrackerDataDecoder::set_debug_on(false);
+  testKnownHits();
+  testSynthetic();
+  testCorrupted();
+  return 0;
+}
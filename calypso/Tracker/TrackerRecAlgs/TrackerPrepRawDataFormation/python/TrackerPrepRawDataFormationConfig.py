@@ -9,7 +9,7 @@ PileUpXingFolder=CompFactory.PileUpXingFolder
 from OutputStreamAthenaPool.OutputStreamConfig import OutputStreamCfg
 from FaserSCT_GeoModel.FaserSCT_GeoModelConfig import FaserSCT_GeometryCfg
 from FaserSiLorentzAngleTool.FaserSCT_LorentzAngleConfig import FaserSCT_LorentzAngleCfg
-from FaserSCT_ConditionsTools.FaserSCT_ConditionsSummaryToolConfig import FaserSCT_ConditionsSummaryToolCfg
+from FaserSCT_ConditionsTools.FaserSCT_ConditionsSummaryToolConfig import FaserSCT_ConditionsSummaryToolCfg, FaserSCT_StripStatusCondAlgCfg
 
 
 def FaserSCT_ClusterizationCommonCfg(flags, name="FaserSCT_ClusterizationToolCommon", **kwargs):
@@ -44,11 +44,20 @@ def FaserSCT_ClusterizationBasicCfg(flags, **kwargs):
     acc = ComponentAccumulator()
     pattern = kwargs.pop("ClusterToolTimingPattern", "")
     checkBadChannels = kwargs.pop("checkBadChannels", "False")
+    # use the bad strip bitmap instead of asking the conditions tools for each strip
+    useStripStatus = kwargs.pop("useStripStatus", False)
+    toolArgs = {}
+    if useStripStatus:
+        acc.merge(FaserSCT_StripStatusCondAlgCfg(flags))
+        toolArgs["StripStatusKey"] = "FaserSCT_StripStatusCondData"
+    # find clusters as runs of hit strips in a per-wafer bitmap
+    if kwargs.pop("bitmapClustering", False):
+        toolArgs["doBitmapClustering"] = True
     # print("ClusterToolTimingPattern = ", pattern)
     if len(pattern) > 0 :
-        clusterTool = acc.popToolsAndMerge(FaserSCT_ClusterizationToolCfg(flags, timeBins=pattern, checkBadChannels=checkBadChannels))
+        clusterTool = acc.popToolsAndMerge(FaserSCT_ClusterizationToolCfg(flags, timeBins=pattern, checkBadChannels=checkBadChannels, **toolArgs))
     else:
-        clusterTool = acc.popToolsAndMerge(FaserSCT_ClusterizationToolCfg(flags, checkBadChannels=checkBadChannels))
+        clusterTool = acc.popToolsAndMerge(FaserSCT_ClusterizationToolCfg(flags, checkBadChannels=checkBadChannels, **toolArgs))
 
     FaserSCT_ConditionsSummaryTool = acc.popToolsAndMerge(FaserSCT_ConditionsSummaryToolCfg(flags))
 
@@ -20,14 +20,15 @@
 #include "TrkRIO_OnTrack/RIO_OnTrack.h"
 #include "StoreGate/ReadHandle.h"
 
+#include "tbb/parallel_for.h"
+#include "tbb/task_arena.h"
+
 #include <list>
 
 namespace Tracker
 {
 
 int SegmentFitAlg::clusterInfo::nEdgeStrips {0};
-size_t SegmentFitAlg::clusterInfo::nClusters {0};
-double SegmentFitAlg::fitInfo::zCenter {0.0};
 static const std::string moduleFailureReason{"SegmentFitAlg: Exceeds max clusters"};
 
 // Constructor with parameters:
@@ -68,7 +69,7 @@ StatusCode SegmentFitAlg::initialize() {
 }
 
 // Process one station
-StatusCode SegmentFitAlg::reconstructStation(ClusterContainerHandle container, int index, std::unique_ptr<TrackCollection>& tracks) const
+StatusCode SegmentFitAlg::reconstructStation(const FaserSCT_ClusterContainer& container, int index, TrackList& tracks) const
 {
   int station = m_detMgr->numerology().stationId(index);
   ATH_MSG_VERBOSE("Processing station " << station);
@@ -91,25 +92,25 @@ StatusCode SegmentFitAlg::reconstructStation(ClusterContainerHandle container, i
   m_numberOfGoodStations++;
 
   // find station center (the reference point for fits)
-  fitInfo::zCenter = findCenter(station);
+  double zCenter = findCenter(station);
 
-  clusterInfo::nClusters = occupancy;
   ClusterList l = tabulateClusters(container, station);
   ATH_MSG_VERBOSE("Station " << station << ": tabulated " << l.size() << " clusters.");
   if (l.size() < m_minClustersPerStation) return StatusCode::SUCCESS;
 
   // flag clusters that are compatible with each other
-  checkCompatibility(l);
+  CompatibilityMatrix compatibility(l.size());
+  checkCompatibility(l, compatibility);
 
   int pairs {0};
-  for (auto c : l)
+  for (size_t i = 0; i < l.size(); i++)
   {
-    pairs += (c->compatible.count() - 1);  // every cluster is compatible with itself
+    if (l[i]->view != 0) pairs += (compatibility.count(i) - 1);  // every cluster is compatible with itself
   }
   ATH_MSG_VERBOSE("Found " << pairs/2 << " compatible cluster pairs from " << l.size() << " clusters (average " << ((double)pairs/2)/l.size() << ").");
 
   // form viable (containing both views) groups of four compatible clusters
-  FitList f = enumerateSeeds(l);
+  FitList f = enumerateSeeds(l, compatibility, zCenter);
   ATH_MSG_VERBOSE("Found " << f.size() << " fit seeds from " << l.size() << " clusters.");
 
   // fit the seeds
@@ -154,11 +155,11 @@ StatusCode SegmentFitAlg::reconstructStation(ClusterContainerHandle container, i
   return StatusCode::SUCCESS;
 }
 
-size_t SegmentFitAlg::stationOccupancy(ClusterContainerHandle container, int station) const
+size_t SegmentFitAlg::stationOccupancy(const FaserSCT_ClusterContainer& container, int station) const
 {
   size_t occupancy {0};
-  FaserSCT_ClusterContainer::const_iterator clusterCollections {container->begin()};
-  FaserSCT_ClusterContainer::const_iterator clusterCollectionsEnd {container->end()};
+  FaserSCT_ClusterContainer::const_iterator clusterCollections {container.begin()};
+  FaserSCT_ClusterContainer::const_iterator clusterCollectionsEnd {container.end()};
   for (; clusterCollections != clusterCollectionsEnd; ++clusterCollections) 
   {
     if (getStation(*clusterCollections) == station) occupancy += (*clusterCollections)->size();
@@ -186,12 +187,12 @@ double SegmentFitAlg::findCenter(int station) const
   return zMean/zCount;
 }
 
-SegmentFitAlg::ClusterList SegmentFitAlg::tabulateClusters(ClusterContainerHandle container, int station) const
+SegmentFitAlg::ClusterList SegmentFitAlg::tabulateClusters(const FaserSCT_ClusterContainer& container, int station) const
 {
   ClusterList clusters;
   int index {0};
-  FaserSCT_ClusterContainer::const_iterator clusterCollections {container->begin()};
-  FaserSCT_ClusterContainer::const_iterator clusterCollectionsEnd {container->end()};
+  FaserSCT_ClusterContainer::const_iterator clusterCollections {container.begin()};
+  FaserSCT_ClusterContainer::const_iterator clusterCollectionsEnd {container.end()};
   for (; clusterCollections != clusterCollectionsEnd; ++clusterCollections) 
   {
     if (getStation(*clusterCollections) == station)
@@ -207,11 +208,12 @@ SegmentFitAlg::ClusterList SegmentFitAlg::tabulateClusters(ClusterContainerHandl
   return clusters;
 }
 
-void SegmentFitAlg::checkCompatibility(ClusterList& clusters) const
+void SegmentFitAlg::checkCompatibility(const ClusterList& clusters, CompatibilityMatrix& compatibility) const
 {
-  for (size_t i = 0; i < clusters.size() - 1; i++)
+  for (size_t i = 0; i < clusters.size(); i++)
   {
     if (clusters[i]->view == 0) continue;
+    compatibility.set(i, i);
     for (size_t j = i + 1; j < clusters.size(); j++)
     {
       if (clusters[j]->view == 0) continue;
@@ -221,8 +223,7 @@ void SegmentFitAlg::checkCompatibility(ClusterList& clusters) const
       if (clusters[i]->layer != clusters[j]->layer)
       {
         m_numberOfRule1Pairs++;
-        clusters[i]->compatible.set(j, true);
-        clusters[j]->compatible.set(i, true);
+        compatibility.set(i, j);
         continue;
       }
       //
@@ -233,8 +234,7 @@ void SegmentFitAlg::checkCompatibility(ClusterList& clusters) const
           clusters[i]->side != clusters[j]->side)
       {
         m_numberOfRule2Pairs++;
-        clusters[i]->compatible.set(j, true);
-        clusters[j]->compatible.set(i, true);
+        compatibility.set(i, j);
         continue;
       }
       if (clusters[i]->moduleIndex == clusters[j]->moduleIndex) continue; // same-module clusters are incompatible if they get here
@@ -244,8 +244,7 @@ void SegmentFitAlg::checkCompatibility(ClusterList& clusters) const
       if (m_allowEtaOverlap && clusters[i]->phi == clusters[j]->phi && abs(clusters[i]->yEnd - clusters[j]->yEnd) <= 2 * m_edgeStrips)
       {
         m_numberOfRule3Pairs++;
-        clusters[i]->compatible.set(j, true);
-        clusters[j]->compatible.set(i, true);
+        compatibility.set(i, j);
         continue;
       }
       //
@@ -258,15 +257,13 @@ void SegmentFitAlg::checkCompatibility(ClusterList& clusters) const
         if (clusters[i]->eta == clusters[j]->eta) 
         {
           m_numberOfRule4Pairs++;
-          clusters[i]->compatible.set(j, true);
-          clusters[j]->compatible.set(i, true);
+          compatibility.set(i, j);
           continue;    
         }
         if (m_allowEtaOverlap && clusters[i]->eta != clusters[j]->eta)
         {
           m_numberOfRule4Pairs++;
-          clusters[i]->compatible.set(j, true);
-          clusters[j]->compatible.set(i, true);
+          compatibility.set(i, j);
           continue;    
         }
       }
@@ -275,10 +272,14 @@ void SegmentFitAlg::checkCompatibility(ClusterList& clusters) const
 }
 
 SegmentFitAlg::FitList 
-SegmentFitAlg::enumerateSeeds(const ClusterList& clusters) const
+SegmentFitAlg::enumerateSeeds(const ClusterList& clusters, const CompatibilityMatrix& compatibility, double zCenter) const
 {
   FitList fits;
-  for (size_t i = 0; i < clusters.size()-3; i++)
+  // compatible clusters of the pairs and triplets, intersected a word at a time
+  const size_t nWords = compatibility.words;
+  std::vector<uint64_t> ij_compat(nWords);
+  std::vector<uint64_t> ijk_compat(nWords);
+  for (size_t i = 0; i + 3 < clusters.size(); i++)
   {
     size_t i_views[2] {0 , 0};
     if (clusters[i]->view == 0)
@@ -293,9 +294,8 @@ SegmentFitAlg::enumerateSeeds(const ClusterList& clusters) const
     {
       i_views[0]= 1;
     }
-    auto i_compat = clusters[i]->compatible;
-    std::vector<size_t> i_vec {i};
-    for (size_t j = i_compat.find_next(i); j != ClusterSet::npos; j = i_compat.find_next(j))
+    const uint64_t* i_compat = compatibility.row(i);
+    for (size_t j = compatibility.next(i_compat, i + 1); j != CompatibilityMatrix::npos; j = compatibility.next(i_compat, j + 1))
     {
       size_t ij_views[2] {i_views[0], i_views[1]};
       if (clusters[j]->view > 0)
@@ -306,8 +306,9 @@ SegmentFitAlg::enumerateSeeds(const ClusterList& clusters) const
       {
         ij_views[0]++;
       }      
-      auto ij_compat = clusters[j]->compatible & i_compat;
-      for (size_t k = ij_compat.find_next(j); k != ClusterSet::npos; k = ij_compat.find_next(k))
+      const uint64_t* j_compat = compatibility.row(j);
+      for (size_t w = 0; w < nWords; w++) ij_compat[w] = i_compat[w] & j_compat[w];
+      for (size_t k = compatibility.next(ij_compat.data(), j + 1); k != CompatibilityMatrix::npos; k = compatibility.next(ij_compat.data(), k + 1))
       {
         size_t ijk_views[2] {ij_views[0], ij_views[1]};
         if (clusters[k]->view > 0)
@@ -319,8 +320,9 @@ SegmentFitAlg::enumerateSeeds(const ClusterList& clusters) const
           ijk_views[0]++;
         }      
         if (ijk_views[0] == 0 || ijk_views[1] == 0) continue; // Need two hits in each view to fit
-        auto ijk_compat = clusters[k]->compatible & ij_compat;
-        for (size_t l = ijk_compat.find_next(k); l != ClusterSet::npos; l = ijk_compat.find_next(l))
+        const uint64_t* k_compat = compatibility.row(k);
+        for (size_t w = 0; w < nWords; w++) ijk_compat[w] = ij_compat[w] & k_compat[w];
+        for (size_t l = compatibility.next(ijk_compat.data(), k + 1); l != CompatibilityMatrix::npos; l = compatibility.next(ijk_compat.data(), l + 1))
         {
           size_t ijkl_views[2] {ijk_views[0], ijk_views[1]};
           if (clusters[l]->view > 0)
@@ -336,7 +338,7 @@ SegmentFitAlg::enumerateSeeds(const ClusterList& clusters) const
               (clusters[j]->layer == clusters[k]->layer && clusters[k]->layer == clusters[l]->layer) ||
               (clusters[k]->layer == clusters[l]->layer && clusters[l]->layer == clusters[i]->layer)) continue;  // Can't fit 3+ hits in same layer
           m_numberOfSeeds++;
-          fits.push_back(std::make_shared<fitInfo>(clusters, std::vector<size_t> {i, j, k, l}));
+          fits.push_back(std::make_shared<fitInfo>(clusters, compatibility, zCenter, std::vector<size_t> {i, j, k, l}));
         }
       }
     }
@@ -440,15 +442,23 @@ SegmentFitAlg::enumerateFits(const FitMap& seeds, const MaskSet& veto) const
       auto seed = p.second;
       for (size_t i = seed->compatibleMask.find_first(); i != ClusterSet::npos; i = seed->compatibleMask.find_next(i))
       {
-        if (abs(seed->fitParams(1) + seed->fitParams(3) * (seed->clusters[i]->z - fitInfo::zCenter) - seed->clusters[i]->yCenter) > m_yResidualCut)
+        if (abs(seed->fitParams(1) + seed->fitParams(3) * (seed->clusters[i]->z - seed->zCenter) - seed->clusters[i]->yCenter) > m_yResidualCut)
           continue;
         ClusterSet mask { seed->clusterMask };
         mask.set(i);
         if (allFits.find(mask) == allFits.end() && !vetoFit(allFailures, mask))
         {
           auto candidate = std::make_shared<fitInfo>(*seed);
-          candidate->addCluster(i);
-          fitClusters(*candidate);
+          if (candidate->hasCovariance)
+          {
+            m_numberOfFits++;
+            candidate->extendFit(i);
+          }
+          else
+          {
+            candidate->addCluster(i);
+            fitClusters(*candidate);
+          }
           if (checkFit(*candidate))
           {
             allFits[candidate->clusterMask] = candidate;
@@ -549,9 +559,32 @@ SegmentFitAlg::execute(const EventContext& ctx) const
   ATH_CHECK(clusterContainer.isValid());
   ATH_MSG_VERBOSE("Retrieved cluster data from event store");
 
-  for (int stationIdx = 0; stationIdx < m_detMgr->numerology().numStations(); stationIdx++)
+  // stations are independent; their tracks are collected separately and stored in station order
+  const int nStations = m_detMgr->numerology().numStations();
+  std::vector<TrackList> stationTracks(nStations);
+  if (m_parallelStations)
+  {
+    std::vector<StatusCode> stationStatus(nStations, StatusCode::SUCCESS);
+    tbb::this_task_arena::isolate([&]() {
+      tbb::parallel_for(0, nStations, [&](int stationIdx) {
+        stationStatus[stationIdx] = reconstructStation(*clusterContainer, stationIdx, stationTracks[stationIdx]);
+      });
+    });
+    for (StatusCode sc : stationStatus)
+    {
+      ATH_CHECK(sc);
+    }
+  }
+  else
+  {
+    for (int stationIdx = 0; stationIdx < nStations; stationIdx++)
+    {
+        ATH_CHECK(reconstructStation(*clusterContainer, stationIdx, stationTracks[stationIdx]));
+    }
+  }
+  for (TrackList& tracks : stationTracks)
   {
-      ATH_CHECK(reconstructStation(clusterContainer, stationIdx, outputTracks));
+    for (std::unique_ptr<Trk::Track>& track : tracks) outputTracks->push_back(std::move(track));
   }
 
   // Loop over stations
@@ -652,7 +685,7 @@ StatusCode SegmentFitAlg::finalize()
 
 // Method to create and store Trk::Track from fit results
 StatusCode 
-SegmentFitAlg::AddTrack(std::unique_ptr<TrackCollection>& tracks, 
+SegmentFitAlg::AddTrack(TrackList& tracks, 
                         const std::shared_ptr<fitInfo>& theFit) const
 {
     Trk::TrackInfo i { Trk::TrackInfo::TrackFitter::Unknown, Trk::ParticleHypothesis::muon };
@@ -661,11 +694,11 @@ SegmentFitAlg::AddTrack(std::unique_ptr<TrackCollection>& tracks,
     // DataVector<const Trk::TrackStateOnSurface>* s = new DataVector<const Trk::TrackStateOnSurface> {};
 
     // translate parameters to nominal fit point
-    s->push_back( GetState(theFit->fitParams, theFit->fitCovariance, nullptr) );
+    s->push_back( GetState(theFit->fitParams, theFit->fitCovariance, nullptr, theFit->zCenter) );
 
     for (int clusterIndex : theFit->candidates)
     {
-      s->push_back( GetState( theFit->fitParams, theFit->fitCovariance, &theFit->clusters[clusterIndex]->cluster) );
+      s->push_back( GetState( theFit->fitParams, theFit->fitCovariance, &theFit->clusters[clusterIndex]->cluster, theFit->zCenter) );
     }
 
     // for (const clusterInfo* cInfo : fitClusters)
@@ -675,27 +708,28 @@ SegmentFitAlg::AddTrack(std::unique_ptr<TrackCollection>& tracks,
 
     // Create and store track
     // std::unique_ptr<DataVector<const Trk::TrackStateOnSurface>> sink(s);
-    tracks->push_back(new Trk::Track(i, std::move(s) , std::move(q)));
+    tracks.push_back(std::make_unique<Trk::Track>(i, std::move(s) , std::move(q)));
     return StatusCode::SUCCESS;
 }
 
 Trk::TrackStateOnSurface*
 SegmentFitAlg::GetState( const Eigen::Matrix< double, 4, 1 >& fitResult, 
                          const Eigen::Matrix< double, 4, 4 >& fitCovariance,  
-                         const FaserSCT_Cluster* fitCluster) const
+                         const FaserSCT_Cluster* fitCluster,
+                         double zCenter) const
 {
     // position of fit point:
     // int station = m_idHelper->station(fitCluster->detectorElement()->identify());
-    double zFit = fitInfo::zCenter;
+    double zFit = zCenter;
     if (fitCluster != nullptr) zFit = fitCluster->globalPosition()[2];
-    Amg::Vector3D pos { fitResult[0] + fitResult[2] * (zFit - fitInfo::zCenter), fitResult[1] + fitResult[3] * (zFit - fitInfo::zCenter), zFit };
+    Amg::Vector3D pos { fitResult[0] + fitResult[2] * (zFit - zCenter), fitResult[1] + fitResult[3] * (zFit - zCenter), zFit };
     double phi = atan2( fitResult[3], fitResult[2] );
     double theta = atan( sqrt(fitResult[2]*fitResult[2] + fitResult[3]*fitResult[3]) );
     double qoverp = 1.0/100000.0;
 
     Eigen::Matrix< double, 4, 4 > jacobian = Eigen::Matrix< double, 4, 4 >::Zero();
-    jacobian << 1, 0, zFit - fitInfo::zCenter, 0, 
-                0, 1, 0, zFit - fitInfo::zCenter,
+    jacobian << 1, 0, zFit - zCenter, 0, 
+                0, 1, 0, zFit - zCenter,
                 0, 0, fitResult[3]/(fitResult[2]*fitResult[2]+fitResult[3]*fitResult[3]), 
                       fitResult[2]/(fitResult[2]*fitResult[2]+fitResult[3]*fitResult[3]),
                 0, 0, fitResult[2]/(sqrt(fitResult[2]*fitResult[2]+fitResult[3]*fitResult[3])*(1+fitResult[2]*fitResult[2]+fitResult[3]*fitResult[3])),
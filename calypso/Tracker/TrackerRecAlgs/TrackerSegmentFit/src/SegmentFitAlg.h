@@ -27,8 +27,10 @@
 #include "GaudiKernel/ToolHandle.h"
 
 //STL
+#include <cstdint>
 #include <map>
 #include <string>
+#include <vector>
 
 //Boost
 #include <boost/dynamic_bitset.hpp>
@@ -82,7 +84,7 @@ class SegmentFitAlg : public AthReentrantAlgorithm
     SegmentFitAlg &operator=(const SegmentFitAlg&) = delete;
     //@}
 
-    static constexpr size_t compatibilityMaxSize = 128; 
+    static constexpr size_t compatibilityMaxSize = 1024; 
 
     struct clusterInfo
     {
@@ -90,7 +92,6 @@ class SegmentFitAlg : public AthReentrantAlgorithm
         clusterInfo(uint theIndex, const FaserSCT_Cluster& theCluster, const FaserSCT_ID* idHelper)
         : index(theIndex)
         , cluster(theCluster)
-        , compatible(nClusters)
         {  
             const TrackerDD::SiDetectorElement* elem = cluster.detectorElement();
             if (elem == nullptr)
@@ -148,17 +149,14 @@ class SegmentFitAlg : public AthReentrantAlgorithm
             if (sinAlpha * cosAlpha < 0)
             {
                 view = -1;
-                compatible.set(index, true);
             }
             else if (sinAlpha * cosAlpha > 0)
             {
                 view = 1;
-                compatible.set(index, true);
             }
             else
             {
                 view = 0; // will be silently ignored
-                compatible.set(index, false);
             }
             yCenter = cluster.globalPosition().y();
             edge = false;
@@ -185,10 +183,8 @@ class SegmentFitAlg : public AthReentrantAlgorithm
         }
         // Data members
         static int nEdgeStrips;
-        static size_t nClusters; 
         uint index;
         const FaserSCT_Cluster& cluster;
-        ClusterSet compatible;
         double sinAlpha;
         double cosAlpha;
         double u;
@@ -207,14 +203,64 @@ class SegmentFitAlg : public AthReentrantAlgorithm
     };
     typedef std::vector<std::shared_ptr<clusterInfo> > ClusterList;
 
+    /// Symmetric compatibility of the clusters of a station, stored as one dense
+    /// bit matrix with a row of 64 bit words per cluster
+    struct CompatibilityMatrix
+    {
+        public:
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
+        CompatibilityMatrix(size_t n)
+        : size { n }
+        , words { (n + 63) / 64 }
+        , bits ( n * ((n + 63) / 64), 0 )
+        { }
+        void set(size_t i, size_t j)
+        {
+            bits[i * words + j / 64] |= uint64_t{1} << (j % 64);
+            bits[j * words + i / 64] |= uint64_t{1} << (i % 64);
+        }
+        bool test(size_t i, size_t j) const
+        {
+            return (bits[i * words + j / 64] >> (j % 64)) & 1;
+        }
+        const uint64_t* row(size_t i) const { return bits.data() + i * words; }
+        size_t count(size_t i) const
+        {
+            size_t n = 0;
+            for (size_t w = 0; w < words; w++) n += __builtin_popcountll(row(i)[w]);
+            return n;
+        }
+        // index of the first bit set in row at or after first, npos if there is none
+        size_t next(const uint64_t* row, size_t first) const
+        {
+            size_t w = first / 64;
+            if (w >= words) return npos;
+            uint64_t word = row[w] & (~uint64_t{0} << (first % 64));
+            while (word == 0)
+            {
+                if (++w == words) return npos;
+                word = row[w];
+            }
+            return w * 64 + __builtin_ctzll(word);
+        }
+        size_t size;
+        size_t words;
+        std::vector<uint64_t> bits;
+    };
+
     struct fitInfo
     {
         public:
         fitInfo(const ClusterList& theClusters, 
+                const CompatibilityMatrix& theCompatibility,
+                double theZCenter,
                 std::vector<size_t> theCandidates)
         : clusters { theClusters }
-        , clusterMask { clusterInfo::nClusters }
-        , compatibleMask { clusterInfo::nClusters }
+        , compatibility { theCompatibility }
+        , clusterMask { theClusters.size() }
+        , compatibleMask { theClusters.size() }
+        , zCenter { theZCenter }
         , fitChi2 { 0 }
         , hasCovariance { false }
         { 
@@ -244,7 +290,10 @@ class SegmentFitAlg : public AthReentrantAlgorithm
         {
             candidates.push_back(n);
             clusterMask.set(n);
-            compatibleMask &= clusters[n]->compatible;
+            for (size_t i = compatibleMask.find_first(); i != ClusterSet::npos; i = compatibleMask.find_next(i))
+            {
+                if (!compatibility.test(n, i)) compatibleMask.reset(i);
+            }
             compatibleMask.set(n, false);
             double sinA = clusters[n]->sinAlpha;
             double cosA = clusters[n]->cosAlpha;
@@ -274,16 +323,39 @@ class SegmentFitAlg : public AthReentrantAlgorithm
                 hasCovariance = false;
             }            
         }
+        // Add cluster n and update the existing fit with it (rank-one update of
+        // the covariance), which is equivalent to refitting all clusters up to
+        // floating-point rounding
+        void extendFit(size_t n)
+        {
+            Eigen::Matrix<double, 4, 1> params = fitParams;
+            Eigen::Matrix<double, 4, 4> covariance = fitCovariance;
+            double chi2 = fitChi2;
+            addCluster(n);
+            double sinA = clusters[n]->sinAlpha;
+            double cosA = clusters[n]->cosAlpha;
+            double    z = clusters[n]->z - zCenter;
+            Eigen::Matrix<double, 4, 1> a;
+            a << sinA, cosA, z * sinA, z * cosA;
+            Eigen::Matrix<double, 4, 1> ca = covariance * a;
+            double denominator = clusters[n]->sigmaSq + a.dot(ca);
+            double residual = clusters[n]->u - a.dot(params);
+            fitParams = params + ca * (residual / denominator);
+            fitCovariance = covariance - ca * ca.transpose() / denominator;
+            fitChi2 = chi2 + residual * residual / denominator;
+            hasCovariance = true;
+        }
         HepGeom::Point3D<double> extrapolateFit(double z) const
         {
             return HepGeom::Point3D<double> { fitParams(0) + fitParams(2) * (z - zCenter), fitParams(1) + fitParams(3) * (z - zCenter), z };
         }
         const ClusterList& clusters;
+        const CompatibilityMatrix& compatibility;
         std::vector<size_t> candidates;
         ClusterSet clusterMask;
         ClusterSet compatibleMask;
         double sums[15];
-        static double zCenter;
+        double zCenter;
         Eigen::Matrix<double, 4, 1> fitParams;
         Eigen::Matrix<double, 4, 4> fitCovariance;
         double                      fitChi2;
@@ -296,12 +368,13 @@ class SegmentFitAlg : public AthReentrantAlgorithm
     typedef std::unordered_set<ClusterSet> MaskSet;
     
     typedef SG::ReadHandle<FaserSCT_ClusterContainer> ClusterContainerHandle;
-    StatusCode reconstructStation(ClusterContainerHandle clusters, int index, std::unique_ptr<TrackCollection>& tracks) const;
-    size_t stationOccupancy(ClusterContainerHandle clusters, int station) const;
+    typedef std::vector<std::unique_ptr<Trk::Track> > TrackList;
+    StatusCode reconstructStation(const FaserSCT_ClusterContainer& clusters, int index, TrackList& tracks) const;
+    size_t stationOccupancy(const FaserSCT_ClusterContainer& clusters, int station) const;
     double findCenter(int station) const;
-    ClusterList tabulateClusters(ClusterContainerHandle clusters, int station) const;
-    void checkCompatibility(ClusterList& clusters) const;
-    FitList enumerateSeeds(const ClusterList& clusters) const;
+    ClusterList tabulateClusters(const FaserSCT_ClusterContainer& clusters, int station) const;
+    void checkCompatibility(const ClusterList& clusters, CompatibilityMatrix& compatibility) const;
+    FitList enumerateSeeds(const ClusterList& clusters, const CompatibilityMatrix& compatibility, double zCenter) const;
     void findGoodSeeds(FitList& allSeeds, FitMap& goodSeeds, MaskSet& badSeeds) const;
     void fitClusters(fitInfo& fit) const;
     bool checkFit(const fitInfo& fit) const;
@@ -389,12 +462,13 @@ class SegmentFitAlg : public AthReentrantAlgorithm
     //      }         
     // };
 
-    StatusCode AddTrack(std::unique_ptr<TrackCollection>& tracks, 
+    StatusCode AddTrack(TrackList& tracks, 
                         const std::shared_ptr<fitInfo>& theFit) const;
 
     Trk::TrackStateOnSurface* GetState( const Eigen::Matrix< double, 4, 1 >& fitResult, 
                                         const Eigen::Matrix< double, 4, 4 >& fitCovariance,  
-                                        const FaserSCT_Cluster* fitCluster ) const; 
+                                        const FaserSCT_Cluster* fitCluster,
+                                        double zCenter ) const; 
 
     // void
     // Residuals(std::vector<const clusterInfo*>& fitClusters) const;
@@ -417,6 +491,7 @@ class SegmentFitAlg : public AthReentrantAlgorithm
     DoubleProperty m_reducedChi2Cut { this, "ReducedChi2Cut", 10.0, "Maximum accepted chi^2 per degree of freedom for final fits; 0 means no cut." };
     DoubleProperty m_sharedHitFraction { this, "SharedHitFraction", -1., "Fraction of hits which are allowed to be shared between two fits." };
     UnsignedIntegerProperty m_minClustersPerFit { this, "MinClustersPerFit", 4, "Minimum number of clusters a fit has to have." };
+    BooleanProperty m_parallelStations { this, "ParallelStations", false, "Reconstruct the stations of an event as parallel TBB tasks" };
 
     mutable std::atomic<int> m_numberOfEvents{0};
     mutable std::atomic<int> m_numberExcessOccupancy{0};
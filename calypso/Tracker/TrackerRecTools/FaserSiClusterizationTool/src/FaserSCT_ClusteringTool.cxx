@@ -23,10 +23,13 @@
 #include "TrackerIdentifier/FaserSCT_ID.h"
 
 #include "FaserSCT_ReClustering.h"
+#include "StripBitmap.h"
 
 #include "GeoPrimitives/GeoPrimitives.h"
 
 #include <algorithm>
+#include <array>
+#include <cstdint>
 
 namespace Tracker
 {
@@ -136,6 +139,10 @@ namespace Tracker
       m_lorentzAngleTool.disable();
     }
 
+    if (m_doBitmapClustering and m_useRowInformation) {
+      ATH_MSG_WARNING("Bitmap clustering does not use row information, the standard clustering will be used");
+    }
+
     if (decodeTimeBins().isFailure()) return StatusCode::FAILURE;
 
     if (!m_timeBinStr.empty()) 
@@ -148,10 +155,23 @@ namespace Tracker
     }
 
     ATH_CHECK(m_SCTDetEleCollKey.initialize());
+    ATH_CHECK(m_stripStatusKey.initialize(m_checkBadChannels and not m_stripStatusKey.empty()));
 
     return StatusCode::SUCCESS;
   }
 
+  bool FaserSCT_ClusteringTool::getStripStatus(const FaserSCT_StripStatusCondData*& stripStatus) const {
+    stripStatus = nullptr;
+    if (not m_checkBadChannels or m_stripStatusKey.empty() or m_useRowInformation) return true;
+    SG::ReadCondHandle<FaserSCT_StripStatusCondData> stripStatusHandle(m_stripStatusKey);
+    stripStatus = *stripStatusHandle;
+    if (stripStatus == nullptr) {
+      ATH_MSG_FATAL(m_stripStatusKey.fullKey() << " is not available.");
+      return false;
+    }
+    return true;
+  }
+
   Tracker::FaserSCT_ClusterCollection* FaserSCT_ClusteringTool::clusterize(const TrackerRawDataCollection<FaserSCT_RDORawData>& collection,
                                                         const FaserSCT_ID& idHelper,
                                                         const FaserSCT_ChannelStatusAlg* /*status */,
@@ -180,18 +200,20 @@ namespace Tracker
    * What if its good and contiguous, but there are also some bad?
    **/
   void FaserSCT_ClusteringTool::addStripsToClusterWithChecks(const Identifier& firstStripId, unsigned int nStrips, std::vector<Identifier>& clusterVector,
-                                                        std::vector<std::vector<Identifier> >& idGroups, const FaserSCT_ID& idHelper) const{
+                                                        std::vector<std::vector<Identifier> >& idGroups, const FaserSCT_ID& idHelper,
+                                                        const FaserSCT_StripStatusCondData* stripStatus) const{
 
     const unsigned int firstStripNumber(idHelper.strip(firstStripId));
     const unsigned int endStripNumber(firstStripNumber + nStrips); // one-past-the-end
     const Identifier   waferId(idHelper.wafer_id(firstStripId));
+    const IdentifierHash waferHash(stripStatus ? idHelper.wafer_hash(waferId) : IdentifierHash());
     clusterVector.reserve(clusterVector.size() + nStrips);
 
     static const Identifier badId;
     unsigned int nBadStrips(0);
     for (unsigned int stripNumber(firstStripNumber); stripNumber not_eq endStripNumber; ++stripNumber) {
       Identifier stripId(idHelper.strip_id(waferId, stripNumber));
-      if (isBad(stripId)) {
+      if (stripStatus ? stripStatus->isBadStrip(waferHash, stripNumber) : isBad(stripId)) {
         ++nBadStrips;
         stripId = badId;
       }
@@ -285,6 +307,7 @@ namespace Tracker
     ATH_MSG_VERBOSE ("FaserSCT_ClusteringTool::clusterize()");
 
     if (m_doNewClustering) return clusterizeNew(collection, idHelper);
+    if (m_doBitmapClustering and not m_useRowInformation) return clusterizeBitmap(collection, idHelper);
 
     Tracker::FaserSCT_ClusterCollection* nullResult(nullptr);
     if (collection.empty()) {
@@ -292,6 +315,9 @@ namespace Tracker
       return nullResult;
     }
 
+    const FaserSCT_StripStatusCondData* stripStatus(nullptr);
+    if (not getStripStatus(stripStatus)) return nullResult;
+
     // Make a copy of the collection for sorting (no need to sort if theres only one RDO)
     std::vector<const FaserSCT_RDORawData*> collectionCopy(collection.begin(), collection.end());
     if (collection.size() not_eq 1) std::sort(collectionCopy.begin(), collectionCopy.end(), strip_less_than());
@@ -355,7 +381,7 @@ namespace Tracker
         } else if (not m_checkBadChannels) {
           addStripsToCluster(firstStripId, nStrips, currentVector, idHelper); // Note this takes the current vector only
         } else {
-          addStripsToClusterWithChecks(firstStripId, nStrips, currentVector, idGroups, idHelper); // This one includes the groups of vectors as well
+          addStripsToClusterWithChecks(firstStripId, nStrips, currentVector, idGroups, idHelper, stripStatus); // This one includes the groups of vectors as well
         }
         for (unsigned int iStrip=0; iStrip<nStrips; iStrip++) {
           if (stripCount < 16) hitsInThirdTimeBin |= (timePattern.test(0) << stripCount);
@@ -454,6 +480,9 @@ namespace Tracker
   {
     if (collection.empty()) return nullptr;
 
+    const FaserSCT_StripStatusCondData* stripStatus(nullptr);
+    if (not getStripStatus(stripStatus)) return nullptr;
+
     std::vector<const FaserSCT_RDORawData*> collectionCopy(collection.begin(), collection.end());
 
     if (collectionCopy.size() > 1) std::sort(collectionCopy.begin(), collectionCopy.end(), strip_less_than());
@@ -520,9 +549,10 @@ namespace Tracker
       //
       if (passTiming) {
         unsigned int nBadStrips(0);
+        const IdentifierHash waferHash(stripStatus ? idHelper.wafer_hash(waferId) : IdentifierHash());
         for (unsigned int sn=thisStrip; sn!=thisStrip+nStrips; ++sn) {
           Identifier stripId = m_useRowInformation ? idHelper.strip_id(waferId,thisRow,sn) : idHelper.strip_id(waferId,sn);
-         if (m_conditionsTool->isGood(stripId, InDetConditions::SCT_STRIP)) {
+         if (stripStatus ? not stripStatus->isBadStrip(waferHash, sn) : m_conditionsTool->isGood(stripId, InDetConditions::SCT_STRIP)) {
             currentVector.push_back(stripId);
          } else {
            currentVector.push_back(badId);
@@ -690,6 +720,119 @@ namespace Tracker
     return clusterCollection;
   }
 
+  /**
+   * Same clusters as clusterize(), built from a bitmap of the hit strips of the wafer side.
+   * The RDOs need not be sorted, clusters are the runs of hit strips after removing bad strips.
+   **/
+  Tracker::FaserSCT_ClusterCollection* FaserSCT_ClusteringTool::clusterizeBitmap(const TrackerRawDataCollection<FaserSCT_RDORawData>& collection,
+                                                               const FaserSCT_ID& idHelper) const
+  {
+    if (collection.empty()) {
+      ATH_MSG_DEBUG("Empty RDO collection");
+      return nullptr;
+    }
+
+    const FaserSCT_StripStatusCondData* stripStatus(nullptr);
+    if (not getStripStatus(stripStatus)) return nullptr;
+
+    const Identifier elementID(collection.identify());
+    const Identifier waferId{idHelper.wafer_id(elementID)};
+    const IdentifierHash waferHash{idHelper.wafer_hash(waferId)};
+
+    // Strips passing the timing requirement, and those of them with a hit in the third time bin
+    StripBitmap hitStrips{};
+    StripBitmap thirdTimeBin{};
+    for (const FaserSCT_RDORawData* pRawData: collection) {
+      const FaserSCT3_RawData* pRawData3(dynamic_cast<const FaserSCT3_RawData*>(pRawData));
+      if (!pRawData3) {
+        ATH_MSG_ERROR("Casting into FaserSCT3_RawData failed. This is probably caused by use of an old RDO file.");
+        return nullptr;
+      }
+      const int timeBin(pRawData3->getTimeBin());
+      if (not m_timeBinStr.empty() and not testTimeBins(timeBin)) continue;
+
+      const unsigned int firstStrip(idHelper.strip(pRawData->identify()));
+      unsigned int endStrip(firstStrip + pRawData->getGroupSize());
+      if (endStrip > nBitmapStrips) {
+        ATH_MSG_WARNING("Strips " << firstStrip << " to " << endStrip-1 << " beyond the strip bitmap, ignoring strips from " << nBitmapStrips);
+        endStrip = nBitmapStrips;
+      }
+      setStrips(hitStrips, firstStrip, endStrip);
+      if (timeBin & 0x1) setStrips(thirdTimeBin, firstStrip, endStrip);
+    }
+
+    // Remove bad strips, which splits the clusters containing them
+    bool removedBadStrips(false);
+    if (m_checkBadChannels) {
+      for (unsigned int word(0); word < nStripWords; ++word) {
+        uint64_t badStrips(0);
+        if (stripStatus) {
+          badStrips = hitStrips[word] & stripStatus->badStripWord(waferHash, word);
+        } else {
+          for (uint64_t bits(hitStrips[word]); bits != 0; bits &= bits - 1) {
+            const unsigned int bit(__builtin_ctzll(bits));
+            if (isBad(idHelper.strip_id(waferId, 64*word + bit))) badStrips |= uint64_t{1} << bit;
+          }
+        }
+        if (badStrips != 0) {
+          hitStrips[word] &= ~badStrips;
+          removedBadStrips = true;
+        }
+      }
+    }
+
+    // Find detector element for these digits
+    SG::ReadCondHandle<TrackerDD::SiDetectorElementCollection> sctDetEleHandle(m_SCTDetEleCollKey);
+    const TrackerDD::SiDetectorElementCollection* sctDetEle(*sctDetEleHandle);
+    if (not sctDetEleHandle.isValid() or sctDetEle==nullptr) {
+      ATH_MSG_FATAL(m_SCTDetEleCollKey.fullKey() << " is not available.");
+      return nullptr;
+    }
+    const TrackerDD::SiDetectorElement* element(sctDetEle->getDetectorElement(waferHash));
+    if (!element) {
+      ATH_MSG_WARNING("Element not in the element map, ID = "<< elementID);
+      return nullptr;
+    }
+    const TrackerDD::SCT_ModuleSideDesign* design(static_cast<const TrackerDD::SCT_ModuleSideDesign*>(&element->design()));
+
+    IdentifierHash idHash(collection.identifyHash());
+    Tracker::FaserSCT_ClusterCollection* clusterCollection = new Tracker::FaserSCT_ClusterCollection(idHash);
+    clusterCollection->setIdentifier(elementID);
+    clusterCollection->reserve(collection.size());
+
+    for (unsigned int firstStrip(findStrip(hitStrips, 0, true)); firstStrip < nBitmapStrips;
+         firstStrip = findStrip(hitStrips, firstStrip, true)) {
+      const unsigned int endStrip(findStrip(hitStrips, firstStrip, false));
+      const unsigned int nStrips(endStrip - firstStrip);
+
+      IdVec_t rdoList;
+      rdoList.reserve(nStrips);
+      for (unsigned int stripNumber(firstStrip); stripNumber != endStrip; ++stripNumber) {
+        rdoList.push_back(idHelper.strip_id(waferId, stripNumber));
+      }
+      // Since clusterId is arbitary (it only needs to be unique) just use ID of first strip
+      const Identifier clusterId(rdoList.front());
+
+      const DimensionAndPosition clusterDim(clusterDimensions(firstStrip, endStrip-1, element, idHelper));
+      const Amg::Vector2D localPos(clusterDim.centre.xPhi(), clusterDim.centre.xEta());
+      // Find length of strip at centre
+      const std::pair<TrackerDD::SiLocalPosition, TrackerDD::SiLocalPosition> ends(design->endsOfStrip(clusterDim.centre));
+      const double stripLength(fabs(ends.first.xEta()-ends.second.xEta()));
+      const Tracker::FaserSiWidth siWidth(Amg::Vector2D(nStrips, 1), Amg::Vector2D(clusterDim.width, stripLength));
+
+      Tracker::FaserSCT_Cluster* cluster = (m_clusterMaker) ? (m_clusterMaker->sctCluster(clusterId, localPos, std::move(rdoList), siWidth, element, m_errorStrategy))
+        : (new Tracker::FaserSCT_Cluster(clusterId, localPos, std::move(rdoList), siWidth, element, Amg::MatrixX()));
+      cluster->setHashAndIndex(clusterCollection->identifyHash(), clusterCollection->size());
+      // As in clusterize(), the word is not recalculated when bad strips were removed
+      cluster->setHitsInThirdTimeBin(removedBadStrips ? 0 : stripWord(thirdTimeBin, firstStrip, nStrips));
+
+      clusterCollection->push_back(cluster);
+      firstStrip = endStrip;
+    }
+
+    return clusterCollection;
+  }
+
   FaserSCT_ClusteringTool::DimensionAndPosition 
   FaserSCT_ClusteringTool::clusterDimensions(int firstStrip, int lastStrip,
                                         const TrackerDD::SiDetectorElement* pElement,
@@ -14,6 +14,7 @@
 #include "Identifier/Identifier.h"
 //#include "FaserSCT_ConditionsTools/ISCT_DCSConditionsTool.h"
 #include "FaserSCT_ConditionsTools/ISCT_ConditionsSummaryTool.h"
+#include "FaserSCT_ConditionsData/FaserSCT_StripStatusCondData.h"
 #include "InDetCondTools/ISiLorentzAngleTool.h"
 #include "TrackerReadoutGeometry/SiDetectorElementCollection.h"
 #include "FaserSiClusterizationTool/IFaserSCT_ClusteringTool.h"
@@ -65,6 +66,11 @@ namespace Tracker
           clusterizeNew(const TrackerRawDataCollection<FaserSCT_RDORawData>& RDOs,
         const FaserSCT_ID& idHelper) const;
 
+        /// Clusterize the SCT RDOs... from a bitmap of the hit strips, without rows
+        virtual Tracker::FaserSCT_ClusterCollection*
+          clusterizeBitmap(const TrackerRawDataCollection<FaserSCT_RDORawData>& RDOs,
+        const FaserSCT_ID& idHelper) const;
+
       private:
         IntegerProperty m_errorStrategy{this, "errorStrategy", 1};
         BooleanProperty m_checkBadChannels{this, "checkBadChannels", false};
@@ -83,8 +89,10 @@ namespace Tracker
         // BooleanProperty m_majority01X{this, "majority01X", false};
         BooleanProperty m_useRowInformation{this, "useRowInformation", false};
         BooleanProperty m_doNewClustering{this, "doNewClustering", false};
+        BooleanProperty m_doBitmapClustering{this, "doBitmapClustering", false};
 
         SG::ReadCondHandleKey<TrackerDD::SiDetectorElementCollection> m_SCTDetEleCollKey{this, "SCTDetEleCollKey", "SCT_DetectorElementCollection", "Key of SiDetectorElementCollection for SCT"};
+        SG::ReadCondHandleKey<FaserSCT_StripStatusCondData> m_stripStatusKey{this, "StripStatusKey", "", "Bad strip bitmap used instead of the conditions tool if set"};
 
 
         ///Add strips to a cluster vector without checking for bad strips
@@ -92,7 +100,7 @@ namespace Tracker
 
         ///Add strips to a cluster vector checking for bad strips
         void addStripsToClusterWithChecks(const Identifier& firstStripId, unsigned int nStrips, IdVec_t& clusterVector,
-          std::vector<IdVec_t>& idGroups, const FaserSCT_ID& idHelper) const;
+          std::vector<IdVec_t>& idGroups, const FaserSCT_ID& idHelper, const FaserSCT_StripStatusCondData* stripStatus) const;
 
         void addStripsToClusterInclRows(const Identifier& firstStripId, unsigned int nStrips, IdVec_t& clusterVector, std::vector<IdVec_t>& idGroups, const FaserSCT_ID& idHelper) const;
 
@@ -117,6 +125,10 @@ namespace Tracker
         /// In-class facade on the 'isGood' method for a strip identifier
         bool isBad(const Identifier& stripId) const;
 
+        /// Bad strip bitmap of the current event, nullptr if the conditions tool is to be used
+        /// (also with row information, the bitmap being indexed by strip number only)
+        bool getStripStatus(const FaserSCT_StripStatusCondData*& stripStatus) const;
+
         // Convert time bin string to array of 3 bits
         StatusCode decodeTimeBins();
         // Convert a single time bin char to an int, bit is modified
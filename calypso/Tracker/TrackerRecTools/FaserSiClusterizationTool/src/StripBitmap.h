@@ -0,0 +1,59 @@
+/*
+  Copyright (C) 2022 CERN for the benefit of the FASER collaboration
+*/
+
+/**
+ * @file StripBitmap.h
+ * Strip bitmap of one wafer side, used by the bitmap mode of FaserSCT_ClusteringTool
+ */
+
+#ifndef FaserSiClusterizationTool_StripBitmap_H
+#define FaserSiClusterizationTool_StripBitmap_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+namespace Tracker
+{
+  // One bit per strip of a wafer side (768 strips) for the bitmap clustering
+  constexpr unsigned int nStripWords = 12;
+  constexpr unsigned int nBitmapStrips = 64*nStripWords;
+  typedef std::array<uint64_t, nStripWords> StripBitmap;
+
+  // Set the bits of strips [first, end)
+  inline void setStrips(StripBitmap& bitmap, unsigned int first, unsigned int end) {
+    while (first < end) {
+      const unsigned int word = first/64;
+      const unsigned int wordEnd = std::min(end, 64*(word+1));
+      const unsigned int nBits = wordEnd - first;
+      const uint64_t bits = (nBits == 64) ? ~uint64_t{0} : ((uint64_t{1} << nBits) - 1);
+      bitmap[word] |= bits << (first%64);
+      first = wordEnd;
+    }
+  }
+
+  // First strip at or after the given one which is hit (or not hit), nBitmapStrips if none
+  inline unsigned int findStrip(const StripBitmap& bitmap, unsigned int strip, bool hit) {
+    unsigned int word = strip/64;
+    if (word >= nStripWords) return nBitmapStrips;
+    uint64_t bits = (hit ? bitmap[word] : ~bitmap[word]) & (~uint64_t{0} << (strip%64));
+    while (bits == 0) {
+      if (++word == nStripWords) return nBitmapStrips;
+      bits = hit ? bitmap[word] : ~bitmap[word];
+    }
+    return 64*word + __builtin_ctzll(bits);
+  }
+
+  // Bits of up to 16 strips starting at the first one, as stored in hitsInThirdTimeBin
+  inline uint16_t stripWord(const StripBitmap& bitmap, unsigned int first, unsigned int nStrips) {
+    const unsigned int word = first/64;
+    const unsigned int shift = first%64;
+    uint64_t bits = bitmap[word] >> shift;
+    if (shift > 48 and word+1 < nStripWords) bits |= bitmap[word+1] << (64-shift);
+    const uint64_t mask = (nStrips >= 16) ? 0xFFFF : ((uint64_t{1} << nStrips) - 1);
+    return static_cast<uint16_t>(bits & mask);
+  }
+}
+
+#endif // FaserSiClusterizationTool_StripBitmap_H
@@ -88,6 +88,28 @@ Tracker::FaserSCT_Cluster* TrackerClusterMakerTool::sctCluster(
 //                                        localPos[Trk::locX)+shift,0);
         Amg::Vector2D locpos(localPos[Trk::locX]+shift, localPos[Trk::locY]);
 
+	Tracker::FaserSCT_Cluster* newCluster = new Tracker::FaserSCT_Cluster(clusterID, locpos, rdoList , width, element, sctErrorMatrix(width, errorStrategy));
+	return newCluster;
+
+}
+
+Tracker::FaserSCT_Cluster* TrackerClusterMakerTool::sctCluster(
+                         const Identifier& clusterID,
+			 const Amg::Vector2D& localPos,
+                         std::vector<Identifier>&& rdoList,
+                         const Tracker::FaserSiWidth& width,
+                         const TrackerDD::SiDetectorElement* element,
+                         int errorStrategy) const{
+
+	// No Lorentz shift, as above
+        Amg::Vector2D locpos(localPos[Trk::locX], localPos[Trk::locY]);
+
+	return new Tracker::FaserSCT_Cluster(clusterID, locpos, std::move(rdoList), width, element, sctErrorMatrix(width, errorStrategy));
+}
+
+Amg::MatrixX TrackerClusterMakerTool::sctErrorMatrix(const Tracker::FaserSiWidth& width,
+                                                     int errorStrategy) const{
+
 	// error matrix
 	const Amg::Vector2D& colRow = width.colRow();// made ref to avoid 
 	// unnecessary copy EJWM
@@ -137,8 +159,7 @@ Tracker::FaserSCT_Cluster* TrackerClusterMakerTool::sctCluster(
 
 	//        delete localPos;
 	//	localPos=0;
-	Tracker::FaserSCT_Cluster* newCluster = new Tracker::FaserSCT_Cluster(clusterID, locpos, rdoList , width, element, errorMatrix);
-	return newCluster;
+	return errorMatrix;
 
 }
 
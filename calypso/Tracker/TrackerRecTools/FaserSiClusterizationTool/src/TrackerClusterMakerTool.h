@@ -21,6 +21,7 @@
 #include "AthenaBaseComps/AthAlgTool.h"
 
 #include "GeoPrimitives/GeoPrimitives.h"
+#include "EventPrimitives/EventPrimitives.h"
 #include "InDetCondTools/ISiLorentzAngleTool.h"
 
 #include "StoreGate/ReadCondHandleKey.h"
@@ -82,9 +83,20 @@ namespace Tracker
                           const Tracker::FaserSiWidth& width,
                           const TrackerDD::SiDetectorElement* element,
                           int errorStrategy) const;
+
+    // Same, moving the list of RDO identifiers into the cluster
+    Tracker::FaserSCT_Cluster* sctCluster(const Identifier& clusterID,
+                          const Amg::Vector2D& localPos,
+                          std::vector<Identifier>&& rdoList,
+                          const Tracker::FaserSiWidth& width,
+                          const TrackerDD::SiDetectorElement* element,
+                          int errorStrategy) const;
   
   private:
 
+    // Local position error matrix of an SCT cluster for the given error strategy
+    Amg::MatrixX sctErrorMatrix(const Tracker::FaserSiWidth& width, int errorStrategy) const;
+
 
 
   //  ToolHandle<FaserSiLorentzAngleTool> m_sctLorentzAngleTool
@@ -0,0 +1,112 @@
+/*
+  Copyright (C) 2022 CERN for the benefit of the FASER collaboration
+*/
+
+/** @file StripBitmap_test.cxx
+    Unit test of the strip bitmap used by the bitmap clustering of FaserSCT_ClusteringTool
+*/
+
+#undef NDEBUG
+#include "StripBitmap.h"
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+
+using namespace Tracker;
+
+namespace {
+
+  void testSetStrips() {
+    std::cout << "testSetStrips\n";
+    StripBitmap bitmap{};
+    setStrips(bitmap, 63, 65);
+    assert(bitmap[0] == uint64_t{1} << 63);
+    assert(bitmap[1] == 1);
+
+    // a full word
+    StripBitmap full{};
+    setStrips(full, 64, 128);
+    assert(full[0] == 0);
+    assert(full[1] == ~uint64_t{0});
+    assert(full[2] == 0);
+
+    // the last strip, and an empty range
+    StripBitmap last{};
+    setStrips(last, 767, 768);
+    setStrips(last, 10, 10);
+    assert(last[0] == 0);
+    assert(last[11] == uint64_t{1} << 63);
+
+    // all strips
+    StripBitmap all{};
+    setStrips(all, 0, nBitmapStrips);
+    for (uint64_t word : all) assert(word == ~uint64_t{0});
+  }
+
+  void testFindStrip() {
+    std::cout << "testFindStrip\n";
+    StripBitmap bitmap{};
+    assert(findStrip(bitmap, 0, true) == nBitmapStrips);
+    assert(findStrip(bitmap, 0, false) == 0);
+
+    setStrips(bitmap, 63, 65);
+    setStrips(bitmap, 767, 768);
+    assert(findStrip(bitmap, 0, true) == 63);
+    assert(findStrip(bitmap, 63, true) == 63);
+    assert(findStrip(bitmap, 64, true) == 64);
+    assert(findStrip(bitmap, 63, false) == 65);
+    assert(findStrip(bitmap, 65, true) == 767);
+    assert(findStrip(bitmap, 767, true) == 767);
+    // nothing after the last strip
+    assert(findStrip(bitmap, 767, false) == nBitmapStrips);
+    assert(findStrip(bitmap, nBitmapStrips, true) == nBitmapStrips);
+
+    // runs of hit strips as the clustering scans them
+    StripBitmap runs{};
+    setStrips(runs, 60, 70);
+    setStrips(runs, 128, 192);
+    unsigned int nRuns = 0;
+    unsigned int expected[2][2] = {{60, 70}, {128, 192}};
+    for (unsigned int first = findStrip(runs, 0, true); first < nBitmapStrips; first = findStrip(runs, first, true)) {
+      const unsigned int end = findStrip(runs, first, false);
+      assert(nRuns < 2);
+      assert(first == expected[nRuns][0] && end == expected[nRuns][1]);
+      ++nRuns;
+      first = end;
+    }
+    assert(nRuns == 2);
+  }
+
+  void testStripWord() {
+    std::cout << "testStripWord\n";
+    StripBitmap bitmap{};
+    setStrips(bitmap, 63, 65);
+    setStrips(bitmap, 767, 768);
+    assert(stripWord(bitmap, 63, 2) == 0x3);
+    assert(stripWord(bitmap, 62, 4) == 0x6);
+    assert(stripWord(bitmap, 64, 1) == 0x1);
+    // at most 16 strips, taken across the word boundary
+    assert(stripWord(bitmap, 50, 20) == 0x6000);
+    assert(stripWord(bitmap, 49, 20) == 0xC000);
+    assert(stripWord(bitmap, 48, 20) == 0x8000);
+    // the last word has no successor
+    assert(stripWord(bitmap, 767, 1) == 0x1);
+    assert(stripWord(bitmap, 760, 8) == 0x80);
+
+    StripBitmap all{};
+    setStrips(all, 0, nBitmapStrips);
+    assert(stripWord(all, 56, 16) == 0xFFFF);
+    assert(stripWord(all, 56, 5) == 0x1F);
+    assert(stripWord(all, 764, 4) == 0xF);
+  }
+
+}
+
+int main() {
+  std::cout << "StripBitmap_test\n";
+  testSetStrips();
+  testFindStrip();
+  testStripWord();
+  return 0;
+}
@@ -28,6 +28,7 @@
 #include <boost/variant/static_visitor.hpp>
 
 // STL
+#include <cmath>
 #include <iostream>
 #include <memory>
 
@@ -88,6 +89,9 @@ FaserActsExtrapolationTool::initialize()
     auto propagator = Acts::Propagator<decltype(stepper), Acts::Navigator>(std::move(stepper),
                                                                       std::move(navigator), Acts::getDefaultLogger("ExtrapolationTool", Acts::Logging::ERROR));
     m_varProp = std::make_unique<VariantPropagator>(propagator);
+    m_straightLineProp = std::make_unique<StraightLinePropagator>(Acts::StraightLineStepper(),
+                                                                  Acts::Navigator(Acts::Navigator::Config{ trackingGeometry }),
+                                                                  Acts::getDefaultLogger("ExtrapolationTool", Acts::Logging::ERROR));
   }
   else if (m_fieldMode == "Constant") {
     if (m_constantFieldVector.value().size() != 3)
@@ -341,7 +345,7 @@ FaserActsExtrapolationTool::propagate(const EventContext& ctx,
   mInteractor.energyLoss = m_interactionEloss;
   mInteractor.recordInteractions = m_interactionRecord;
 
-  auto parameters = boost::apply_visitor([&](const auto& propagator) -> std::optional<const Acts::BoundTrackParameters> {
+  auto propagateToTarget = [&](const auto& propagator) -> std::optional<const Acts::BoundTrackParameters> {
       auto result = propagator.propagate(startParameters, target, options);
       if (!result.ok()) {
         ATH_MSG_ERROR("Got error during propagation: " << result.error()
@@ -349,11 +353,97 @@ FaserActsExtrapolationTool::propagate(const EventContext& ctx,
         return std::nullopt; 
       }
       return result.value().endParameters;
-    }, *m_varProp);
+    };
+
+  if (fieldFree(mctx, startParameters.position(anygctx), startParameters.momentum(), target.center(anygctx).z())) {
+    return propagateToTarget(*m_straightLineProp);
+  }
+  return boost::apply_visitor(propagateToTarget, *m_varProp);
+}
+
+std::vector<std::optional<Acts::BoundTrackParameters>>
+FaserActsExtrapolationTool::propagateToSurfaces(const EventContext& ctx,
+                                           const Acts::BoundTrackParameters& startParameters,
+                                           const std::vector<const Acts::Surface*>& targets,
+                                           Acts::Direction navDir /*= Acts::forward*/,
+                                           double pathLimit /*= std::numeric_limits<double>::max()*/) const
+{
+  using namespace Acts::UnitLiterals;
+  ATH_MSG_VERBOSE(name() << "::" << __FUNCTION__ << " begin");
+
+  Acts::MagneticFieldContext mctx = getMagneticFieldContext(ctx);
+  const FaserActsGeometryContext& gctx = m_trackingGeometryTool->getGeometryContext(ctx);
+
+  auto anygctx = gctx.context();
+
+  // Action list and abort list
+  using ActionList = Acts::ActionList<Acts::MaterialInteractor>;
+  using AbortConditions = Acts::AbortList<EndOfWorld>;
+  using Options = Acts::PropagatorOptions<ActionList, AbortConditions>;
+
+  Options options(anygctx, mctx);
+
+  options.loopProtection
+    = (Acts::VectorHelpers::perp(startParameters.momentum())
+       < m_ptLoopers * 1_MeV);
+  options.maxStepSize = m_maxStepSize * 1_m;
+  options.maxSteps = m_maxStep;
+  options.direction = navDir;
+
+  auto& mInteractor = options.actionList.get<Acts::MaterialInteractor>();
+  mInteractor.multipleScattering = m_interactionMultiScatering;
+  mInteractor.energyLoss = m_interactionEloss;
+  mInteractor.recordInteractions = m_interactionRecord;
+
+  // Each leg continues from the last surface that was reached, so the field and
+  // material between the start and the last target are stepped through once.
+  std::vector<std::optional<Acts::BoundTrackParameters>> parameters;
+  parameters.reserve(targets.size());
+  std::optional<Acts::BoundTrackParameters> current {startParameters};
+  double pathLength = 0;
+  for (const Acts::Surface* target : targets) {
+    options.pathLimit = pathLimit - pathLength;
+    auto propagateToTarget = [&](const auto& propagator) -> std::optional<Acts::BoundTrackParameters> {
+        auto result = propagator.propagate(*current, *target, options);
+        if (!result.ok()) {
+          ATH_MSG_ERROR("Got error during propagation: " << result.error()
+          << ". Returning empty parameters.");
+          return std::nullopt;
+        }
+        pathLength += std::abs(result.value().pathLength);
+        return result.value().endParameters;
+      };
+    auto targetParameters = fieldFree(mctx, current->position(anygctx), current->momentum(), target->center(anygctx).z())
+                            ? propagateToTarget(*m_straightLineProp)
+                            : boost::apply_visitor(propagateToTarget, *m_varProp);
+    if (targetParameters) current.emplace(*targetParameters);
+    parameters.push_back(std::move(targetParameters));
+  }
+
+  ATH_MSG_VERBOSE(name() << "::" << __FUNCTION__ << " end");
 
   return parameters;
 }
 
+bool
+FaserActsExtrapolationTool::fieldFree(const Acts::MagneticFieldContext& mctx,
+                                      const Acts::Vector3& startPosition,
+                                      const Acts::Vector3& startMomentum,
+                                      double z) const
+{
+  // only the FASER field is classified, and only inside the aperture
+  if (!m_straightLineProp) return false;
+  const MagField::FaserFieldRegions* regions = mctx.get<const FaserFieldCacheCondObj*>()->fieldRegions();
+  if (regions == nullptr) return false;
+  if (Acts::VectorHelpers::perp(startPosition) > regions->radius()) return false;
+  // the straight line has to reach z without leaving the aperture, checking
+  // its end is enough as the aperture is a cylinder
+  if (startMomentum.z() == 0) return false;
+  const Acts::Vector3 endPosition = startPosition + startMomentum * ((z - startPosition.z()) / startMomentum.z());
+  if (Acts::VectorHelpers::perp(endPosition) > regions->radius()) return false;
+  return regions->fieldFree(startPosition.z(), z);
+}
+
 Acts::MagneticFieldContext FaserActsExtrapolationTool::getMagneticFieldContext(const EventContext& ctx) const {
   SG::ReadCondHandle<FaserFieldCacheCondObj> readHandle{m_fieldCondObjInputKey, ctx};
   if (!readHandle.isValid()) {
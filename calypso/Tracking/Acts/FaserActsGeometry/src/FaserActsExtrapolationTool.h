@@ -31,6 +31,7 @@
 // ACTS
 #include "Acts/Propagator/detail/SteppingLogger.hpp"
 #include "Acts/Propagator/Navigator.hpp"
+#include "Acts/Propagator/StraightLineStepper.hpp"
 #include "Acts/Propagator/StandardAborters.hpp"
 #include "Acts/Propagator/SurfaceCollector.hpp"
 #include "Acts/MagneticField/ConstantBField.hpp"
@@ -68,6 +69,7 @@ private:
   using SteppingLogger = Acts::detail::SteppingLogger;
   using EndOfWorld = Acts::EndOfWorldReached;
   using ResultType = Acts::Result<ActsPropagationOutput>;
+  using StraightLinePropagator = Acts::Propagator<Acts::StraightLineStepper, Acts::Navigator>;
 
 public:
   virtual
@@ -100,6 +102,14 @@ public:
             Acts::Direction navDir = Acts::Direction::Forward, 
             double pathLimit = std::numeric_limits<double>::max()) const override;
 
+  virtual
+  std::vector<std::optional<Acts::BoundTrackParameters>>
+  propagateToSurfaces(const EventContext& ctx,
+                      const Acts::BoundTrackParameters& startParameters,
+                      const std::vector<const Acts::Surface*>& targets,
+                      Acts::Direction navDir = Acts::Direction::Forward,
+                      double pathLimit = std::numeric_limits<double>::max()) const override;
+
   virtual
   const IFaserActsTrackingGeometryTool*
   trackingGeometryTool() const override
@@ -113,7 +123,14 @@ public:
 
 
 private:
+  // true if a straight track from startPosition along startMomentum stays in one
+  // field-free region, inside the classified aperture, up to z
+  bool fieldFree(const Acts::MagneticFieldContext& mctx, const Acts::Vector3& startPosition,
+                 const Acts::Vector3& startMomentum, double z) const;
+
   std::unique_ptr<ActsExtrapolationDetail::VariantPropagator> m_varProp;
+  // used instead of m_varProp across field-free regions of the FASER field
+  std::unique_ptr<StraightLinePropagator> m_straightLineProp;
   std::unique_ptr<const Acts::Logger> m_logger{nullptr};
 
   // Read handle for conditions object to get the field cache
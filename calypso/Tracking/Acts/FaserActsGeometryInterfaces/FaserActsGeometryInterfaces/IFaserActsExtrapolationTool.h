@@ -67,6 +67,17 @@ class IFaserActsExtrapolationTool : virtual public IAlgTool {
             Acts::Direction navDir = Acts::Direction::Forward,
             double pathLimit = std::numeric_limits<double>::max()) const = 0;
 
+  /// Parameters on each of the target surfaces, which must be given in the
+  /// order they are reached in direction navDir. The track is propagated only
+  /// once, each leg starting from the parameters on the previous surface.
+  virtual
+  std::vector<std::optional<Acts::BoundTrackParameters>>
+  propagateToSurfaces(const EventContext& ctx,
+                      const Acts::BoundTrackParameters& startParameters,
+                      const std::vector<const Acts::Surface*>& targets,
+                      Acts::Direction navDir = Acts::Direction::Forward,
+                      double pathLimit = std::numeric_limits<double>::max()) const = 0;
+
   virtual
   const IFaserActsTrackingGeometryTool*
   trackingGeometryTool() const = 0;
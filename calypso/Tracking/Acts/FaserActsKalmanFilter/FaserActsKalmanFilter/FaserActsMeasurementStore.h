@@ -0,0 +1,74 @@
+#ifndef FASERACTSKALMANFILTER_FASERACTSMEASUREMENTSTORE_H
+#define FASERACTSKALMANFILTER_FASERACTSMEASUREMENTSTORE_H
+
+#include "AthenaKernel/CLASS_DEF.h"
+#include "Identifier/Identifier.h"
+#include "FaserActsKalmanFilter/IndexSourceLink.h"
+#include "FaserActsKalmanFilter/Measurement.h"
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace Tracker
+{
+  class FaserSCT_Cluster;
+  class FaserSCT_SpacePoint;
+}
+
+/**
+ * Acts measurements of all SCT clusters of an event, built once by the
+ * MeasurementStoreAlg and shared read-only by the seed tools, CKF2 and the
+ * KalmanFitterTool. The index of an IndexSourceLink is the position of its
+ * measurement in sourceLinks and measurements.
+ *
+ * Layers are masked with the same 3 * station + layer numbering as the
+ * maskedLayers properties. Masking only removes source links from the
+ * geometry ordered container, the measurement indices stay the same.
+ */
+class FaserActsMeasurementStore {
+public:
+  static uint32_t layerMask(const std::vector<int>& maskedLayers) {
+    uint32_t mask = 0;
+    for (int layer : maskedLayers) {
+      if (layer >= 0 && layer < 32) mask |= (1u << layer);
+    }
+    return mask;
+  }
+
+  /// Source links of the clusters outside the masked layers, ordered by geometry
+  /// identifier. Returns nullptr if the producer did not prepare this mask.
+  const IndexSourceLinkContainer* sourceLinkContainer(uint32_t mask) const {
+    auto it = views.find(mask);
+    return it != views.end() ? &it->second : nullptr;
+  }
+
+  /// Fill container with the source links of the clusters outside the masked layers
+  void fillSourceLinkContainer(uint32_t mask, IndexSourceLinkContainer& container) const {
+    container.clear();
+    container.reserve(sourceLinks.size());
+    for (size_t i = 0; i < sourceLinks.size(); ++i) {
+      if (mask & (1u << layers[i])) continue;
+      container.emplace_hint(container.end(), sourceLinks[i]);
+    }
+  }
+
+  // one entry per measurement
+  std::vector<IndexSourceLink> sourceLinks;
+  std::vector<Measurement> measurements;
+  std::vector<uint8_t> layers;
+
+  // all clusters and space points of the event, in container order
+  std::vector<const Tracker::FaserSCT_Cluster*> clusters;
+  std::vector<const Tracker::FaserSCT_SpacePoint*> spacePoints;
+
+  // measurement index and space point of each cluster identifier
+  std::map<Identifier, Index> indexMap;
+  std::map<Identifier, const Tracker::FaserSCT_SpacePoint*> spacePointMap;
+
+  // geometry ordered source links for each prepared layer mask
+  std::map<uint32_t, IndexSourceLinkContainer> views;
+};
+
+CLASS_DEF(FaserActsMeasurementStore, 137962315, 1)
+
+#endif  // FASERACTSKALMANFILTER_FASERACTSMEASUREMENTSTORE_H
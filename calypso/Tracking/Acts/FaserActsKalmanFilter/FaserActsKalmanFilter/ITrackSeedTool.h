@@ -3,10 +3,14 @@
 
 #include "GaudiKernel/IInterface.h"
 #include "GaudiKernel/IAlgTool.h"
+#include "GaudiKernel/EventContext.h"
 #include "FaserActsKalmanFilter/IndexSourceLink.h"
 #include "FaserActsKalmanFilter/IdentifierLink.h"
 #include "FaserActsKalmanFilter/Measurement.h"
 #include "Acts/EventData/TrackParameters.hpp"
+#include <array>
+#include <memory>
+#include <vector>
 // #include "TrackerPrepRawData/FaserSCT_Cluster.h"
 // #include "TrackerSpacePoint/FaserSCT_SpacePoint.h"
 
@@ -16,20 +20,33 @@ namespace Tracker
   class FaserSCT_SpacePoint;
 }
 
+/**
+ * Seeds and measurements of a single event. The seed tools fill a new
+ * object for every call of run(), so that several events can be in flight
+ * at the same time. Tools may derive from it to pass on additional data.
+ */
+struct TrackSeedResult {
+  virtual ~TrackSeedResult() = default;
+
+  std::shared_ptr<const std::vector<Acts::BoundTrackParameters>> initialTrackParameters {};
+  std::shared_ptr<const Acts::Surface> initialSurface {};
+  std::shared_ptr<const std::vector<IndexSourceLink>> sourceLinks {};
+  // geometry ordered source links for the track finding, built from sourceLinks if not set
+  std::shared_ptr<const IndexSourceLinkContainer> sourceLinkContainer {};
+  std::shared_ptr<const IdentifierLink> idLinks {};
+  std::shared_ptr<const std::vector<Measurement>> measurements {};
+  std::shared_ptr<const std::vector<const Tracker::FaserSCT_Cluster*>> clusters {};
+  std::shared_ptr<const std::vector<std::array<std::vector<const Tracker::FaserSCT_Cluster*>, 3>>> seedClusters {};
+  std::shared_ptr<const std::vector<const Tracker::FaserSCT_SpacePoint*>> spacePoints {};
+  double targetZPosition {0.};
+};
+
 class ITrackSeedTool : virtual public IAlgTool {
 public:
-  DeclareInterfaceID(ITrackSeedTool, 1, 0);
+  DeclareInterfaceID(ITrackSeedTool, 2, 0);
 
-  virtual StatusCode run(std::vector<int> maskedLayers = {}, bool backward = false) = 0;
-  virtual const std::shared_ptr<std::vector<Acts::BoundTrackParameters>> initialTrackParameters() const = 0;
-  virtual const std::shared_ptr<const Acts::Surface> initialSurface() const = 0;
-  virtual const std::shared_ptr<std::vector<IndexSourceLink>> sourceLinks() const = 0;
-  virtual const std::shared_ptr<IdentifierLink> idLinks() const = 0;
-  virtual const std::shared_ptr<std::vector<Measurement>> measurements() const = 0;
-  virtual const std::shared_ptr<std::vector<const Tracker::FaserSCT_Cluster*>> clusters() const = 0;
-  virtual const std::shared_ptr<std::vector<std::array<std::vector<const Tracker::FaserSCT_Cluster*>, 3>>> seedClusters() const = 0;
-  virtual const std::shared_ptr<std::vector<const Tracker::FaserSCT_SpacePoint*>> spacePoints() const = 0;
-  virtual double targetZPosition() const = 0;
+  virtual StatusCode run(const EventContext& ctx, std::unique_ptr<const TrackSeedResult>& result,
+                         const std::vector<int>& maskedLayers = {}, bool backward = false) const = 0;
 };
 
 #endif  // FASERACTSKALMANFILTER_ITRACKSEEDTOOL_H
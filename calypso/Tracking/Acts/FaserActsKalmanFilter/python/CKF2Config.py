@@ -17,6 +17,15 @@ def FaserActsAlignmentCondAlgCfg(flags, **kwargs):
     return acc
 
 
+def MeasurementStoreAlgCfg(flags, **kwargs):
+    acc = ComponentAccumulator()
+    result, actsTrackingGeometryTool = ActsTrackingGeometryToolCfg(flags)
+    acc.merge(result)
+    kwargs.setdefault("TrackingGeometryTool", actsTrackingGeometryTool)
+    acc.addEventAlgo(CompFactory.MeasurementStoreAlg(**kwargs))
+    return acc
+
+
 def CKF2_OutputCfg(flags):
     acc = ComponentAccumulator()
     itemList = ["xAOD::EventInfo#*",
@@ -36,6 +45,8 @@ def CKF2Cfg(flags, actsOutputTag, **kwargs):
     # acc.merge(FaserActsAlignmentCondAlgCfg(flags))
     acts_tracking_geometry_svc = ActsTrackingGeometrySvcCfg(flags)
     acc.merge(acts_tracking_geometry_svc )
+    # the measurements are shared by all CKF2 instances of the job
+    acc.merge(MeasurementStoreAlgCfg(flags))
 
     # track_seed_tool = CompFactory.ClusterTrackSeedTool()
     # track_seed_tool = CompFactory.ActsTrackSeedTool()
@@ -104,6 +115,7 @@ def CKF2Cfg(flags, actsOutputTag, **kwargs):
     kalman_fitter1.StatesWriter = kwargs.get("StatesWriter", False)
     kalman_fitter1.SeedCovarianceScale = 10
     kalman_fitter1.isMC = flags.Input.isMC
+    kalman_fitter1.MeasurementStore = "FaserActsMeasurementStore"
     kalman_fitter1.RootTrajectoryStatesWriterTool = trajectory_states_writer_tool1
     kalman_fitter1.RootTrajectorySummaryWriterTool = trajectory_summary_writer_tool1
     ckf.KalmanFitterTool1 = kalman_fitter1
@@ -5,12 +5,14 @@
 from AthenaConfiguration.ComponentFactory import CompFactory
 from FaserSCT_GeoModel.FaserSCT_GeoModelConfig import FaserSCT_GeometryCfg
 from FaserActsGeometry.ActsGeometryConfig import ActsTrackingGeometrySvcCfg
+from FaserActsKalmanFilter.CKF2Config import MeasurementStoreAlgCfg
 
 
 def SeedingCfg(flags, **kwargs):
     acc = FaserSCT_GeometryCfg(flags)
     acts_tracking_geometry_svc = ActsTrackingGeometrySvcCfg(flags)
     acc.merge(acts_tracking_geometry_svc )
+    acc.merge(MeasurementStoreAlgCfg(flags))
     seedingAlg = CompFactory.SeedingAlg(**kwargs)
     acc.addEventAlgo(seedingAlg)
     return acc
@@ -6,6 +6,7 @@ from AthenaConfiguration.ComponentFactory import CompFactory
 from OutputStreamAthenaPool.OutputStreamConfig import OutputStreamCfg
 from MagFieldServices.MagFieldServicesConfig import MagneticFieldSvcCfg
 from FaserActsGeometry.ActsGeometryConfig import ActsTrackingGeometrySvcCfg
+from FaserActsKalmanFilter.CKF2Config import MeasurementStoreAlgCfg
 
 
 def FaserActsAlignmentCondAlgCfg(flags, **kwargs):
@@ -33,6 +34,7 @@ def TI12CKF2Cfg(flags, **kwargs):
     # acc.merge(FaserActsAlignmentCondAlgCfg(flags))
     acts_tracking_geometry_svc = ActsTrackingGeometrySvcCfg(flags)
     acc.merge(acts_tracking_geometry_svc )
+    acc.merge(MeasurementStoreAlgCfg(flags))
 
     # track_seed_tool = CompFactory.ClusterTrackSeedTool()
     # track_seed_tool = CompFactory.ActsTrackSeedTool()
@@ -84,6 +86,7 @@ def TI12CKF2Cfg(flags, **kwargs):
     kalman_fitter1.SummaryWriter = True
     kalman_fitter1.StatesWriter = True
     kalman_fitter1.SeedCovarianceScale = 10
+    kalman_fitter1.MeasurementStore = "FaserActsMeasurementStore"
     kalman_fitter1.RootTrajectoryStatesWriterTool = trajectory_states_writer_tool1
     kalman_fitter1.RootTrajectorySummaryWriterTool = trajectory_summary_writer_tool1
     ckf.KalmanFitterTool1 = kalman_fitter1
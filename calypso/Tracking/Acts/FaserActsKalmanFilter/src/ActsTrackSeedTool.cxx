@@ -27,16 +27,17 @@ StatusCode ActsTrackSeedTool::initialize() {
 }
 
 
-StatusCode ActsTrackSeedTool::run(std::vector<int> /*maskedLayers*/, bool /*backward*/) {
-  SG::ReadHandle<TrackCollection> trackCollection {m_trackCollection};
+StatusCode ActsTrackSeedTool::run(const EventContext& ctx, std::unique_ptr<const TrackSeedResult>& result,
+                       const std::vector<int>& /*maskedLayers*/, bool /*backward*/) const {
+  SG::ReadHandle<TrackCollection> trackCollection {m_trackCollection, ctx};
   ATH_CHECK(trackCollection.isValid());
 
-  SG::ReadHandle<Tracker::FaserSCT_ClusterContainer> clusterContainer {m_clusterContainerKey};
+  SG::ReadHandle<Tracker::FaserSCT_ClusterContainer> clusterContainer {m_clusterContainerKey, ctx};
   ATH_CHECK(clusterContainer.isValid());
 
   using IdentifierMap = std::map<Identifier, Acts::GeometryIdentifier>;
   std::shared_ptr<IdentifierMap> identifierMap = m_trackingGeometryTool->getIdentifierMap();
-  const FaserActsGeometryContext& gctx = m_trackingGeometryTool->getGeometryContext();
+  const FaserActsGeometryContext& gctx = m_trackingGeometryTool->getGeometryContext(ctx);
   Acts::GeometryContext geoctx = gctx.context();
 
   const int kSize = 1;
@@ -101,13 +102,15 @@ StatusCode ActsTrackSeedTool::run(std::vector<int> /*maskedLayers*/, bool /*back
     }
   }
 
-  m_initialTrackParameters = std::make_shared<std::vector<Acts::BoundTrackParameters>>(initParams);
-  m_sourceLinks = std::make_shared<std::vector<IndexSourceLink>>(sourceLinks);
-  m_idLinks = std::make_shared<IdentifierLink>(identifierLinkMap);
-  m_measurements = std::make_shared<std::vector<Measurement>>(measurements);
-  m_initialSurface = Acts::Surface::makeShared<Acts::PlaneSurface>(
+  auto seedResult = std::make_unique<TrackSeedResult>();
+  seedResult->initialTrackParameters = std::make_shared<std::vector<Acts::BoundTrackParameters>>(std::move(initParams));
+  seedResult->sourceLinks = std::make_shared<std::vector<IndexSourceLink>>(std::move(sourceLinks));
+  seedResult->idLinks = std::make_shared<IdentifierLink>(std::move(identifierLinkMap));
+  seedResult->measurements = std::make_shared<std::vector<Measurement>>(std::move(measurements));
+  seedResult->initialSurface = Acts::Surface::makeShared<Acts::PlaneSurface>(
       Acts::Vector3 {0, 0, m_origin}, Acts::Vector3{0, 0, -1});
-  m_clusters = std::make_shared<std::vector<const Tracker::FaserSCT_Cluster*>>(clusters);
+  seedResult->clusters = std::make_shared<std::vector<const Tracker::FaserSCT_Cluster*>>(std::move(clusters));
+  result = std::move(seedResult);
 
   return StatusCode::SUCCESS;
 }
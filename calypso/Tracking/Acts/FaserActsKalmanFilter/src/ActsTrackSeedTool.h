@@ -18,29 +18,11 @@ public:
   virtual ~ActsTrackSeedTool() = default;
   virtual StatusCode initialize() override;
   virtual StatusCode finalize() override;
-  virtual StatusCode run(std::vector<int> /*maskedLayers*/, bool /*backward*/) override;
+  virtual StatusCode run(const EventContext& ctx, std::unique_ptr<const TrackSeedResult>& result,
+                         const std::vector<int>& /*maskedLayers*/, bool /*backward*/) const override;
 
-  const std::shared_ptr<std::vector<Acts::BoundTrackParameters>> initialTrackParameters() const override;
-  const std::shared_ptr<const Acts::Surface> initialSurface() const override;
-  const std::shared_ptr<std::vector<IndexSourceLink>> sourceLinks() const override;
-  const std::shared_ptr<IdentifierLink> idLinks() const override;
-  const std::shared_ptr<std::vector<Measurement>> measurements() const override;
-  const std::shared_ptr<std::vector<const Tracker::FaserSCT_Cluster*>> clusters() const override;
-  const std::shared_ptr<std::vector<std::array<std::vector<const Tracker::FaserSCT_Cluster*>, 3>>> seedClusters() const override;
-  const std::shared_ptr<std::vector<const Tracker::FaserSCT_SpacePoint*>> spacePoints() const override;
-  double targetZPosition() const override;
 
 private:
-  std::shared_ptr<std::vector<Acts::BoundTrackParameters>> m_initialTrackParameters;
-  std::shared_ptr<const Acts::Surface> m_initialSurface;
-  std::shared_ptr<std::vector<IndexSourceLink>> m_sourceLinks {};
-  std::shared_ptr<IdentifierLink> m_idLinks {};
-  std::shared_ptr<std::vector<Measurement>> m_measurements {};
-  std::shared_ptr<std::vector<const Tracker::FaserSCT_Cluster*>> m_clusters {};
-  std::shared_ptr<std::vector<std::array<std::vector<const Tracker::FaserSCT_Cluster*>, 3>>> m_seedClusters {};
-  std::shared_ptr<std::vector<const Tracker::FaserSCT_SpacePoint*>> m_spacePoints {};
-  double m_targetZPosition {0.};
-
   const FaserSCT_ID* m_idHelper {nullptr};
   const TrackerDD::SCT_DetectorManager* m_detManager {nullptr};
 
@@ -69,48 +51,4 @@ private:
       const Acts::BoundSquareMatrix& cov, double origin);
 };
 
-inline const std::shared_ptr<std::vector<Acts::BoundTrackParameters>>
-ActsTrackSeedTool::initialTrackParameters() const {
-  return m_initialTrackParameters;
-}
-
-inline const std::shared_ptr<const Acts::Surface>
-ActsTrackSeedTool::initialSurface() const {
-  return m_initialSurface;
-}
-
-inline const std::shared_ptr<std::vector<IndexSourceLink>>
-ActsTrackSeedTool::sourceLinks() const {
-  return m_sourceLinks;
-}
-
-inline const std::shared_ptr<IdentifierLink>
-ActsTrackSeedTool::idLinks() const {
-  return m_idLinks;
-}
-
-inline const std::shared_ptr<std::vector<Measurement>>
-ActsTrackSeedTool::measurements() const {
-  return m_measurements;
-}
-
-inline const std::shared_ptr<std::vector<const Tracker::FaserSCT_Cluster*>>
-ActsTrackSeedTool::clusters() const {
-  return m_clusters;
-}
-
-inline const std::shared_ptr<std::vector<std::array<std::vector<const Tracker::FaserSCT_Cluster*>, 3>>>
-ActsTrackSeedTool::seedClusters() const {
-  return m_seedClusters;
-}
-
-inline const std::shared_ptr<std::vector<const Tracker::FaserSCT_SpacePoint*>>
-ActsTrackSeedTool::spacePoints() const {
-  return m_spacePoints;
-}
-
-inline double ActsTrackSeedTool::targetZPosition() const {
-  return m_targetZPosition;
-}
-
 #endif // FASERACTSKALMANFILTER_ACTSTRACKSEEDTOOL_H
@@ -34,12 +34,15 @@
 #include "Acts/TrackFinding/CombinatorialKalmanFilterError.hpp"
 #include "Acts/EventData/ProxyAccessor.hpp"
 #include "CircleFitTrackSeedTool.h"
+#include "GreedyAmbiguitySolver.h"
 
-size_t CKF2::TrackInfo::nClusters {0};
-
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
 
 CKF2::CKF2(const std::string& name, ISvcLocator* pSvcLocator) :
-    AthAlgorithm(name, pSvcLocator) {}
+    AthReentrantAlgorithm(name, pSvcLocator) {}
 
 
 StatusCode CKF2::initialize() {
@@ -92,8 +95,7 @@ StatusCode CKF2::initialize() {
 }
 
 
-StatusCode CKF2::execute() {
-  const EventContext& ctx = Gaudi::Hive::currentContext();
+StatusCode CKF2::execute(const EventContext& ctx) const {
   m_numberOfEvents++;
 
   // Should work, but won't compile
@@ -108,31 +110,30 @@ StatusCode CKF2::execute() {
   std::shared_ptr<const Acts::TrackingGeometry> trackingGeometry
       = m_trackingGeometryTool->trackingGeometry();
 
-  const FaserActsGeometryContext& faserActsGeometryContext = m_trackingGeometryTool->getGeometryContext();
+  const FaserActsGeometryContext& faserActsGeometryContext = m_trackingGeometryTool->getGeometryContext(ctx);
   auto gctx = faserActsGeometryContext.context();
   Acts::MagneticFieldContext magFieldContext = getMagneticFieldContext(ctx);
   Acts::CalibrationContext calibContext;
 
-  CHECK(m_trackSeedTool->run(m_maskedLayers, m_backwardPropagation));
-  std::shared_ptr<const Acts::Surface> targetSurface =
-      m_trackSeedTool->initialSurface();
-  std::shared_ptr<std::vector<Acts::BoundTrackParameters>> initialParameters =
-      m_trackSeedTool->initialTrackParameters();
-  std::shared_ptr<std::vector<IndexSourceLink>> sourceLinks =
-      m_trackSeedTool->sourceLinks();
-  double targetZposition = m_trackSeedTool->targetZPosition();
+  std::unique_ptr<const TrackSeedResult> seedResult;
+  CHECK(m_trackSeedTool->run(ctx, seedResult, m_maskedLayers, m_backwardPropagation));
+  std::shared_ptr<const Acts::Surface> targetSurface = seedResult->initialSurface;
+  std::shared_ptr<const std::vector<Acts::BoundTrackParameters>> initialParameters =
+      seedResult->initialTrackParameters;
+  std::shared_ptr<const std::vector<IndexSourceLink>> sourceLinks = seedResult->sourceLinks;
+  double targetZposition = seedResult->targetZPosition;
   
-  std::shared_ptr<std::vector<Measurement>> measurements = m_trackSeedTool->measurements();
-  std::shared_ptr<std::vector<const Tracker::FaserSCT_Cluster*>> clusters = m_trackSeedTool->clusters();
-  std::shared_ptr<std::vector<const Tracker::FaserSCT_SpacePoint*>> spacePoints = m_trackSeedTool->spacePoints();
-  std::shared_ptr<std::vector<std::array<std::vector<const Tracker::FaserSCT_Cluster*>, 3>>> seedClusters = m_trackSeedTool->seedClusters();
+  std::shared_ptr<const std::vector<Measurement>> measurements = seedResult->measurements;
+  std::shared_ptr<const std::vector<const Tracker::FaserSCT_Cluster*>> clusters = seedResult->clusters;
+  std::shared_ptr<const std::vector<const Tracker::FaserSCT_SpacePoint*>> spacePoints = seedResult->spacePoints;
+  std::shared_ptr<const std::vector<std::array<std::vector<const Tracker::FaserSCT_Cluster*>, 3>>> seedClusters = seedResult->seedClusters;
 
-  TrackInfo::nClusters = sourceLinks->size();
+  const size_t nClusters = sourceLinks->size();
 
 
-  CircleFitTrackSeedTool* Tool = dynamic_cast<CircleFitTrackSeedTool*>(m_trackSeedTool.get());
-  if(Tool){
-    std::shared_ptr<std::vector<CircleFitTrackSeedTool::Seed>> selectedseeds = Tool->seeds();
+  const auto* circleFitResult = dynamic_cast<const CircleFitTrackSeedTool::SeedResult*>(seedResult.get());
+  if(circleFitResult){
+    std::shared_ptr<const std::vector<CircleFitTrackSeedTool::Seed>> selectedseeds = circleFitResult->seeds;
     if (m_seedWriter && !m_noDiagnostics) {
       ATH_CHECK(m_seedWriterTool->write(gctx, *selectedseeds, m_isMC));
     }
@@ -172,11 +173,15 @@ StatusCode CKF2::execute() {
 
   //2) slAccessor 
   IndexSourceLinkContainer tmp;
-  for (const auto& sl : *sourceLinks) {
-    tmp.emplace_hint(tmp.end(), sl);
-  }
   IndexSourceLinkAccessor slAccessor;
-  slAccessor.container = &tmp;
+  if (seedResult->sourceLinkContainer) {
+    slAccessor.container = seedResult->sourceLinkContainer.get();
+  } else {
+    for (const auto& sl : *sourceLinks) {
+      tmp.emplace_hint(tmp.end(), sl);
+    }
+    slAccessor.container = &tmp;
+  }
 
   //3) measurement selector 
   Acts::MeasurementSelector::Config measurementSelectorCfg = {
@@ -210,54 +215,58 @@ StatusCode CKF2::execute() {
 
   unsigned int nSeed = 0;
 
-  for (std::size_t iseed = 0; iseed < (*initialParameters).size(); ++iseed) {
-    ATH_MSG_DEBUG("  position: " << (*initialParameters)[iseed].position(gctx).transpose());
-    ATH_MSG_DEBUG("  momentum: " << (*initialParameters)[iseed].momentum().transpose());
-    ATH_MSG_DEBUG("  charge:   " << (*initialParameters)[iseed].charge());
-    // Clear trackContainerTemp and trackStateContainerTemp
-    tracksTemp.clear();
-
-    auto result = (*m_finder)((*initialParameters).at(iseed), options, calibrator, slAccessor, Acts::MeasurementSelector(measurementSelectorCfg), tracksTemp);
+  if (m_parallelSeeds && initialParameters->size() >= m_minSeedsForParallel) {
+    findTracksParallel(*initialParameters, options, calibrator, slAccessor, measurementSelectorCfg, nSeed - 1, tracks);
+  } else {
+    for (std::size_t iseed = 0; iseed < (*initialParameters).size(); ++iseed) {
+      ATH_MSG_DEBUG("  position: " << (*initialParameters)[iseed].position(gctx).transpose());
+      ATH_MSG_DEBUG("  momentum: " << (*initialParameters)[iseed].momentum().transpose());
+      ATH_MSG_DEBUG("  charge:   " << (*initialParameters)[iseed].charge());
+      // Clear trackContainerTemp and trackStateContainerTemp
+      tracksTemp.clear();
+
+      auto result = (*m_finder)((*initialParameters).at(iseed), options, calibrator, slAccessor, Acts::MeasurementSelector(measurementSelectorCfg), tracksTemp);
    
-    if (!result.ok()) {
-      ATH_MSG_WARNING("Track finding failed for seed " << iseed << " with error" << result.error());
-      continue;
-    }
+      if (!result.ok()) {
+        ATH_MSG_WARNING("Track finding failed for seed " << iseed << " with error" << result.error());
+        continue;
+      }
 
-    auto& tracksForSeed = result.value();
-    m_numberOfFittedTracks += tracksForSeed.size();
-    ATH_MSG_DEBUG("Find " << tracksForSeed.size() << " tracks for this seed");
-    for (auto& track : tracksForSeed) {
-      // Set the seed number, this number decrease by 1 since the seed number
-      // has already been updated
-      seedNumber(track) = nSeed - 1;
-      auto destProxy = tracks.getTrack(tracks.addTrack());
-      destProxy.copyFrom(track, true);  // make sure we copy track states!
+      auto& tracksForSeed = result.value();
+      m_numberOfFittedTracks += tracksForSeed.size();
+      ATH_MSG_DEBUG("Find " << tracksForSeed.size() << " tracks for this seed");
+      for (auto& track : tracksForSeed) {
+        // Set the seed number, this number decrease by 1 since the seed number
+        // has already been updated
+        seedNumber(track) = nSeed - 1;
+        auto destProxy = tracks.getTrack(tracks.addTrack());
+        destProxy.copyFrom(track, true);  // make sure we copy track states!
+      }
     }
   }
   
-  std::list<TrackInfo> allTracks;
+  std::vector<TrackInfo> allTracks;
+  allTracks.reserve(tracks.size());
   for(const auto& track: tracks){
-    allTracks.push_back(track); 
+    allTracks.emplace_back(track, nClusters); 
   }
 
   // the list of tracks is sorted by the number of measurements using the chi2 value as a tie-breaker
-  allTracks.sort([](const TrackInfo &left, const TrackInfo &right) {
+  std::stable_sort(allTracks.begin(), allTracks.end(), [](const TrackInfo &left, const TrackInfo &right) {
     if (left.nMeasurements > right.nMeasurements) return true;
     if (left.nMeasurements < right.nMeasurements) return false;
     if (left.chi2 < right.chi2) return true;
     else return false;
   });
 
-  while (not allTracks.empty()) {
-    TrackInfo selected = allTracks.front();
-    
+  // select tracks with more than 12 measurements which share at most 6 hits with a better track
+  GreedyAmbiguitySolver solver(nClusters);
+  for (const TrackInfo& info : allTracks) {
+    solver.addCandidate(info.clusterSet, info.nMeasurements > 12);
+  }
+  for (size_t i : solver.solve(6)) {
     auto destProxy = selectedTracks.getTrack(selectedTracks.addTrack());
-    destProxy.copyFrom(tracks.getTrack(selected.index), true);  // make sure we copy track states!
-
-    allTracks.remove_if([&](const TrackInfo &p) {
-      return (p.nMeasurements <= 12) || ((p.clusterSet & selected.clusterSet).count() > 6);
-    });
+    destProxy.copyFrom(tracks.getTrack(allTracks[i].index), true);  // make sure we copy track states!
   }
   ATH_MSG_DEBUG("There are " << selectedTracks.size() << " selected tracks for this event.");
 
@@ -309,6 +318,80 @@ StatusCode CKF2::execute() {
 }
 
 
+namespace {
+  // Track containers owned by one TBB worker thread
+  struct FinderWorker {
+    FinderWorker() :
+        tracksTemp(std::make_shared<Acts::VectorTrackContainer>(), std::make_shared<Acts::VectorMultiTrajectory>()),
+        tracks(std::make_shared<Acts::VectorTrackContainer>(), std::make_shared<Acts::VectorMultiTrajectory>()) {
+      tracksTemp.addColumn<unsigned int>("trackGroup");
+      tracks.addColumn<unsigned int>("trackGroup");
+    }
+    FaserActsTrackContainer tracksTemp;
+    FaserActsTrackContainer tracks;
+  };
+
+  // Tracks found for one seed, stored in the container of the worker which processed it
+  struct SeedTracks {
+    const FaserActsTrackContainer* container {nullptr};
+    std::vector<FaserActsTrackContainer::IndexType> indices {};
+    std::error_code error {};
+  };
+}
+
+
+void CKF2::findTracksParallel(const std::vector<Acts::BoundTrackParameters>& initialParameters,
+                              const GeneralFitterOptions& options,
+                              const MeasurementCalibratorAdapter& calibrator,
+                              const IndexSourceLinkAccessor& slAccessor,
+                              const Acts::MeasurementSelector::Config& measurementSelectorCfg,
+                              unsigned int trackGroup, FaserActsTrackContainer& tracks) const {
+  Acts::ProxyAccessor<unsigned int> seedNumber("trackGroup");
+  tbb::enumerable_thread_specific<FinderWorker> workers;
+  std::vector<SeedTracks> seedTracks(initialParameters.size());
+
+  // Isolate the loop, so that a waiting thread does not pick up other algorithms of the scheduler
+  tbb::this_task_arena::isolate([&]() {
+    tbb::parallel_for(tbb::blocked_range<std::size_t>(0, initialParameters.size()),
+                      [&](const tbb::blocked_range<std::size_t>& range) {
+      FinderWorker& worker = workers.local();
+      for (std::size_t iseed = range.begin(); iseed != range.end(); ++iseed) {
+        worker.tracksTemp.clear();
+        auto result = (*m_finder)(initialParameters[iseed], options, calibrator, slAccessor,
+                                  Acts::MeasurementSelector(measurementSelectorCfg), worker.tracksTemp);
+        SeedTracks& found = seedTracks[iseed];
+        if (!result.ok()) {
+          found.error = result.error();
+          continue;
+        }
+        found.container = &worker.tracks;
+        for (auto& track : result.value()) {
+          seedNumber(track) = trackGroup;
+          auto destProxy = worker.tracks.getTrack(worker.tracks.addTrack());
+          destProxy.copyFrom(track, true);
+          found.indices.push_back(destProxy.index());
+        }
+      }
+    });
+  });
+
+  // merge in seed order, so that the result does not depend on the scheduling
+  for (std::size_t iseed = 0; iseed < seedTracks.size(); ++iseed) {
+    const SeedTracks& found = seedTracks[iseed];
+    if (found.error) {
+      ATH_MSG_WARNING("Track finding failed for seed " << iseed << " with error" << found.error);
+      continue;
+    }
+    m_numberOfFittedTracks += found.indices.size();
+    ATH_MSG_DEBUG("Find " << found.indices.size() << " tracks for seed " << iseed);
+    for (auto index : found.indices) {
+      auto destProxy = tracks.getTrack(tracks.addTrack());
+      destProxy.copyFrom(found.container->getTrack(index), true);
+    }
+  }
+}
+
+
 StatusCode CKF2::finalize() {
   ATH_MSG_INFO("CombinatorialKalmanFilterAlg::finalize()");
   ATH_MSG_INFO("BackwardPropagation: " << m_backwardPropagation);
@@ -333,7 +416,7 @@ Acts::MagneticFieldContext CKF2::getMagneticFieldContext(const EventContext& ctx
 
 
 
-void CKF2::computeSharedHits(std::vector<IndexSourceLink>* sourceLinks, FaserActsTrackContainer& tracks) const {
+void CKF2::computeSharedHits(const std::vector<IndexSourceLink>* sourceLinks, FaserActsTrackContainer& tracks) const {
 
   std::vector<std::size_t> firstTrackOnTheHit(
       sourceLinks->size(), std::numeric_limits<std::size_t>::max());
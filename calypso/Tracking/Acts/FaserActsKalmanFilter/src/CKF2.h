@@ -5,7 +5,6 @@
 #include "TrackFinderFunction.h"
 
 #include "AthenaBaseComps/AthReentrantAlgorithm.h"
-#include "AthenaBaseComps/AthAlgorithm.h"
 #include "FaserActsGeometryInterfaces/IFaserActsTrackingGeometryTool.h"
 #include "Acts/TrackFitting/KalmanFitter.hpp"
 #include "Acts/TrackFinding/CombinatorialKalmanFilter.hpp"
@@ -23,6 +22,7 @@
 #include <boost/dynamic_bitset.hpp>
 #include "CreateTrkTrackTool.h"
 #include "xAODEventInfo/EventInfo.h"
+#include <atomic>
 
 
 using ClusterSet = boost::dynamic_bitset<>;
@@ -37,17 +37,17 @@ namespace TrackerDD {
 class SCT_DetectorManager;
 }
 
-class CKF2 : public AthAlgorithm {
+class CKF2 : public AthReentrantAlgorithm {
 public:
   CKF2(const std::string& name, ISvcLocator* pSvcLocator);
   virtual ~CKF2() = default;
 
   StatusCode initialize() override;
-  StatusCode execute() override;
+  StatusCode execute(const EventContext& ctx) const override;
   StatusCode finalize() override;
 
   struct TrackInfo {
-    TrackInfo(const FaserActsTrackContainer::TrackProxy& trk) :
+    TrackInfo(const FaserActsTrackContainer::TrackProxy& trk, size_t nClusters) :
       clusterSet{nClusters} {
       
       nMeasurements = trk.nMeasurements();
@@ -64,7 +64,6 @@ public:
       }
     }
 
-    static size_t nClusters;
     ClusterSet clusterSet;
     size_t nMeasurements;
     double chi2;
@@ -75,12 +74,19 @@ public:
   virtual Acts::MagneticFieldContext getMagneticFieldContext(const EventContext& ctx) const;
 
 private:
-  size_t m_numberOfEvents {0};
-  size_t m_numberOfTrackSeeds {0};
-  size_t m_numberOfFittedTracks {0};
-  size_t m_numberOfSelectedTracks {0};
-
-  void computeSharedHits(std::vector<IndexSourceLink>* sourceLinks, FaserActsTrackContainer& tracks) const;
+  mutable std::atomic<size_t> m_numberOfEvents {0};
+  mutable std::atomic<size_t> m_numberOfTrackSeeds {0};
+  mutable std::atomic<size_t> m_numberOfFittedTracks {0};
+  mutable std::atomic<size_t> m_numberOfSelectedTracks {0};
+
+  void computeSharedHits(const std::vector<IndexSourceLink>* sourceLinks, FaserActsTrackContainer& tracks) const;
+  // run the track finding of all seeds as TBB tasks and add the tracks to tracks in seed order
+  void findTracksParallel(const std::vector<Acts::BoundTrackParameters>& initialParameters,
+                          const GeneralFitterOptions& options,
+                          const MeasurementCalibratorAdapter& calibrator,
+                          const IndexSourceLinkAccessor& slAccessor,
+                          const Acts::MeasurementSelector::Config& measurementSelectorCfg,
+                          unsigned int trackGroup, FaserActsTrackContainer& tracks) const;
   std::shared_ptr<TrackFinderFunction> m_finder;
   std::shared_ptr<TrackFitterFunction> m_fitter;
   std::unique_ptr<const Acts::Logger> m_logger;
@@ -104,6 +110,8 @@ private:
   Gaudi::Property<double> m_chi2Max {this, "chi2Max", 15};
   Gaudi::Property<unsigned long> m_nMax {this, "nMax", 10};
   Gaudi::Property<std::vector<int>> m_maskedLayers {this, "maskedLayers", {}};
+  Gaudi::Property<bool> m_parallelSeeds {this, "ParallelSeeds", false, "Run the track finding for the seeds of an event as parallel TBB tasks"};
+  Gaudi::Property<unsigned int> m_minSeedsForParallel {this, "MinSeedsForParallel", 16, "Minimum number of seeds for which the track finding is run in parallel"};
   SG::ReadCondHandleKey<FaserFieldCacheCondObj> m_fieldCondObjInputKey {this, "FaserFieldCacheCondObj", "fieldCondObj", "Name of the Magnetic Field conditions object key"};
   ToolHandle<ITrackSeedTool> m_trackSeedTool {this, "TrackSeed", "ClusterTrackSeedTool"};
   ToolHandle<IFaserActsTrackingGeometryTool> m_trackingGeometryTool {this, "TrackingGeometryTool", "FaserActsTrackingGeometryTool"};
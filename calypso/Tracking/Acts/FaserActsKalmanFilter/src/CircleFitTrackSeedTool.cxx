@@ -2,7 +2,6 @@
 #include "TrackerRIO_OnTrack/FaserSCT_ClusterOnTrack.h"
 #include "TrackerIdentifier/FaserSCT_ID.h"
 #include "TrackerReadoutGeometry/SCT_DetectorManager.h"
-#include "TrackerPrepRawData/FaserSCT_ClusterCollection.h"
 #include "TrackerPrepRawData/FaserSCT_Cluster.h"
 #include "Identifier/Identifier.h"
 #include "Acts/Geometry/GeometryIdentifier.hpp"
@@ -10,13 +9,14 @@
 #include "CircleFit.h"
 #include "LinearFit.h"
 #include "TrackClassification.h"
+#include "GreedyAmbiguitySolver.h"
+#include "SeedCombinatorics.h"
 #include <array>
 #include <algorithm>
+#include <chrono>
+#include <cmath>
 
 
-std::map<Identifier,Index> CircleFitTrackSeedTool::s_indexMap {};
-std::map<Identifier, const Tracker::FaserSCT_SpacePoint*> CircleFitTrackSeedTool::s_spacePointMap {};
-
 CircleFitTrackSeedTool::CircleFitTrackSeedTool(
     const std::string& type, const std::string& name, const IInterface* parent)
     : base_class(type, name, parent) {}
@@ -27,21 +27,18 @@ StatusCode CircleFitTrackSeedTool::initialize() {
       ATH_CHECK(detStore()->retrieve(m_detManager, "SCT"));
       ATH_CHECK(m_trackingGeometryTool.retrieve());
       ATH_CHECK(m_trackCollection.initialize());
-      ATH_CHECK(m_clusterContainerKey.initialize());
-      ATH_CHECK(m_spacePointContainerKey.initialize());
+      ATH_CHECK(m_measurementStoreKey.initialize());
   // ATH_CHECK(m_simDataCollectionKey.initialize());
   // ATH_CHECK(m_mcEventCollectionKey.initialize());
   return StatusCode::SUCCESS;
 }
 
 
-StatusCode CircleFitTrackSeedTool::run(std::vector<int> maskedLayers, bool backward) {
-
-  SG::ReadHandle<Tracker::FaserSCT_ClusterContainer> clusterContainer {m_clusterContainerKey};
-      ATH_CHECK(clusterContainer.isValid());
+StatusCode CircleFitTrackSeedTool::run(const EventContext& ctx, std::unique_ptr<const TrackSeedResult>& result,
+                                       const std::vector<int>& maskedLayers, bool backward) const {
 
-  SG::ReadHandle<FaserSCT_SpacePointContainer> spacePointContainer {m_spacePointContainerKey};
-      ATH_CHECK(spacePointContainer.isValid());
+  SG::ReadHandle<FaserActsMeasurementStore> store {m_measurementStoreKey, ctx};
+      ATH_CHECK(store.isValid());
 
   // SG::ReadHandle<TrackerSimDataCollection> simData {m_simDataCollectionKey};
   // ATH_CHECK(simData.isValid());
@@ -49,62 +46,17 @@ StatusCode CircleFitTrackSeedTool::run(std::vector<int> maskedLayers, bool backw
   // SG::ReadHandle<McEventCollection> mcEvents {m_mcEventCollectionKey};
   // ATH_CHECK(mcEvents.isValid());
 
-  using IdentifierMap = std::map<Identifier, Acts::GeometryIdentifier>;
-  std::shared_ptr<IdentifierMap> identifierMap = m_trackingGeometryTool->getIdentifierMap();
   // std::map<int, const HepMC::GenParticle*> particles {};
   // for (const HepMC::GenParticle* particle : mcEvents->front()->particle_range()) {
   //   particles[particle->barcode()] = particle;
   // }
 
-  // std::map<Identifier, const Tracker::FaserSCT_SpacePoint*> s_spacePointMap {};
-  std::vector<const Tracker::FaserSCT_SpacePoint*> spacePoints {};
-  for (const FaserSCT_SpacePointCollection* spacePointCollection : *spacePointContainer) {
-    for (const Tracker::FaserSCT_SpacePoint *spacePoint: *spacePointCollection) {
-      spacePoints.push_back(spacePoint);
-      Identifier id1 = spacePoint->cluster1()->identify();
-      CircleFitTrackSeedTool::s_spacePointMap[id1] = spacePoint;
-      Identifier id2 = spacePoint->cluster2()->identify();
-      CircleFitTrackSeedTool::s_spacePointMap[id2] = spacePoint;
-    }
-  }
-
-
-  using ThisMeasurement = Acts::Measurement<Acts::BoundIndices, 1>;
-  std::array<Acts::BoundIndices, 1> Indices = {Acts::eBoundLoc0};
-  std::vector<IndexSourceLink> sourceLinks {};
-  std::vector<Measurement> measurements {};
-  std::vector<const Tracker::FaserSCT_Cluster*> clusters {};
-  for (const Tracker::FaserSCT_ClusterCollection* clusterCollection : *clusterContainer) {
-    for (const Tracker::FaserSCT_Cluster* cluster : *clusterCollection) {
-      clusters.push_back(cluster);
-      Identifier id = cluster->detectorElement()->identify();
-      if (std::find(maskedLayers.begin(), maskedLayers.end(), 3 * m_idHelper->station(id) + m_idHelper->layer(id)) != maskedLayers.end()) {
-        continue;
-      }
-//      if(m_idHelper->station(id)==0) continue;
-      CircleFitTrackSeedTool::s_indexMap[cluster->identify()] = measurements.size();
-      if (identifierMap->count(id) != 0) {
-        Acts::GeometryIdentifier geoId = identifierMap->at(id);
-        IndexSourceLink sourceLink(geoId, measurements.size(), cluster);
-        // create measurement
-        const auto& par = cluster->localPosition();
-	auto cova = cluster->localCovariance();
-        Eigen::Matrix<double, 1, 1> pos {par.x(),};
-        Eigen::Matrix<double, 1, 1> cov {0.0231 * 0.0231,};
-        Acts::SourceLink sl{sourceLink}; 
-        ThisMeasurement meas(std::move(sl), Indices, pos, cov);
-        sourceLinks.push_back(sourceLink);
-        measurements.emplace_back(std::move(meas));
-      }
-    }
-  }
-
-  SG::ReadHandle<TrackCollection> trackCollection {m_trackCollection};
+  SG::ReadHandle<TrackCollection> trackCollection {m_trackCollection, ctx};
       ATH_CHECK(trackCollection.isValid());
 
   std::array<std::vector<Segment>, 4> segments {};
   for (const Trk::Track* track : *trackCollection) {
-    auto s = Segment(track, m_idHelper, maskedLayers);
+    auto s = Segment(track, m_idHelper, store->indexMap, store->spacePointMap, maskedLayers);
     //remove IFT in seeding
     if(m_removeIFT){
     if (s.station != -1 &&s.station != 0) segments[s.station].push_back(s);
@@ -114,24 +66,28 @@ StatusCode CircleFitTrackSeedTool::run(std::vector<int> maskedLayers, bool backw
     }
   }
 
-  std::vector<Segment> combination {};
+  auto start = std::chrono::steady_clock::now();
+  SeedCombinatorics comb {m_maxSlopeDifferenceX, m_maxResidualX, m_maxSeeds};
   std::vector<Seed> seeds {};
-  // create seeds from four stations
-  go(segments, combination, seeds, 0, 4, backward);
-  if (seeds.size() < 2) {
-    // create seeds from three stations
-    go(segments, combination, seeds, 0, 3, backward);
-  }
-  // create seeds from two stations
-  if (seeds.size() < 2) {
-    go(segments, combination, seeds, 0, 2, backward);
-  }
-  if (seeds.size() < 2) {
-    go(segments, combination, seeds, 0, 1, backward);
+  // create seeds from four stations, then from three, two and one station
+  // as long as there are less than two seeds
+  comb.run(segments, [&](const std::vector<const Segment*> &combination) {
+    std::vector<Segment> segs {};
+    segs.reserve(combination.size());
+    for (const Segment* seg : combination) segs.push_back(*seg);
+    seeds.push_back(Seed(segs, backward));
+  });
+  auto time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+  m_numberOfEvents++;
+  m_numberOfSeedFits += seeds.size();
+  m_numberOfRejectedCombinations += comb.rejected();
+  m_seedingTime += time;
+  if (comb.capped()) {
+    m_numberOfCappedEvents++;
+    ATH_MSG_WARNING("Stop seed generation after " << m_maxSeeds.value() << " seeds");
   }
-
-  std::list<Seed> allSeeds;
-  for (const Seed &seed : seeds) allSeeds.push_back(seed);
+  ATH_MSG_DEBUG("Fitted " << seeds.size() << " seeds out of " << comb.combinations() << " segment combinations in " << time << " us");
 
   // allSeeds.sort([](const Seed &left, const Seed &right) {
   //   if (left.size > right.size) return true;
@@ -139,23 +95,23 @@ StatusCode CircleFitTrackSeedTool::run(std::vector<int> maskedLayers, bool backw
   //   if (left.chi2 < right.chi2) return true;
   //   else return false;
   // });
-  allSeeds.sort([](const Seed &left, const Seed &right) {
+  std::stable_sort(seeds.begin(), seeds.end(), [](const Seed &left, const Seed &right) {
     if (left.stations > right.stations) return true;
     if (left.stations < right.stations) return false;
     if (left.chi2/std::max(left.positions.size() + left.fakePositions.size() - left.constraints, 1UL) < right.chi2/std::max(right.positions.size() + right.fakePositions.size() - right.constraints, 1UL)) return true;
     else return false;
   });
 
+  // keep seeds with at least 10 clusters which share at most 6 clusters with a better seed
   std::vector<Seed> selectedSeeds {};
-  while (not allSeeds.empty()) {
-    Seed selected = allSeeds.front();
-    selectedSeeds.push_back(selected);
-    // allSeeds.remove_if([&](const Seed &p) {
-    //   return ((p.clusterSet & selected.clusterSet).count() == p.clusterSet.count());
-    // });
-    allSeeds.remove_if([&](const Seed &p) {
-      return (p.size < 10) || ((p.clusterSet & selected.clusterSet).count() > 6);
-    });
+  if (!seeds.empty()) {
+    GreedyAmbiguitySolver solver(seeds.front().clusterSet.size());
+    for (const Seed &seed : seeds) {
+      solver.addCandidate(seed.clusterSet, seed.size >= 10);
+    }
+    for (size_t i : solver.solve(6)) {
+      selectedSeeds.push_back(std::move(seeds[i]));
+    }
   }
 
   Acts::BoundSquareMatrix cov = Acts::BoundSquareMatrix::Zero();
@@ -176,24 +132,36 @@ StatusCode CircleFitTrackSeedTool::run(std::vector<int> maskedLayers, bool backw
   } else {
     origin = 2470;
   }
-  m_targetZPosition = origin;
   std::vector<Acts::BoundTrackParameters> initParams {};
   ATH_MSG_DEBUG("Sorted seed properties:");
   for (const Seed &seed : selectedSeeds) {
     ATH_MSG_DEBUG("seed size: " << seed.size << ", chi2: " << seed.chi2);
     initParams.push_back(seed.get_params(origin, cov, backward));
   }
-  m_seeds = std::make_shared<std::vector<Seed>>(selectedSeeds);
-  m_initialTrackParameters = std::make_shared<std::vector<Acts::BoundTrackParameters>>(initParams);
-  m_sourceLinks = std::make_shared<std::vector<IndexSourceLink>>(sourceLinks);
-  // m_idLinks = std::make_shared<IdentifierLink>(identifierLinkMap);
-  m_measurements = std::make_shared<std::vector<Measurement>>(measurements);
+  auto seedResult = std::make_unique<SeedResult>();
+  seedResult->targetZPosition = origin;
+  seedResult->seeds = std::make_shared<std::vector<Seed>>(std::move(selectedSeeds));
+  seedResult->initialTrackParameters = std::make_shared<std::vector<Acts::BoundTrackParameters>>(std::move(initParams));
+  // The store is owned by StoreGate for the whole event, so the result only
+  // points into it and the measurements are not copied for every CKF2 instance
+  const FaserActsMeasurementStore* storePtr = store.cptr();
+  seedResult->sourceLinks = std::shared_ptr<const std::vector<IndexSourceLink>>(std::shared_ptr<void>(), &storePtr->sourceLinks);
+  // seedResult->idLinks = std::make_shared<IdentifierLink>(identifierLinkMap);
+  seedResult->measurements = std::shared_ptr<const std::vector<Measurement>>(std::shared_ptr<void>(), &storePtr->measurements);
+  const uint32_t mask = FaserActsMeasurementStore::layerMask(maskedLayers);
+  if (const IndexSourceLinkContainer* view = storePtr->sourceLinkContainer(mask)) {
+    seedResult->sourceLinkContainer = std::shared_ptr<const IndexSourceLinkContainer>(std::shared_ptr<void>(), view);
+  } else {
+    auto container = std::make_shared<IndexSourceLinkContainer>();
+    storePtr->fillSourceLinkContainer(mask, *container);
+    seedResult->sourceLinkContainer = std::move(container);
+  }
   //@todo make sure this is correct 
-  m_initialSurface = Acts::Surface::makeShared<Acts::PlaneSurface>(
+  seedResult->initialSurface = Acts::Surface::makeShared<Acts::PlaneSurface>(
       Acts::Vector3 {0, 0, origin}, Acts::Vector3{0, 0, -1});
-  m_clusters = std::make_shared<std::vector<const Tracker::FaserSCT_Cluster*>>(clusters);
-  m_spacePoints = std::make_shared<std::vector<const Tracker::FaserSCT_SpacePoint*>>(spacePoints);
-  s_indexMap.clear();
+  seedResult->clusters = std::shared_ptr<const std::vector<const Tracker::FaserSCT_Cluster*>>(std::shared_ptr<void>(), &storePtr->clusters);
+  seedResult->spacePoints = std::shared_ptr<const std::vector<const Tracker::FaserSCT_SpacePoint*>>(std::shared_ptr<void>(), &storePtr->spacePoints);
+  result = std::move(seedResult);
 
 
   return StatusCode::SUCCESS;
@@ -201,30 +169,18 @@ StatusCode CircleFitTrackSeedTool::run(std::vector<int> maskedLayers, bool backw
 
 
 StatusCode CircleFitTrackSeedTool::finalize() {
+  ATH_MSG_INFO(m_numberOfEvents << " events processed.");
+  ATH_MSG_INFO(m_numberOfSeedFits << " seed fits.");
+  ATH_MSG_INFO(m_numberOfRejectedCombinations << " segment combinations rejected before the fit.");
+  ATH_MSG_INFO(m_numberOfCappedEvents << " events reached the maximum number of seeds.");
+  ATH_MSG_INFO("Seed generation took " << m_seedingTime / 1000 << " ms.");
   return StatusCode::SUCCESS;
 }
 
 
-void CircleFitTrackSeedTool::go(const std::array<std::vector<Segment>, 4> &v,
-                                std::vector<Segment> &combination,
-                                std::vector<Seed> &seeds,
-                                int offset, int k,
-                                bool backward) {
-  if (k == 0) {
-    seeds.push_back(Seed(combination, backward));
-    return;
-  }
-  for (std::size_t i = offset; i < v.size() + 1 - k; ++i) {
-    for (const auto& ve : v[i]) {
-      combination.push_back(ve);
-      go(v, combination, seeds, i+1, k-1, backward);
-      combination.pop_back();
-    }
-  }
-}
-
-CircleFitTrackSeedTool::Segment::Segment(const Trk::Track* track, const FaserSCT_ID *idHelper, const std::vector<int> &maskedLayers) :
-    clusterSet(CircleFitTrackSeedTool::s_indexMap.size()) {
+CircleFitTrackSeedTool::Segment::Segment(const Trk::Track* track, const FaserSCT_ID *idHelper, const IndexMap &indexMap,
+                                         const SpacePointMap &spacePointMap, const std::vector<int> &maskedLayers) :
+    clusterSet(indexMap.size()) {
   for (const Trk::TrackStateOnSurface* trackState : *(track->trackStateOnSurfaces())) {
     auto clusterOnTrack = dynamic_cast<const Tracker::FaserSCT_ClusterOnTrack*> (trackState->measurementOnTrack());
     if (clusterOnTrack) {
@@ -241,15 +197,16 @@ CircleFitTrackSeedTool::Segment::Segment(const Trk::Track* track, const FaserSCT
 	}
       }*/
       clusters.push_back(cluster);
-      if (CircleFitTrackSeedTool::s_spacePointMap.count(id) > 0) {
-        const Tracker::FaserSCT_SpacePoint *sp = CircleFitTrackSeedTool::s_spacePointMap.at(cluster->identify());
+      if (spacePointMap.count(id) > 0) {
+        const Tracker::FaserSCT_SpacePoint *sp = spacePointMap.at(cluster->identify());
         if (std::find(spacePoints.begin(), spacePoints.end(), sp) == spacePoints.end()) {
           spacePoints.push_back(sp);
         }
       }
       station = idHelper->station(id);
 //      if(station==0)continue;
-      clusterSet.set(CircleFitTrackSeedTool::s_indexMap.at(id));
+      auto index = indexMap.find(id);
+      if (index != indexMap.end()) clusterSet.set(index->second);
       auto fitParameters = track->trackParameters()->front();
       position = fitParameters->position();
       momentum = fitParameters->momentum();
@@ -258,10 +215,11 @@ CircleFitTrackSeedTool::Segment::Segment(const Trk::Track* track, const FaserSCT
   fakePositions.push_back(position);
   fakePositions.push_back(position - 30 * momentum.normalized());
   fakePositions.push_back(position + 30 * momentum.normalized());
+  if (station != -1 && momentum.z() != 0) slopeX = momentum.x() / momentum.z();
 }
 
 CircleFitTrackSeedTool::Seed::Seed(const std::vector<Segment> &segments, bool backward) :
-    clusterSet(CircleFitTrackSeedTool::s_indexMap.size()) {
+    clusterSet(segments.front().clusterSet.size()) {
   for (const Segment &seg : segments) {
     segs.push_back(seg);//get the segments of one Seed*********************************
     clusters.insert(clusters.end(), seg.clusters.begin(), seg.clusters.end());
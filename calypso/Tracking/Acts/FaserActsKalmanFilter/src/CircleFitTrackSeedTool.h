@@ -1,8 +1,8 @@
 #ifndef FASERACTSKALMANFILTER_CIRCLEFITTRACKSEEDTOOL_H
 #define FASERACTSKALMANFILTER_CIRCLEFITTRACKSEEDTOOL_H
 
-#include "TrackerSpacePoint/FaserSCT_SpacePointContainer.h"
-#include "TrackerPrepRawData/FaserSCT_ClusterContainer.h"
+#include "TrackerSpacePoint/FaserSCT_SpacePoint.h"
+#include "TrackerPrepRawData/FaserSCT_Cluster.h"
 #include "AthenaBaseComps/AthAlgTool.h"
 #include "Gaudi/Property.h"
 #include "GaudiKernel/IInterface.h"
@@ -10,6 +10,7 @@
 
 #include "FaserActsGeometryInterfaces/IFaserActsTrackingGeometryTool.h"
 #include "FaserActsKalmanFilter/ITrackSeedTool.h"
+#include "FaserActsKalmanFilter/FaserActsMeasurementStore.h"
 #include "TrkTrack/TrackCollection.h"
 #include "TrackerRIO_OnTrack/FaserSCT_ClusterOnTrack.h"
 #include "TrkRIO_OnTrack/RIO_OnTrack.h"
@@ -18,6 +19,7 @@
 // #include "TrackerSimData/TrackerSimDataCollection.h"
 // #include "GeneratorObjects/McEventCollection.h"
 #include <array>
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
@@ -34,23 +36,18 @@ public:
   virtual ~CircleFitTrackSeedTool() = default;
   virtual StatusCode initialize() override;
   virtual StatusCode finalize() override;
-  virtual StatusCode run(std::vector<int> maskedLayers = {}, bool backward=false) override;
-  
-  
-  const std::shared_ptr<std::vector<Acts::BoundTrackParameters>> initialTrackParameters() const override;
-  const std::shared_ptr<const Acts::Surface> initialSurface() const override;
-  const std::shared_ptr<std::vector<IndexSourceLink>> sourceLinks() const override;
-  const std::shared_ptr<IdentifierLink> idLinks() const override;
-  const std::shared_ptr<std::vector<Measurement>> measurements() const override;
-  const std::shared_ptr<std::vector<const Tracker::FaserSCT_Cluster*>> clusters() const override;
-  const std::shared_ptr<std::vector<std::array<std::vector<const Tracker::FaserSCT_Cluster*>, 3>>> seedClusters() const override;
-  const std::shared_ptr<std::vector<const Tracker::FaserSCT_SpacePoint*>> spacePoints() const override;
-  double targetZPosition() const override;
+  virtual StatusCode run(const EventContext& ctx, std::unique_ptr<const TrackSeedResult>& result,
+                         const std::vector<int>& maskedLayers = {}, bool backward=false) const override;
+
+  // Index of every cluster in the measurement list and the space point it belongs to
+  using IndexMap = std::map<Identifier, Index>;
+  using SpacePointMap = std::map<Identifier, const Tracker::FaserSCT_SpacePoint*>;
 
 
   struct Segment {
   public:
-    Segment(const Trk::Track* track, const FaserSCT_ID *idHelper, const std::vector<int> &maskedLayers = {});
+    Segment(const Trk::Track* track, const FaserSCT_ID *idHelper, const IndexMap &indexMap,
+            const SpacePointMap &spacePointMap, const std::vector<int> &maskedLayers = {});
     int station = -1;
     std::vector<const Tracker::FaserSCT_Cluster*> clusters;
     std::vector<const Tracker::FaserSCT_SpacePoint*> spacePoints;
@@ -59,6 +56,8 @@ public:
     Acts::Vector3 position;
     std::vector<Acts::Vector3> fakePositions;
     Acts::Vector3 momentum;
+    // slope dx/dz, used to reject incompatible segment combinations before fitting
+    double slopeX = 0;
   };
 
   struct Seed {
@@ -90,39 +89,20 @@ public:
     double m_sigma_x = 0.8;
     double m_sigma_y = 0.016;
   };
-  const std::shared_ptr<std::vector<CircleFitTrackSeedTool::Seed>> seeds() const;
-
 
+  // Seed result which also keeps the selected seeds for the RootSeedWriterTool
+  struct SeedResult : public TrackSeedResult {
+    std::shared_ptr<const std::vector<Seed>> seeds {};
+  };
 
 private:
- 
-
-  void go(const std::array<std::vector<Segment>, 4> &v, std::vector<Segment> &combination,
-          std::vector<Seed> &seeds, int offset, int k, bool backward=false);
-
-  static std::map<Identifier, Index> s_indexMap;
-  static std::map<Identifier, const Tracker::FaserSCT_SpacePoint*> s_spacePointMap;
-
-  std::shared_ptr<std::vector<Acts::BoundTrackParameters>> m_initialTrackParameters;
-  std::shared_ptr<const Acts::Surface> m_initialSurface;
-  std::shared_ptr<std::vector<IndexSourceLink>> m_sourceLinks {};
-  std::shared_ptr<IdentifierLink> m_idLinks {};
-  std::shared_ptr<std::vector<Measurement>> m_measurements {};
-  std::shared_ptr<std::vector<const Tracker::FaserSCT_Cluster*>> m_clusters {};
-  std::shared_ptr<std::vector<std::array<std::vector<const Tracker::FaserSCT_Cluster*>, 3>>> m_seedClusters {};
-  std::shared_ptr<std::vector<const Tracker::FaserSCT_SpacePoint*>> m_spacePoints {};
- 
-  std::shared_ptr<std::vector<Seed>> m_seeds {};
-
-  double m_targetZPosition {0};
 
   const FaserSCT_ID* m_idHelper {nullptr};
   const TrackerDD::SCT_DetectorManager* m_detManager {nullptr};
 
   ToolHandle<IFaserActsTrackingGeometryTool> m_trackingGeometryTool { this, "TrackingGeometryTool", "FaserActsTrackingGeometryTool"};
   SG::ReadHandleKey<TrackCollection> m_trackCollection { this, "TrackCollection", "SegmentFit", "Input track collection name" };
-  SG::ReadHandleKey<Tracker::FaserSCT_ClusterContainer> m_clusterContainerKey { this, "ClusterContainer", "SCT_ClusterContainer"};
-  SG::ReadHandleKey<FaserSCT_SpacePointContainer> m_spacePointContainerKey { this, "SpacePoints", "SCT_SpacePointContainer"};
+  SG::ReadHandleKey<FaserActsMeasurementStore> m_measurementStoreKey { this, "MeasurementStore", "FaserActsMeasurementStore", "Measurements of all clusters, filled by MeasurementStoreAlg" };
   // SG::ReadHandleKey<McEventCollection> m_mcEventCollectionKey { this, "McEventCollection", "TruthEvent"};
   // SG::ReadHandleKey<TrackerSimDataCollection> m_simDataCollectionKey { this, "TrackerSimDataCollection", "SCT_SDO_Map"};
 
@@ -135,56 +115,16 @@ private:
   Gaudi::Property<double> m_covQOverP {this, "covQOverP", 1};
   Gaudi::Property<double> m_covTime {this, "covTime", 1};
   Gaudi::Property<bool> m_removeIFT{this, "removeIFT", false};
+  // windows in the x-z view between the segments of a seed, a value <= 0 disables the check
+  Gaudi::Property<double> m_maxSlopeDifferenceX {this, "maxSlopeDifferenceX", 0.1, "Maximum difference of dx/dz between two segments of a seed"};
+  Gaudi::Property<double> m_maxResidualX {this, "maxResidualX", 50., "Maximum distance in x [mm] of a segment to the extrapolation of the previous one"};
+  Gaudi::Property<size_t> m_maxSeeds {this, "maxSeeds", 20000, "Maximum number of seed fits per event"};
+
+  mutable std::atomic<size_t> m_numberOfEvents {0};
+  mutable std::atomic<size_t> m_numberOfSeedFits {0};
+  mutable std::atomic<size_t> m_numberOfRejectedCombinations {0};
+  mutable std::atomic<size_t> m_numberOfCappedEvents {0};
+  mutable std::atomic<size_t> m_seedingTime {0};
 };
 
-
-inline const std::shared_ptr<std::vector<CircleFitTrackSeedTool::Seed>> 
-CircleFitTrackSeedTool::seeds() const {
-  return m_seeds;
-}
-
-inline const std::shared_ptr<std::vector<Acts::BoundTrackParameters>>
-CircleFitTrackSeedTool::initialTrackParameters() const {
-  return m_initialTrackParameters;
-}
-
-inline const std::shared_ptr<const Acts::Surface>
-CircleFitTrackSeedTool::initialSurface() const {
-  return m_initialSurface;
-}
-
-inline const std::shared_ptr<std::vector<IndexSourceLink>>
-CircleFitTrackSeedTool::sourceLinks() const {
-  return m_sourceLinks;
-}
-
-inline const std::shared_ptr<IdentifierLink>
-CircleFitTrackSeedTool::idLinks() const {
-  return m_idLinks;
-}
-
-inline const std::shared_ptr<std::vector<Measurement>>
-CircleFitTrackSeedTool::measurements() const {
-  return m_measurements;
-}
-
-inline const std::shared_ptr<std::vector<const Tracker::FaserSCT_Cluster*>>
-CircleFitTrackSeedTool::clusters() const {
-  return m_clusters;
-}
-
-inline const std::shared_ptr<std::vector<std::array<std::vector<const Tracker::FaserSCT_Cluster*>, 3>>>
-CircleFitTrackSeedTool::seedClusters() const {
-  return m_seedClusters;
-}
-
-inline const std::shared_ptr<std::vector<const Tracker::FaserSCT_SpacePoint*>>
-CircleFitTrackSeedTool::spacePoints() const {
-  return m_spacePoints;
-}
-
-inline double CircleFitTrackSeedTool::targetZPosition() const {
-  return m_targetZPosition;
-}
-
 #endif  // FASERACTSKALMANFILTER_CIRCLEFITTRACKSEEDTOOL_H
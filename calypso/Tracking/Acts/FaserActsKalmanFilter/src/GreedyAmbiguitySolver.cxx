@@ -0,0 +1,50 @@
+#include "GreedyAmbiguitySolver.h"
+
+#include <algorithm>
+
+
+GreedyAmbiguitySolver::GreedyAmbiguitySolver(size_t nHits) : m_hitCandidates(nHits) {}
+
+
+void GreedyAmbiguitySolver::addCandidate(const boost::dynamic_bitset<>& hits, bool passed) {
+  const size_t candidate = m_candidateHits.size();
+  std::vector<size_t> candidateHits;
+  candidateHits.reserve(hits.count());
+  for (size_t hit = hits.find_first(); hit != boost::dynamic_bitset<>::npos; hit = hits.find_next(hit)) {
+    if (hit >= m_hitCandidates.size()) m_hitCandidates.resize(hit + 1);
+    // candidates are added in order, so the lists stay sorted
+    m_hitCandidates[hit].push_back(candidate);
+    candidateHits.push_back(hit);
+  }
+  m_candidateHits.push_back(std::move(candidateHits));
+  m_passed.push_back(passed);
+}
+
+
+std::vector<size_t> GreedyAmbiguitySolver::solve(size_t maxSharedHits) const {
+  const size_t nCandidates = m_candidateHits.size();
+  std::vector<size_t> selected {};
+  std::vector<bool> removed(nCandidates, false);
+  std::vector<size_t> sharedHits(nCandidates, 0);
+  std::vector<size_t> touched {};
+
+  for (size_t i = 0; i < nCandidates; ++i) {
+    if (removed[i] || (!selected.empty() && !m_passed[i])) continue;
+    selected.push_back(i);
+
+    // count the hits shared with the following candidates
+    for (size_t hit : m_candidateHits[i]) {
+      const std::vector<size_t>& candidates = m_hitCandidates[hit];
+      for (auto it = std::upper_bound(candidates.begin(), candidates.end(), i); it != candidates.end(); ++it) {
+        if (removed[*it]) continue;
+        if (sharedHits[*it]++ == 0) touched.push_back(*it);
+      }
+    }
+    for (size_t j : touched) {
+      if (sharedHits[j] > maxSharedHits) removed[j] = true;
+      sharedHits[j] = 0;
+    }
+    touched.clear();
+  }
+  return selected;
+}
@@ -0,0 +1,35 @@
+#ifndef FASERACTSKALMANFILTER_GREEDYAMBIGUITYSOLVER_H
+#define FASERACTSKALMANFILTER_GREEDYAMBIGUITYSOLVER_H
+
+#include <boost/dynamic_bitset.hpp>
+#include <cstddef>
+#include <vector>
+
+/**
+ * Greedy selection of tracks or seeds which do not share too many hits.
+ *
+ * The candidates have to be added in order of decreasing quality. The first
+ * candidate is always selected, after that a candidate is selected if it
+ * passed the quality cut and shares at most maxSharedHits hits with every
+ * candidate selected before it. The hits of each candidate are kept in a
+ * hit to candidate index, so that a selection only visits the candidates
+ * which share at least one hit with it.
+ */
+class GreedyAmbiguitySolver {
+public:
+  explicit GreedyAmbiguitySolver(size_t nHits);
+
+  void addCandidate(const boost::dynamic_bitset<>& hits, bool passed = true);
+
+  // indices of the selected candidates, in the order they were added
+  std::vector<size_t> solve(size_t maxSharedHits) const;
+
+  size_t size() const { return m_candidateHits.size(); }
+
+private:
+  std::vector<std::vector<size_t>> m_candidateHits;
+  std::vector<std::vector<size_t>> m_hitCandidates;
+  std::vector<bool> m_passed;
+};
+
+#endif  // FASERACTSKALMANFILTER_GREEDYAMBIGUITYSOLVER_H
@@ -9,6 +9,7 @@
 #include "Acts/TrackFitting/GainMatrixSmoother.hpp"
 #include "Acts/TrackFitting/GainMatrixUpdater.hpp"
 #include "TrackerIdentifier/FaserSCT_ID.h"
+#include "StoreGate/ReadHandle.h"
 
 #include "TrackerRIO_OnTrack/FaserSCT_ClusterOnTrack.h"
 
@@ -19,6 +20,7 @@ KalmanFitterTool::KalmanFitterTool(const std::string& type, const std::string& n
 
 StatusCode KalmanFitterTool::initialize() {
   ATH_CHECK(m_fieldCondObjInputKey.initialize());
+  ATH_CHECK(m_measurementStoreKey.initialize(!m_measurementStoreKey.empty()));
   ATH_CHECK(m_trackingGeometryTool.retrieve());
   ATH_CHECK(m_createTrkTrackTool.retrieve());
   ATH_CHECK(detStore()->retrieve(m_idHelper,"FaserSCT_ID"));
@@ -365,7 +367,17 @@ KalmanFitterTool::fit(const EventContext &ctx, const Acts::GeometryContext &gctx
   Acts::MagneticFieldContext mfContext = getMagneticFieldContext(ctx);
   Acts::CalibrationContext calibContext = Acts::CalibrationContext();
 
-  auto [sourceLinks, measurements] = getMeasurementsFromTrack(inputTrack);
+  const FaserActsMeasurementStore* store = nullptr;
+  if (!m_measurementStoreKey.empty()) {
+    SG::ReadHandle<FaserActsMeasurementStore> storeHandle {m_measurementStoreKey, ctx};
+    if (!storeHandle.isValid()) {
+      ATH_MSG_ERROR("Failed to retrieve " << m_measurementStoreKey.key());
+      return nullptr;
+    }
+    store = storeHandle.cptr();
+  }
+
+  auto [sourceLinks, measurements] = getMeasurementsFromTrack(inputTrack, store);
   auto trackParameters = getParametersFromTrack(inputTrack->trackParameters()->front(), inputVector, origin);
   //Inflate the covariance of the starting track parameters
   //@todo: make the inflation configurable
@@ -529,7 +541,7 @@ KalmanFitterTool::getMeasurementsFromTrack(Trk::Track *track, Identifier& /*wafe
   return std::make_tuple(sourceLinks, measurements);
 }
 std::tuple<std::vector<IndexSourceLink>, std::vector<Measurement>>
-KalmanFitterTool::getMeasurementsFromTrack(Trk::Track *track) const {
+KalmanFitterTool::getMeasurementsFromTrack(Trk::Track *track, const FaserActsMeasurementStore* store) const {
   const int kSize = 1;
   std::array<Acts::BoundIndices, kSize> Indices = {Acts::eBoundLoc0};
   using ThisMeasurement = Acts::Measurement<Acts::BoundIndices, kSize>;
@@ -543,16 +555,23 @@ KalmanFitterTool::getMeasurementsFromTrack(Trk::Track *track) const {
     const Tracker::FaserSCT_Cluster* cluster = clusterOnTrack->prepRawData();
     if (clusterOnTrack) {
       Identifier id = clusterOnTrack->identify();
-      Identifier waferId = m_idHelper->wafer_id(id);
-      if (identifierMap->count(waferId) != 0) {
-        Acts::GeometryIdentifier geoId = identifierMap->at(waferId);
-        IndexSourceLink sourceLink(geoId, measurements.size(), cluster);
-        Eigen::Matrix<double, 1, 1> pos {meas->localParameters()[Trk::locX],};
-        Eigen::Matrix<double, 1, 1> cov {0.08 * 0.08 / 12};
-        ThisMeasurement actsMeas(Acts::SourceLink{std::move(sourceLink)}, Indices, pos, cov);
-        sourceLinks.push_back(sourceLink);
-        measurements.emplace_back(std::move(actsMeas));
+      Acts::GeometryIdentifier geoId;
+      if (store) {
+        // position and error are refitted values, only the surface comes from the store
+        auto index = store->indexMap.find(id);
+        if (index == store->indexMap.end()) continue;
+        geoId = store->sourceLinks[index->second].geometryId();
+      } else {
+        Identifier waferId = m_idHelper->wafer_id(id);
+        if (identifierMap->count(waferId) == 0) continue;
+        geoId = identifierMap->at(waferId);
       }
+      IndexSourceLink sourceLink(geoId, measurements.size(), cluster);
+      Eigen::Matrix<double, 1, 1> pos {meas->localParameters()[Trk::locX],};
+      Eigen::Matrix<double, 1, 1> cov {0.08 * 0.08 / 12};
+      ThisMeasurement actsMeas(Acts::SourceLink{std::move(sourceLink)}, Indices, pos, cov);
+      sourceLinks.push_back(sourceLink);
+      measurements.emplace_back(std::move(actsMeas));
     }
   }
   return std::make_tuple(sourceLinks, measurements);
@@ -3,12 +3,14 @@
 
 #include "TrackerPrepRawData/FaserSCT_ClusterContainer.h"
 #include "AthenaBaseComps/AthAlgTool.h"
+#include "StoreGate/ReadHandleKey.h"
 #include "Acts/EventData/TrackParameters.hpp"
 #include "Acts/TrackFitting/KalmanFitter.hpp"
 #include "Acts/EventData/MeasurementHelpers.hpp"
 #include "FaserActsGeometryInterfaces/IFaserActsTrackingGeometryTool.h"
 #include "FaserActsKalmanFilter/IndexSourceLink.h"
 #include "FaserActsKalmanFilter/Measurement.h"
+#include "FaserActsKalmanFilter/FaserActsMeasurementStore.h"
 #include "FaserActsRecMultiTrajectory.h"
 #include "MagFieldConditions/FaserFieldCacheCondObj.h"
 #include "RootTrajectoryStatesWriterTool.h"
@@ -71,7 +73,7 @@ public:
 private:
   const FaserSCT_ID* m_idHelper {nullptr};
   std::tuple<std::vector<IndexSourceLink>, std::vector<Measurement>>
-  getMeasurementsFromTrack(Trk::Track *track) const;
+  getMeasurementsFromTrack(Trk::Track *track, const FaserActsMeasurementStore* store = nullptr) const;
   std::tuple<std::vector<IndexSourceLink>, std::vector<Measurement>>
   getMeasurementsFromTrack(Trk::Track *track, Identifier& wafer_id) const;
   std::tuple<std::vector<IndexSourceLink>, std::vector<Measurement>>
@@ -88,6 +90,7 @@ private:
   Gaudi::Property<bool> m_noDiagnostics {this, "noDiagnostics", true, "Set ACTS logging level to INFO and do not run performance writer, states writer or summary writer"};
 
   SG::ReadCondHandleKey<FaserFieldCacheCondObj> m_fieldCondObjInputKey {this, "FaserFieldCacheCondObj", "fieldCondObj", "Name of the Magnetic Field conditions object key"};
+  SG::ReadHandleKey<FaserActsMeasurementStore> m_measurementStoreKey {this, "MeasurementStore", "", "Optional measurement store used to look up the surfaces of the clusters"};
   ToolHandle<IFaserActsTrackingGeometryTool> m_trackingGeometryTool {this, "TrackingGeometryTool", "FaserActsTrackingGeometryTool"};
   ToolHandle<RootTrajectoryStatesWriterTool> m_trajectoryStatesWriterTool {this, "RootTrajectoryStatesWriterTool", "RootTrajectoryStatesWriterTool"};
   ToolHandle<RootTrajectorySummaryWriterTool> m_trajectorySummaryWriterTool {this, "RootTrajectorySummaryWriterTool", "RootTrajectorySummaryWriterTool"};
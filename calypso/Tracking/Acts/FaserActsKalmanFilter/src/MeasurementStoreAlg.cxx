@@ -0,0 +1,80 @@
+#include "MeasurementStoreAlg.h"
+
+#include "StoreGate/ReadHandle.h"
+#include "StoreGate/WriteHandle.h"
+#include "TrackerIdentifier/FaserSCT_ID.h"
+#include "TrackerPrepRawData/FaserSCT_Cluster.h"
+#include "TrackerSpacePoint/FaserSCT_SpacePoint.h"
+#include "Acts/Geometry/GeometryIdentifier.hpp"
+
+
+MeasurementStoreAlg::MeasurementStoreAlg(const std::string& name, ISvcLocator* pSvcLocator) :
+    AthReentrantAlgorithm(name, pSvcLocator) {}
+
+
+StatusCode MeasurementStoreAlg::initialize() {
+  ATH_CHECK(detStore()->retrieve(m_idHelper, "FaserSCT_ID"));
+  ATH_CHECK(m_trackingGeometryTool.retrieve());
+  ATH_CHECK(m_clusterContainerKey.initialize());
+  ATH_CHECK(m_spacePointContainerKey.initialize());
+  ATH_CHECK(m_measurementStoreKey.initialize());
+  return StatusCode::SUCCESS;
+}
+
+
+StatusCode MeasurementStoreAlg::execute(const EventContext& ctx) const {
+  SG::ReadHandle<Tracker::FaserSCT_ClusterContainer> clusterContainer {m_clusterContainerKey, ctx};
+  ATH_CHECK(clusterContainer.isValid());
+
+  SG::ReadHandle<FaserSCT_SpacePointContainer> spacePointContainer {m_spacePointContainerKey, ctx};
+  ATH_CHECK(spacePointContainer.isValid());
+
+  using IdentifierMap = std::map<Identifier, Acts::GeometryIdentifier>;
+  std::shared_ptr<IdentifierMap> identifierMap = m_trackingGeometryTool->getIdentifierMap();
+
+  auto store = std::make_unique<FaserActsMeasurementStore>();
+
+  for (const FaserSCT_SpacePointCollection* spacePointCollection : *spacePointContainer) {
+    for (const Tracker::FaserSCT_SpacePoint *spacePoint: *spacePointCollection) {
+      store->spacePoints.push_back(spacePoint);
+      store->spacePointMap[spacePoint->cluster1()->identify()] = spacePoint;
+      store->spacePointMap[spacePoint->cluster2()->identify()] = spacePoint;
+    }
+  }
+
+  using ThisMeasurement = Acts::Measurement<Acts::BoundIndices, 1>;
+  std::array<Acts::BoundIndices, 1> Indices = {Acts::eBoundLoc0};
+  Eigen::Matrix<double, 1, 1> cov {m_std_cluster * m_std_cluster,};
+  for (const Tracker::FaserSCT_ClusterCollection* clusterCollection : *clusterContainer) {
+    for (const Tracker::FaserSCT_Cluster* cluster : *clusterCollection) {
+      store->clusters.push_back(cluster);
+      Identifier id = cluster->detectorElement()->identify();
+      auto geoId = identifierMap->find(id);
+      if (geoId == identifierMap->end()) continue;
+      Index index = store->measurements.size();
+      IndexSourceLink sourceLink(geoId->second, index, cluster);
+      Eigen::Matrix<double, 1, 1> pos {cluster->localPosition().x(),};
+      store->measurements.emplace_back(ThisMeasurement(Acts::SourceLink{sourceLink}, Indices, pos, cov));
+      store->sourceLinks.push_back(sourceLink);
+      store->layers.push_back(3 * m_idHelper->station(id) + m_idHelper->layer(id));
+      store->indexMap[cluster->identify()] = index;
+    }
+  }
+
+  // the unmasked view and the one used by the CKF passes without IFT
+  for (uint32_t mask : {0u, FaserActsMeasurementStore::layerMask(m_maskedLayers)}) {
+    if (store->views.count(mask) > 0) continue;
+    store->fillSourceLinkContainer(mask, store->views[mask]);
+  }
+  ATH_MSG_DEBUG("Measurement store with " << store->measurements.size() << " measurements from "
+                << store->clusters.size() << " clusters");
+
+  SG::WriteHandle<FaserActsMeasurementStore> measurementStore {m_measurementStoreKey, ctx};
+  ATH_CHECK(measurementStore.record(std::move(store)));
+  return StatusCode::SUCCESS;
+}
+
+
+StatusCode MeasurementStoreAlg::finalize() {
+  return StatusCode::SUCCESS;
+}
@@ -0,0 +1,41 @@
+#ifndef FASERACTSKALMANFILTER_MEASUREMENTSTOREALG_H
+#define FASERACTSKALMANFILTER_MEASUREMENTSTOREALG_H
+
+#include "AthenaBaseComps/AthReentrantAlgorithm.h"
+#include "StoreGate/ReadHandleKey.h"
+#include "StoreGate/WriteHandleKey.h"
+#include "TrackerPrepRawData/FaserSCT_ClusterContainer.h"
+#include "TrackerSpacePoint/FaserSCT_SpacePointContainer.h"
+#include "FaserActsGeometryInterfaces/IFaserActsTrackingGeometryTool.h"
+#include "FaserActsKalmanFilter/FaserActsMeasurementStore.h"
+#include <vector>
+
+class FaserSCT_ID;
+
+/**
+ * Build the Acts measurements of all SCT clusters once per event, so that
+ * the CKF2 passes and their seed and fitter tools do not each redo it.
+ */
+class MeasurementStoreAlg : public AthReentrantAlgorithm {
+public:
+  MeasurementStoreAlg(const std::string& name, ISvcLocator* pSvcLocator);
+  virtual ~MeasurementStoreAlg() = default;
+
+  virtual StatusCode initialize() override;
+  virtual StatusCode execute(const EventContext& ctx) const override;
+  virtual StatusCode finalize() override;
+
+private:
+  const FaserSCT_ID* m_idHelper {nullptr};
+
+  ToolHandle<IFaserActsTrackingGeometryTool> m_trackingGeometryTool {this, "TrackingGeometryTool", "FaserActsTrackingGeometryTool"};
+  SG::ReadHandleKey<Tracker::FaserSCT_ClusterContainer> m_clusterContainerKey {this, "ClusterContainer", "SCT_ClusterContainer"};
+  SG::ReadHandleKey<FaserSCT_SpacePointContainer> m_spacePointContainerKey {this, "SpacePoints", "SCT_SpacePointContainer"};
+  SG::WriteHandleKey<FaserActsMeasurementStore> m_measurementStoreKey {this, "MeasurementStore", "FaserActsMeasurementStore", "Output measurement store"};
+
+  // position resolution of a cluster
+  Gaudi::Property<double> m_std_cluster {this, "std_cluster", 0.0231};
+  Gaudi::Property<std::vector<int>> m_maskedLayers {this, "maskedLayers", {0, 1, 2}, "Layers of the extra source link view, 3 * station + layer"};
+};
+
+#endif // FASERACTSKALMANFILTER_MEASUREMENTSTOREALG_H
@@ -111,6 +111,7 @@ StatusCode RootSeedWriterTool::finalize() {
 
 
 StatusCode RootSeedWriterTool::write(const Acts::GeometryContext& geoContext, const std::vector<CircleFitTrackSeedTool::Seed> &seeds, bool isMC) const {
+  std::lock_guard<std::mutex> lock(m_writeMutex);
   EventContext ctx = Gaudi::Hive::currentContext();
 
   std::shared_ptr<TrackerSimDataCollection> simData {nullptr};
@@ -20,6 +20,7 @@
 #include"CircleFitTrackSeedTool.h"
 #include<string>
 #include<vector>
+#include<mutex>
 
 class TFile;
 class TTree;
@@ -53,6 +54,7 @@ private:
   
   TFile* m_outputFile;
   TTree* m_outputTree;
+  mutable std::mutex m_writeMutex;  ///< serialises writes to the tree from concurrent events
 
   mutable std::vector<double> m_truth_pdg;
   mutable std::vector<double> m_truth_barcode;
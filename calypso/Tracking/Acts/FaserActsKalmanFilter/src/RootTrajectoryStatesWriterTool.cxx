@@ -270,6 +270,7 @@ StatusCode RootTrajectoryStatesWriterTool::finalize() {
 }
 
 StatusCode RootTrajectoryStatesWriterTool::write(const Acts::GeometryContext& gctx, const FaserActsTrackContainer& tracks, bool isMC) const {
+  std::lock_guard<std::mutex> lock(m_writeMutex);
   float nan = std::numeric_limits<float>::quiet_NaN();
 
   if (m_outputFile == nullptr)
@@ -12,6 +12,7 @@
 #include <array>
 #include <string>
 #include <vector>
+#include <mutex>
 
 
 class FaserSCT_ID;
@@ -48,6 +49,7 @@ private:
   Gaudi::Property<bool> m_mc {this, "MC", false};
   TFile* m_outputFile;
   TTree* m_outputTree;
+  mutable std::mutex m_writeMutex;  ///< serialises writes to the tree from concurrent events
 
   enum ParameterType { ePredicted, eFiltered, eSmoothed, eUnbiased, eSize };
 
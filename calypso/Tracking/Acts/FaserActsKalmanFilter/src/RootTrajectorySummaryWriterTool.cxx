@@ -143,6 +143,7 @@ StatusCode RootTrajectorySummaryWriterTool::finalize() {
 
 StatusCode RootTrajectorySummaryWriterTool::write(
     const Acts::GeometryContext& geoContext, const FaserActsTrackContainer& tracks, bool isMC) const {
+  std::lock_guard<std::mutex> lock(m_writeMutex);
   EventContext ctx = Gaudi::Hive::currentContext();
 
   std::shared_ptr<TrackerSimDataCollection> simData {nullptr};
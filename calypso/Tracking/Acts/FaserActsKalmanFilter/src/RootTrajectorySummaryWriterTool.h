@@ -12,6 +12,7 @@
 #include <array>
 #include <string>
 #include <vector>
+#include <mutex>
 
 class FaserSCT_ID;
 namespace  TrackerDD {
@@ -49,6 +50,7 @@ private:
 
   TFile* m_outputFile;
   TTree* m_outputTree;
+  mutable std::mutex m_writeMutex;  ///< serialises writes to the tree from concurrent events
   mutable uint32_t m_eventNr{0};         ///< The event number
   mutable std::vector<uint32_t> m_trackNr;  ///< The track number in event
 
@@ -0,0 +1,107 @@
+#ifndef FASERACTSKALMANFILTER_SEEDCOMBINATORICS_H
+#define FASERACTSKALMANFILTER_SEEDCOMBINATORICS_H
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+/**
+ * Combinations of track segments in the four tracking stations, as used by
+ * the CircleFitTrackSeedTool.
+ *
+ * Combinations with one segment from each of four stations are tried first.
+ * As long as fewer than two seeds have been fitted, combinations from three,
+ * two and finally single stations are added. A segment is only appended to a
+ * combination if it is compatible in the x-z view, where the tracks are
+ * straight, with the last segment already in it. A window <= 0 disables the
+ * corresponding check.
+ *
+ * The Segment type needs a slopeX member (dx/dz) and a position with x() and
+ * z() accessors. The fit is called with every accepted combination.
+ */
+class SeedCombinatorics {
+public:
+  SeedCombinatorics(double maxSlopeDifferenceX, double maxResidualX, size_t maxSeeds) :
+      m_maxSlopeDifferenceX(maxSlopeDifferenceX), m_maxResidualX(maxResidualX), m_maxSeeds(maxSeeds) {}
+
+  template <typename Segment, typename Fit>
+  void run(const std::array<std::vector<Segment>, 4> &v, Fit &&fit) {
+    std::vector<const Segment*> combination {};
+    for (int k = 4; k > 0; --k) {
+      if (k < 4 && m_fitted >= 2) break;
+      go(v, combination, 0, k, fit);
+    }
+  }
+
+  template <typename Segment>
+  bool compatible(const Segment &first, const Segment &second) const {
+    // the field bends in the y-z plane, in x the segments of a track are on a straight line
+    if (m_maxSlopeDifferenceX > 0 && std::abs(first.slopeX - second.slopeX) > m_maxSlopeDifferenceX) {
+      return false;
+    }
+    if (m_maxResidualX > 0) {
+      double slope = 0.5 * (first.slopeX + second.slopeX);
+      double x = first.position.x() + slope * (second.position.z() - first.position.z());
+      if (std::abs(second.position.x() - x) > m_maxResidualX) return false;
+    }
+    return true;
+  }
+
+  // number of combinations of k segments from the stations starting at offset
+  template <typename Segment>
+  static size_t numberOfCombinations(const std::array<std::vector<Segment>, 4> &v, int offset, int k) {
+    if (k == 0) return 1;
+    size_t n = 0;
+    for (std::size_t i = offset; i < v.size() + 1 - k; ++i) {
+      if (!v[i].empty()) n += v[i].size() * numberOfCombinations(v, i+1, k-1);
+    }
+    return n;
+  }
+
+  // combinations which were considered, including the rejected ones
+  size_t combinations() const { return m_combinations; }
+  size_t rejected() const { return m_rejected; }
+  size_t fitted() const { return m_fitted; }
+  // true if combinations were dropped because maxSeeds was reached
+  bool capped() const { return m_capped; }
+
+private:
+  template <typename Segment, typename Fit>
+  void go(const std::array<std::vector<Segment>, 4> &v, std::vector<const Segment*> &combination,
+          int offset, int k, Fit &fit) {
+    if (k == 0) {
+      m_combinations++;
+      if (m_fitted >= m_maxSeeds) {
+        m_capped = true;
+        return;
+      }
+      fit(combination);
+      m_fitted++;
+      return;
+    }
+    for (std::size_t i = offset; i < v.size() + 1 - k; ++i) {
+      for (const auto& ve : v[i]) {
+        if (!combination.empty() && !compatible(*combination.back(), ve)) {
+          size_t n = numberOfCombinations(v, i+1, k-1);
+          m_combinations += n;
+          m_rejected += n;
+          continue;
+        }
+        combination.push_back(&ve);
+        go(v, combination, i+1, k-1, fit);
+        combination.pop_back();
+      }
+    }
+  }
+
+  double m_maxSlopeDifferenceX;
+  double m_maxResidualX;
+  size_t m_maxSeeds;
+  size_t m_combinations = 0;
+  size_t m_rejected = 0;
+  size_t m_fitted = 0;
+  bool m_capped = false;
+};
+
+#endif  // FASERACTSKALMANFILTER_SEEDCOMBINATORICS_H
@@ -1,7 +1,7 @@
 #include "SeedingAlg.h"
 
 SeedingAlg::SeedingAlg(const std::string& name, ISvcLocator* pSvcLocator) :
-    AthAlgorithm(name, pSvcLocator) {}
+    AthReentrantAlgorithm(name, pSvcLocator) {}
 
 
 StatusCode SeedingAlg::initialize() {
@@ -10,9 +10,9 @@ StatusCode SeedingAlg::initialize() {
 }
 
 
-StatusCode SeedingAlg::execute() {
-  // const EventContext& ctx = Gaudi::Hive::currentContext();
-  ATH_CHECK(m_trackSeedTool->run());
+StatusCode SeedingAlg::execute(const EventContext& ctx) const {
+  std::unique_ptr<const TrackSeedResult> seeds;
+  ATH_CHECK(m_trackSeedTool->run(ctx, seeds));
   return StatusCode::SUCCESS;
 }
 
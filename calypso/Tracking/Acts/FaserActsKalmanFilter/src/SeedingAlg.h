@@ -2,18 +2,17 @@
 #define FASERACTSKALMANFILTER_SEEDINGALG_H
 
 #include "AthenaBaseComps/AthReentrantAlgorithm.h"
-#include "AthenaBaseComps/AthAlgorithm.h"
 #include "FaserActsKalmanFilter/ITrackSeedTool.h"
 #include <boost/dynamic_bitset.hpp>
 
 
-class SeedingAlg : public AthAlgorithm {
+class SeedingAlg : public AthReentrantAlgorithm {
 public:
   SeedingAlg(const std::string& name, ISvcLocator* pSvcLocator);
   virtual ~SeedingAlg() = default;
 
   StatusCode initialize() override;
-  StatusCode execute() override;
+  StatusCode execute(const EventContext& ctx) const override;
   StatusCode finalize() override;
 
 private:
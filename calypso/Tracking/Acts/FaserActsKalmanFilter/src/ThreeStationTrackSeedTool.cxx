@@ -23,12 +23,13 @@ StatusCode ThreeStationTrackSeedTool::initialize() {
 }
 
 
-StatusCode ThreeStationTrackSeedTool::run(std::vector<int> /*maskedLayers*/, bool /*backward*/) {
+StatusCode ThreeStationTrackSeedTool::run(const EventContext& ctx, std::unique_ptr<const TrackSeedResult>& result,
+                       const std::vector<int>& /*maskedLayers*/, bool /*backward*/) const {
   // create track seeds for multiple tracks
-  SG::ReadHandle<TrackCollection> trackCollection {m_trackCollection};
+  SG::ReadHandle<TrackCollection> trackCollection {m_trackCollection, ctx};
   ATH_CHECK(trackCollection.isValid());
 
-  SG::ReadHandle<Tracker::FaserSCT_ClusterContainer> clusterContainer {m_clusterContainerKey};
+  SG::ReadHandle<Tracker::FaserSCT_ClusterContainer> clusterContainer {m_clusterContainerKey, ctx};
   ATH_CHECK(clusterContainer.isValid());
 
   using IdentifierMap = std::map<Identifier, Acts::GeometryIdentifier>;
@@ -104,14 +105,16 @@ StatusCode ThreeStationTrackSeedTool::run(std::vector<int> /*maskedLayers*/, boo
     }
   }
 
-  m_initialTrackParameters = std::make_shared<std::vector<Acts::BoundTrackParameters>>(initParams);
-  m_sourceLinks = std::make_shared<std::vector<IndexSourceLink>>(sourceLinks);
-  m_idLinks = std::make_shared<IdentifierLink>(identifierLinkMap);
-  m_measurements = std::make_shared<std::vector<Measurement>>(measurements);
-  m_initialSurface = Acts::Surface::makeShared<Acts::PlaneSurface>(
+  auto seedResult = std::make_unique<TrackSeedResult>();
+  seedResult->initialTrackParameters = std::make_shared<std::vector<Acts::BoundTrackParameters>>(std::move(initParams));
+  seedResult->sourceLinks = std::make_shared<std::vector<IndexSourceLink>>(std::move(sourceLinks));
+  seedResult->idLinks = std::make_shared<IdentifierLink>(std::move(identifierLinkMap));
+  seedResult->measurements = std::make_shared<std::vector<Measurement>>(std::move(measurements));
+  seedResult->initialSurface = Acts::Surface::makeShared<Acts::PlaneSurface>(
       Acts::Vector3 {0, 0, m_origin}, Acts::Vector3{0, 0, -1});
-  m_clusters = std::make_shared<std::vector<const Tracker::FaserSCT_Cluster*>>(clusters);
-  m_seedClusters = std::make_shared<std::vector<std::array<std::vector<const Tracker::FaserSCT_Cluster*>, 3>>>(seeds);
+  seedResult->clusters = std::make_shared<std::vector<const Tracker::FaserSCT_Cluster*>>(std::move(clusters));
+  seedResult->seedClusters = std::make_shared<std::vector<std::array<std::vector<const Tracker::FaserSCT_Cluster*>, 3>>>(std::move(seeds));
+  result = std::move(seedResult);
 
   return StatusCode::SUCCESS;
 }
@@ -33,6 +33,7 @@
 #include "../TrackTruthMatchingTool.h"
 #include "../FiducialParticleTool.h"
 #include "../RootSeedWriteTool.h"
+#include "../MeasurementStoreAlg.h"
 
 DECLARE_COMPONENT(FaserActsKalmanFilterAlg)
 //#todoDECLARE_COMPONENT(CombinatorialKalmanFilterAlg)
@@ -65,3 +66,4 @@ DECLARE_COMPONENT(GhostBusters)
 DECLARE_COMPONENT(CreateTrkTrackTool)
 DECLARE_COMPONENT(TrackTruthMatchingTool)
 DECLARE_COMPONENT(FiducialParticleTool)
+DECLARE_COMPONENT(MeasurementStoreAlg)
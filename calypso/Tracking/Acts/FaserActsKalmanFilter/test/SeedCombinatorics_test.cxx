@@ -0,0 +1,158 @@
+/*
+  Copyright (C) 2022 CERN for the benefit of the FASER collaboration
+*/
+
+/** @file SeedCombinatorics_test.cxx
+    Unit test of the segment combinations used by the CircleFitTrackSeedTool
+*/
+
+#undef NDEBUG
+#include "SeedCombinatorics.h"
+
+#include <array>
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+  struct Position {
+    double m_x, m_z;
+    double x() const { return m_x; }
+    double z() const { return m_z; }
+  };
+
+  struct Segment {
+    int station;
+    Position position;
+    double slopeX;
+  };
+
+  typedef std::array<std::vector<Segment>, 4> Stations;
+
+  // station z positions, roughly as in the detector
+  const double stationZ[4] = {0., 1200., 1700., 2200.};
+
+  Segment segment(int station, double x, double slopeX) {
+    return Segment{station, Position{x, stationZ[station]}, slopeX};
+  }
+
+  // number of stations of every fitted combination
+  std::vector<size_t> fit(SeedCombinatorics &comb, const Stations &stations) {
+    std::vector<size_t> sizes;
+    comb.run(stations, [&](const std::vector<const Segment*> &combination) {
+      sizes.push_back(combination.size());
+    });
+    return sizes;
+  }
+
+  void testCompatible() {
+    std::cout << "testCompatible\n";
+    SeedCombinatorics comb {0.1, 50., 100};
+    // straight line in x
+    assert(comb.compatible(segment(1, 10., 0.01), segment(2, 15., 0.01)));
+    // slopes differ too much
+    assert(!comb.compatible(segment(1, 10., 0.01), segment(2, 15., 0.2)));
+    // extrapolation misses by more than 50 mm
+    assert(!comb.compatible(segment(1, 10., 0.01), segment(2, 80., 0.01)));
+
+    // windows <= 0 are disabled
+    SeedCombinatorics open {0., 0., 100};
+    assert(open.compatible(segment(1, 10., 0.01), segment(2, 80., 0.2)));
+  }
+
+  void testNumberOfCombinations() {
+    std::cout << "testNumberOfCombinations\n";
+    Stations stations;
+    stations[0] = {segment(0, 0., 0.), segment(0, 1., 0.)};
+    stations[1] = {segment(1, 0., 0.), segment(1, 1., 0.), segment(1, 2., 0.)};
+    stations[3] = {segment(3, 0., 0.)};
+    assert(SeedCombinatorics::numberOfCombinations(stations, 0, 3) == 2*3*1);
+    assert(SeedCombinatorics::numberOfCombinations(stations, 0, 2) == 2*3 + 2*1 + 3*1);
+    assert(SeedCombinatorics::numberOfCombinations(stations, 0, 4) == 0);
+  }
+
+  void testFourStations() {
+    std::cout << "testFourStations\n";
+    // two compatible tracks, no fallback to fewer stations
+    Stations stations;
+    for (int station = 0; station < 4; ++station) {
+      double z = stationZ[station];
+      stations[station] = {segment(station, 0.01*z, 0.01), segment(station, 100. - 0.01*z, -0.01)};
+    }
+    SeedCombinatorics comb {0.1, 50., 100};
+    std::vector<size_t> sizes = fit(comb, stations);
+    assert(sizes == std::vector<size_t>(2, 4));
+    assert(comb.combinations() == 16);
+    assert(comb.rejected() == 14);
+    assert(!comb.capped());
+
+    // without windows all combinations are fitted
+    SeedCombinatorics open {0., 0., 100};
+    assert(fit(open, stations).size() == 16);
+    assert(open.rejected() == 0);
+  }
+
+  void testAllRejected() {
+    std::cout << "testAllRejected\n";
+    // two segments per station, but the x slopes differ between the
+    // stations so that no pair of segments is compatible
+    Stations stations;
+    for (int station = 0; station < 4; ++station) {
+      double slope = 0.3*station;
+      stations[station] = {segment(station, 0., slope), segment(station, 500., slope)};
+    }
+    SeedCombinatorics comb {0.1, 50., 100};
+    std::vector<size_t> sizes = fit(comb, stations);
+    // all 4, 3 and 2 station combinations are rejected, the single
+    // segments are still fitted
+    assert(sizes == std::vector<size_t>(8, 1));
+    assert(comb.fitted() == 8);
+    assert(comb.rejected() == 16 + 32 + 24);
+    assert(comb.combinations() == comb.rejected() + comb.fitted());
+  }
+
+  void testFallback() {
+    std::cout << "testFallback\n";
+    // one four station track, and a three station track whose segment in
+    // the first station does not match
+    Stations stations;
+    for (int station = 0; station < 4; ++station) {
+      stations[station] = {segment(station, 0., 0.)};
+    }
+    stations[1].push_back(segment(1, 300., 0.));
+    stations[2].push_back(segment(2, 300., 0.));
+    stations[3].push_back(segment(3, 300., 0.));
+    SeedCombinatorics comb {0.1, 50., 100};
+    std::vector<size_t> sizes = fit(comb, stations);
+    // a single four station seed falls back to all compatible three
+    // station combinations, but not to two stations
+    assert(sizes == std::vector<size_t>({4, 3, 3, 3, 3, 3}));
+    assert(comb.fitted() == 6);
+  }
+
+  void testCapped() {
+    std::cout << "testCapped\n";
+    Stations stations;
+    for (int station = 0; station < 4; ++station) {
+      stations[station] = {segment(station, 0., 0.), segment(station, 1., 0.), segment(station, 2., 0.)};
+    }
+    SeedCombinatorics comb {0., 0., 10};
+    std::vector<size_t> sizes = fit(comb, stations);
+    assert(sizes.size() == 10);
+    assert(comb.capped());
+    assert(comb.combinations() == 81);
+  }
+
+}
+
+int main() {
+  std::cout << "SeedCombinatorics_test\n";
+  testCompatible();
+  testNumberOfCombinations();
+  testFourStations();
+  testAllRejected();
+  testFallback();
+  testCapped();
+  return 0;
+}
@@ -38,7 +38,9 @@
 // Forward declaration
 class IWaveformDigiConditionsTool;
 
-typedef std::map<Identifier, TH1D*> EvstHistMap;
+// Energy vs. time for each channel, binned like a histogram with
+// under- (first) and overflow (last) entries
+typedef std::map<Identifier, std::vector<double>> EvstHistMap;
 
 ///Interface for waveform digitisation tools
 class IWaveformDigitisationTool : virtual public IAlgTool 
@@ -13,6 +13,8 @@
 #include "ScintReadoutGeometry/ScintDetectorElement.h"
 #include "CaloReadoutGeometry/CaloDetectorElement.h"
 
+#include <algorithm>
+
 // Constructor
 WaveformDigitisationTool::WaveformDigitisationTool(const std::string& type, const std::string& name, const IInterface* parent) :
   base_class(type, name, parent)
@@ -73,34 +75,61 @@ WaveformDigitisationTool::generate_baseline(float mean, float rms) const {
   return m_random->Gaus(mean, rms);
 }
 
+void
+WaveformDigitisationTool::generate_baselines(float mean, float rms, unsigned int n, float* baseline) const {
+  // Same random sequence as calling generate_baseline n times
+  for (unsigned int i=0; i < n; i++) 
+    baseline[i] = m_random->Gaus(mean, rms);
+}
+
 
 /// Fill EvsT histograms
 /// Time should be in ns
 void 
 WaveformDigitisationTool::fill_evst_hist(EvstHistMap& map, const Identifier& id, float time, float energy) const {
 
-  if (map.find(id) == map.end()) {
+  auto& hist = map[id];
+  if (hist.empty()) {
     ATH_MSG_DEBUG("Creating EvsT hist for channel" << id);
     // Start histogram before zero to pick up any early arriving hits
-    map[id] = new TH1D("", "", m_overSamples * (m_digitizerSamples+m_preSamples), -m_digitizerPeriod*m_preSamples, m_digitizerPeriod*m_digitizerSamples);
+    // Bins as TH1D, plus under- and overflow
+    hist.resize(m_overSamples * (m_digitizerSamples+m_preSamples) + 2);
   }
 
   if (time < (-m_digitizerPeriod*m_preSamples))
     ATH_MSG_WARNING("ID " << id << " hit found with time " << time << " E " << energy << "!");
 
-  map[id]->Fill(time, energy);
+  hist[evst_bin(time)] += energy;
 }
 
-/// Delete histograms and clear map
+/// Clear map
 void 
 WaveformDigitisationTool::clear_evst_hist(EvstHistMap& map) const {
+  map.clear();
+}
 
-  // Delete histogram objects
-  for (auto& it : map)
-    delete it.second;
+/// Same bin as TAxis::FindBin for the EvsT histogram range
+unsigned int
+WaveformDigitisationTool::evst_bin(float time) const {
 
-  // Also remove map elements (now null pointers)
-  map.clear();
+  const int nbins = m_overSamples * (m_digitizerSamples+m_preSamples);
+  const double xmin = -m_digitizerPeriod*m_preSamples;
+  const double xmax = m_digitizerPeriod*m_digitizerSamples;
+
+  double x = time;
+  if (x < xmin) return 0;
+  if (!(x < xmax)) return nbins+1;
+  return 1 + int(nbins*(x-xmin)/(xmax-xmin));
+}
+
+double
+WaveformDigitisationTool::evst_bin_center(unsigned int ibin) const {
+
+  const int nbins = m_overSamples * (m_digitizerSamples+m_preSamples);
+  const double xmin = -m_digitizerPeriod*m_preSamples;
+  const double xmax = m_digitizerPeriod*m_digitizerSamples;
+
+  return xmin + (ibin - 0.5) * (xmax-xmin) / nbins;
 }
 
 //template <class HitCollection>
@@ -131,14 +160,86 @@ WaveformDigitisationTool::create_kernel(const EventContext& ctx,
   return kernel;
 }
 
+std::shared_ptr<const WaveformDigitisationTool::KernelTable>
+WaveformDigitisationTool::get_kernel(const EventContext& ctx, 
+				     const ToolHandle<IWaveformDigiConditionsTool>& digiCondTool) const {
+
+  float alpha = digiCondTool->cb_alpha(ctx);
+  float n = digiCondTool->cb_n(ctx);
+  float sigma = digiCondTool->cb_sigma(ctx);
+  float mean = digiCondTool->cb_mean(ctx);
+  float norm = digiCondTool->cb_norm(ctx);
+
+  std::lock_guard<std::mutex> lock(m_kernelMutex);
+
+  // The parameters only change with the conditions IOV
+  if (m_kernel && m_kernel->alpha == alpha && m_kernel->n == n &&
+      m_kernel->sigma == sigma && m_kernel->mean == mean && m_kernel->norm == norm) 
+    return m_kernel;
+
+  ATH_MSG_DEBUG("Tabulating time kernel with alpha " << alpha << " n " << n 
+		<< " sigma " << sigma << " mean " << mean << " norm " << norm);
+
+  auto table = std::make_shared<KernelTable>();
+  table->alpha = alpha;
+  table->n = n;
+  table->sigma = sigma;
+  table->mean = mean;
+  table->norm = norm;
+
+  TF1* kernel = create_kernel(ctx, digiCondTool);
+
+  // Times are calculated as in the per-event evaluation they replace
+  table->digitizer.resize(digitizer_samples());
+  for (unsigned int i=0; i < digitizer_samples(); i++) 
+    table->digitizer[i] = kernel->Eval(m_digitizerPeriod * i);
+
+  table->oversampled.resize(digitizer_samples() * over_samples());
+  for (unsigned int ik=0; ik < table->oversampled.size(); ik++) {
+    float ktime = ik * digitizer_period()/over_samples();
+    table->oversampled[ik] = kernel->Eval(ktime);
+  }
+
+  delete kernel;
+
+  m_kernel = table;
+  return m_kernel;
+}
+
+void
+WaveformDigitisationTool::fill_waveform(const EventContext& ctx,
+					const ToolHandle<IWaveformDigiConditionsTool>& digiCondTool,
+					const double* signal, std::vector<uint16_t>& waveform) const {
+
+  // Random baseline for all samples at once
+  std::vector<float> baseline(digitizer_samples());
+  generate_baselines(digiCondTool->base_mean(ctx), digiCondTool->base_rms(ctx),
+		     digitizer_samples(), baseline.data());
+
+  for (unsigned int i=0; i < digitizer_samples(); i++) {
+
+    // Background only if there is no signal
+    float value = signal ? signal[i] : 0.;
+
+    // Waveform is some random baseline plus a negative signal
+    int ivalue = std::round(baseline[i] - value);
+
+    // Don't let value go below zero
+    if (ivalue < 0) 
+      waveform.push_back(0);
+    else
+      waveform.push_back(ivalue);
+  }
+}
+
 std::map<Identifier, std::vector<uint16_t>>& 
 WaveformDigitisationTool::generate_scint_waveforms(
 		const EventContext& ctx,
 		const ToolHandle<IWaveformDigiConditionsTool>& digiCondTool,
 		const ScintHitCollection* hitCollection) const {
 
-  // Create digitization kernel
-  TF1* kernel = create_kernel(ctx, digiCondTool);
+  // Digitization kernel for the current conditions
+  auto kernel = get_kernel(ctx, digiCondTool);
 
   // Helpers, to be filled below as needed
 
@@ -182,36 +283,22 @@ WaveformDigitisationTool::generate_scint_waveforms(
   } // Done with loop over hits
 
   // Now make waveforms
-  int value;
-  float signal, baseline;
+  std::vector<double> signal(digitizer_samples());
 
-  for (const auto& w : waveforms) {
+  for (auto& w : waveforms) {
 
-    auto id = w.first;
+    float energy = esum[w.first];
 
     // Now fill each entry with the sum of the kernel
     // and some random background
-    for (unsigned int i=0; int(i) < m_digitizerSamples; i++) {
-      signal = kernel->Eval(m_digitizerPeriod * i) * esum[id];
-      baseline = generate_baseline(digiCondTool->base_mean(ctx),
-				   digiCondTool->base_rms(ctx));
-
-      // Waveform is some random baseline plus a negative signal
-      value = std::round(baseline - signal);
-
-      // Don't let value go below zero
-      if (value < 0) 
-	waveforms[id].push_back(0);
-      else
-	waveforms[id].push_back(value);
+    for (unsigned int i=0; i < digitizer_samples(); i++) {
+      signal[i] = kernel->digitizer[i] * energy;
+    }
 
-    } // End of loop over bins
+    fill_waveform(ctx, digiCondTool, signal.data(), w.second);
 
   } // End of loop over channels
 
-  // Clean up after ourselves
-  delete kernel;
-
   return waveforms;
 }
 
@@ -307,11 +394,13 @@ WaveformDigitisationTool::generate_scint_timing_waveforms(
   } // Done with loop over hits
 
   // Debugging printout 
-  for (auto it : evst_hist) {
-    ATH_MSG_DEBUG("Nonzero bins Evst hist id = " << it.first);
-    for (unsigned int ibin=0; int(ibin) <= it.second->GetNbinsX(); ibin++) {
-      if (it.second->GetBinContent(ibin) == 0) continue;
-      ATH_MSG_DEBUG(" bin: " << ibin << " t:" << it.second->GetBinCenter(ibin) << " val: " << it.second->GetBinContent(ibin));
+  if (msgLvl(MSG::DEBUG)) {
+    for (const auto& it : evst_hist) {
+      ATH_MSG_DEBUG("Nonzero bins Evst hist id = " << it.first);
+      for (unsigned int ibin=0; ibin+1 < it.second.size(); ibin++) {
+	if (it.second[ibin] == 0) continue;
+	ATH_MSG_DEBUG(" bin: " << ibin << " t:" << evst_bin_center(ibin) << " val: " << it.second[ibin]);
+      }
     }
   }
 
@@ -319,10 +408,12 @@ WaveformDigitisationTool::generate_scint_timing_waveforms(
   convolve_waveforms(ctx, digiCondTool, evst_hist, waveforms);
 
   // Check what we have done
-  for (const auto& w : waveforms) {
-    ATH_MSG_DEBUG("Waveform for ID " << w.first);
-    for(unsigned int i=400; i<450; i++) 
-      ATH_MSG_DEBUG(digitizer_period()*i << "ns -> " << w.second[i]);
+  if (msgLvl(MSG::DEBUG)) {
+    for (const auto& w : waveforms) {
+      ATH_MSG_DEBUG("Waveform for ID " << w.first);
+      for(unsigned int i=400; i<450 && i<w.second.size(); i++) 
+	ATH_MSG_DEBUG(digitizer_period()*i << "ns -> " << w.second[i]);
+    }
   }
 
   // Cleanup
@@ -337,8 +428,8 @@ WaveformDigitisationTool::generate_calo_waveforms(
 		const ToolHandle<IWaveformDigiConditionsTool>& digiCondTool,
 		const CaloHitCollection* hitCollection) const {
 
-  // Create digitization kernel
-  TF1* kernel = create_kernel(ctx, digiCondTool);
+  // Digitization kernel for the current conditions
+  auto kernel = get_kernel(ctx, digiCondTool);
 
   // Helpers, to be filled below as needed
 
@@ -361,36 +452,22 @@ WaveformDigitisationTool::generate_calo_waveforms(
   } // Done with loop over hits
 
   // Now make waveforms
-  int value;
-  float signal, baseline;
+  std::vector<double> signal(digitizer_samples());
 
-  for (const auto& w : waveforms) {
+  for (auto& w : waveforms) {
 
-    auto id = w.first;
+    float energy = esum[w.first];
 
     // Now fill each entry with the sum of the kernel
     // and some random background
-    for (unsigned int i=0; int(i) < m_digitizerSamples; i++) {
-      signal = kernel->Eval(m_digitizerPeriod * i) * esum[id];
-      baseline = generate_baseline(digiCondTool->base_mean(ctx),
-				   digiCondTool->base_rms(ctx));
-
-      // Waveform is some random baseline plus a negative signal
-      value = std::round(baseline - signal);
-
-      // Don't let value go below zero
-      if (value < 0) 
-	waveforms[id].push_back(0);
-      else
-	waveforms[id].push_back(value);
+    for (unsigned int i=0; i < digitizer_samples(); i++) {
+      signal[i] = kernel->digitizer[i] * energy;
+    }
 
-    } // End of loop over bins
+    fill_waveform(ctx, digiCondTool, signal.data(), w.second);
 
   } // End of loop over channels
 
-  // Clean up after ourselves
-  delete kernel;
-
   return waveforms;
 }
 
@@ -442,11 +519,13 @@ WaveformDigitisationTool::generate_calo_timing_waveforms(
   } // Done with loop over hits
 
   // Debugging printout 
-  for (auto it : evst_hist) {
-    ATH_MSG_DEBUG("Nonzero bins Evst hist id = " << it.first);
-    for (unsigned int ibin=0; int(ibin) <= it.second->GetNbinsX(); ibin++) {
-      if (it.second->GetBinContent(ibin) == 0) continue;
-      ATH_MSG_DEBUG(" bin: " << ibin << " t:" << it.second->GetBinCenter(ibin) << " val: " << it.second->GetBinContent(ibin));
+  if (msgLvl(MSG::DEBUG)) {
+    for (const auto& it : evst_hist) {
+      ATH_MSG_DEBUG("Nonzero bins Evst hist id = " << it.first);
+      for (unsigned int ibin=0; ibin+1 < it.second.size(); ibin++) {
+	if (it.second[ibin] == 0) continue;
+	ATH_MSG_DEBUG(" bin: " << ibin << " t:" << evst_bin_center(ibin) << " val: " << it.second[ibin]);
+      }
     }
   }
 
@@ -454,10 +533,12 @@ WaveformDigitisationTool::generate_calo_timing_waveforms(
   convolve_waveforms(ctx, digiCondTool, evst_hist, waveforms);
 
   // Check what we have done
-  for (const auto& w : waveforms) {
-    ATH_MSG_DEBUG("Waveform for ID " << w.first);
-    for(unsigned int i=400; i<450; i++) 
-      ATH_MSG_DEBUG(digitizer_period()*i << "ns -> " << w.second[i]);
+  if (msgLvl(MSG::DEBUG)) {
+    for (const auto& w : waveforms) {
+      ATH_MSG_DEBUG("Waveform for ID " << w.first);
+      for(unsigned int i=400; i<450 && i<w.second.size(); i++) 
+	ATH_MSG_DEBUG(digitizer_period()*i << "ns -> " << w.second[i]);
+    }
   }
 
   // Cleanup
@@ -508,11 +589,18 @@ WaveformDigitisationTool::convolve_waveforms(
     std::map<Identifier, std::vector<uint16_t>>& waveforms
 					     ) const {
 
-  // Create digitization kernel
-  TF1* kernel = create_kernel(ctx, digiCondTool);
+  // Digitization kernel for the current conditions, tabulated at the EvsT binning
+  auto kernel = get_kernel(ctx, digiCondTool);
+  const std::vector<double>& ktable = kernel->oversampled;
+
+  // Use this vector to sum our values
+  // We will oversample by the same amount as the Evst histogram
+  const int nwave = digitizer_samples() * over_samples();
+  std::vector<double> dwave(nwave);
+  std::vector<double> dswave(digitizer_samples());
 
   // Convolve Evst histogram vs. kernel for each waveform
-  for (const auto& w : waveforms) {
+  for (auto& w : waveforms) {
 
     auto id = w.first;
 
@@ -524,37 +612,20 @@ WaveformDigitisationTool::convolve_waveforms(
       ATH_MSG_DEBUG("Didn't find EvsT hist for id " << id <<"!");
 
       // Fill waveform with background only as Evst is empty
-      for (unsigned int i=0; i < digitizer_samples(); i++) {
-
-	float baseline = generate_baseline(digiCondTool->base_mean(ctx),
-					   digiCondTool->base_rms(ctx));
-
-	// Waveform is some random baseline
-	int ivalue = std::round(baseline);
-
-	// Don't let value go below zero
-	if (ivalue < 0) 
-	  waveforms[id].push_back(0);
-	else
-	  waveforms[id].push_back(ivalue);
-
-      } // End of loop over digitizer samples
+      fill_waveform(ctx, digiCondTool, nullptr, w.second);
 
       // Done with this waveform
       continue;
     }
 
-    auto h = it->second;
-
-    // Use this vector to sum our values
-    // We will oversample by the same amount as the Evst histogram
-    std::vector<double> dwave(digitizer_samples() * over_samples());
-    // ATH_MSG_DEBUG("Creating dwave with length " << dwave.size());
+    const std::vector<double>& h = it->second;
+    std::fill(dwave.begin(), dwave.end(), 0.);
 
-    // Convolute evst signals with the time kernel
-    for(unsigned int ih=1; int(ih) < h->GetNbinsX(); ih++) {
+    // Convolute evst signals with the tabulated time kernel
+    // Skip the underflow and the last bin, as with the TH1D
+    for(int ih=1; ih+2 < int(h.size()); ih++) {
 
-      float value = h->GetBinContent(ih);
+      float value = h[ih];
 
       // If bin is empty, move on
       if (value <= 0.) continue;
@@ -563,72 +634,26 @@ WaveformDigitisationTool::convolve_waveforms(
       // Histogram doesn't start at t=0, so subtract pre_samples
       int iw = ih - 1 - (pre_samples() * over_samples());
 
-      // Convolute the histogram with the time kernel
-      for (unsigned int ik=0; ik < dwave.size(); ik++) {
-	// Figure out destination bin first, skip if out of range
-	if ((iw + int(ik)) < 0) continue; // add int() to fix comp warnings
-	if ((iw + ik) >= dwave.size()) continue;
-
-	float ktime = ik * digitizer_period()/over_samples();
-	float kval = kernel->Eval(ktime) * value;
-	dwave[iw+ik] += kval;
-
-	// if (kval > 0.01)
-	//   ATH_MSG_DEBUG(" Bin " << ih << " kernel bin " << ik << " time " << ktime << " value " << kval);
+      // Only destination bins inside dwave contribute
+      int first = std::max(0, iw);
+      int last = std::min(nwave, nwave + iw);
+      for (int iwave=first; iwave < last; iwave++) {
+	dwave[iwave] += float(ktable[iwave - iw] * value);
       }
 
     } // Done with convolution
 
-    // Debug printout
-    // ATH_MSG_DEBUG("dwave array for " << id);
-    // unsigned int iw=0;
-    // for (auto v : dwave) {
-    //   iw++;
-    //   if (v <= 0.1) continue;
-    //   ATH_MSG_DEBUG(" bin "<< iw << " val " << v);
-    // }
-
     // Need to down-sample dwave to fit waveform spacing
     // Take average (or sum / over_sampling) to get amplitude correct
-    std::vector<double> dswave(digitizer_samples());
-    // ATH_MSG_DEBUG("Creating dswave with length " << dswave.size());
-
-    for (unsigned int i=0; i < dwave.size(); i++) {
+    std::fill(dswave.begin(), dswave.end(), 0.);
+    for (int i=0; i < nwave; i++) {
       dswave[i/over_samples()] += (dwave[i] / over_samples());
     }
 
-    // Debug printout
-    // ATH_MSG_DEBUG("dswave array for " << id);
-    // iw=0;
-    // for (auto v : dswave) {
-    //   iw++;
-    //   if (v <= 0.1) continue;
-    //   ATH_MSG_DEBUG(" bin "<< iw << " val " << v);
-    // }
-
     // Now fill each entry of the waveform with the down-sampled signal 
     // and some random background
-    for (unsigned int i=0; i < digitizer_samples(); i++) {
-
-      float signal = dswave[i];
-      float baseline = generate_baseline(digiCondTool->base_mean(ctx),
-					 digiCondTool->base_rms(ctx));
-
-      // Waveform is some random baseline plus a negative signal
-      int ivalue = std::round(baseline - signal);
-
-      // Don't let value go below zero
-      if (ivalue < 0) 
-	waveforms[id].push_back(0);
-      else
-	waveforms[id].push_back(ivalue);
-
-    } // End of loop over dswave
+    fill_waveform(ctx, digiCondTool, dswave.data(), w.second);
 
   } // End of loop over channels
 
-  // Clean up after ourselves
-  delete kernel;
-
 }
-
@@ -39,6 +39,8 @@
 #include "TF1.h"
 
 //STL
+#include <memory>
+#include <mutex>
 
 class WaveformDigitisationTool: public extends<AthAlgTool, IWaveformDigitisationTool> {
  public:
@@ -56,6 +58,9 @@ class WaveformDigitisationTool: public extends<AthAlgTool, IWaveformDigitisation
   /// Generate random baseline 
   float generate_baseline(float mean, float rms) const;
 
+  /// Generate random baseline for n samples
+  void generate_baselines(float mean, float rms, unsigned int n, float* baseline) const;
+
   /// Fill EvsT histograms
   void fill_evst_hist(EvstHistMap& map, const Identifier& id, float time, float energy) const;
 
@@ -123,6 +128,26 @@ class WaveformDigitisationTool: public extends<AthAlgTool, IWaveformDigitisation
   TF1* create_kernel(const EventContext& ctx, 
 		     const ToolHandle<IWaveformDigiConditionsTool>& digiCondTool) const;
 
+  /// Time kernel tabulated once for a set of digitization conditions
+  struct KernelTable {
+    float alpha, n, sigma, mean, norm;
+    std::vector<double> digitizer;   // At each digitizer sample
+    std::vector<double> oversampled; // At each EvsT bin
+  };
+
+  /// Kernel for the current conditions, only rebuilt when they change
+  std::shared_ptr<const KernelTable> get_kernel(const EventContext& ctx, 
+		     const ToolHandle<IWaveformDigiConditionsTool>& digiCondTool) const;
+
+  /// EvsT bin for time (in ns), with the same binning as a TH1D
+  unsigned int evst_bin(float time) const;
+  double evst_bin_center(unsigned int ibin) const;
+
+  /// Waveform from the (negative) signal plus random baseline
+  void fill_waveform(const EventContext& ctx,
+		     const ToolHandle<IWaveformDigiConditionsTool>& digiCondTool,
+		     const double* signal, std::vector<uint16_t>& waveform) const;
+
   void convolve_waveforms(
     const EventContext& ctx,
     const ToolHandle<IWaveformDigiConditionsTool>& digiCondTool,
@@ -144,6 +169,10 @@ class WaveformDigitisationTool: public extends<AthAlgTool, IWaveformDigitisation
   const ScintDD::TriggerDetectorManager* m_triggerDetMan{nullptr};
   const ScintDD::PreshowerDetectorManager* m_preshowerDetMan{nullptr};
   const CaloDD::EcalDetectorManager* m_caloDetMan{nullptr};
+
+  /// Cached time kernel
+  mutable std::mutex m_kernelMutex;
+  mutable std::shared_ptr<const KernelTable> m_kernel;
 };
 
 #endif // WAVEDIGITOOLS_WAVEFORMDIGITISATIONTOOL_H
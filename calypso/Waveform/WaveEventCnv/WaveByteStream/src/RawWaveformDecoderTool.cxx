@@ -6,7 +6,9 @@
 #include "AthenaBaseComps/AthAlgTool.h"
 
 #include "WaveRawEvent/RawWaveform.h"
-#include "EventFormats/DigitizerDataFragment.hpp"
+#include "EventFormats/DigitizerDataView.hpp"
+
+#include <optional>
 
 static const InterfaceID IID_IRawWaveformDecoderTool("RawWaveformDecoderTool", 1, 0);
 
@@ -43,44 +45,66 @@ StatusCode
 RawWaveformDecoderTool::convert(const DAQFormats::EventFull* re, 
 				RawWaveformContainer* container,
 				const std::string key,
-				WaveformCableMap cable_map,
-				WaveformRangeMap range_map
+				const WaveformCableMappingCondData& cable_map,
+				const WaveformCalibCondData& calib
 )
 {
-  ATH_MSG_DEBUG("RawWaveformDecoderTool::convert("+key+")");
-
   if (!re) {
     ATH_MSG_ERROR("EventFull passed to convert() is null!");
     return StatusCode::FAILURE;
   }
 
+  // Wraps the fragments the EventFull copied when it was read, without copying them again
+  DAQFormats::EventView view;
+  try {
+    view.load(*re);
+  } catch ( DAQFormats::EFormatException& e ) {
+    ATH_MSG_ERROR("RawWaveformDecoderTool:\n" << e.what());
+    return StatusCode::FAILURE;
+  }
+  return convert(view, container, key, cable_map, calib);
+}
+
+StatusCode
+RawWaveformDecoderTool::convert(const DAQFormats::EventView& view, 
+				RawWaveformContainer* container,
+				const std::string key,
+				const WaveformCableMappingCondData& cable_map,
+				const WaveformCalibCondData& calib
+)
+{
+  ATH_MSG_DEBUG("RawWaveformDecoderTool::convert("+key+")");
+
   if (!container) {
     ATH_MSG_ERROR("RawWaveformContainer passed to convert() is null!");
     return StatusCode::FAILURE;
   }
 
   // Find the Waveform fragment
-  const DigitizerDataFragment* digitizer = NULL;
-  const DigitizerDataFragment* digitizer0 = NULL;
-  const DigitizerDataFragment* digitizer1 = NULL;
-  const DAQFormats::EventFragment* frag = NULL;
+  const DigitizerDataView* digitizer = NULL;
+  const DigitizerDataView* digitizer0 = NULL;
+  const DigitizerDataView* digitizer1 = NULL;
+  const DAQFormats::FragmentView* frag = NULL;
+
+  // Decoded fragments live on the stack and point into the raw event, no samples are copied
+  std::optional<DigitizerDataView> digitizerData0;
+  std::optional<DigitizerDataView> digitizerData1;
   
   // Dump all fragments for debugging
-  // for(const auto &id : re->getFragmentIDs()) {
-  //   frag=re->find_fragment(id);
-  //   ATH_MSG_DEBUG("Fragment:\n" << *frag);
+  // for(const auto &fragment : view) {
+  //   ATH_MSG_DEBUG("Fragment:\n" << fragment);
   // }
   
-  for(const auto &id : re->getFragmentIDs()) {
-    frag=re->find_fragment(id);
+  for(const auto &fragment : view) {
+    frag=&fragment;
 
     if ((frag->source_id()&0xFFFF0000) != DAQFormats::SourceIDs::PMTSourceID) continue;
     ATH_MSG_DEBUG("Found Fragment:\n" << *frag);
 
     if ((frag->source_id()&0x03) == 0)
-      digitizer0 = new DigitizerDataFragment(frag->payload<const uint32_t*>(), frag->payload_size());
+      digitizer0 = &digitizerData0.emplace(frag->payload<const uint32_t*>(), frag->payload_size());
     else if ((frag->source_id()&0x03) == 1)
-      digitizer1 = new DigitizerDataFragment(frag->payload<const uint32_t*>(), frag->payload_size());
+      digitizer1 = &digitizerData1.emplace(frag->payload<const uint32_t*>(), frag->payload_size());
     else
       ATH_MSG_WARNING("Couldn't match digitizer with fragment source id!");
   }
@@ -137,7 +161,7 @@ RawWaveformDecoderTool::convert(const DAQFormats::EventFull* re,
   for (int channel: channelList) {
 
     // Only look at channels we care about
-    if (det_type != cable_map[channel].first) continue;
+    if (det_type != cable_map.type(channel)) continue;
 
     ATH_MSG_DEBUG("Converting channel "+std::to_string(channel)+" for "+key);
 
@@ -157,7 +181,8 @@ RawWaveformDecoderTool::convert(const DAQFormats::EventFull* re,
     RawWaveform* wfm = new RawWaveform();
 
     try {
-      wfm->setWaveform( channel, digitizer->channel_adc_counts( chan ) );
+      DigitizerDataView::SampleSpan counts = digitizer->channel_adc_counts( chan );
+      wfm->setWaveform( channel, counts.data(), counts.size() );
     } catch ( DigitizerData::DigitizerDataException& e ) {
       ATH_MSG_WARNING("RawWaveformDecoderTool:\n"
 		   <<e.what()
@@ -177,12 +202,13 @@ RawWaveformDecoderTool::convert(const DAQFormats::EventFull* re,
     }
 
     // Set ID if one exists (clock, for instance, doesn't have an identifier)
-    if (cable_map.at(channel).second != -1) { // Identifier doesn't have operator>=
-      wfm->setIdentifier(cable_map[channel].second);
+    const Identifier id = cable_map.identifier(channel);
+    if (id != -1) { // Identifier doesn't have operator>=
+      wfm->setIdentifier(id);
     }
 
     // Set ADC range
-    wfm->setRange(range_map.at(channel));
+    wfm->setRange(calib.range(channel));
 
     container->push_back(wfm);    
 
@@ -194,11 +220,6 @@ RawWaveformDecoderTool::convert(const DAQFormats::EventFull* re,
 
   }
 
-  // Don't spring a leak
-  delete digitizer0;
-  if (digitizer1)
-    delete digitizer1;
-  
   ATH_MSG_DEBUG( "RawWaveformDecoderTool created container " << key 
 		 << " with size=" << container->size());
   return StatusCode::SUCCESS; 
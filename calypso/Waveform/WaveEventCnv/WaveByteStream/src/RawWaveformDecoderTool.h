@@ -13,8 +13,8 @@
 #include "EventFormats/DAQFormats.hpp"
 #include "WaveRawEvent/RawWaveformContainer.h"
 
-#include "WaveformConditionsTools/IWaveformCableMappingTool.h"
-#include "WaveformConditionsTools/IWaveformRangeTool.h"
+#include "WaveformConditionsTools/WaveformCableMappingCondData.h"
+#include "WaveformConditionsTools/WaveformCalibCondData.h"
 
 // This class provides conversion between bytestream and Waveform objects
 
@@ -31,7 +31,10 @@ class RawWaveformDecoderTool : public AthAlgTool {
   virtual StatusCode initialize();
   virtual StatusCode finalize();
 
-  StatusCode convert(const DAQFormats::EventFull* re, RawWaveformContainer* wfm, std::string key, WaveformCableMap cable_map, WaveformRangeMap range_map);
+  StatusCode convert(const DAQFormats::EventFull* re, RawWaveformContainer* wfm, std::string key, const WaveformCableMappingCondData& cable_map, const WaveformCalibCondData& calib);
+
+  // Same, from an EventView (currently only built over an EventFull by the overload above)
+  StatusCode convert(const DAQFormats::EventView& view, RawWaveformContainer* wfm, std::string key, const WaveformCableMappingCondData& cable_map, const WaveformCalibCondData& calib);
 
 private:
 };
@@ -93,15 +93,26 @@ StatusCode WaveByteStreamCnv::createObj(IOpaqueAddress* pAddr, DataObject*& pObj
 
   RawWaveformContainer* wfmCont = new RawWaveformContainer;
 
-  // Get mapping tool
-  auto mapping = m_mappingTool->getCableMapping();
-  ATH_MSG_DEBUG("Cable mapping contains " << mapping.size() << " entries");
+  // Get mapping decoded for this IOV
+  const WaveformCableMappingCondData* mapping = m_mappingTool->getCableMappingData();
+  if (!mapping) {
+    ATH_MSG_ERROR("Cannot get waveform cable mapping!");
+    delete wfmCont;
+    return StatusCode::FAILURE;
+  }
+  ATH_MSG_DEBUG("Cable mapping contains " << mapping->size() << " entries");
 
-  auto range = m_rangeTool->getRangeMapping();
-  ATH_MSG_DEBUG("Range contains " << range.size() << " entries");
+  // Ranges compiled for this IOV
+  const WaveformCalibCondData* calib = m_rangeTool->getRangeData();
+  if (!calib) {
+    ATH_MSG_ERROR("Cannot get waveform ranges!");
+    delete wfmCont;
+    return StatusCode::FAILURE;
+  }
+  ATH_MSG_DEBUG("Range table contains " << calib->size() << " channels");
 
   // Convert selected channels
-  CHECK( m_tool->convert(re, wfmCont, key, mapping, range) );
+  CHECK( m_tool->convert(re, wfmCont, key, *mapping, *calib) );
   
   pObj = SG::asStorable(wfmCont);
 
@@ -25,6 +25,7 @@
 #include "Identifier/Identifiable.h"
 
 class DigitizerDataFragment;
+class DigitizerDataView;
 
 class RawWaveform : public Identifiable {
 
@@ -82,7 +83,10 @@ public:
   // Set functions
   void setIdentifier (Identifier id);  // Identifier class
   void setHeader (const DigitizerDataFragment* frag);
-  void setWaveform (unsigned int channel, const std::vector<uint16_t> waveform);
+  void setHeader (const DigitizerDataView* frag);
+  void setWaveform (unsigned int channel, const std::vector<uint16_t>& waveform);
+  // Fill directly from a contiguous range of samples (eg. a DigitizerDataView)
+  void setWaveform (unsigned int channel, const uint16_t* counts, size_t nsamples);
 
   // Set functions for P->T conversion
   void setBoardId(unsigned int id) {m_board_id = id;}
@@ -4,6 +4,7 @@
 
 #include "WaveRawEvent/RawWaveform.h"
 #include "EventFormats/DigitizerDataFragment.hpp"
+#include "EventFormats/DigitizerDataView.hpp"
 
 // Default consdtructor 
 //
@@ -41,14 +42,26 @@ RawWaveform::setHeader(const DigitizerDataFragment* frag) {
 }
 
 void
-RawWaveform::setWaveform(unsigned int channel, const std::vector<uint16_t> waveform) {
-  m_channel = channel;
+RawWaveform::setHeader(const DigitizerDataView* frag) {
+  m_board_id = frag->board_id();
+  m_pattern_trig_options = frag->pattern_trig_options();
+  m_channel_mask = frag->channel_mask();
+  m_event_counter = frag->event_counter();
+  m_trigger_time_tag = frag->trigger_time_tag();
+  m_samples = frag->n_samples();
+}
+
+void
+RawWaveform::setWaveform(unsigned int channel, const std::vector<uint16_t>& waveform) {
+  setWaveform(channel, waveform.data(), waveform.size());
+}
 
-  // Make sure the vector is empty first
-  m_adc_counts.clear();
+void
+RawWaveform::setWaveform(unsigned int channel, const uint16_t* counts, size_t nsamples) {
+  m_channel = channel;
 
-  for(uint16_t count: waveform) 
-    m_adc_counts.push_back(count);
+  // Single widening copy, replaces any previous content
+  m_adc_counts.assign(counts, counts + nsamples);
 }
 
 std::ostream 
@@ -7,6 +7,8 @@ from AthenaConfiguration.ComponentFactory import CompFactory
 
 from OutputStreamAthenaPool.OutputStreamConfig import OutputStreamCfg
 from WaveformConditionsTools.WaveformTimingConfig import WaveformTimingCfg
+from WaveformConditionsTools.WaveformCableMappingConfig import WaveformCableMappingCfg
+from WaveformConditionsTools.WaveformCalibConfig import WaveformCalibCfg
 
 WaveformReconstructionTool = CompFactory.WaveformReconstructionTool
 ClockReconstructionTool = CompFactory.ClockReconstructionTool
@@ -80,6 +82,9 @@ def WaveformHitRecCfg(flags, name="WaveformRecAlg", source="", **kwargs):
     kwargs.setdefault("WaveformHitContainerKey", source+"WaveformHits")
     kwargs.setdefault("WaveformReconstructionTool", tool)
               
+    # Trigger timing compiled once per IOV
+    acc.merge(WaveformCalibCfg(flags))
+
     recoAlg = CompFactory.RawWaveformRecAlg(name, **kwargs)
     recoAlg.WaveformReconstructionTool = tool
     acc.addEventAlgo(recoAlg)
@@ -107,6 +112,8 @@ def PseudoScintHitToWaveformRecCfg(flags, name="PseudoScintHitToWaveformRecAlg",
 
     acc = ComponentAccumulator()
 
+    acc.merge(WaveformCableMappingCfg(flags))
+
     tool = CompFactory.PseudoSimToWaveformRecTool(name=source+"PseudoSimToWaveformRecTool", **kwargs)
     
     kwargs.setdefault("ScintHitContainerKey", source+"Hits")
@@ -126,6 +133,8 @@ def PseudoCaloHitToWaveformRecCfg(flags, name="PseudoCaloHitToWaveformRecAlg", *
 
     acc = ComponentAccumulator()
 
+    acc.merge(WaveformCableMappingCfg(flags))
+
     tool = CompFactory.PseudoSimToWaveformRecTool(name="CaloPseudoSimToWaveformRecTool", **kwargs)
     
     kwargs.setdefault("CaloHitContainerKey", "EcalHits")
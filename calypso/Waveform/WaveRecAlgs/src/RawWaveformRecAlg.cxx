@@ -1,5 +1,7 @@
 #include "RawWaveformRecAlg.h"
 
+#include "StoreGate/ReadCondHandle.h"
+
 RawWaveformRecAlg::RawWaveformRecAlg(const std::string& name, 
 					 ISvcLocator* pSvcLocator)
   : AthReentrantAlgorithm(name, pSvcLocator) { 
@@ -19,6 +21,9 @@ RawWaveformRecAlg::initialize() {
   // Set key to read clock info
   ATH_CHECK( m_clockKey.initialize() );
 
+  // Set key to read timing calibration
+  ATH_CHECK( m_calibKey.initialize() );
+
   // Set key to write container
   ATH_CHECK( m_waveformHitContainerKey.initialize() );
 
@@ -68,19 +73,15 @@ RawWaveformRecAlg::execute(const EventContext& ctx) const {
     return StatusCode::SUCCESS;
   }
 
-  // First reconstruct the primary hit (based on trigger time)
-  for( const auto& wave : *waveformHandle) {
-    ATH_MSG_DEBUG("Reconstruct primary waveform for channel " << wave->channel());
-    CHECK( m_recoTool->reconstructPrimary(*wave, hitContainerHandle.ptr()) );
-  }
+  // Trigger timing for this IOV
+  SG::ReadCondHandle<WaveformCalibCondData> calibHandle(m_calibKey, ctx);
+  ATH_CHECK( calibHandle.isValid() );
+  const WaveformCalibCondData& calib = **calibHandle;
 
-  // Second, reconstruct any additional out of time hits
-  if (m_findMultipleHits) {
-    for( const auto& wave : *waveformHandle) {
-      ATH_MSG_DEBUG("Reconstruct secondary waveform for channel " << wave->channel());
-      CHECK( m_recoTool->reconstructSecondary(*wave, hitContainerHandle.ptr()) );
-    }
-  }
+  // Reconstruct the primary hits (based on trigger time) of all channels, 
+  // then any additional out of time hits
+  ATH_MSG_DEBUG("Reconstruct " << waveformHandle->size() << " waveforms");
+  CHECK( m_recoTool->reconstructAll(*waveformHandle, hitContainerHandle.ptr(), m_findMultipleHits, calib) );
 
   // Also find the clock information
   SG::ReadHandle<xAOD::WaveformClock> clockHandle(m_clockKey, ctx);
@@ -91,7 +92,7 @@ RawWaveformRecAlg::execute(const EventContext& ctx) const {
   if ( clockHandle.isValid() ) {
     ATH_MSG_DEBUG("Found ReadHandle for WaveformClock");
     clockptr = clockHandle.ptr();
-    CHECK( m_recoTool->setLocalTime(clockptr, hitContainerHandle.ptr()) );
+    CHECK( m_recoTool->setLocalTime(clockptr, hitContainerHandle.ptr(), calib) );
   } else {
     ATH_MSG_WARNING("Didn't find ReadHandle for WaveformClock!");
   }
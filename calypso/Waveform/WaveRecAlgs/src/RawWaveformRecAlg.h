@@ -17,8 +17,12 @@
 // Tool classes
 #include "WaveRecTools/IWaveformReconstructionTool.h"
 
+// Conditions
+#include "WaveformConditionsTools/WaveformCalibCondData.h"
+
 // Handles
 #include "StoreGate/ReadHandleKey.h"
+#include "StoreGate/ReadCondHandleKey.h"
 #include "StoreGate/WriteHandleKey.h"
 
 // Gaudi
@@ -77,6 +81,14 @@ class RawWaveformRecAlg : public AthReentrantAlgorithm {
     {this, "WaveformClockKey", "WaveformClock"};
   //@}
 
+  /**
+   * @name Per-IOV timing calibration using SG::ReadCondHandleKey
+   */
+  //@{
+  SG::ReadCondHandleKey<WaveformCalibCondData> m_calibKey
+    {this, "CalibKey", "WaveformCalibCondData"};
+  //@}
+
   /**
    * @name Output data using SG::WriteHandleKey
    */
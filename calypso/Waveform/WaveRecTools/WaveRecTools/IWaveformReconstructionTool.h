@@ -21,6 +21,7 @@
 
 class RawWaveform;
 class RawWaveformContainer;
+class WaveformCalibCondData;
 
 ///Interface for Waveform reco algorithms
 class IWaveformReconstructionTool : virtual public IAlgTool 
@@ -28,7 +29,7 @@ class IWaveformReconstructionTool : virtual public IAlgTool
   public:
 
   // InterfaceID
-  DeclareInterfaceID(IWaveformReconstructionTool, 1, 0);
+  DeclareInterfaceID(IWaveformReconstructionTool, 1, 1);
 
   virtual ~IWaveformReconstructionTool() = default;
 
@@ -40,10 +41,27 @@ class IWaveformReconstructionTool : virtual public IAlgTool
   virtual StatusCode reconstructSecondary(const RawWaveform& wave, 
 					  xAOD::WaveformHitContainer* container) const = 0;
 
+  // Reconstruct primary and secondary hits of all waveforms in the event,
+  // same result as calling the two methods above channel by channel
+  virtual StatusCode reconstructAll(const RawWaveformContainer& waves,
+				    xAOD::WaveformHitContainer* container,
+				    bool findSecondary) const = 0;
+
   // Set local hit times from LHC clock
   virtual StatusCode setLocalTime(const xAOD::WaveformClock* clock,
 				  xAOD::WaveformHitContainer* container) const = 0;
 
+  // Same as above, with the trigger times taken from the calibration 
+  // table of the current IOV instead of the timing tool
+  virtual StatusCode reconstructAll(const RawWaveformContainer& waves,
+				    xAOD::WaveformHitContainer* container,
+				    bool findSecondary,
+				    const WaveformCalibCondData& calib) const = 0;
+
+  virtual StatusCode setLocalTime(const xAOD::WaveformClock* clock,
+				  xAOD::WaveformHitContainer* container,
+				  const WaveformCalibCondData& calib) const = 0;
+
 };
 
 #endif // SCINTRECTOOLS_IWAVEFORMRECONSTRUCTIONTOOL_H
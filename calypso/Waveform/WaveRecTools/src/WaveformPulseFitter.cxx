@@ -0,0 +1,281 @@
+/*
+  Copyright (C) 2022 CERN for the benefit of the FASER collaboration
+*/
+
+#include "WaveformPulseFitter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+WaveformPulseFitter::WaveformPulseFitter(Shape shape) :
+  m_shape(shape),
+  m_npar(shape == Shape::Gaussian ? 3 : 5),
+  m_chi2(0.),
+  m_ndf(0)
+{
+  for (int i=0; i<MaxParameters; i++) {
+    m_lo[i] = -std::numeric_limits<double>::max();
+    m_hi[i] = std::numeric_limits<double>::max();
+    m_fixed[i] = false;
+  }
+}
+
+void
+WaveformPulseFitter::setLimits(int i, double lo, double hi) {
+  m_lo[i] = lo;
+  m_hi[i] = hi;
+}
+
+void
+WaveformPulseFitter::fixParameter(int i, bool fix) {
+  m_fixed[i] = fix;
+}
+
+double
+WaveformPulseFitter::value(double x, const double* par) const {
+  double grad[MaxParameters];
+  return value(x, par, grad);
+}
+
+double
+WaveformPulseFitter::value(double x, const double* par, double* grad) const {
+
+  const double peak = par[0];
+  const double mean = par[1];
+  const double sigma = par[2];
+
+  if (m_shape == Shape::Gaussian) {
+    double u = (x - mean) / sigma;
+    double e = std::exp(-0.5 * u * u);
+    grad[0] = e;
+    grad[1] = peak * e * u / sigma;
+    grad[2] = peak * e * u * u / sigma;
+    return peak * e;
+  }
+
+  // Crystal Ball as ROOT::Math::crystalball_function, tail on the low
+  // side of z, which is the high side in x for negative alpha
+  const double alpha = par[3];
+  const double n = par[4];
+  double s = (alpha < 0.) ? -1. : 1.;
+  double a = std::abs(alpha);
+  double z = s * (x - mean) / sigma;
+
+  double g, dgdz;
+  if (z > -a) {
+    g = std::exp(-0.5 * z * z);
+    dgdz = -z * g;
+    grad[3] = 0.;
+    grad[4] = 0.;
+  } else {
+    double nDivAlpha = n / a;
+    double B = nDivAlpha - a;
+    double d = B - z;
+    g = std::exp(-0.5 * a * a) * std::pow(nDivAlpha / d, n);
+    dgdz = g * n / d;
+    // d(ln g)/da and d(ln g)/dn
+    double dlnda = -a - n / a + n * (n / (a * a) + 1.) / d;
+    double dlndn = std::log(nDivAlpha / d) + 1. - nDivAlpha / d;
+    grad[3] = peak * g * dlnda * s;
+    grad[4] = peak * g * dlndn;
+  }
+  grad[0] = g;
+  grad[1] = peak * dgdz * (-s / sigma);
+  grad[2] = peak * dgdz * (-z / sigma);
+  return peak * g;
+}
+
+double
+WaveformPulseFitter::integral(const double* par, double lo, double hi) const {
+
+  const double peak = par[0];
+  const double mean = par[1];
+  const double sigma = par[2];
+
+  // Integral of exp(-z^2/2) between z1 and z2
+  auto gaussInt = [](double z1, double z2) {
+    return std::sqrt(M_PI / 2.) * (std::erf(z2 / M_SQRT2) - std::erf(z1 / M_SQRT2));
+  };
+
+  if (m_shape == Shape::Gaussian) {
+    return peak * sigma * gaussInt((lo - mean) / sigma, (hi - mean) / sigma);
+  }
+
+  const double alpha = par[3];
+  const double n = par[4];
+  double s = (alpha < 0.) ? -1. : 1.;
+  double a = std::abs(alpha);
+  double z1 = s * (lo - mean) / sigma;
+  double z2 = s * (hi - mean) / sigma;
+  if (z1 > z2) std::swap(z1, z2);
+
+  double sum = 0.;
+  if (z2 > -a) sum += gaussInt(std::max(z1, -a), z2);
+  if (z1 < -a) {
+    // Power law tail between z1 and min(z2, -a)
+    double zt = std::min(z2, -a);
+    double nDivAlpha = n / a;
+    double B = nDivAlpha - a;
+    double norm = std::exp(-0.5 * a * a) * std::pow(nDivAlpha, n);
+    if (std::abs(n - 1.) < 1e-9) {
+      sum += norm * (std::log(B - z1) - std::log(B - zt));
+    } else {
+      sum += norm * (std::pow(B - zt, 1. - n) - std::pow(B - z1, 1. - n)) / (n - 1.);
+    }
+  }
+  return peak * sigma * sum;
+}
+
+double
+WaveformPulseFitter::getX(const double* par, double y, double lo, double hi) const {
+
+  // Like TF1::GetX, scan for the first sign change and refine it
+  const int npx = 100;
+  if (!(hi > lo)) return std::numeric_limits<double>::quiet_NaN();
+
+  double step = (hi - lo) / npx;
+  double xa = lo;
+  double fa = value(xa, par) - y;
+  if (fa == 0.) return xa;
+  for (int i=1; i<=npx; i++) {
+    double xb = lo + i * step;
+    double fb = value(xb, par) - y;
+    if (fb == 0.) return xb;
+    if ((fa < 0.) != (fb < 0.)) {
+      // Bisection to the requested precision
+      for (int iter=0; iter<100 && (xb - xa) > 1e-10; iter++) {
+	double xm = 0.5 * (xa + xb);
+	double fm = value(xm, par) - y;
+	if ((fa < 0.) == (fm < 0.)) {
+	  xa = xm;
+	  fa = fm;
+	} else {
+	  xb = xm;
+	}
+      }
+      return 0.5 * (xa + xb);
+    }
+    xa = xb;
+    fa = fb;
+  }
+  return std::numeric_limits<double>::quiet_NaN();
+}
+
+int
+WaveformPulseFitter::fit(const float* time, const float* wave, size_t npoints, double* par) {
+
+  int free[MaxParameters];
+  int nfree = 0;
+  for (int i=0; i<m_npar; i++) {
+    par[i] = std::clamp(par[i], m_lo[i], m_hi[i]);
+    if (!m_fixed[i]) free[nfree++] = i;
+  }
+
+  m_chi2 = 0.;
+  m_ndf = (npoints > size_t(nfree)) ? npoints - nfree : 0;
+  if (nfree == 0 || npoints < size_t(nfree)) return 4;
+
+  // Sum of squares, and normal equations J^T J and J^T r for the free parameters
+  auto evaluate = [&](const double* p, double alpha[][MaxParameters], double* beta) {
+    double chi2 = 0.;
+    if (alpha) {
+      for (int j=0; j<nfree; j++) {
+	beta[j] = 0.;
+	for (int k=0; k<nfree; k++) alpha[j][k] = 0.;
+      }
+    }
+    double grad[MaxParameters];
+    for (size_t i=0; i<npoints; i++) {
+      double r = wave[i] - value(time[i], p, grad);
+      chi2 += r * r;
+      if (!alpha) continue;
+      for (int j=0; j<nfree; j++) {
+	beta[j] += grad[free[j]] * r;
+	for (int k=0; k<=j; k++) alpha[j][k] += grad[free[j]] * grad[free[k]];
+      }
+    }
+    if (alpha) {
+      for (int j=0; j<nfree; j++)
+	for (int k=j+1; k<nfree; k++) alpha[j][k] = alpha[k][j];
+    }
+    return chi2;
+  };
+
+  double alpha[MaxParameters][MaxParameters];
+  double beta[MaxParameters];
+  double chi2 = evaluate(par, alpha, beta);
+  if (!std::isfinite(chi2)) return 4;
+
+  double lambda = 1e-3;
+  const int maxIterations = 500;
+  for (int iter=0; iter<maxIterations; iter++) {
+
+    // Solve (alpha + lambda*diag(alpha)) step = beta by Gaussian elimination
+    double m[MaxParameters][MaxParameters+1];
+    for (int j=0; j<nfree; j++) {
+      for (int k=0; k<nfree; k++) m[j][k] = alpha[j][k];
+      m[j][j] += lambda * (alpha[j][j] > 0. ? alpha[j][j] : 1.);
+      m[j][nfree] = beta[j];
+    }
+    bool singular = false;
+    for (int c=0; c<nfree && !singular; c++) {
+      int pivot = c;
+      for (int r=c+1; r<nfree; r++)
+	if (std::abs(m[r][c]) > std::abs(m[pivot][c])) pivot = r;
+      if (!(std::abs(m[pivot][c]) > 0.)) {
+	singular = true;
+	break;
+      }
+      if (pivot != c)
+	for (int k=0; k<=nfree; k++) std::swap(m[c][k], m[pivot][k]);
+      for (int r=c+1; r<nfree; r++) {
+	double f = m[r][c] / m[c][c];
+	for (int k=c; k<=nfree; k++) m[r][k] -= f * m[c][k];
+      }
+    }
+    if (singular) return 4;
+
+    double step[MaxParameters];
+    for (int j=nfree-1; j>=0; j--) {
+      double sum = m[j][nfree];
+      for (int k=j+1; k<nfree; k++) sum -= m[j][k] * step[k];
+      step[j] = sum / m[j][j];
+    }
+
+    double trial[MaxParameters];
+    bool smallStep = true;
+    for (int i=0; i<m_npar; i++) trial[i] = par[i];
+    for (int j=0; j<nfree; j++) {
+      int i = free[j];
+      trial[i] = std::clamp(par[i] + step[j], m_lo[i], m_hi[i]);
+      if (std::abs(trial[i] - par[i]) > 1e-8 * (std::abs(par[i]) + 1e-8)) smallStep = false;
+    }
+
+    // Expected distance to the minimum, stop below the Minuit default (0.002 * 0.01)
+    double edm = 0.;
+    for (int j=0; j<nfree; j++) edm += 0.5 * step[j] * beta[j];
+
+    double trialChi2 = evaluate(trial, nullptr, nullptr);
+    if (std::isfinite(trialChi2) && trialChi2 <= chi2) {
+      bool converged = smallStep || edm < 2e-5 || (chi2 - trialChi2) <= 1e-10 * chi2;
+      for (int i=0; i<m_npar; i++) par[i] = trial[i];
+      chi2 = evaluate(par, alpha, beta);
+      lambda = std::max(lambda / 10., 1e-12);
+      if (converged) {
+	m_chi2 = chi2;
+	return 0;
+      }
+    } else {
+      // No improvement possible any more along the gradient, we are at the minimum
+      if (smallStep || lambda > 1e12) {
+	m_chi2 = chi2;
+	return 0;
+      }
+      lambda *= 10.;
+    }
+  }
+
+  m_chi2 = chi2;
+  return 4;
+}
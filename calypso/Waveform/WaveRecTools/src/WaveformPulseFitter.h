@@ -0,0 +1,73 @@
+/*
+  Copyright (C) 2022 CERN for the benefit of the FASER collaboration
+*/
+
+///////////////////////////////////////////////////////////////////
+// WaveformPulseFitter.h
+//   Header file for class WaveformPulseFitter
+///////////////////////////////////////////////////////////////////
+// Least squares fit of Gaussian and Crystal Ball pulse shapes
+// without ROOT objects
+///////////////////////////////////////////////////////////////////
+#ifndef WAVERECTOOLS_WAVEFORMPULSEFITTER_H
+#define WAVERECTOOLS_WAVEFORMPULSEFITTER_H
+
+#include <cstddef>
+
+/**
+ * @class WaveformPulseFitter
+ * Levenberg-Marquardt fit with analytic derivatives of the pulse shapes
+ * used in WaveformReconstructionTool. The shapes and parameter order are
+ * the same as the ROOT TF1 "gaus" (peak, mean, sigma) and "crystalball"
+ * (peak, mean, sigma, alpha, n) formulas, and the fit minimises the same
+ * unweighted sum of squares as TGraph::Fit without errors.
+ */
+
+class WaveformPulseFitter {
+
+ public:
+
+  enum class Shape { Gaussian, CrystalBall };
+  static constexpr int MaxParameters = 5;
+
+  WaveformPulseFitter(Shape shape);
+
+  // Limits for parameter i, applied after every step
+  void setLimits(int i, double lo, double hi);
+
+  // Keep parameter i at its start value
+  void fixParameter(int i, bool fix = true);
+
+  // Fit npoints (time, wave) pairs, par holds the start values on input
+  // and the result on output. Returns 0 on success, as Minuit does
+  int fit(const float* time, const float* wave, size_t npoints, double* par);
+
+  // Sum of squared residuals and degrees of freedom of the last fit
+  double chi2() const {return m_chi2;}
+  unsigned int ndf() const {return m_ndf;}
+
+  int nParameters() const {return m_npar;}
+
+  // Shape value and derivatives with respect to the parameters
+  double value(double x, const double* par) const;
+  double value(double x, const double* par, double* grad) const;
+
+  // Integral of the shape between lo and hi
+  double integral(const double* par, double lo, double hi) const;
+
+  // First x in [lo, hi] where the shape crosses y, NaN if there is none
+  double getX(const double* par, double y, double lo, double hi) const;
+
+ private:
+
+  Shape m_shape;
+  int m_npar;
+  double m_lo[MaxParameters];
+  double m_hi[MaxParameters];
+  bool m_fixed[MaxParameters];
+
+  double m_chi2;
+  unsigned int m_ndf;
+};
+
+#endif // WAVERECTOOLS_WAVEFORMPULSEFITTER_H
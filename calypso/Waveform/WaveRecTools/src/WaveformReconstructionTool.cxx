@@ -9,6 +9,7 @@
  **/
 
 #include "WaveformReconstructionTool.h"
+#include "WaveformPulseFitter.h"
 
 #include "TH1F.h"
 #include "TF1.h"
@@ -19,7 +20,9 @@
 
 #include <vector>
 #include <tuple>
+#include <algorithm>
 #include <math.h>
+#include <cstdint>
 
 // Constructor
 WaveformReconstructionTool::WaveformReconstructionTool(const std::string& type, const std::string& name, const IInterface* parent) :
@@ -34,10 +37,36 @@ WaveformReconstructionTool::initialize() {
 
   gErrorIgnoreLevel = kFatal;  // STFU!
 
-  if (m_useSimpleBaseline.value()) {
+  if (m_useSimpleBaseline.value() || m_baselineMode.value() == "Simple") {
+    m_mode = BaselineMode::Simple;
     ATH_MSG_INFO("Will use simple baseline estimation");
-  } else {
+  } else if (m_baselineMode.value() == "Fit") {
+    m_mode = BaselineMode::Fit;
     ATH_MSG_INFO("Will use fit to determine baseline");
+  } else if (m_baselineMode.value() == "Native") {
+    m_mode = BaselineMode::Native;
+    ATH_MSG_INFO("Will use native histogram fit to determine baseline");
+  } else {
+    ATH_MSG_ERROR("Unknown BaselineMode " << m_baselineMode.value() << ", use Simple, Fit or Native");
+    return StatusCode::FAILURE;
+  }
+
+  if (m_mode == BaselineMode::Native && 
+      (m_baselineRangeBins.value() <= 0 || m_baselineRange.value() % m_baselineRangeBins.value() != 0 || m_baselineFitRange.value() <= 0)) {
+    ATH_MSG_ERROR("Native baseline needs BaselineRange (" << m_baselineRange.value() 
+		  << ") to be a multiple of BaselineRangeBins (" << m_baselineRangeBins.value() 
+		  << ") and a positive BaselineFitRange");
+    return StatusCode::FAILURE;
+  }
+
+  if (m_pulseFitMode.value() == "ROOT") {
+    m_fitMode = PulseFitMode::ROOT;
+  } else if (m_pulseFitMode.value() == "Native") {
+    m_fitMode = PulseFitMode::Native;
+    ATH_MSG_INFO("Will use native pulse fits");
+  } else {
+    ATH_MSG_ERROR("Unknown PulseFitMode " << m_pulseFitMode.value() << ", use ROOT or Native");
+    return StatusCode::FAILURE;
   }
 
   ATH_CHECK( m_timingTool.retrieve() );
@@ -58,69 +87,23 @@ WaveformReconstructionTool::reconstructPrimary(
   xAOD::WaveformHit* newhit = new xAOD::WaveformHit();
   hitContainer->push_back(newhit);
 
-  // Set digitizer channel and identifier
-  newhit->set_channel(wave.channel());
-  newhit->set_identifier(wave.identify());
-
-  // Make sure we have ADC counts
-  if (wave.adc_counts().size() == 0) {
-    ATH_MSG_WARNING( "Found waveform for channel " << wave.channel() 
-		     << " with size " << wave.adc_counts().size() << "!");
-	
-    newhit->set_status_bit(xAOD::WaveformStatus::WAVEFORM_MISSING);
-    return StatusCode::SUCCESS;
-  } 
-
-  if (wave.adc_counts().size() != wave.n_samples()) {
-    ATH_MSG_WARNING( "Found waveform for channel " << wave.channel() 
-		     << " with size " << wave.adc_counts().size() 
-		     << " not equal to number of samples " << wave.n_samples());
-	
-    newhit->set_status_bit(xAOD::WaveformStatus::WAVEFORM_INVALID);
+  if (!preparePrimary(wave, newhit)) 
     return StatusCode::SUCCESS;
-  }
-
-  // Find the baseline for this waveform
-  findBaseline(wave, newhit);
 
   // Check for problems
   if (newhit->status_bit(xAOD::WaveformStatus::BASELINE_FAILED)) 
     return StatusCode::SUCCESS;
 
-  // Get the nominal trigger time (in ns) from config
-  float trigger_time = m_timingTool->nominalTriggerTime();
-
-  // Set range for windowed data in digitizer samples
-  float offset = m_timingTool->triggerTimeOffset(wave.channel());
-
-  int lo_edge = int((trigger_time+offset)/2.) + m_windowStart;
-  int hi_edge = int((trigger_time+offset)/2.) + m_windowStart + m_windowWidth;
-
-  if (hi_edge >= int(wave.size())) {
-    // This likely means we have the wrong digitizer range
-    ATH_MSG_WARNING("Found channel " << wave.channel() << " with low edge: " << lo_edge << " hi edge: " << hi_edge << " > wave.size() " << wave.size());
-    ATH_MSG_WARNING("  trigger_time + offset: " << (trigger_time+offset) << " => " << int((trigger_time+offset)/2.));
-    newhit->set_status_bit(xAOD::WaveformStatus::WAVEFORM_INVALID);
-    return StatusCode::SUCCESS;
-  }
-  
-  // Fill raw hit values
-  fillRawHitValues(wave, lo_edge, hi_edge, newhit);
+  std::vector<float> signal(wave.size());
+  convertWaveform(wave, newhit->baseline_mean(), signal.data());
 
-  // Check if this is over threshold
-  if (newhit->peak() < newhit->baseline_rms() * m_primaryPeakThreshold) {
-    ATH_MSG_DEBUG("Primary hit failed threshold");
-    newhit->set_status_bit(xAOD::WaveformStatus::THRESHOLD_FAILED);
-  } else {
-    // Reconstruct hit in this range
-    reconstructHit(newhit);
-  }
+  reconstructPrimaryWindow(wave, signal.data(), triggerTime(nullptr, wave.channel()), newhit);
 
   return StatusCode::SUCCESS;
 }
 
 //
-// Form primary hits using trigger time
+// Form secondary hits anywhere in the waveform
 //
 StatusCode
 WaveformReconstructionTool::reconstructSecondary(
@@ -159,11 +142,200 @@ WaveformReconstructionTool::reconstructSecondary(
     return StatusCode::SUCCESS;
   }
 
+  std::vector<float> signal(wave.size());
+  convertWaveform(wave, primaryHit->baseline_mean(), signal.data());
+
+  reconstructSecondaryHit(wave, signal.data(), primaryHit, hitContainer);
+
+  return StatusCode::SUCCESS;
+}
+
+//
+// Form primary and secondary hits for all waveforms of the event
+//
+StatusCode
+WaveformReconstructionTool::reconstructAll(
+	 const RawWaveformContainer& waveContainer,
+	 xAOD::WaveformHitContainer* hitContainer,
+	 bool findSecondary) const {
+  return reconstructAllWaveforms(waveContainer, hitContainer, findSecondary, nullptr);
+}
+
+StatusCode
+WaveformReconstructionTool::reconstructAll(
+	 const RawWaveformContainer& waveContainer,
+	 xAOD::WaveformHitContainer* hitContainer,
+	 bool findSecondary,
+	 const WaveformCalibCondData& calib) const {
+  return reconstructAllWaveforms(waveContainer, hitContainer, findSecondary, &calib);
+}
+
+StatusCode
+WaveformReconstructionTool::reconstructAllWaveforms(
+	 const RawWaveformContainer& waveContainer,
+	 xAOD::WaveformHitContainer* hitContainer,
+	 bool findSecondary,
+	 const WaveformCalibCondData* calib) const {
+
+  ATH_MSG_DEBUG(" reconstructAll called for " << waveContainer.size() << " waveforms");
+
+  const size_t nchan = waveContainer.size();
+  if (nchan == 0) return StatusCode::SUCCESS;
+
+  // Baseline subtracted signal in mV for all channels, one row per 
+  // channel padded to 16 samples so every row starts on a 64 byte boundary
+  size_t nsamples = 0;
+  for (const RawWaveform* wave : waveContainer) 
+    nsamples = std::max(nsamples, wave->size());
+  const size_t stride = (nsamples + 15) & ~size_t(15);
+
+  std::vector<float> buffer(nchan * stride + 16);
+  float* matrix = buffer.data();
+  while (reinterpret_cast<std::uintptr_t>(matrix) % 64 != 0) matrix++;
+
+  std::vector<xAOD::WaveformHit*> primaries(nchan);
+  std::vector<bool> usable(nchan);
+
+  // Primary hits and baselines, in container order as reconstructPrimary
+  for (size_t ichan=0; ichan<nchan; ichan++) {
+    primaries[ichan] = new xAOD::WaveformHit();
+    hitContainer->push_back(primaries[ichan]);
+    usable[ichan] = preparePrimary(*waveContainer[ichan], primaries[ichan]);
+  }
+
+  // Convert all usable waveforms in one pass
+  for (size_t ichan=0; ichan<nchan; ichan++) {
+    if (!usable[ichan]) continue;
+    convertWaveform(*waveContainer[ichan], primaries[ichan]->baseline_mean(), 
+		    matrix + ichan * stride);
+  }
+
+  // Fit the trigger windows
+  for (size_t ichan=0; ichan<nchan; ichan++) {
+    if (!usable[ichan]) continue;
+    if (primaries[ichan]->status_bit(xAOD::WaveformStatus::BASELINE_FAILED)) continue;
+    reconstructPrimaryWindow(*waveContainer[ichan], matrix + ichan * stride, 
+			     triggerTime(calib, waveContainer[ichan]->channel()), primaries[ichan]);
+  }
+
+  if (!findSecondary) return StatusCode::SUCCESS;
+
+  // Secondary hits, skipping waveforms flagged as invalid by the primary
+  for (size_t ichan=0; ichan<nchan; ichan++) {
+    if (!usable[ichan]) continue;
+    if (primaries[ichan]->status_bit(xAOD::WaveformStatus::WAVEFORM_INVALID)) continue;
+    reconstructSecondaryHit(*waveContainer[ichan], matrix + ichan * stride, 
+			    primaries[ichan], hitContainer);
+  }
+
+  return StatusCode::SUCCESS;
+}
+
+// Set identifiers, check the waveform and find the baseline
+bool
+WaveformReconstructionTool::preparePrimary(const RawWaveform& wave,
+					   xAOD::WaveformHit* newhit) const {
+
+  // Set digitizer channel and identifier
+  newhit->set_channel(wave.channel());
+  newhit->set_identifier(wave.identify());
+
+  // Make sure we have ADC counts
+  if (wave.adc_counts().size() == 0) {
+    ATH_MSG_WARNING( "Found waveform for channel " << wave.channel() 
+		     << " with size " << wave.adc_counts().size() << "!");
+	
+    newhit->set_status_bit(xAOD::WaveformStatus::WAVEFORM_MISSING);
+    return false;
+  } 
+
+  if (wave.adc_counts().size() != wave.n_samples()) {
+    ATH_MSG_WARNING( "Found waveform for channel " << wave.channel() 
+		     << " with size " << wave.adc_counts().size() 
+		     << " not equal to number of samples " << wave.n_samples());
+	
+    newhit->set_status_bit(xAOD::WaveformStatus::WAVEFORM_INVALID);
+    return false;
+  }
+
+  // Find the baseline for this waveform
+  findBaseline(wave, newhit);
+
+  return true;
+}
+
+// Baseline subtracted signal (in mV, positive for pulses) of all samples
+void
+WaveformReconstructionTool::convertWaveform(const RawWaveform& wave, 
+					    float baseline, float* signal) const {
+
+  const unsigned int* counts = wave.adc_counts().data();
+  const float mv_per_bit = wave.mv_per_bit();
+  const size_t nsamples = wave.size();
+  for (size_t i=0; i<nsamples; i++) {
+    signal[i] = baseline - mv_per_bit * counts[i];
+  }
+}
+
+// Nominal trigger time plus channel offset
+float
+WaveformReconstructionTool::triggerTime(const WaveformCalibCondData* calib, int channel) const {
+  if (calib) return calib->nominalTriggerTime() + calib->triggerTimeOffset(channel);
+  return m_timingTool->nominalTriggerTime() + m_timingTool->triggerTimeOffset(channel);
+}
+
+// Reconstruct the primary hit in the trigger window
+void
+WaveformReconstructionTool::reconstructPrimaryWindow(const RawWaveform& wave,
+						     const float* signal,
+						     float trigger_time,
+						     xAOD::WaveformHit* newhit) const {
+
+  // Set range for windowed data in digitizer samples
+  int lo_edge = int(trigger_time/2.) + m_windowStart;
+  int hi_edge = int(trigger_time/2.) + m_windowStart + m_windowWidth;
+
+  if (hi_edge >= int(wave.size())) {
+    // This likely means we have the wrong digitizer range
+    ATH_MSG_WARNING("Found channel " << wave.channel() << " with low edge: " << lo_edge << " hi edge: " << hi_edge << " > wave.size() " << wave.size());
+    ATH_MSG_WARNING("  trigger_time + offset: " << trigger_time << " => " << int(trigger_time/2.));
+    newhit->set_status_bit(xAOD::WaveformStatus::WAVEFORM_INVALID);
+    return;
+  }
+  
+  // Fill raw hit values
+  fillRawHitValues(wave, signal, lo_edge, hi_edge, newhit);
+
+  // Check if this is over threshold
+  if (newhit->peak() < newhit->baseline_rms() * m_primaryPeakThreshold) {
+    ATH_MSG_DEBUG("Primary hit failed threshold");
+    newhit->set_status_bit(xAOD::WaveformStatus::THRESHOLD_FAILED);
+  } else {
+    // Reconstruct hit in this range
+    reconstructHit(newhit);
+  }
+}
+
+// Look for a secondary hit outside of the primary window
+void
+WaveformReconstructionTool::reconstructSecondaryHit(const RawWaveform& wave,
+						    const float* signal,
+						    const xAOD::WaveformHit* primaryHit,
+						    xAOD::WaveformHitContainer* hitContainer) const {
+
+  // Without a baseline there is no primary window to look around
+  if (primaryHit->status_bit(xAOD::WaveformStatus::BASELINE_FAILED)) {
+    ATH_MSG_DEBUG("Found primary hit with baseline failed");
+    return;
+  }
+
   WaveformBaselineData baseline;
 
   baseline.mean = primaryHit->baseline_mean();
   baseline.rms = primaryHit->baseline_rms();
   
+  const int nsamples = wave.size();
+
   // Find the secondary peak position
   int ipeak;
 
@@ -176,19 +348,12 @@ WaveformReconstructionTool::reconstructSecondary(
     int lo_edge = int(primaryHit->time_vector().front()/2.);
     int hi_edge = int(primaryHit->time_vector().back()/2.);
 
-    std::vector<float> wwave_lo(lo_edge);
-    std::vector<float> wwave_hi(wave.adc_counts().size() - hi_edge - 1);
-
     int ipeak_lo = -1.;
     int ipeak_hi = -1.;
 
     // Look before
     if (m_findSecondaryBefore) {
-      for (int i=0; i<lo_edge; i++) {
-	wwave_lo[i] = baseline.mean - wave.mv_per_bit() * wave.adc_counts()[i];
-      }
-
-      ipeak_lo = findPeak(baseline, m_secondaryPeakThreshold, wwave_lo);
+      ipeak_lo = findPeak(baseline, m_secondaryPeakThreshold, signal, 0, lo_edge);
 
       if (ipeak_lo < 0) {
 	ATH_MSG_DEBUG("No hit found before " << lo_edge);
@@ -199,15 +364,11 @@ WaveformReconstructionTool::reconstructSecondary(
 
     // Look after
     if (m_findSecondaryAfter) {
-      for (unsigned int i=(hi_edge+1); i<wave.adc_counts().size(); i++) {
-	wwave_hi[(i-(hi_edge+1))] = baseline.mean - wave.mv_per_bit() * wave.adc_counts()[i];
-      }
-
-      ipeak_hi = findPeak(baseline, m_secondaryPeakThreshold, wwave_hi);
+      ipeak_hi = findPeak(baseline, m_secondaryPeakThreshold, signal, hi_edge+1, nsamples);
 
       // Is this too close to the primary hit?
-      if (ipeak_hi < 5) {
-	ATH_MSG_DEBUG("Found hit after at " << (ipeak_hi + hi_edge + 1)<< " but too close to edge");
+      if (ipeak_hi >= 0 && ipeak_hi < hi_edge + 6) {
+	ATH_MSG_DEBUG("Found hit after at " << ipeak_hi << " but too close to edge");
 	ipeak_hi = -1;
       }
 
@@ -220,46 +381,41 @@ WaveformReconstructionTool::reconstructSecondary(
 
     // Nothing found
     if (ipeak_lo < 0 && ipeak_hi < 0)
-      return StatusCode::SUCCESS;
+      return;
 
     // Both?
     if (ipeak_lo >= 0 && ipeak_hi >= 0) {
 
       // Pick the largest signal
-      if (wwave_lo[ipeak_lo] >= wwave_hi[ipeak_hi]) {
+      if (signal[ipeak_lo] >= signal[ipeak_hi]) {
 	ipeak = ipeak_lo;
-	ATH_MSG_DEBUG("Picked before as " << wwave_lo[ipeak_lo]
-		      << " > " << wwave_hi[ipeak_hi]);
+	ATH_MSG_DEBUG("Picked before as " << signal[ipeak_lo]
+		      << " > " << signal[ipeak_hi]);
       } else {
-	ipeak = ipeak_hi + hi_edge + 1;
-	ATH_MSG_DEBUG("Picked after as " << wwave_lo[ipeak_lo]
-		      << " < " << wwave_hi[ipeak_hi]);
+	ipeak = ipeak_hi;
+	ATH_MSG_DEBUG("Picked after as " << signal[ipeak_lo]
+		      << " < " << signal[ipeak_hi]);
       }
 
-    
-    } else if (ipeak_lo > 0) {
+    } else if (ipeak_lo >= 0) {
       ipeak = ipeak_lo;
-      ATH_MSG_DEBUG("Peak before with " << wwave_lo[ipeak_lo]);
+      ATH_MSG_DEBUG("Peak before with " << signal[ipeak_lo]);
     } else {
-      ATH_MSG_DEBUG("Peak after with " << wwave_hi[ipeak_hi]);
-      ipeak = ipeak_hi+hi_edge+1;
+      ATH_MSG_DEBUG("Peak after with " << signal[ipeak_hi]);
+      ipeak = ipeak_hi;
     }
 
   } else {
 
     ATH_MSG_DEBUG("Looking for secondary hit without primary hit above threshold");
-    std::vector<float> wwave(wave.adc_counts().size());
-    for (unsigned int i=0; i<wave.adc_counts().size(); i++) {
-      wwave[i] = baseline.mean - wave.mv_per_bit() * wave.adc_counts()[i];
-    }
 
-    ipeak = findPeak(baseline, m_secondaryPeakThreshold, wwave);
+    ipeak = findPeak(baseline, m_secondaryPeakThreshold, signal, 0, nsamples);
 
     // Nothing found
     if (ipeak < 0) 
-      return StatusCode::SUCCESS;
+      return;
 
-    ATH_MSG_DEBUG("Found secondary peak with no primary " << wwave[ipeak]);
+    ATH_MSG_DEBUG("Found secondary peak with no primary " << signal[ipeak]);
   }
 
   // We seem to have a secondary hit
@@ -278,17 +434,29 @@ WaveformReconstructionTool::reconstructSecondary(
   int hi_edge = ipeak + m_windowStart + m_windowWidth;
 
   // Fill raw hit values
-  fillRawHitValues(wave, lo_edge, hi_edge, newhit);
+  fillRawHitValues(wave, signal, lo_edge, hi_edge, newhit);
 
   // Must be over threshold, so reconstruct here
   reconstructHit(newhit);
-
-  return StatusCode::SUCCESS;
 }
 
 StatusCode
 WaveformReconstructionTool::setLocalTime(const xAOD::WaveformClock* clock,
 					 xAOD::WaveformHitContainer* container) const {
+  return setLocalTimes(clock, container, nullptr);
+}
+
+StatusCode
+WaveformReconstructionTool::setLocalTime(const xAOD::WaveformClock* clock,
+					 xAOD::WaveformHitContainer* container,
+					 const WaveformCalibCondData& calib) const {
+  return setLocalTimes(clock, container, &calib);
+}
+
+StatusCode
+WaveformReconstructionTool::setLocalTimes(const xAOD::WaveformClock* clock,
+					  xAOD::WaveformHitContainer* container,
+					  const WaveformCalibCondData* calib) const {
 
   ATH_MSG_DEBUG(" setLocalTime called ");
 
@@ -308,9 +476,6 @@ WaveformReconstructionTool::setLocalTime(const xAOD::WaveformClock* clock,
     clock_valid = true;
   }
 
-  float trigger_time = m_timingTool->nominalTriggerTime();
-  float offset;
-
   // Should actually find the time of the trigger here 
   // and set bcid time offset from that
   // Loop through hits and set local time
@@ -326,8 +491,7 @@ WaveformReconstructionTool::setLocalTime(const xAOD::WaveformClock* clock,
     }
 
     // Also set time with respect to nominal trigger
-    offset = m_timingTool->triggerTimeOffset(hit->channel());
-    hit->set_trigger_time(hit->localtime() - (trigger_time + offset));
+    hit->set_trigger_time(hit->localtime() - triggerTime(calib, hit->channel()));
   }
 
   return StatusCode::SUCCESS;
@@ -342,10 +506,16 @@ WaveformReconstructionTool::findBaseline(const RawWaveform& raw_wave,
   // Find baseline
   static WaveformBaselineData baseline;
 
-  if (m_useSimpleBaseline.value())
+  switch (m_mode) {
+  case BaselineMode::Simple:
     baseline = findSimpleBaseline(raw_wave);
-  else
+    break;
+  case BaselineMode::Native:
+    baseline = findNativeBaseline(raw_wave);
+    break;
+  default:
     baseline = findAdvancedBaseline(raw_wave);
+  }
 
   if (!(baseline.valid)) {
     ATH_MSG_WARNING("Failed to reconstruct baseline!");
@@ -369,6 +539,7 @@ WaveformReconstructionTool::findBaseline(const RawWaveform& raw_wave,
 // Fill the raw hit parameters
 void
 WaveformReconstructionTool::fillRawHitValues(const RawWaveform& wave,
+					   const float* signal,
 					   int lo_edge, int hi_edge, 
 					   xAOD::WaveformHit* hit) const {
 
@@ -390,7 +561,7 @@ WaveformReconstructionTool::fillRawHitValues(const RawWaveform& wave,
   for (int i=lo_edge; i<=hi_edge; i++) {
     unsigned int j = i-lo_edge;
     wtime[j] = 2.*i; // 2ns per sample at 500 MHz
-    wwave[j] = hit->baseline_mean() - wave.mv_per_bit() * wave.adc_counts()[i];
+    wwave[j] = signal[i];
   }
 
   hit->set_time_vector(wtime);
@@ -478,18 +649,20 @@ WaveformReconstructionTool::reconstructHit(xAOD::WaveformHit* hit) const {
 
 }
 
-// Returns location of peak in array wave
+// Returns location of peak in wave between lo and hi (exclusive)
 // Return value is -1 if peak is below threshold
 int
-WaveformReconstructionTool::findPeak(WaveformBaselineData& baseline, 
+WaveformReconstructionTool::findPeak(const WaveformBaselineData& baseline, 
 				     float threshold,
-				     std::vector<float>& wave) const 
+				     const float* wave, int lo, int hi) const 
 {
 
   ATH_MSG_DEBUG("findPeak called");
 
+  if (hi <= lo) return -1;
+
   // Find max value location in array
-  unsigned int imax = std::max_element(wave.begin(), wave.end()) - wave.begin();
+  int imax = std::max_element(wave + lo, wave + hi) - wave;
   float maxval = wave[imax];
   ATH_MSG_DEBUG( "Found peak value " << maxval << " at position " << imax );
 
@@ -677,8 +850,160 @@ WaveformReconstructionTool::findAdvancedBaseline(const RawWaveform& raw_wave) co
   return baseline;
 }
 
+WaveformBaselineData&
+WaveformReconstructionTool::findNativeBaseline(const RawWaveform& raw_wave) const {
+
+  ATH_MSG_DEBUG( "findNativeBaseline called" );
+
+  // This must be static so we can return a reference
+  static WaveformBaselineData baseline;  
+  baseline.clear();
+
+  // Same procedure as findAdvancedBaseline, but the histograms are plain
+  // integer arrays and the Gaussian fit is a binned Poisson likelihood fit
+  // done by Newton iterations, so no ROOT objects are created per channel
+  const std::vector<unsigned int>& counts = raw_wave.adc_counts();
+  int ilo = std::max(0, m_baselineSampleLo.value());
+  int ihi = std::min(m_baselineSampleHi.value(), int(counts.size())-1);
+  if (ihi < ilo) {
+    ATH_MSG_WARNING( "Found waveform with " << counts.size() << " samples, not enough to find baseline!" );
+    return baseline;
+  }
+
+  // Coarse histogram to find most likely value (first maximum, as TH1::GetMaximumBin)
+  int nbins = m_baselineRangeBins;
+  int width = m_baselineRange / nbins;
+  std::vector<int> h1(nbins, 0);
+  for (int i=ilo; i<=ihi; i++) {
+    int bin = int(counts[i]) / width;
+    if (bin < nbins) h1[bin]++;
+  }
+  int maxbin = int(std::max_element(h1.begin(), h1.end()) - h1.begin());
+  double maxbinval = (maxbin + 0.5) * width;
+  ATH_MSG_DEBUG( "Found max bin at " << maxbinval << " counts");
+
+  // Second histogram with integer resolution around the peak, bin i holds count first+i
+  nbins = m_baselineFitRange;
+  int first = int(maxbinval - nbins/2);
+  std::vector<int> h2(nbins, 0);
+  for (int i=ilo; i<=ihi; i++) {
+    int bin = int(counts[i]) - first;
+    if (bin >= 0 && bin < nbins) h2[bin]++;
+  }
+
+  // Mean, RMS and peak of the bins in [blo, bhi]
+  auto moments = [&h2, first](int blo, int bhi, double& mean, double& rms, double& peak) {
+    double sumw = 0., sumx = 0., sumx2 = 0.;
+    peak = 0.;
+    for (int b=blo; b<=bhi; b++) {
+      double x = first + b;
+      sumw  += h2[b];
+      sumx  += h2[b] * x;
+      sumx2 += h2[b] * x * x;
+      peak = std::max(peak, double(h2[b]));
+    }
+    if (sumw <= 0.) {
+      mean = rms = 0.;
+      return;
+    }
+    mean = sumx / sumw;
+    rms = std::sqrt(std::max(0., sumx2 / sumw - mean * mean));
+  };
+  // Bin containing value x, clamped to the histogram (as TAxis::SetRangeUser)
+  auto findBin = [first, nbins](double x) {
+    return std::clamp(int(std::floor(x - (first - 0.5))), 0, nbins-1);
+  };
+
+  // Start with full histogram range
+  double mean, rms, peak;
+  moments(0, nbins-1, mean, rms, peak);
+  ATH_MSG_DEBUG( "Initial Mean: " << mean << " RMS: " << rms << " Peak: " << peak );
+
+  // Restrict range to +/- window sigma of mean
+  double window = m_baselineFitWindow;  // Window range in sigma
+  int blo = findBin(mean-window*rms);
+  int bhi = findBin(mean+window*rms);
+  moments(blo, bhi, mean, rms, peak);
+  ATH_MSG_DEBUG( "2 Sigma Mean: " << mean << " RMS: " << rms << " Peak: " << peak);
+
+  // Fit the bins with centers inside the final window and the restricted range
+  double fitlo = mean-window*rms;
+  double fithi = mean+window*rms;
+  int flo = std::max(blo, int(std::ceil(fitlo - first)));
+  int fhi = std::min(bhi, int(std::floor(fithi - first)));
+
+  // Gaussian written as exp(a + b*t + c*t^2) with t = x - mean, the Poisson
+  // log likelihood is concave in (a, b, c) so Newton steps converge quickly
+  int fitStatus = 1;
+  double chi2 = 0.;
+  int nfit = fhi - flo + 1;
+  unsigned int ndf = nfit > 3 ? nfit - 3 : 1;
+  if (nfit >= 3 && rms > 0. && peak > 0.) {
+    double par[3] = {std::log(peak), 0., -0.5 / (rms * rms)};
+    for (int iter=0; iter<50 && fitStatus != 0; iter++) {
+      double grad[3] = {0., 0., 0.};
+      double hess[3][3] = {{0., 0., 0.}, {0., 0., 0.}, {0., 0., 0.}};
+      for (int b=flo; b<=fhi; b++) {
+	double t = first + b - mean;
+	double phi[3] = {1., t, t * t};
+	double f = std::exp(par[0] + par[1] * t + par[2] * t * t);
+	for (int j=0; j<3; j++) {
+	  grad[j] += (h2[b] - f) * phi[j];
+	  for (int k=0; k<3; k++) hess[j][k] += f * phi[j] * phi[k];
+	}
+      }
+      // Solve hess * step = grad (Cramer's rule, symmetric positive definite)
+      double det = hess[0][0] * (hess[1][1] * hess[2][2] - hess[1][2] * hess[2][1])
+	- hess[0][1] * (hess[1][0] * hess[2][2] - hess[1][2] * hess[2][0])
+	+ hess[0][2] * (hess[1][0] * hess[2][1] - hess[1][1] * hess[2][0]);
+      if (!(std::abs(det) > 0.)) break;
+      double step[3];
+      for (int j=0; j<3; j++) {
+	double m[3][3];
+	for (int r=0; r<3; r++) 
+	  for (int k=0; k<3; k++) m[r][k] = (k == j) ? grad[r] : hess[r][k];
+	step[j] = (m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1])
+		   - m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0])
+		   + m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0])) / det;
+      }
+      for (int j=0; j<3; j++) par[j] += step[j];
+      if (std::abs(step[0]) < 1e-6 && std::abs(step[1]) < 1e-6 * std::max(1., rms) 
+	  && std::abs(step[2]) < 1e-6 * std::abs(par[2])) fitStatus = 0;
+    }
+    if (fitStatus == 0 && par[2] < 0.) {
+      // Baker-Cousins likelihood chi2, as reported for ROOT likelihood fits
+      for (int b=flo; b<=fhi; b++) {
+	double t = first + b - mean;
+	double f = std::exp(par[0] + par[1] * t + par[2] * t * t);
+	chi2 += 2. * (f - h2[b]);
+	if (h2[b] > 0) chi2 += 2. * h2[b] * std::log(h2[b] / f);
+      }
+      double sigma2 = -0.5 / par[2];
+      rms  = std::sqrt(sigma2);
+      mean = mean + par[1] * sigma2;
+      peak = std::exp(par[0] + 0.5 * par[1] * par[1] * sigma2);
+      ATH_MSG_DEBUG( "G Fit   Mean: " << mean << " RMS: " << rms << " Peak: " << peak << " Chi2/N: " << chi2/ndf);  
+    } else {
+      fitStatus = 4;
+    }
+  }
+
+  if (fitStatus != 0) {
+    ATH_MSG_WARNING( " Baseline fit failed! ");
+  }
+
+  baseline.valid = true;
+  baseline.channel = raw_wave.channel();
+  baseline.mean = mean;
+  baseline.rms = rms;
+  baseline.fit_status = fitStatus; 
+  baseline.peak = peak;
+  baseline.chi2n = chi2/ndf;
+  return baseline;
+}
+
 WaveformFitResult&
-WaveformReconstructionTool::findRawHitValues(const std::vector<float> time, const std::vector<float> wave) const {
+WaveformReconstructionTool::findRawHitValues(const std::vector<float>& time, const std::vector<float>& wave) const {
 
   ATH_MSG_DEBUG("findRawHitValues called");
 
@@ -731,10 +1056,13 @@ WaveformReconstructionTool::findRawHitValues(const std::vector<float> time, cons
 }
 
 WaveformFitResult&
-WaveformReconstructionTool::fitGaussian(const WaveformFitResult& raw, const std::vector<float> time, const std::vector<float> wave) const {
+WaveformReconstructionTool::fitGaussian(const WaveformFitResult& raw, const std::vector<float>& time, const std::vector<float>& wave) const {
 
   ATH_MSG_DEBUG("fitGaussian called");
 
+  if (m_fitMode == PulseFitMode::Native)
+    return fitGaussianNative(raw, time.data(), wave.data(), time.size());
+
   // This must be static so we can return a reference
   static WaveformFitResult gfit;
   gfit.clear();
@@ -786,10 +1114,13 @@ WaveformReconstructionTool::fitGaussian(const WaveformFitResult& raw, const std:
 
 WaveformFitResult&
 WaveformReconstructionTool::fitCBall(const WaveformFitResult& gfit, 
-     const std::vector<float> time, const std::vector<float> wave) const {
+     const std::vector<float>& time, const std::vector<float>& wave) const {
 
   ATH_MSG_DEBUG("fitCBall called");
 
+  if (m_fitMode == PulseFitMode::Native)
+    return fitCBallNative(gfit, time.data(), wave.data(), time.size());
+
   // This must be static so we can return a reference
   static WaveformFitResult cbfit;
   cbfit.clear();
@@ -873,3 +1204,125 @@ WaveformReconstructionTool::fitCBall(const WaveformFitResult& gfit,
 
   return cbfit;
 }
+
+// Same fit as fitGaussian, with the windowed data fitted in place
+WaveformFitResult&
+WaveformReconstructionTool::fitGaussianNative(const WaveformFitResult& raw, 
+     const float* time, const float* wave, size_t npoints) const {
+
+  ATH_MSG_DEBUG("fitGaussianNative called");
+
+  // This must be static so we can return a reference
+  static WaveformFitResult gfit;
+  gfit.clear();
+
+  // Start with raw values by default
+  gfit = raw;
+
+  WaveformPulseFitter fitter(WaveformPulseFitter::Shape::Gaussian);
+  fitter.setLimits(2, 0., 20.);  // Constrain width
+
+  double par[WaveformPulseFitter::MaxParameters] = {raw.peak, raw.mean, raw.sigma};
+  gfit.fit_status = fitter.fit(time, wave, npoints, par);
+  gfit.valid = (gfit.fit_status == 0);
+
+  if (!gfit.valid) {
+    ATH_MSG_WARNING( " Gaussian waveform fit failed! ");
+  } else {
+    // Improve estimation with fit results
+    gfit.peak = par[0];
+    gfit.mean = par[1];
+    gfit.sigma = par[2];
+    gfit.integral = fitter.integral(par, time[0], time[npoints-1]);
+
+    // Find time here
+    gfit.time = fitter.getX(par, gfit.peak * m_timingPeakFraction, time[0], gfit.mean);
+
+    if (isnan(gfit.time)) {
+      ATH_MSG_WARNING(" Gaussian fit returned time as NaN, assume fit failed");
+      gfit = raw;
+      gfit.fit_status = false;
+    }
+
+    ATH_MSG_DEBUG("G Fit   Mean: " << gfit.mean << " RMS: " << gfit.sigma 
+		  << " Peak: " << gfit.peak << " Int: " << gfit.integral << " Time: " << gfit.time);
+  }
+
+  return gfit;
+}
+
+// Same fit as fitCBall, with the windowed data fitted in place
+WaveformFitResult&
+WaveformReconstructionTool::fitCBallNative(const WaveformFitResult& gfit, 
+     const float* time, const float* wave, size_t npoints) const {
+
+  ATH_MSG_DEBUG("fitCBallNative called");
+
+  // This must be static so we can return a reference
+  static WaveformFitResult cbfit;
+  cbfit.clear();
+
+  // Values to preset CB fit
+  cbfit.peak = abs(gfit.peak);
+  cbfit.mean = gfit.mean;
+  cbfit.sigma = abs(gfit.sigma);
+  if (cbfit.sigma > 20.) cbfit.sigma = 2.;
+  cbfit.alpha = -0.5;  // Negative to get tail on high side
+  cbfit.nval = 2.;
+
+  WaveformPulseFitter fitter(WaveformPulseFitter::Shape::CrystalBall);
+  fitter.setLimits(2, 0., 20.);
+  fitter.setLimits(3, -10., 0.);
+
+  double par[WaveformPulseFitter::MaxParameters] = 
+    {cbfit.peak, cbfit.mean, cbfit.sigma, cbfit.alpha, cbfit.nval};
+
+  // Try fixing the tail first
+  fitter.fixParameter(4);
+  if (fitter.fit(time, wave, npoints, par) != 0) {
+    ATH_MSG_DEBUG( " First Crystal Ball waveform fit failed! ");
+  }
+
+  // Now try releasing the tail parameter, starting from the first fit
+  fitter.fixParameter(4, false);
+  fitter.setLimits(4, 0., 1.E3);
+  par[4] = cbfit.nval;
+
+  cbfit.fit_status = fitter.fit(time, wave, npoints, par);
+  cbfit.valid = (cbfit.fit_status == 0);
+
+  if (!cbfit.valid) {
+    ATH_MSG_DEBUG( " Full Crystal Ball waveform fit failed! ");
+  } else {
+    // Improve estimation with fit results
+    cbfit.peak = par[0];
+    cbfit.mean = par[1];
+    cbfit.sigma = par[2];
+    cbfit.alpha = par[3];
+    cbfit.nval = par[4];
+
+    unsigned int ndf = fitter.ndf();
+    if (ndf == 0) ndf = 1;
+    cbfit.chi2ndf = fitter.chi2()/ndf;
+
+    cbfit.integral = fitter.integral(par, time[0], time[npoints-1]);
+
+    // Find time here
+    cbfit.time = fitter.getX(par, cbfit.peak * m_timingPeakFraction, time[0], cbfit.mean);
+
+    if (isnan(cbfit.time)) {
+      ATH_MSG_WARNING(" Crystal Ball fit returned time as NaN, assume fit failes");
+      cbfit.time = gfit.time;
+      cbfit.fit_status = false;
+    }
+
+    ATH_MSG_DEBUG("CB Fit  Mean: " << cbfit.mean << " RMS: " << cbfit.sigma 
+		  << " Peak: " << cbfit.peak << " Int: " << cbfit.integral
+		  << " Time: " << cbfit.time 
+		  << " N: " << cbfit.nval << " Alpha: " << cbfit.alpha 
+		  << " Chi2/Ndf: " << cbfit.chi2ndf );
+
+  }
+
+  return cbfit;
+}
@@ -22,6 +22,7 @@
 
 // Tool classes
 #include "WaveformConditionsTools/IWaveformTimingTool.h"
+#include "WaveformConditionsTools/WaveformCalibCondData.h"
 
 //Gaudi
 #include "GaudiKernel/ToolHandle.h"
@@ -48,10 +49,26 @@ class WaveformReconstructionTool: public extends<AthAlgTool, IWaveformReconstruc
   virtual StatusCode reconstructSecondary(const RawWaveform& wave,
 					xAOD::WaveformHitContainer* hitContainer) const;
 
+  /// Reconstruct primary and (optionally) secondary hits for all 
+  /// waveforms of the event in one go
+  virtual StatusCode reconstructAll(const RawWaveformContainer& waveContainer,
+				    xAOD::WaveformHitContainer* hitContainer,
+				    bool findSecondary) const;
+
   /// Set local hit times from LHC clock
   virtual StatusCode setLocalTime(const xAOD::WaveformClock* clock,
 				  xAOD::WaveformHitContainer* container) const;
 
+  /// Same, with trigger times from the calibration table
+  virtual StatusCode reconstructAll(const RawWaveformContainer& waveContainer,
+				    xAOD::WaveformHitContainer* hitContainer,
+				    bool findSecondary,
+				    const WaveformCalibCondData& calib) const;
+
+  virtual StatusCode setLocalTime(const xAOD::WaveformClock* clock,
+				  xAOD::WaveformHitContainer* container,
+				  const WaveformCalibCondData& calib) const;
+
 
  private:
 
@@ -59,6 +76,14 @@ class WaveformReconstructionTool: public extends<AthAlgTool, IWaveformReconstruc
   // Baseline Estimation Parameters
   BooleanProperty m_useSimpleBaseline{this, "UseSimpleBaseline", false};
 
+  // Baseline algorithm: Simple (average of first samples), 
+  // Fit (ROOT histogram and TF1 fit) or Native (same estimate on 
+  // integer histograms with a built-in likelihood fit, no ROOT objects)
+  // UseSimpleBaseline = True overrides this for backwards compatibility
+  StringProperty m_baselineMode{this, "BaselineMode", "Fit"};
+  enum class BaselineMode { Simple, Fit, Native };
+  BaselineMode m_mode{BaselineMode::Fit};
+
   ToolHandle<IWaveformTimingTool> m_timingTool
     {this, "WaveformTimingTool", "WaveformTimingTool"};
 
@@ -101,6 +126,13 @@ class WaveformReconstructionTool: public extends<AthAlgTool, IWaveformReconstruc
   IntegerProperty m_windowStart{this, "FitWindowStart", -20};  
   IntegerProperty m_windowWidth{this, "FitWindowWidth", 75};
 
+  //
+  // Pulse fit engine: ROOT (TGraph and TF1 fits) or Native (built-in 
+  // Levenberg-Marquardt fit of the same shapes, no ROOT objects)
+  StringProperty m_pulseFitMode{this, "PulseFitMode", "ROOT"};
+  enum class PulseFitMode { ROOT, Native };
+  PulseFitMode m_fitMode{PulseFitMode::ROOT};
+
   //
   // Remove overflow values from CB fit
   BooleanProperty m_removeOverflow{this, "RemoveOverflow", true};
@@ -116,8 +148,34 @@ class WaveformReconstructionTool: public extends<AthAlgTool, IWaveformReconstruc
   BooleanProperty m_findSecondaryAfter{this, "FindSecondaryAfter", false};
 
   // Reco algorithms
-  // Fill hit with raw data from waveform
-  void fillRawHitValues(const RawWaveform& wave,
+  // Set up primary hit and find baseline, false if waveform is missing or invalid
+  bool preparePrimary(const RawWaveform& wave, xAOD::WaveformHit* hit) const;
+
+  // Baseline subtracted signal in mV for all samples of wave
+  void convertWaveform(const RawWaveform& wave, float baseline, float* signal) const;
+
+  // Nominal trigger time plus channel offset (in ns), from the 
+  // calibration table if given, otherwise from the timing tool
+  float triggerTime(const WaveformCalibCondData* calib, int channel) const;
+
+  // Implementation of the public methods, calib may be null
+  StatusCode reconstructAllWaveforms(const RawWaveformContainer& waveContainer,
+				     xAOD::WaveformHitContainer* hitContainer,
+				     bool findSecondary,
+				     const WaveformCalibCondData* calib) const;
+  StatusCode setLocalTimes(const xAOD::WaveformClock* clock,
+			   xAOD::WaveformHitContainer* container,
+			   const WaveformCalibCondData* calib) const;
+
+  // Primary hit in the trigger window and secondary hits around it
+  void reconstructPrimaryWindow(const RawWaveform& wave, const float* signal,
+				float trigger_time, xAOD::WaveformHit* hit) const;
+  void reconstructSecondaryHit(const RawWaveform& wave, const float* signal,
+			       const xAOD::WaveformHit* primaryHit,
+			       xAOD::WaveformHitContainer* hitContainer) const;
+
+  // Fill hit with raw data from converted waveform
+  void fillRawHitValues(const RawWaveform& wave, const float* signal,
 			int lo_edge, int hi_edge,
 			xAOD::WaveformHit* hit) const;
 
@@ -127,23 +185,27 @@ class WaveformReconstructionTool: public extends<AthAlgTool, IWaveformReconstruc
   // Baseline algorithms
   WaveformBaselineData& findSimpleBaseline(const RawWaveform& wave) const;
   WaveformBaselineData& findAdvancedBaseline(const RawWaveform& wave) const;
+  WaveformBaselineData& findNativeBaseline(const RawWaveform& wave) const;
   WaveformBaselineData& findBaseline(const RawWaveform& wave, 
 				     xAOD::WaveformHit* hit) const;
 
 
-  // Find peak in wave, return index to peak position, or -1 if 
+  // Find peak in wave[lo, hi), return index to peak position, or -1 if 
   // peak isn't greater than threshold
-  int findPeak(WaveformBaselineData& baseline, float threshold, 
-		std::vector<float>& wave) const;
+  int findPeak(const WaveformBaselineData& baseline, float threshold, 
+	       const float* wave, int lo, int hi) const;
 
   // Get estimate from waveform data itself
-  WaveformFitResult& findRawHitValues(const std::vector<float> time, 
-				      const std::vector<float> wave) const;
+  WaveformFitResult& findRawHitValues(const std::vector<float>& time, 
+				      const std::vector<float>& wave) const;
 
   // Fit windowed data to Gaussian (to get initial estimate of parameters
   WaveformFitResult& fitGaussian(const WaveformFitResult& raw,
-				 const std::vector<float> time, 
-				 const std::vector<float> wave) const;
+				 const std::vector<float>& time, 
+				 const std::vector<float>& wave) const;
+  WaveformFitResult& fitGaussianNative(const WaveformFitResult& raw,
+				       const float* time, const float* wave,
+				       size_t npoints) const;
 
   // Find overflows and remove points from arrays
   bool findOverflow(float baseline, 
@@ -151,8 +213,11 @@ class WaveformReconstructionTool: public extends<AthAlgTool, IWaveformReconstruc
 
   // Fit windowed data to CrystalBall function
   WaveformFitResult& fitCBall(const WaveformFitResult& gfit, 
-			      const std::vector<float> time, 
-			      const std::vector<float> wave) const;
+			      const std::vector<float>& time, 
+			      const std::vector<float>& wave) const;
+  WaveformFitResult& fitCBallNative(const WaveformFitResult& gfit, 
+				    const float* time, const float* wave,
+				    size_t npoints) const;
 
 };
 
@@ -22,6 +22,8 @@
 // Contains detector type "calo", "trigger", "veto", "preshower" and identifier 
 typedef std::map<int, std::pair<std::string, Identifier> > WaveformCableMap;
 
+class WaveformCableMappingCondData;
+
 class IWaveformCableMappingTool: virtual public IAlgTool {
 
  public:
@@ -41,6 +43,10 @@ class IWaveformCableMappingTool: virtual public IAlgTool {
   virtual int getChannelMapping(const EventContext& ctx, const Identifier id) const = 0;
   virtual int getChannelMapping(const Identifier id) const = 0;
 
+  // Decoded mapping of the current IOV, indexed by digitizer channel (nullptr if unavailable)
+  virtual const WaveformCableMappingCondData* getCableMappingData(const EventContext& ctx) const = 0;
+  virtual const WaveformCableMappingCondData* getCableMappingData(void) const = 0;
+
 
 };
 
@@ -19,6 +19,8 @@
 // ADC range in volts indexed by digitizer channel number
 typedef std::map<int, float> WaveformRangeMap;
 
+class WaveformCalibCondData;
+
 class IWaveformRangeTool: virtual public IAlgTool {
 
  public:
@@ -35,6 +37,10 @@ class IWaveformRangeTool: virtual public IAlgTool {
   virtual WaveformRangeMap getRangeMapping(const EventContext& ctx) const = 0;
   virtual WaveformRangeMap getRangeMapping(void) const = 0;
 
+  // Calibration table of the current IOV which holds the ranges (nullptr if unavailable)
+  virtual const WaveformCalibCondData* getRangeData(const EventContext& ctx) const = 0;
+  virtual const WaveformCalibCondData* getRangeData(void) const = 0;
+
 };
 
 //---------------------------------------------------------------------- 
@@ -0,0 +1,91 @@
+/*
+  Copyright (C) 2022 CERN for the benefit of the FASER collaboration
+*/
+
+/** @file WaveformCableMappingCondData.h
+    Digitizer cable mapping decoded once per IOV by WaveformCableMappingCondAlg
+*/
+
+#ifndef WAVEFORMCABLEMAPPINGCONDDATA_H
+#define WAVEFORMCABLEMAPPINGCONDDATA_H
+
+#include "WaveformConditionsTools/IWaveformCableMappingTool.h"
+
+#include "Identifier/Identifier.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+/** Detector type and identifier of each digitizer channel, in flat arrays
+    indexed by channel number, and the reverse identifier -> channel lookup.
+    Channels not in the folder have an empty type.
+*/
+class WaveformCableMappingCondData {
+
+ public:
+  WaveformCableMappingCondData() = default;
+  virtual ~WaveformCableMappingCondData() = default;
+
+  // Set the detector type and identifier of a digitizer channel
+  // Channels are expected in increasing order, as they come from COOL
+  void setChannel(unsigned int channel, const std::string& type, const Identifier& id) {
+    if (channel >= m_type.size()) {
+      m_type.resize(channel + 1);
+      m_identifier.resize(channel + 1);
+    }
+    m_type[channel] = type;
+    m_identifier[channel] = id;
+    // Keep the reverse lookup sorted, the first channel wins for duplicate identifiers
+    auto it = std::upper_bound(m_channels.begin(), m_channels.end(), id,
+                               [](const Identifier& lhs, const std::pair<Identifier, int>& rhs) { return lhs < rhs.first; });
+    m_channels.emplace(it, id, channel);
+  }
+
+  // Number of mapped digitizer channels
+  unsigned int size() const { return m_channels.size(); }
+  // One past the highest digitizer channel
+  unsigned int maxChannel() const { return m_type.size(); }
+
+  // Detector type "calo", "trigger", "veto", "preshower", ... or empty if not mapped
+  const std::string& type(unsigned int channel) const {
+    static const std::string empty;
+    return channel < m_type.size() ? m_type[channel] : empty;
+  }
+  Identifier identifier(unsigned int channel) const {
+    return channel < m_identifier.size() ? m_identifier[channel] : Identifier();
+  }
+
+  // Reverse mapping, returns -1 if the identifier is not mapped
+  int channel(const Identifier& id) const {
+    auto it = std::lower_bound(m_channels.begin(), m_channels.end(), id,
+                               [](const std::pair<Identifier, int>& lhs, const Identifier& rhs) { return lhs.first < rhs; });
+    if (it == m_channels.end() or it->first != id) return -1;
+    return it->second;
+  }
+
+  // Mapping as returned by IWaveformCableMappingTool::getCableMapping
+  WaveformCableMap getMap() const {
+    WaveformCableMap mapping;
+    for (const auto& entry : m_channels) {
+      mapping.emplace(entry.second, std::make_pair(m_type[entry.second], entry.first));
+    }
+    return mapping;
+  }
+
+ private:
+  std::vector<std::string> m_type;                    // indexed by channel
+  std::vector<Identifier> m_identifier;               // indexed by channel
+  std::vector<std::pair<Identifier, int> > m_channels; // sorted by identifier
+};
+
+// Class definition for StoreGate
+#include "AthenaKernel/CLASS_DEF.h"
+CLASS_DEF( WaveformCableMappingCondData , 185296370 , 1 )
+
+// Condition container definition for CondInputLoader
+#include "AthenaKernel/CondCont.h"
+CONDCONT_DEF( WaveformCableMappingCondData, 39815437 );
+
+#endif // WAVEFORMCABLEMAPPINGCONDDATA_H
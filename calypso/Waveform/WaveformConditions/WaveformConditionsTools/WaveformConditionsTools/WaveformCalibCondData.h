@@ -0,0 +1,72 @@
+/*
+  Copyright (C) 2022 CERN for the benefit of the FASER collaboration
+*/
+
+/** @file WaveformCalibCondData.h
+    Per-channel waveform and calorimeter calibration compiled once per IOV
+    by WaveformCalibCondAlg
+*/
+
+#ifndef WAVEFORMCALIBCONDDATA_H
+#define WAVEFORMCALIBCONDDATA_H
+
+#include <vector>
+
+/** Calibration table indexed by digitizer channel. Channels without an entry
+    in the conditions folders keep the defaults the conditions tools return
+    for missing payloads.
+*/
+class WaveformCalibCondData {
+
+ public:
+  struct Channel {
+    float triggerOffset{0.};  // correction to the nominal trigger time (ns)
+    float range{0.};          // digitizer ADC range (V)
+    float HV{0.};             // PMT HV (V)
+    float HV_ref{0.};         // PMT HV of the reference MIP measurement (V)
+    float MIPcharge_ref{1.};  // reference MIP charge (pC)
+    float gainRatio{1.};      // gain at HV_ref over gain at HV, from the PMT gain curve
+  };
+
+  WaveformCalibCondData() = default;
+  virtual ~WaveformCalibCondData() = default;
+
+  // Filling, used by WaveformCalibCondAlg
+  void setNominalTriggerTime(float time) { m_nominalTriggerTime = time; }
+  Channel& channel(unsigned int ch) {
+    if (ch >= m_channels.size()) m_channels.resize(ch + 1);
+    return m_channels[ch];
+  }
+
+  // Nominal trigger time (ns) in the digitizer readout
+  float nominalTriggerTime() const { return m_nominalTriggerTime; }
+
+  // Calibration of one digitizer channel
+  const Channel& channel(unsigned int ch) const {
+    static const Channel defaults;
+    return ch < m_channels.size() ? m_channels[ch] : defaults;
+  }
+  float triggerTimeOffset(unsigned int ch) const { return channel(ch).triggerOffset; }
+  float range(unsigned int ch) const { return channel(ch).range; }
+  float HV(unsigned int ch) const { return channel(ch).HV; }
+  float HV_ref(unsigned int ch) const { return channel(ch).HV_ref; }
+  float MIPcharge_ref(unsigned int ch) const { return channel(ch).MIPcharge_ref; }
+  float gainRatio(unsigned int ch) const { return channel(ch).gainRatio; }
+
+  // One past the highest channel in the table
+  unsigned int size() const { return m_channels.size(); }
+
+ private:
+  float m_nominalTriggerTime{-1.};
+  std::vector<Channel> m_channels;
+};
+
+// Class definition for StoreGate
+#include "AthenaKernel/CLASS_DEF.h"
+CLASS_DEF( WaveformCalibCondData , 251847623 , 1 )
+
+// Condition container definition for CondInputLoader
+#include "AthenaKernel/CondCont.h"
+CONDCONT_DEF( WaveformCalibCondData, 164093185 );
+
+#endif // WAVEFORMCALIBCONDDATA_H
@@ -6,6 +6,7 @@ from AthenaConfiguration.ComponentAccumulator import ComponentAccumulator
 from AthenaConfiguration.ComponentFactory import CompFactory
 from IOVDbSvc.IOVDbSvcConfig import addFolders
 WaveformCableMappingTool=CompFactory.WaveformCableMappingTool
+WaveformCableMappingCondAlg=CompFactory.WaveformCableMappingCondAlg
 
 def WaveformCableMappingToolCfg(flags, name="WaveformCableMappingTool", **kwargs):
     """ Return a configured WaveformCableMappingTool"""
@@ -23,5 +24,7 @@ def WaveformCableMappingCfg(flags, **kwargs):
     dbInstance = kwargs.get("dbInstance", "TDAQ_OFL")
     dbFolder = kwargs.get("dbFolder", "/WAVE/DAQ/CableMapping")
     acc.merge(addFolders(flags, dbFolder, dbInstance, className="CondAttrListCollection"))
+    # decode the folder once per IOV
+    acc.addCondAlgo(WaveformCableMappingCondAlg(ReadKey=dbFolder))
     return acc
 
@@ -0,0 +1,19 @@
+""" Define methods to configure WaveformCalibCondAlg
+
+Copyright (C) 2022 CERN for the benefit of the FASER collaboration
+"""
+from AthenaConfiguration.ComponentAccumulator import ComponentAccumulator
+from AthenaConfiguration.ComponentFactory import CompFactory
+from WaveformConditionsTools.WaveformTimingConfig import WaveformTimingCfg
+WaveformCalibCondAlg=CompFactory.WaveformCalibCondAlg
+
+def WaveformCalibCfg(flags, name="WaveformCalibCondAlg", **kwargs):
+    """ Return configured ComponentAccumulator with the per-IOV waveform calibration table
+
+    The timing folders are always read. RangeReadKey, PMT_HV_ReadKey and MIP_ref_ReadKey
+    may be set in kwargs, the corresponding folders must then be added by the caller
+    """
+    acc = ComponentAccumulator()
+    acc.merge(WaveformTimingCfg(flags))
+    acc.addCondAlgo(WaveformCalibCondAlg(name, **kwargs))
+    return acc
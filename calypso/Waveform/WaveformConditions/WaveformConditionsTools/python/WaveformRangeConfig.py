@@ -5,6 +5,7 @@ Copyright (C) 2022 CERN for the benefit of the FASER collaboration
 from AthenaConfiguration.ComponentAccumulator import ComponentAccumulator
 from AthenaConfiguration.ComponentFactory import CompFactory
 from IOVDbSvc.IOVDbSvcConfig import addFolders
+from WaveformConditionsTools.WaveformCalibConfig import WaveformCalibCfg
 WaveformRangeTool=CompFactory.WaveformRangeTool
 
 def WaveformRangeToolCfg(flags, name="WaveformRangeTool", **kwargs):
@@ -29,5 +30,7 @@ def WaveformRangeCfg(flags, **kwargs):
     # Must use non-shorthand folder specification here
     folder_string = f"<db>{dbInstance}/{dbName}</db> {dbFolder}"
     acc.merge(addFolders(flags, folder_string, className="CondAttrListCollection"))
+    # ranges are read once per IOV into the calibration table
+    acc.merge(WaveformCalibCfg(flags, RangeReadKey=dbFolder))
     return acc
 
@@ -0,0 +1,149 @@
+/*
+  Copyright (C) 2022 CERN for the benefit of the FASER collaboration
+*/
+
+/** @file WaveformCableMappingCondAlg.cxx
+    Based on WaveformCableMappingTool
+*/
+
+#include "WaveformCableMappingCondAlg.h"
+
+#include "FaserCaloIdentifier/EcalID.h"
+#include "ScintIdentifier/VetoID.h"
+#include "ScintIdentifier/VetoNuID.h"
+#include "ScintIdentifier/TriggerID.h"
+#include "ScintIdentifier/PreshowerID.h"
+
+#include "GaudiKernel/EventIDRange.h"
+
+#include <memory>
+
+WaveformCableMappingCondAlg::WaveformCableMappingCondAlg(const std::string& name, ISvcLocator* pSvcLocator)
+  : ::AthReentrantAlgorithm(name, pSvcLocator)
+{
+}
+
+//----------------------------------------------------------------------
+StatusCode
+WaveformCableMappingCondAlg::initialize() {
+  ATH_MSG_DEBUG("initialize " << name());
+
+  ATH_CHECK(m_condSvc.retrieve());
+
+  ATH_CHECK(m_readKey.initialize());
+  ATH_CHECK(m_writeKey.initialize());
+  if (m_condSvc->regHandle(this, m_writeKey).isFailure()) {
+    ATH_MSG_FATAL("unable to register WriteCondHandle " << m_writeKey.fullKey() << " with CondSvc");
+    return StatusCode::FAILURE;
+  }
+
+  // Set up helpers
+  ATH_CHECK(detStore()->retrieve(m_ecalID, "EcalID"));
+  ATH_CHECK(detStore()->retrieve(m_vetoID, "VetoID"));
+  ATH_CHECK(detStore()->retrieve(m_vetoNuID, "VetoNuID"));
+  ATH_CHECK(detStore()->retrieve(m_triggerID, "TriggerID"));
+  ATH_CHECK(detStore()->retrieve(m_preshowerID, "PreshowerID"));
+
+  return StatusCode::SUCCESS;
+}
+
+//----------------------------------------------------------------------
+StatusCode
+WaveformCableMappingCondAlg::execute(const EventContext& ctx) const {
+  ATH_MSG_DEBUG("execute " << name());
+
+  // Write Cond Handle
+  SG::WriteCondHandle<WaveformCableMappingCondData> writeHandle{m_writeKey, ctx};
+  // Do we have a valid Write Cond Handle for current time?
+  if (writeHandle.isValid()) {
+    ATH_MSG_DEBUG("CondHandle " << writeHandle.fullKey() << " is already valid."
+                  << ". In theory this should not be called, but may happen"
+                  << " if multiple concurrent events are being processed out of order.");
+    return StatusCode::SUCCESS;
+  }
+
+  // Read Cond Handle
+  SG::ReadCondHandle<CondAttrListCollection> readHandle{m_readKey, ctx};
+  const CondAttrListCollection* readCdo{*readHandle};
+  if (readCdo==nullptr) {
+    ATH_MSG_FATAL("Null pointer to the read conditions object");
+    return StatusCode::FAILURE;
+  }
+  // Get the validitiy range
+  EventIDRange rangeW;
+  if (not readHandle.range(rangeW)) {
+    ATH_MSG_FATAL("Failed to retrieve validity range for " << readHandle.key());
+    return StatusCode::FAILURE;
+  }
+  ATH_MSG_DEBUG("Size of CondAttrListCollection " << readHandle.fullKey() << " readCdo->size()= " << readCdo->size());
+  ATH_MSG_DEBUG("Range of input is " << rangeW);
+
+  std::unique_ptr<WaveformCableMappingCondData> writeCdo{std::make_unique<WaveformCableMappingCondData>()};
+
+  CondAttrListCollection::const_iterator attrList{readCdo->begin()};
+  CondAttrListCollection::const_iterator end{readCdo->end()};
+  // CondAttrListCollection doesn't support C++11 type loops, no generic 'begin'
+  for (; attrList!=end; ++attrList) {
+    // A CondAttrListCollection is a map of ChanNum and AttributeList
+    CondAttrListCollection::ChanNum channelNumber{attrList->first};
+    const CondAttrListCollection::AttributeList &payload{attrList->second};
+    if (not payload.exists("type") or payload["type"].isNull()) continue;
+
+    std::string det_type{payload["type"].data<std::string>()};
+
+    int stationVal{payload["station"].data<int>()};
+    int plateVal  {payload["plate"].data<int>()};
+    int rowVal    {payload["row"].data<int>()};
+    int moduleVal {payload["module"].data<int>()};
+    int pmtVal    {payload["pmt"].data<int>()};
+    Identifier identifier;
+
+    if (det_type == "calo" || det_type == "calo2") {
+      // Do checks of PMT identifier
+      identifier = m_ecalID->pmt_id(rowVal, moduleVal, pmtVal, true);
+    }
+    else if (det_type == "veto") {
+      identifier = m_vetoID->pmt_id(stationVal, plateVal, pmtVal);
+    }
+    else if (det_type == "vetonu") {
+      identifier = m_vetoNuID->pmt_id(stationVal, plateVal, pmtVal);
+    }
+    else if (det_type == "trigger") {
+      identifier = m_triggerID->pmt_id(stationVal, plateVal, pmtVal);
+    }
+    else if (det_type == "preshower") {
+      identifier = m_preshowerID->pmt_id(stationVal, plateVal, pmtVal);
+    }
+    else if (det_type == "clock" || det_type == "none") {
+      // No valid identifiers for these
+      identifier = -1;
+    }
+    else {
+      ATH_MSG_WARNING("Detector type " << det_type << " not known for channel " << channelNumber << "!");
+      det_type = std::string("none");
+      identifier = -1;
+    }
+
+    ATH_MSG_DEBUG("Mapped digitizer channel " << channelNumber << " to " << det_type << " ID: " << identifier);
+
+    writeCdo->setChannel(channelNumber, det_type, identifier);
+  }
+  const unsigned int nChannels{writeCdo->size()};
+
+  if (writeHandle.record(rangeW, std::move(writeCdo)).isFailure()) {
+    ATH_MSG_FATAL("Could not record WaveformCableMappingCondData " << writeHandle.key()
+                  << " with EventRange " << rangeW
+                  << " into Conditions Store");
+    return StatusCode::FAILURE;
+  }
+  ATH_MSG_INFO("recorded new CDO " << writeHandle.key() << " with " << nChannels << " channels and range " << rangeW << " into Conditions Store");
+
+  return StatusCode::SUCCESS;
+}
+
+//----------------------------------------------------------------------
+StatusCode
+WaveformCableMappingCondAlg::finalize() {
+  ATH_MSG_DEBUG("finalize " << name());
+  return StatusCode::SUCCESS;
+}
@@ -0,0 +1,52 @@
+// -*- C++ -*-
+
+/*
+  Copyright (C) 2022 CERN for the benefit of the FASER collaboration
+*/
+
+/** @file WaveformCableMappingCondAlg.h
+    Decodes /WAVE/DAQ/CableMapping once per IOV into WaveformCableMappingCondData
+*/
+
+#ifndef WAVEFORM_CABLE_MAPPING_COND_ALG
+#define WAVEFORM_CABLE_MAPPING_COND_ALG
+
+#include "AthenaBaseComps/AthReentrantAlgorithm.h"
+
+#include "AthenaPoolUtilities/CondAttrListCollection.h"
+#include "StoreGate/ReadCondHandleKey.h"
+#include "StoreGate/WriteCondHandleKey.h"
+#include "WaveformConditionsTools/WaveformCableMappingCondData.h"
+
+#include "GaudiKernel/ICondSvc.h"
+
+class EcalID;
+class VetoID;
+class VetoNuID;
+class TriggerID;
+class PreshowerID;
+
+class WaveformCableMappingCondAlg : public AthReentrantAlgorithm {
+
+ public:
+  WaveformCableMappingCondAlg(const std::string& name, ISvcLocator* pSvcLocator);
+  virtual ~WaveformCableMappingCondAlg() = default;
+  virtual StatusCode initialize() override;
+  virtual StatusCode execute(const EventContext& ctx) const override;
+  virtual StatusCode finalize() override;
+  virtual bool isClonable() const override { return true; };
+
+ private:
+  SG::ReadCondHandleKey<CondAttrListCollection> m_readKey{this, "ReadKey", "/WAVE/DAQ/CableMapping", "Key of input cabling folder"};
+  SG::WriteCondHandleKey<WaveformCableMappingCondData> m_writeKey{this, "WriteKey", "WaveformCableMappingCondData", "Key of output decoded cable mapping"};
+  ServiceHandle<ICondSvc> m_condSvc{this, "CondSvc", "CondSvc"};
+
+  // ID helpers
+  const EcalID* m_ecalID{nullptr};
+  const VetoID* m_vetoID{nullptr};
+  const VetoNuID* m_vetoNuID{nullptr};
+  const TriggerID* m_triggerID{nullptr};
+  const PreshowerID* m_preshowerID{nullptr};
+};
+
+#endif // WAVEFORM_CABLE_MAPPING_COND_ALG
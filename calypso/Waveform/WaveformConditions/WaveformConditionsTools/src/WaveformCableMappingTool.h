@@ -17,16 +17,8 @@
 #include "AthenaBaseComps/AthAlgTool.h"
 #include "WaveformConditionsTools/IWaveformCableMappingTool.h"
 
-// Identifiers
-#include "Identifier/Identifier.h"
-#include "FaserCaloIdentifier/EcalID.h"
-#include "ScintIdentifier/VetoID.h"
-#include "ScintIdentifier/VetoNuID.h"
-#include "ScintIdentifier/TriggerID.h"
-#include "ScintIdentifier/PreshowerID.h"
-
 // Include Athena stuff
-#include "AthenaPoolUtilities/CondAttrListCollection.h"
+#include "WaveformConditionsTools/WaveformCableMappingCondData.h"
 #include "StoreGate/ReadCondHandleKey.h"
 
 #include "GaudiKernel/ICondSvc.h"
@@ -36,7 +28,8 @@
 #include "GaudiKernel/EventContext.h"
 
 /** This class contains a Tool that reads Waveform cable mapping data and makes it available to 
-    other algorithms. The current implementation reads the data from a COOL database. 
+    other algorithms. The data are decoded from the COOL database once per IOV by
+    WaveformCableMappingCondAlg.
 */
 
 class WaveformCableMappingTool: public extends<AthAlgTool, IWaveformCableMappingTool> {
@@ -62,20 +55,15 @@ class WaveformCableMappingTool: public extends<AthAlgTool, IWaveformCableMapping
   virtual int getChannelMapping(const EventContext& ctx, const Identifier id) const override;
   virtual int getChannelMapping(const Identifier id) const override;
 
+  virtual const WaveformCableMappingCondData* getCableMappingData(const EventContext& ctx) const override;
+  virtual const WaveformCableMappingCondData* getCableMappingData(void) const override;
+
  private:
   // Read Cond Handle
-  SG::ReadCondHandleKey<CondAttrListCollection> m_readKey{this, "ReadKey", "/WAVE/DAQ/CableMapping", "Key of input cabling folder"};
+  SG::ReadCondHandleKey<WaveformCableMappingCondData> m_condKey{this, "CondKey", "WaveformCableMappingCondData", "Key of decoded cable mapping"};
 
   ServiceHandle<ICondSvc> m_condSvc{this, "CondSvc", "CondSvc"};
 
-  // ID helpers
-  const EcalID* m_ecalID{nullptr};
-  const VetoID* m_vetoID{nullptr};
-  const VetoNuID* m_vetoNuID{nullptr};
-  const TriggerID* m_triggerID{nullptr};
-  const PreshowerID* m_preshowerID{nullptr};
-
-
 };
 
 //---------------------------------------------------------------------- 
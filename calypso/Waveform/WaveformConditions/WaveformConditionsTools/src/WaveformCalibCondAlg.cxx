@@ -0,0 +1,173 @@
+/*
+  Copyright (C) 2022 CERN for the benefit of the FASER collaboration
+*/
+
+/** @file WaveformCalibCondAlg.cxx
+    Based on WaveformTimingTool, WaveformRangeTool and CaloRecTool
+*/
+
+#include "WaveformCalibCondAlg.h"
+
+#include "GaudiKernel/EventIDRange.h"
+
+#include "TFile.h"
+
+#include <cmath>
+#include <memory>
+
+WaveformCalibCondAlg::WaveformCalibCondAlg(const std::string& name, ISvcLocator* pSvcLocator)
+  : ::AthReentrantAlgorithm(name, pSvcLocator)
+{
+}
+
+//----------------------------------------------------------------------
+StatusCode
+WaveformCalibCondAlg::initialize() {
+  ATH_MSG_DEBUG("initialize " << name());
+
+  ATH_CHECK(m_condSvc.retrieve());
+
+  ATH_CHECK(m_timingReadKey.initialize());
+  ATH_CHECK(m_offsetReadKey.initialize());
+  ATH_CHECK(m_rangeReadKey.initialize(not m_rangeReadKey.empty()));
+  ATH_CHECK(m_HVReadKey.initialize(not m_HVReadKey.empty()));
+  ATH_CHECK(m_MIPrefReadKey.initialize(not m_MIPrefReadKey.empty()));
+
+  ATH_CHECK(m_writeKey.initialize());
+  if (m_condSvc->regHandle(this, m_writeKey).isFailure()) {
+    ATH_MSG_FATAL("unable to register WriteCondHandle " << m_writeKey.fullKey() << " with CondSvc");
+    return StatusCode::FAILURE;
+  }
+
+  // The gain curves are only needed to extrapolate the calorimeter gain
+  if (not m_HVReadKey.empty() and not m_MIPrefReadKey.empty()) {
+    std::unique_ptr<TFile> file{TFile::Open(m_PMT_HV_Gain_Curve_file.value().c_str(), "read")};
+    if (!file || file->IsZombie()) {
+      ATH_MSG_FATAL("Cannot open PMT HV gain curve file " << m_PMT_HV_Gain_Curve_file.value());
+      return StatusCode::FAILURE;
+    }
+    for (const std::string& curveName : m_HVgainCurveNames.value()) {
+      const TF1* curve = file->Get<TF1>(curveName.c_str());
+      if (!curve) {
+        ATH_MSG_FATAL("No PMT HV gain curve " << curveName << " in " << m_PMT_HV_Gain_Curve_file.value());
+        return StatusCode::FAILURE;
+      }
+      m_HVgainCurves.push_back(*curve);
+    }
+    file->Close();
+  }
+
+  return StatusCode::SUCCESS;
+}
+
+//----------------------------------------------------------------------
+void
+WaveformCalibCondAlg::fillChannels(const CondAttrListCollection& coll, const std::string& name,
+                                   WaveformCalibCondData& cdo, float WaveformCalibCondData::Channel::* field) const {
+  CondAttrListCollection::const_iterator attrList{coll.begin()};
+  CondAttrListCollection::const_iterator end{coll.end()};
+  // CondAttrListCollection doesn't support C++11 type loops, no generic 'begin'
+  for (; attrList!=end; ++attrList) {
+    CondAttrListCollection::ChanNum channelNumber{attrList->first};
+    const CondAttrListCollection::AttributeList &payload{attrList->second};
+    if (payload.exists(name) and not payload[name].isNull()) {
+      cdo.channel(channelNumber).*field = payload[name].data<float>();
+      ATH_MSG_DEBUG("Found digitizer channel " << channelNumber << " " << name << " as " << cdo.channel(channelNumber).*field);
+    } else {
+      ATH_MSG_WARNING("No valid " << name << " found for channel " << channelNumber << "!");
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+StatusCode
+WaveformCalibCondAlg::execute(const EventContext& ctx) const {
+  ATH_MSG_DEBUG("execute " << name());
+
+  // Write Cond Handle
+  SG::WriteCondHandle<WaveformCalibCondData> writeHandle{m_writeKey, ctx};
+  // Do we have a valid Write Cond Handle for current time?
+  if (writeHandle.isValid()) {
+    ATH_MSG_DEBUG("CondHandle " << writeHandle.fullKey() << " is already valid."
+                  << ". In theory this should not be called, but may happen"
+                  << " if multiple concurrent events are being processed out of order.");
+    return StatusCode::SUCCESS;
+  }
+
+  std::unique_ptr<WaveformCalibCondData> writeCdo{std::make_unique<WaveformCalibCondData>()};
+
+  // Nominal trigger time
+  SG::ReadCondHandle<AthenaAttributeList> timingHandle{m_timingReadKey, ctx};
+  const AthenaAttributeList* timingCdo{*timingHandle};
+  if (timingCdo==nullptr) {
+    ATH_MSG_FATAL("Null pointer to the read conditions object " << m_timingReadKey.key());
+    return StatusCode::FAILURE;
+  }
+  writeHandle.addDependency(timingHandle);
+  const CondAttrListCollection::AttributeList &timingPayload{*timingCdo};
+  if (timingPayload.exists("NominalTriggerTime") and not timingPayload["NominalTriggerTime"].isNull()) {
+    writeCdo->setNominalTriggerTime(timingPayload["NominalTriggerTime"].data<float>());
+    ATH_MSG_DEBUG("Found nominal trigger time " << writeCdo->nominalTriggerTime() << " ns");
+  } else {
+    ATH_MSG_WARNING("No valid nominal trigger time found!");
+  }
+
+  // Per-channel folders
+  auto readChannels = [&](const SG::ReadCondHandleKey<CondAttrListCollection>& key,
+                          const std::string& name, float WaveformCalibCondData::Channel::* field) -> bool {
+    SG::ReadCondHandle<CondAttrListCollection> readHandle{key, ctx};
+    const CondAttrListCollection* readCdo{*readHandle};
+    if (readCdo==nullptr) {
+      ATH_MSG_FATAL("Null pointer to the read conditions object " << key.key());
+      return false;
+    }
+    writeHandle.addDependency(readHandle);
+    ATH_MSG_DEBUG("Size of CondAttrListCollection " << readHandle.fullKey() << " readCdo->size()= " << readCdo->size());
+    fillChannels(*readCdo, name, *writeCdo, field);
+    return true;
+  };
+
+  if (not readChannels(m_offsetReadKey, "TriggerOffset", &WaveformCalibCondData::Channel::triggerOffset)) return StatusCode::FAILURE;
+  if (not m_rangeReadKey.empty()) {
+    if (not readChannels(m_rangeReadKey, "range", &WaveformCalibCondData::Channel::range)) return StatusCode::FAILURE;
+  }
+  if (not m_HVReadKey.empty()) {
+    if (not readChannels(m_HVReadKey, "HV", &WaveformCalibCondData::Channel::HV)) return StatusCode::FAILURE;
+  }
+  if (not m_MIPrefReadKey.empty()) {
+    if (not readChannels(m_MIPrefReadKey, "HV_ref", &WaveformCalibCondData::Channel::HV_ref)) return StatusCode::FAILURE;
+    if (not readChannels(m_MIPrefReadKey, "charge_ref", &WaveformCalibCondData::Channel::MIPcharge_ref)) return StatusCode::FAILURE;
+  }
+
+  // Gain at HV_ref relative to the gain at HV, channels without a gain curve only use the power law
+  if (not m_HVgainCurves.empty()) {
+    for (unsigned int ch = 0; ch < writeCdo->size(); ch++) {
+      WaveformCalibCondData::Channel& calib = writeCdo->channel(ch);
+      if (calib.HV <= 0. or calib.HV_ref <= 0.) continue;
+      float curveRatio = 1.;
+      if (ch < m_HVgainCurves.size()) {
+        curveRatio = m_HVgainCurves[ch].Eval(calib.HV_ref) / m_HVgainCurves[ch].Eval(calib.HV);
+      }
+      calib.gainRatio = curveRatio * std::pow(calib.HV_ref / calib.HV, 6.6);
+      ATH_MSG_DEBUG("Digitizer channel " << ch << " HV gain ratio " << calib.gainRatio);
+    }
+  }
+
+  const unsigned int nChannels{writeCdo->size()};
+  if (writeHandle.record(std::move(writeCdo)).isFailure()) {
+    ATH_MSG_FATAL("Could not record WaveformCalibCondData " << writeHandle.key()
+                  << " with EventRange " << writeHandle.getRange()
+                  << " into Conditions Store");
+    return StatusCode::FAILURE;
+  }
+  ATH_MSG_INFO("recorded new CDO " << writeHandle.key() << " with " << nChannels << " channels and range " << writeHandle.getRange() << " into Conditions Store");
+
+  return StatusCode::SUCCESS;
+}
+
+//----------------------------------------------------------------------
+StatusCode
+WaveformCalibCondAlg::finalize() {
+  ATH_MSG_DEBUG("finalize " << name());
+  return StatusCode::SUCCESS;
+}
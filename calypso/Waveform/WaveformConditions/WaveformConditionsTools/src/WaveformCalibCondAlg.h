@@ -0,0 +1,68 @@
+// -*- C++ -*-
+
+/*
+  Copyright (C) 2022 CERN for the benefit of the FASER collaboration
+*/
+
+/** @file WaveformCalibCondAlg.h
+    Compiles the waveform timing, digitizer range and calorimeter calibration
+    folders once per IOV into WaveformCalibCondData
+*/
+
+#ifndef WAVEFORM_CALIB_COND_ALG
+#define WAVEFORM_CALIB_COND_ALG
+
+#include "AthenaBaseComps/AthReentrantAlgorithm.h"
+
+#include "AthenaPoolUtilities/AthenaAttributeList.h"
+#include "AthenaPoolUtilities/CondAttrListCollection.h"
+#include "StoreGate/ReadCondHandleKey.h"
+#include "StoreGate/WriteCondHandleKey.h"
+#include "WaveformConditionsTools/WaveformCalibCondData.h"
+
+#include "GaudiKernel/ICondSvc.h"
+#include "Gaudi/Property.h"
+
+// ROOT
+#include "TF1.h"
+
+#include <string>
+#include <vector>
+
+/** The range, HV and MIP reference folders are optional (an empty key is not
+    read), so that jobs without calorimeter reconstruction do not need them.
+    The HV gain ratio is only evaluated when both calorimeter folders are read.
+*/
+class WaveformCalibCondAlg : public AthReentrantAlgorithm {
+
+ public:
+  WaveformCalibCondAlg(const std::string& name, ISvcLocator* pSvcLocator);
+  virtual ~WaveformCalibCondAlg() = default;
+  virtual StatusCode initialize() override;
+  virtual StatusCode execute(const EventContext& ctx) const override;
+  virtual StatusCode finalize() override;
+  virtual bool isClonable() const override { return true; };
+
+ private:
+  SG::ReadCondHandleKey<AthenaAttributeList> m_timingReadKey{this, "TimingReadKey", "/WAVE/DAQ/Timing", "Key of timing folder"};
+  SG::ReadCondHandleKey<CondAttrListCollection> m_offsetReadKey{this, "OffsetReadKey", "/WAVE/DAQ/TimingOffset", "Key of timing offset folder"};
+  SG::ReadCondHandleKey<CondAttrListCollection> m_rangeReadKey{this, "RangeReadKey", "", "Key of digitizer range folder"};
+  SG::ReadCondHandleKey<CondAttrListCollection> m_HVReadKey{this, "PMT_HV_ReadKey", "", "Key of folder for PMT HV reading"};
+  SG::ReadCondHandleKey<CondAttrListCollection> m_MIPrefReadKey{this, "MIP_ref_ReadKey", "", "Key of folder for MIP charge calibration measurement"};
+  SG::WriteCondHandleKey<WaveformCalibCondData> m_writeKey{this, "WriteKey", "WaveformCalibCondData", "Key of output calibration table"};
+  ServiceHandle<ICondSvc> m_condSvc{this, "CondSvc", "CondSvc"};
+
+  // PMT HV gain curves, indexed by digitizer channel, used to extrapolate the gain from HV_ref to HV
+  StringProperty m_PMT_HV_Gain_Curve_file{this, "PMT_HV_Gain_Curve_file", "/cvmfs/faser.cern.ch/repo/sw/database/DBRelease/current/pmtgain/CaloGainCurves.root"};
+  Gaudi::Property<std::vector<std::string> > m_HVgainCurveNames{this, "HVgainCurves",
+      {"pol5_HV_Gain_Curve_PMT_LB8770", "pol5_HV_Gain_Curve_PMT_LB8733", "pol5_HV_Gain_Curve_PMT_LB8786", "pol5_HV_Gain_Curve_PMT_LB8732"},
+      "Names of the PMT HV gain curves of the first digitizer channels"};
+
+  std::vector<TF1> m_HVgainCurves;
+
+  // Fill one float per channel from a CondAttrListCollection
+  void fillChannels(const CondAttrListCollection& coll, const std::string& name,
+                    WaveformCalibCondData& cdo, float WaveformCalibCondData::Channel::* field) const;
+};
+
+#endif // WAVEFORM_CALIB_COND_ALG
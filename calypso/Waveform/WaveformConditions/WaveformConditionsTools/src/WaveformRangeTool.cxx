@@ -21,7 +21,7 @@ WaveformRangeTool::initialize() {
 
   ATH_MSG_DEBUG("WaveformRangeTool::initialize()");
 
-  ATH_CHECK(m_readKey.initialize());
+  ATH_CHECK(m_condKey.initialize());
 
   return StatusCode::SUCCESS;
 }
@@ -33,6 +33,23 @@ WaveformRangeTool::finalize() {
   return StatusCode::SUCCESS;
 }
 
+//----------------------------------------------------------------------
+const WaveformCalibCondData*
+WaveformRangeTool::getRangeData(const EventContext& ctx) const {
+  SG::ReadCondHandle<WaveformCalibCondData> condData{m_condKey, ctx};
+  if (not condData.isValid()) {
+    ATH_MSG_FATAL("Failed to retrieve " << m_condKey.key());
+    return nullptr;
+  }
+  return *condData;
+}
+
+const WaveformCalibCondData*
+WaveformRangeTool::getRangeData(void) const {
+  const EventContext& ctx{Gaudi::Hive::currentContext()};
+  return getRangeData(ctx);
+}
+
 //----------------------------------------------------------------------
 WaveformRangeMap
 WaveformRangeTool::getRangeMapping(const EventContext& ctx) const {
@@ -40,43 +57,12 @@ WaveformRangeTool::getRangeMapping(const EventContext& ctx) const {
   ATH_MSG_DEBUG("in getRangeMapping()");
   WaveformRangeMap mappingData;
 
-  // Read Cond Handle
-  SG::ReadCondHandle<CondAttrListCollection> readHandle{m_readKey, ctx};
-  const CondAttrListCollection* readCdo{*readHandle}; 
-  if (readCdo==nullptr) {
-    ATH_MSG_FATAL("Null pointer to the read conditions object");
-    return mappingData;
-  }
-  // Get the validitiy range
-  EventIDRange rangeW;
-  if (not readHandle.range(rangeW)) {
-    ATH_MSG_FATAL("Failed to retrieve validity range for " << readHandle.key());
-    return mappingData;
-  }
-  ATH_MSG_DEBUG("Size of CondAttrListCollection " << readHandle.fullKey() << " readCdo->size()= " << readCdo->size());
-  ATH_MSG_DEBUG("Range of input is " << rangeW);
-  
-  // Read range info
-
-  CondAttrListCollection::const_iterator attrList{readCdo->begin()};
-  CondAttrListCollection::const_iterator end{readCdo->end()};
-  // CondAttrListCollection doesn't support C++11 type loops, no generic 'begin'
-  for (; attrList!=end; ++attrList) {
-    // A CondAttrListCollection is a map of ChanNum and AttributeList
-    CondAttrListCollection::ChanNum channelNumber{attrList->first};
-    const CondAttrListCollection::AttributeList &payload{attrList->second};
-    if (payload.exists("range") and not payload["range"].isNull()) {
-
-      float range {payload["range"].data<float>()};
-
-      ATH_MSG_DEBUG("Found digitizer channel " << channelNumber << " range as " << range);
-
-      mappingData.emplace(std::make_pair(channelNumber, range));
-
-    }
-
-  } // End of loop over attributes
+  const WaveformCalibCondData* condData{getRangeData(ctx)};
+  if (condData==nullptr) return mappingData;
 
+  for (unsigned int channel = 0; channel < condData->size(); channel++) {
+    mappingData.emplace(channel, condData->range(channel));
+  }
   return mappingData;
 } 
 
@@ -85,6 +71,3 @@ WaveformRangeTool::getRangeMapping(void) const {
   const EventContext& ctx{Gaudi::Hive::currentContext()};
   return getRangeMapping(ctx);
 }
-
-
-
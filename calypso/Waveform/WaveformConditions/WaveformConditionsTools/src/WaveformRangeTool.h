@@ -17,7 +17,7 @@
 #include "WaveformConditionsTools/IWaveformRangeTool.h"
 
 // Include Athena stuff
-#include "AthenaPoolUtilities/CondAttrListCollection.h"
+#include "WaveformConditionsTools/WaveformCalibCondData.h"
 #include "StoreGate/ReadCondHandleKey.h"
 
 #include "GaudiKernel/ICondSvc.h"
@@ -27,7 +27,8 @@
 #include "GaudiKernel/EventContext.h"
 
 /** This class contains a Tool that reads Waveform range data and makes it available to 
-    other algorithms. The current implementation reads the data from a COOL database. 
+    other algorithms. The ranges are read from the COOL database once per IOV by
+    WaveformCalibCondAlg.
 */
 
 class WaveformRangeTool: public extends<AthAlgTool, IWaveformRangeTool> {
@@ -48,9 +49,12 @@ class WaveformRangeTool: public extends<AthAlgTool, IWaveformRangeTool> {
   virtual WaveformRangeMap getRangeMapping(const EventContext& ctx) const override;
   virtual WaveformRangeMap getRangeMapping(void) const override;
 
+  virtual const WaveformCalibCondData* getRangeData(const EventContext& ctx) const override;
+  virtual const WaveformCalibCondData* getRangeData(void) const override;
+
  private:
   // Read Cond Handle
-  SG::ReadCondHandleKey<CondAttrListCollection> m_readKey{this, "ReadKey", "/WAVE/DAQ/Range", "Key of range folder"};
+  SG::ReadCondHandleKey<WaveformCalibCondData> m_condKey{this, "CondKey", "WaveformCalibCondData", "Key of calibration table with the ranges"};
 
   ServiceHandle<ICondSvc> m_condSvc{this, "CondSvc", "CondSvc"};
 
@@ -1,9 +1,13 @@
 #include "../WaveformRangeTool.h"
 #include "../WaveformTimingTool.h"
 #include "../WaveformCableMappingTool.h"
+#include "../WaveformCableMappingCondAlg.h"
 #include "../WaveformDigiConditionsTool.h"
+#include "../WaveformCalibCondAlg.h"
 
 DECLARE_COMPONENT( WaveformRangeTool )
 DECLARE_COMPONENT( WaveformTimingTool )
 DECLARE_COMPONENT( WaveformCableMappingTool )
+DECLARE_COMPONENT( WaveformCableMappingCondAlg )
 DECLARE_COMPONENT( WaveformDigiConditionsTool )
+DECLARE_COMPONENT( WaveformCalibCondAlg )
@@ -11,6 +11,7 @@
 #include <stdexcept>
 #include <chrono>
 #include <vector>
+#include <array>
 #include <iomanip>
 #include <map>
 #include <fstream>
@@ -26,6 +27,9 @@ CREATE_EXCEPTION_TYPE(CompressionDataException,DAQFormats)
 
 namespace DAQFormats {
   typedef std::vector<uint8_t> byteVector;
+
+  class FragmentView;
+  class EventView;
   
   //FIXME: add Doxygen
 
@@ -82,6 +86,7 @@ namespace DAQFormats {
   class EventFragment {
   public:
     friend inline std::ostream& operator<<(std::ostream &out, const  DAQFormats::EventFragment &frag);
+    friend class FragmentView;
 
     EventFragment() = delete;
 
@@ -174,14 +179,14 @@ namespace DAQFormats {
     uint64_t timestamp() const { return header.timestamp; }
     
   private:
-    const uint16_t FragmentVersionLatest = 0x0001;
+    static constexpr uint16_t FragmentVersionLatest = 0x0001;
     /*
     Current Version
     00 01
     Compressed Fragment
     01 01
     */
-    const uint8_t FragmentMarker = 0xAA; // indicates good raw data events
+    static constexpr uint8_t FragmentMarker = 0xAA; // indicates good raw data events
     struct EventFragmentHeader {
       uint8_t marker;
       uint8_t fragment_tag;
@@ -210,6 +215,7 @@ namespace DAQFormats {
      */
     
     friend inline std::ostream& operator<<(std::ostream &out, const  DAQFormats::EventFull &ev);
+    friend class EventView;
     EventFull(uint8_t event_tag=IncompleteTag, unsigned int run_number=0, uint64_t event_number=0) {
       microseconds timestamp;
       timestamp = duration_cast<microseconds>(system_clock::now().time_since_epoch());
@@ -498,8 +504,8 @@ namespace DAQFormats {
     }
 
   private:
-    const uint8_t EventVersionLatest = 0x01;
-    const uint8_t EventMarker = 0xBB;
+    static constexpr uint8_t EventVersionLatest = 0x01;
+    static constexpr uint8_t EventMarker = 0xBB;
     std::vector<uint8_t> compressedData;
     struct EventHeader {
       uint8_t marker;
@@ -520,6 +526,202 @@ namespace DAQFormats {
     std::map<uint32_t,const EventFragment*> fragments;
   };
 
+  /** \brief Non-owning view of an encoded event fragment
+   *
+   *  The header and payload are accessed in place, so the underlying
+   *  buffer (raw event data or an EventFragment) must outlive the view.
+   */
+
+  class FragmentView {
+  public:
+    friend inline std::ostream& operator<<(std::ostream &out, const  DAQFormats::FragmentView &frag);
+
+    FragmentView() : header(nullptr), data(nullptr) {}
+
+    /** \brief Constructor given an already encoded fragment
+     */
+    FragmentView(const uint8_t *buffer, size_t size, bool allowExcessData=false) {
+      if (size<8) THROW(EFormatException,"Too little data for fragment header");
+      header=reinterpret_cast<const EventFragment::EventFragmentHeader*>(buffer);
+      if (header->marker!=EventFragment::FragmentMarker) THROW(EFormatException,"No fragment header");
+      if (header->version_number!=EventFragment::FragmentVersionLatest) THROW(EFormatException,"Unsupported fragment version");
+      if (size<header->header_size) THROW(EFormatException,"Too little data for fragment header");
+      if (size<static_cast<size_t>(header->header_size)+header->payload_size) THROW(EFormatException,"Too little data for fragment");
+      if ((size!=static_cast<size_t>(header->header_size)+header->payload_size)&&!allowExcessData) THROW(EFormatException,"fragment size does not match header information");
+      data=buffer+header->header_size;
+    }
+
+    /// \brief Constructor given a decoded fragment, no data is copied
+    explicit FragmentView(const EventFragment &frag) :
+      header(&frag.header), data(frag.fragment.data()) {}
+
+    /// \brief Returns the payload as pointer of desired type
+    template <typename T = void *> T payload() const {
+      static_assert(std::is_pointer<T>(), "Type parameter must be a pointer type");
+      return reinterpret_cast<T>(data);
+    }
+
+    bool valid() const { return header!=nullptr; }
+
+    //getters here
+    uint64_t event_id() const { return header->event_id; }
+    uint8_t  fragment_tag() const { return header->fragment_tag; }
+    uint32_t source_id() const { return header->source_id; }
+    uint16_t bc_id() const { return header->bc_id; }
+    uint16_t status() const { return header->status; }
+    uint16_t trigger_bits() const { return header->trigger_bits; }
+    uint32_t size() const { return header->header_size+header->payload_size; }
+    uint16_t header_size() const { return header->header_size; }
+    uint32_t payload_size() const { return header->payload_size; }
+    uint64_t timestamp() const { return header->timestamp; }
+
+  private:
+    const EventFragment::EventFragmentHeader *header;
+    const uint8_t *data;
+  };
+
+  /** \brief Non-owning view of a full event
+   *
+   *  Headers are parsed in place over a caller-owned buffer and fragments
+   *  are looked up through a fixed-size table indexed by source id, so
+   *  loading an event does not allocate. Compressed events are expanded
+   *  into a caller-provided scratch vector which can be reused between
+   *  events. The buffer (and scratch vector) must outlive the view.
+   */
+
+  class EventView {
+  public:
+    friend inline std::ostream& operator<<(std::ostream &out, const  DAQFormats::EventView &ev);
+
+    /// Maximum number of fragments a view can hold
+    static constexpr size_t MaxFragments = 64;
+
+    typedef const FragmentView* const_iterator;
+
+    EventView() : nFragments(0) {
+      header = EventFull::EventHeader();
+      index.fill(0);
+    }
+
+    /// \brief Constructor given an existing event in stream of bytes
+    EventView(const uint8_t *buffer, size_t eventsize, byteVector *scratch=nullptr) : EventView() {
+      load(buffer, eventsize, scratch);
+    }
+
+    /// \brief Constructor given a decoded event, no fragment data is copied
+    explicit EventView(const EventFull &event) : EventView() {
+      load(event);
+    }
+
+    /** \brief Load event from stream of bytes
+     *
+     *  If the event is compressed, the payload is decompressed into scratch,
+     *  which must then be provided.
+     */
+    void load(const uint8_t *buffer, size_t eventsize, byteVector *scratch=nullptr) {
+      clear();
+      if (eventsize<sizeof(EventFull::EventHeader)) THROW(EFormatException,"Too small to be event");
+      header=*reinterpret_cast<const EventFull::EventHeader *>(buffer);
+      if (header.marker!=EventFull::EventMarker) THROW(EFormatException,"Wrong event header");
+      if (header.version_number != EventFull::EventVersionLatest) THROW(EFormatException,"Unsupported event format version");
+      if (eventsize<header.header_size) THROW(EFormatException,"Too small to be event");
+
+      const uint8_t *payloadData=buffer+header.header_size;
+      size_t datasize=eventsize-header.header_size;
+      if (header.status & Compressed) {
+        if (!scratch) THROW(CompressionDataException,"Compressed event requires a decompression buffer");
+        if (!EventFull::decompressPayload(header.compression_code,payloadData,datasize,*scratch))
+          THROW(CompressionDataException,"DECOMPRESSION FAILED SKIPPING EVENT READ");
+        payloadData=scratch->data();
+        datasize=scratch->size();
+        header.payload_size=datasize;
+        header.status=static_cast<uint16_t>(header.status&~Compressed);
+        header.compression_code=NotCompressed;
+      }
+      if (datasize != header.payload_size) THROW(EFormatException, "Payload size does not match header information");
+
+      for(int fragNum=0;fragNum<header.fragment_count;fragNum++) {
+        FragmentView fragment(payloadData,datasize,true);
+        payloadData+=fragment.size();
+        datasize-=fragment.size();
+        addFragment(fragment);
+      }
+    }
+
+    /// \brief Load view of an already decoded event
+    void load(const EventFull &event) {
+      clear();
+      header=event.header;
+      for(const auto& frag: event.fragments) {
+        addFragment(FragmentView(*frag.second));
+      }
+    }
+
+    /// Forget current event, the view can then be reused
+    void clear() {
+      for(size_t i=0;i<nFragments;i++) {
+        size_t slot=indexSlot(fragments[i].source_id());
+        if (slot<IndexSize) index[slot]=0;
+      }
+      nFragments=0;
+    }
+
+    // getters here
+    uint8_t event_tag() const { return header.event_tag; }
+    uint16_t status() const { return header.status; }
+    uint64_t event_id() const { return header.event_id; }
+    uint64_t event_counter() const { return header.event_counter; }
+    uint16_t bc_id() const { return header.bc_id; }
+    uint32_t size() const { return header.header_size+header.payload_size; }
+    uint16_t header_size() const { return header.header_size; }
+    uint32_t payload_size() const { return header.payload_size; }
+    uint64_t timestamp() const { return header.timestamp; }
+    uint64_t run_number() const { return header.run_number; }
+    uint16_t trigger_bits() const { return header.trigger_bits; }
+    uint16_t fragment_count() const { return static_cast<uint16_t>(nFragments); }
+    uint8_t event_version() const { return header.version_number; }
+
+    /// Iterate over fragments in the order they appear in the event
+    const_iterator begin() const { return fragments.data(); }
+    const_iterator end() const { return fragments.data()+nFragments; }
+
+    /// Find fragment with specific source id
+    const FragmentView *find_fragment(uint32_t source_id) const {
+      size_t slot=indexSlot(source_id);
+      if (slot<IndexSize) {
+        if (!index[slot]) return nullptr;
+        return &fragments[index[slot]-1];
+      }
+      for(size_t i=0;i<nFragments;i++) {
+        if (fragments[i].source_id()==source_id) return &fragments[i];
+      }
+      return nullptr;
+    }
+
+  private:
+    // Direct lookup covers 16 modules for each of 8 source types, which
+    // includes all source ids in use. Others fall back to a linear search.
+    static constexpr size_t IndexSize = 8*16;
+    static size_t indexSlot(uint32_t source_id) {
+      if (source_id & 0xFFF8FFF0) return IndexSize;
+      return ((source_id>>16)<<4) | (source_id&0xF);
+    }
+
+    void addFragment(const FragmentView &fragment) {
+      if (nFragments>=MaxFragments) THROW(EFormatException,"Too many fragments for event view");
+      size_t slot=indexSlot(fragment.source_id());
+      if ((slot<IndexSize && index[slot]) || (slot>=IndexSize && find_fragment(fragment.source_id())))
+        THROW(EFormatException,"Duplicate fragment addition!");
+      fragments[nFragments++]=fragment;
+      if (slot<IndexSize) index[slot]=static_cast<uint8_t>(nFragments);
+    }
+
+    EventFull::EventHeader header;
+    std::array<FragmentView,MaxFragments> fragments;
+    std::array<uint8_t,IndexSize> index; // position+1 in fragments, 0 if absent
+    size_t nFragments;
+  };
+
   inline std::ostream &operator<<(std::ostream &out, const  DAQFormats::EventFragment &frag) {
     out<<" Fragment: tag="<<static_cast<int>(frag.fragment_tag())
       <<" source=0x"<<std::hex<<std::setfill('0')<<std::setw(4)<<std::hex<<frag.source_id()
@@ -546,6 +748,33 @@ namespace DAQFormats {
 
       return out;
   }
+
+  inline std::ostream &operator<<(std::ostream &out, const  DAQFormats::FragmentView &frag) {
+    out<<" Fragment: tag="<<static_cast<int>(frag.fragment_tag())
+      <<" source=0x"<<std::hex<<std::setfill('0')<<std::setw(4)<<std::hex<<frag.source_id()
+      <<" bc="<<std::dec<<std::setfill(' ')<<std::setw(4)<<frag.bc_id()
+      <<" status=0x"<<std::hex<<std::setw(4)<<std::setfill('0')<<frag.status()
+      <<" payload="<<std::dec<<std::setfill(' ')<<std::setw(5)<<frag.payload_size()
+      <<" bytes";
+      return out;
+  }
+
+  inline std::ostream &operator<<(std::ostream &out, const  DAQFormats::EventView &ev) {
+      out<<"Event: "<<std::setw(8)<<ev.event_counter()<<" (0x"<<std::hex<<std::setfill('0') <<std::setw(8)<<std::right<<ev.event_id()<<") "
+        <<std::setfill(' ')
+        <<" run="<<std::dec<<ev.run_number()
+        <<" tag="<<std::dec<<static_cast<int>(ev.event_tag())
+        <<" bc="<<std::dec<<std::setw(4)<<ev.bc_id()
+        <<" trig=0x"<<std::hex<<std::setfill('0')<<std::setw(4)<<std::right<<ev.trigger_bits()
+        <<" status=0x"<<std::hex<<std::setw(4)<<static_cast<int>(ev.status())
+        <<std::setfill(' ')
+        <<" time="<<std::dec<<ev.timestamp()
+        <<" #fragments="<<ev.fragment_count()
+        <<" payload="<<std::dec<<std::setw(6)<<ev.payload_size()
+        <<" bytes";
+
+      return out;
+  }
 }
 
 #define customdatatypeList (DataFragment<EventFull>)(DataFragment<EventFragment>)
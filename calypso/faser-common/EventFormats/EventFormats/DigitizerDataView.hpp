@@ -0,0 +1,170 @@
+/*
+  Copyright (C) 2019-2020 CERN for the benefit of the FASER collaboration
+*/
+
+///////////////////////////////////////////////////////////////////
+// DigitizerDataView.hpp, (c) FASER Detector software
+///////////////////////////////////////////////////////////////////
+
+#pragma once
+#include <array>
+#include <iomanip>
+#include <vector>
+#include "EventFormats/DigitizerDataFragment.hpp"
+
+/** \brief Decoded digitizer fragment giving the ADC samples as contiguous spans
+ *
+ *  Decodes and checks the header exactly like DigitizerDataFragment, but does
+ *  not copy the samples into per-channel vectors. Each word holds two samples
+ *  with the first one in the lower half, and the words of a channel follow
+ *  each other, so on little-endian hosts the payload already is the uint16_t
+ *  sample array of all enabled channels in channel order and the spans point
+ *  straight into it. On big-endian hosts the samples are unpacked once into
+ *  a single contiguous buffer owned by the view.
+ *
+ *  The view does not own the payload, which must outlive it.
+ */
+class DigitizerDataView {
+  public:
+
+    /// Non-owning range of samples of a single channel
+    struct SampleSpan {
+      const uint16_t* first;
+      size_t count;
+      const uint16_t* data() const { return first; }
+      size_t size() const { return count; }
+      bool empty() const { return count == 0; }
+      const uint16_t* begin() const { return first; }
+      const uint16_t* end() const { return first + count; }
+      uint16_t operator[](size_t i) const { return first[i]; }
+    };
+
+    DigitizerDataView( const uint32_t *data, size_t size ) {
+      m_size = size;
+
+      if( size < 16 ){
+        THROW(DigitizerData::DigitizerDataException, "The fragment is not big enough to even be a header");
+      }
+
+      // decode header, same as DigitizerDataFragment
+      m_event_size            = data[0] & 0x0FFFFFFF;
+      m_board_id              = data[1] >> 27;
+      m_board_fail_flag       = GetBit(data[1], 26);
+      m_pattern_trig_options  = static_cast<uint16_t>((data[1] & 0x00FFFFFF) >> 8);
+      m_channel_mask          = static_cast<uint16_t>((data[1] & 0x000000FF) | ((data[2] & 0xFF000000) >> 16));
+      m_event_counter         = data[2] & 0x00FFFFFF;
+      m_trigger_time_tag      = data[3];
+
+      if( (m_event_size*4) != size ){
+        THROW(DigitizerData::DigitizerDataException, "Mismatch in payload size (" + std::to_string(size) + ") and expected size (" + std::to_string(m_event_size*4) + ")");
+      }
+
+      unsigned int event_size_no_header = m_event_size-4;
+      unsigned int n_channels_active = static_cast<unsigned int>(std::bitset<N_MAX_CHAN>(m_channel_mask).count());
+      if( n_channels_active == 0 ){
+        THROW(DigitizerData::DigitizerDataException, "No channels enabled in channel mask");
+      }
+      if( event_size_no_header%n_channels_active != 0 ){
+        THROW(DigitizerData::DigitizerDataException, "Mismatch in data length and number of enabled channels");
+      }
+      unsigned int words_per_channel = event_size_no_header/n_channels_active;
+      m_n_samples = 2*words_per_channel;
+
+      // sample offset of every channel, disabled channels get an empty range
+      uint32_t offset = 0;
+      for(int iChan=0; iChan<N_MAX_CHAN; iChan++){
+        m_offsets[static_cast<size_t>(iChan)] = offset;
+        if( channel_has_data(iChan) ) offset += m_n_samples;
+      }
+      m_offsets[N_MAX_CHAN] = offset;
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+      m_samples = reinterpret_cast<const uint16_t*>(data + 4);
+#else
+      m_buffer.resize(offset);
+      for(size_t iWord=0; iWord<offset/2; iWord++){
+        uint32_t chData = data[4+iWord];
+        m_buffer[2*iWord]   = static_cast<uint16_t>(chData & 0x0000FFFF);        // sample[n]
+        m_buffer[2*iWord+1] = static_cast<uint16_t>((chData & 0xFFFF0000) >> 16); // sample[n+1]
+      }
+      m_samples = m_buffer.data();
+#endif
+    }
+
+    /// Always true, as every enabled channel has n_samples() samples by construction
+    bool valid() const { return true; }
+
+    // getters, same meaning as in DigitizerDataFragment
+    uint32_t event_size() const { return m_event_size; }
+    uint32_t board_id() const { return m_board_id; }
+    uint32_t board_fail_flag() const { return m_board_fail_flag; }
+    uint32_t pattern_trig_options() const { return m_pattern_trig_options; }
+    uint32_t channel_mask() const { return m_channel_mask; }
+    uint32_t event_counter() const { return m_event_counter; }
+    uint32_t trigger_time_tag() const { return m_trigger_time_tag; }
+    unsigned int n_samples() const { return m_n_samples; }
+    size_t size() const { return m_size; }
+    bool channel_has_data(int channel) const { return GetBit(m_channel_mask, channel); }
+
+    /// Samples of a single channel, empty if the channel was not enabled
+    SampleSpan channel_adc_counts(int channel) const {
+      if( channel<0 || channel>=N_MAX_CHAN ){
+        THROW(DigitizerData::DigitizerDataException, "The requested channel is not in the adc counts map.");
+      }
+      size_t chan = static_cast<size_t>(channel);
+      return SampleSpan{m_samples + m_offsets[chan], m_offsets[chan+1]-m_offsets[chan]};
+    }
+
+    /// Samples of all enabled channels, in channel order
+    SampleSpan adc_counts() const { return SampleSpan{m_samples, m_offsets[N_MAX_CHAN]}; }
+
+  private:
+    uint32_t m_event_size;
+    uint32_t m_board_id;
+    bool     m_board_fail_flag;
+    uint16_t m_pattern_trig_options;
+    uint16_t m_channel_mask;
+    uint32_t m_event_counter;
+    uint32_t m_trigger_time_tag;
+    unsigned int m_n_samples;
+    size_t m_size;
+
+    const uint16_t* m_samples;
+    std::array<uint32_t, N_MAX_CHAN+1> m_offsets;
+#if !(defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__))
+    std::vector<uint16_t> m_buffer;
+#endif
+};
+
+inline std::ostream &operator<<(std::ostream &out, const DigitizerDataView &event) {
+  out<<"Digitizer Fragment"<<std::endl
+     <<std::setw(30)<<" event_size:           "<<std::setfill(' ')<<std::setw(32)<<std::hex<<event.event_size()<<std::setfill(' ')<<std::endl
+     <<std::setw(30)<<" board_id:             "<<std::setfill(' ')<<std::setw(32)<<std::dec<<event.board_id()<<std::setfill(' ')<<std::endl
+     <<std::setw(30)<<" board_fail_flag:      "<<std::setfill(' ')<<std::setw(32)<<std::dec<<event.board_fail_flag()<<std::setfill(' ')<<std::endl
+     <<std::setw(30)<<" pattern_trig_options: "<<std::setfill(' ')<<std::setw(32)<<std::dec<<event.pattern_trig_options()<<std::setfill(' ')<<std::endl
+     <<std::setw(30)<<" channel_mask:         "<<std::setfill(' ')<<std::setw(32)<<std::dec<<event.channel_mask()<<std::setfill(' ')<<std::endl
+     <<std::setw(30)<<" event_counter:        "<<std::setfill(' ')<<std::setw(32)<<std::dec<<event.event_counter()<<std::setfill(' ')<<std::endl
+     <<std::setw(30)<<" trigger_time_tag:     "<<std::setfill(' ')<<std::setw(32)<<std::dec<<event.trigger_time_tag()<<std::setfill(' ')<<std::endl;
+
+  // print global header of channels
+  out<<std::setw(10)<<std::dec<<"Time"<<"|";
+  for(int iChan=0; iChan<N_MAX_CHAN; iChan++){
+    out<<std::setw(6)<<std::dec<<iChan<<"["<<GetBit(event.channel_mask(), iChan)<<"]";
+  }
+  out<<std::endl;
+
+  for(unsigned int iSamp=0; iSamp<event.n_samples(); iSamp++){
+    out<<std::setw(10)<<std::dec<<iSamp<<"|";
+    for(int iChan=0; iChan<N_MAX_CHAN; iChan++){
+      if( event.channel_has_data(iChan) ){
+        out<<std::setw(9)<<std::dec<<event.channel_adc_counts(iChan)[iSamp];
+      }
+      else{
+        out<<std::setw(9)<<" - ";
+      }
+    }
+    out<<std::endl;
+  }
+
+  return out;
+}
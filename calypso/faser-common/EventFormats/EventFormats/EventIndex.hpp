@@ -0,0 +1,188 @@
+/*
+  Copyright (C) 2019-2024 CERN for the benefit of the FASER collaboration
+*/
+
+///////////////////////////////////////////////////////////////////
+// EventIndex.hpp, (c) FASER Detector software
+///////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <stdint.h>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <algorithm>
+#include <iomanip>
+#include <ostream>
+#include "DAQFormats.hpp"
+
+/** \brief Persistent sidecar index of the events in a raw data file
+ *
+ *  The index is a small binary file stored next to the raw file
+ *  (<rawfile>.idx) holding the file offset, on-disk size and the main
+ *  header fields of every event, so that readers can seek, skip or
+ *  prefilter on trigger bits without decoding the events themselves.
+ */
+namespace DAQFormats {
+
+  struct EventIndexHeader {
+    char     magic[8];
+    uint16_t version;
+    uint16_t entry_size;
+    uint32_t run_number;
+    uint64_t n_entries;
+    uint64_t file_size;     // size of the indexed raw file, used to detect stale indices
+  }  __attribute__((__packed__));
+
+  struct EventIndexEntry {
+    uint64_t offset;        // byte offset of the event in the raw file
+    uint64_t event_counter;
+    uint64_t event_id;
+    uint32_t size;          // on-disk (possibly compressed) event size
+    uint16_t bc_id;
+    uint16_t trigger_bits;
+    uint16_t status;
+    uint8_t  event_tag;
+    uint8_t  reserved;
+  }  __attribute__((__packed__));
+
+  class EventIndex {
+  public:
+    static constexpr uint16_t IndexVersionLatest = 0x0001;
+    static constexpr const char* IndexMagic = "FASERIDX";
+    static constexpr const char* IndexSuffix = ".idx";
+
+    EventIndex(unsigned int run_number=0) : run(run_number) {}
+
+    /// Name of the sidecar index belonging to a raw data file
+    static std::string indexFileName(const std::string& rawFileName) {
+      return rawFileName+IndexSuffix;
+    }
+
+    /// Add an event found at the given offset, size is the on-disk size
+    template <class EventType>
+    void add(uint64_t offset, uint32_t size, const EventType& event) {
+      EventIndexEntry entry;
+      entry.offset        = offset;
+      entry.event_counter = event.event_counter();
+      entry.event_id      = event.event_id();
+      entry.size          = size;
+      entry.bc_id         = event.bc_id();
+      entry.trigger_bits  = event.trigger_bits();
+      entry.status        = event.status();
+      entry.event_tag     = event.event_tag();
+      entry.reserved      = 0;
+      if (entries.empty()) run=static_cast<uint32_t>(event.run_number());
+      entries.push_back(entry);
+    }
+
+    void clear() { entries.clear(); }
+
+    /** \brief Read index from file
+     *
+     *  Returns false if the file does not exist, is not a valid index or,
+     *  if rawFileSize is given, was made for a file of a different size.
+     */
+    bool read(const std::string& fileName, uint64_t rawFileSize=0) {
+      clear();
+      std::ifstream in(fileName, std::ios::binary);
+      if (!in.is_open()) return false;
+      EventIndexHeader header;
+      in.read(reinterpret_cast<char *>(&header),sizeof(header));
+      if (in.fail()) return false;
+      if (std::memcmp(header.magic,IndexMagic,sizeof(header.magic))) return false;
+      if (header.version!=IndexVersionLatest) return false;
+      if (header.entry_size!=sizeof(EventIndexEntry)) return false;
+      if (rawFileSize && header.file_size!=rawFileSize) return false;
+      entries.resize(header.n_entries);
+      in.read(reinterpret_cast<char *>(entries.data()),static_cast<std::streamsize>(header.n_entries*sizeof(EventIndexEntry)));
+      if (in.fail()) {
+	clear();
+	return false;
+      }
+      run=header.run_number;
+      fileSize=header.file_size;
+      return true;
+    }
+
+    /** \brief Write index to file
+     *
+     *  The index is first written to a temporary file which is then renamed,
+     *  so concurrent readers never see a partial index.
+     */
+    bool write(const std::string& fileName, uint64_t rawFileSize) const {
+      EventIndexHeader header;
+      std::memcpy(header.magic,IndexMagic,sizeof(header.magic));
+      header.version    = IndexVersionLatest;
+      header.entry_size = sizeof(EventIndexEntry);
+      header.run_number = run;
+      header.n_entries  = entries.size();
+      header.file_size  = rawFileSize;
+      std::string tmpName=fileName+".tmp";
+      {
+	std::ofstream out(tmpName, std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!out.is_open()) return false;
+	out.write(reinterpret_cast<const char *>(&header),sizeof(header));
+	out.write(reinterpret_cast<const char *>(entries.data()),static_cast<std::streamsize>(entries.size()*sizeof(EventIndexEntry)));
+	if (out.fail()) {
+	  out.close();
+	  std::remove(tmpName.c_str());
+	  return false;
+	}
+      }
+      if (std::rename(tmpName.c_str(),fileName.c_str())) {
+	std::remove(tmpName.c_str());
+	return false;
+      }
+      return true;
+    }
+
+    // getters here
+    size_t size() const { return entries.size(); }
+    bool empty() const { return entries.empty(); }
+    uint32_t run_number() const { return run; }
+    uint64_t file_size() const { return fileSize; }
+    const EventIndexEntry& operator[](size_t i) const { return entries[i]; }
+    const EventIndexEntry& at(size_t i) const { return entries.at(i); }
+    const std::vector<EventIndexEntry>& getEntries() const { return entries; }
+
+    /// Position of the event with given event counter, or size() if not found
+    size_t find_event(uint64_t event_counter) const {
+      // event counters are normally increasing within a file
+      auto it=std::lower_bound(entries.begin(),entries.end(),event_counter,
+			       [](const EventIndexEntry& e, uint64_t c) { return e.event_counter<c; });
+      if (it!=entries.end() && it->event_counter==event_counter) return static_cast<size_t>(it-entries.begin());
+      for(size_t i=0;i<entries.size();i++)
+	if (entries[i].event_counter==event_counter) return i;
+      return entries.size();
+    }
+
+    /// Position of the first event at or after pos passing (trigger_bits & mask), or size() if none
+    size_t next_triggered(size_t pos, uint16_t mask) const {
+      if (!mask) return std::min(pos,entries.size());
+      for(;pos<entries.size();pos++)
+	if (entries[pos].trigger_bits & mask) return pos;
+      return entries.size();
+    }
+
+  private:
+    uint32_t run;
+    uint64_t fileSize=0;
+    std::vector<EventIndexEntry> entries;
+  };
+
+  inline std::ostream &operator<<(std::ostream &out, const DAQFormats::EventIndexEntry &entry) {
+    out<<std::setw(12)<<entry.event_counter
+       <<std::setw(14)<<entry.offset
+       <<std::setw(9)<<entry.size
+       <<std::setw(7)<<entry.bc_id
+       <<"  0x"<<std::hex<<std::setw(4)<<std::setfill('0')<<entry.trigger_bits
+       <<"  0x"<<std::setw(4)<<entry.status
+       <<"  0x"<<std::setw(2)<<static_cast<int>(entry.event_tag)
+       <<std::setfill(' ')<<std::dec;
+    return out;
+  }
+
+}
@@ -23,13 +23,12 @@
         return ComputeFletcherChecksum(m_checksumH, m_checksumL);
       }
       static uint32_t ReturnFletcherChecksum(const uint32_t* data, size_t size){
-        std::vector<uint32_t> words(data, data+size/sizeof(uint32_t));
-        size_t wordsTotal = words.size();
+        size_t wordsTotal = size/sizeof(uint32_t);
         if (wordsTotal <= 1) return 0;
         uint32_t checksumL(0);
         uint32_t checksumH(0);
-        for (unsigned i = 0; i<wordsTotal-1; i++) {
-          checksumL += words[i];
+        for (size_t i = 0; i<wordsTotal-1; i++) {
+          checksumL += data[i];
           checksumH += checksumL;
         }
         return ComputeFletcherChecksum(checksumH, checksumL);
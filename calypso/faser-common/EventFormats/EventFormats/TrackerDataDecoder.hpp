@@ -0,0 +1,565 @@
+/*
+  Copyright (C) 2019-2020 CERN for the benefit of the FASER collaboration
+*/
+
+///////////////////////////////////////////////////////////////////
+// TrackerDataDecoder.hpp, (c) FASER Detector software
+///////////////////////////////////////////////////////////////////
+
+#pragma once
+#include "EventFormats/TrackerDataFragment.hpp"
+#include <array>
+
+/** \brief Decoded hits of one tracker (TRB) data fragment, stored as flat arrays
+ *
+ *  Hits of a module are contiguous and ordered by chip index (0-11), in the
+ *  same order as SCTEvent::GetHits(), so the hits of chip c of module m are
+ *  [chipBegin(m,c), chipBegin(m,c+1)). Chips 0-5 are on side 0, 6-11 on side 1.
+ *  The buffer keeps its capacity when cleared, so it can be reused for all
+ *  fragments of a job without further allocations.
+ */
+struct TrackerHitBuffer
+{
+  static constexpr size_t MODULES = TrackerDataFragment::MODULES_PER_FRAGMENT;
+  static constexpr size_t CHIPS = TrackerDataFragment::CHIPS_PER_MODULE;
+
+  struct Module {
+    bool present;
+    bool complete;      // see SCTEvent::IsComplete()
+    bool missingData;   // see SCTEvent::MissingData()
+    bool bcidMismatch;  // see SCTEvent::BCIDMismatch()
+    bool hasError;      // see SCTEvent::HasError()
+    uint16_t l1id;
+    uint16_t bcid;
+    uint32_t errorBegin;
+    uint32_t errorEnd;
+    std::array<uint32_t, CHIPS+1> chipBegin;
+  };
+
+  TrackerHitBuffer() {
+    chip.reserve(1024);
+    strip.reserve(1024);
+    pattern.reserve(1024);
+    clear();
+  }
+
+  void clear() {
+    m_size = 0;
+    m_event_id = 0xffffff;
+    m_bc_id = 0xffff;
+    m_crc = 0;
+    m_crc_calculated = 0;
+    m_trb_error_id = 0;
+    m_has_trb_error = false;
+    m_event_id_missing = true;
+    m_bc_id_missing = true;
+    m_crc_missing = true;
+    m_frame_counter_invalid = false;
+    m_unrecognized_frames = false;
+    m_module_error_ids.clear();
+    for (Module& m : modules) m = Module{false, true, false, false, false, 0, 0, 0, 0, {}};
+    chip.clear();
+    strip.clear();
+    pattern.clear();
+    errorChip.clear();
+    errorCode.clear();
+  }
+
+  bool valid() const {
+    return !m_event_id_missing && !m_bc_id_missing && !m_crc_missing && m_crc == m_crc_calculated &&
+      !m_has_trb_error && m_module_error_ids.empty() && !m_frame_counter_invalid && !m_unrecognized_frames;
+  }
+
+  // getters, same meaning as in TrackerDataFragment
+  uint32_t event_id() const { return m_event_id; }
+  uint32_t bc_id() const { return m_bc_id; }
+  size_t size() const { return m_size; }
+  uint8_t trb_error_id() const { return m_trb_error_id; }
+  const std::vector<uint8_t>& module_error_id() const { return m_module_error_ids; }
+  bool hasData(size_t module) const { return modules[module].present; }
+  bool has_trb_error() const { return m_has_trb_error; }
+  bool has_module_error() const { return m_module_error_ids.size() > 0; }
+  bool has_crc_error() const { return m_crc != m_crc_calculated; }
+  bool missing_event_id() const { return m_event_id_missing; }
+  bool missing_bcid() const { return m_bc_id_missing; }
+  bool missing_crc() const { return m_crc_missing; }
+  bool missing_frames() const { return m_frame_counter_invalid; }
+  bool unrecognized_frames() const { return m_unrecognized_frames; }
+
+  size_t nHits() const { return chip.size(); }
+  uint32_t chipBegin(size_t module, size_t chipIndex) const { return modules[module].chipBegin[chipIndex]; }
+  uint32_t moduleBegin(size_t module) const { return modules[module].chipBegin[0]; }
+  uint32_t moduleEnd(size_t module) const { return modules[module].chipBegin[CHIPS]; }
+
+  std::array<Module, MODULES> modules;
+
+  // Hits
+  std::vector<uint8_t> chip;     // chip index on module, 0-11
+  std::vector<uint8_t> strip;    // strip on chip
+  std::vector<uint8_t> pattern;  // 3-bit hit pattern
+  // Chip errors, per module in [errorBegin, errorEnd)
+  std::vector<uint8_t> errorChip;
+  std::vector<uint8_t> errorCode;
+
+private:
+  friend class TrackerDataDecoder;
+
+  size_t m_size;
+  uint32_t m_event_id;
+  uint32_t m_bc_id;
+  uint32_t m_crc;
+  uint32_t m_crc_calculated;
+  uint8_t m_trb_error_id;
+  bool m_has_trb_error;
+  bool m_event_id_missing;
+  bool m_bc_id_missing;
+  bool m_crc_missing;
+  bool m_frame_counter_invalid;
+  bool m_unrecognized_frames;
+  std::vector<uint8_t> m_module_error_ids;
+};
+
+/** \brief Single pass decoder of tracker data fragments into a TrackerHitBuffer
+ *
+ *  Gives the same hits, validity and error flags as TrackerDataFragment, but
+ *  reads the module bit streams in place and writes the hits straight into
+ *  the flat buffer. Decoder and buffer are meant to be reused, all scratch
+ *  space is kept between fragments.
+ */
+class TrackerDataDecoder
+{
+  public:
+    TrackerDataDecoder() {
+      for (auto& stream : m_streams) stream.reserve(256);
+    }
+
+    /// Decode fragment payload of size bytes, hits is cleared first
+    void decode(const uint32_t *data, size_t size, TrackerHitBuffer& hits);
+
+    static void set_debug_on( bool debug = true ) { m_debug = debug; }
+
+  private:
+    static constexpr size_t SIDES = TrackerDataFragment::SIDES_PER_MODULE;
+
+    /// Same bit arithmetic as Bitstream, but reads the words in place
+    class BitReader {
+      public:
+        BitReader(const uint32_t* data, size_t size);
+        void RemoveBits(unsigned int n);
+        uint32_t GetWord32() const { return m_currentBuffer; }
+        bool BitsAvailable() const { return (m_bitsAvailable > 0); }
+      private:
+        size_t remaining() const { return m_size - m_pos; }
+        static constexpr unsigned int m_usedBitsPerWord = 24;
+        const uint32_t* m_data;
+        size_t m_size;
+        size_t m_pos;
+        uint32_t m_currentBuffer;
+        unsigned int m_bitsUsedOfNextWord;
+        long m_bitsAvailable;
+    };
+
+    const std::vector<uint32_t>& stream(size_t module, size_t side) const { return m_streams[module*SIDES+side]; }
+    uint32_t firstWord(size_t module, size_t side) const;
+    void decodeModule(uint8_t module, TrackerHitBuffer& hits);
+    void startModule(uint8_t module, uint32_t begin, unsigned int l1id, unsigned int bcid, TrackerHitBuffer& hits);
+    bool chipIndex(unsigned int chip, TrackerHitBuffer::Module& mod, uint8_t& index) const;
+    void sortModule(uint8_t module, uint32_t begin, TrackerHitBuffer& hits);
+
+    // chip address (without the 2 MSB) to chip index, -1 for unknown chips
+    static constexpr std::array<int8_t, 16> m_chipTable { 0, 1, 2, 3, 4, 5, -1, -1, 6, 7, 8, 9, 10, 11, -1, -1 };
+
+    std::array<std::vector<uint32_t>, TrackerHitBuffer::MODULES*SIDES> m_streams;
+    std::vector<uint8_t> m_sortChip;
+    std::vector<uint8_t> m_sortStrip;
+    std::vector<uint8_t> m_sortPattern;
+
+    inline static bool m_debug = false;
+};
+
+inline void TrackerDataDecoder::decode(const uint32_t *data, size_t size, TrackerHitBuffer& hits)
+{
+  // Word layout, see TrackerDataFragment
+  constexpr uint32_t MASK_FRAMECNT = 0x38000000;
+  constexpr uint32_t RSHIFT_FRAMECNT = 27;
+  constexpr uint32_t FRAME_COUNTER_CYCLE = 8;
+  constexpr uint32_t MASK_WORDTYPE = 0xC0000000;
+  constexpr uint32_t TRB_END = 0x07000eee;
+  constexpr uint32_t MASK_MODULEDATA_CHANNEL = 0x40000000;
+  constexpr uint32_t RSHIFT_MODULEDATA_CHANNEL = 30;
+  constexpr uint32_t MASK_MODULEDATA_MODULEID = 0x07000000;
+  constexpr uint32_t RSHIFT_MODULEDATA_MODULEID = 24;
+  constexpr uint32_t MASK_MODULEDATA = 0xFFFFFF;
+  constexpr uint32_t MASK_TRBDATA_MODULEID = 0x00700000;
+  constexpr uint32_t RSHIFT_TRBDATA_MODULEID = 20;
+  constexpr uint32_t MASK_TRBDATA_ERRORCHANNEL = 0x01000000;
+  constexpr uint32_t RSHIFT_TRBDATA_ERRORCHANNEL = 24;
+  constexpr uint32_t LSHIFT_ERROR_CHANNEL = 7;
+  constexpr uint32_t LSHIFT_ERROR_MODULE = 4;
+  constexpr uint32_t MASK_ERROR = 0xF;
+  constexpr uint32_t MASK_BCID = 0xFFF;
+  constexpr uint32_t MASK_EVNTCNT = 0xFFFFFF;
+  constexpr uint32_t MASK_CRC = 0xFFFFFF;
+
+  hits.clear();
+  for (auto& s : m_streams) s.clear();
+
+  hits.m_size = size;
+  hits.m_crc_calculated = FletcherChecksum::ReturnFletcherChecksum(data, size);
+
+  uint32_t nextFrameCounter{0xf}; // invalid
+  size_t nWords = size/4;
+  for (size_t i = 0; i < nWords; i++)
+  {
+    uint32_t word = data[i];
+    uint32_t frameCounter {((word & MASK_FRAMECNT)>>RSHIFT_FRAMECNT)};
+    if ((i > 0) && (word != TRB_END) && (frameCounter != nextFrameCounter))
+    {
+      hits.m_frame_counter_invalid = true;
+      break;
+    }
+    nextFrameCounter = ++frameCounter % FRAME_COUNTER_CYCLE;
+
+    switch (word & MASK_WORDTYPE)
+    {
+      case 0x00000000: // TRB header / trailer
+        if (((word & TrackerDataFragment::MASK_TRBDATATYPE) == TrackerDataFragment::TRBDATATYPE_EVENTID) && hits.m_event_id_missing)
+        {
+          hits.m_event_id = word & MASK_EVNTCNT;
+          hits.m_event_id_missing = false;
+          continue;
+        }
+        if (word == TRB_END) break;
+        if (((word & TrackerDataFragment::MASK_TRBDATATYPE) == TrackerDataFragment::TRBDATATYPE_CRC) && hits.m_crc_missing)
+        {
+          hits.m_crc = word & MASK_CRC;
+          hits.m_crc_missing = false;
+          if (m_debug && (i < nWords - 1)) WARNING("TrackerDataDecoder::decode :: Unexpected data following CRC word will be ignored.");
+          break;
+        }
+        hits.m_unrecognized_frames = true;
+        break;
+
+      case 0x40000000: // TRB data
+        switch (word & TrackerDataFragment::MASK_TRBDATATYPE)
+        {
+          case TrackerDataFragment::TRBDATATYPE_BCID:
+            if (hits.m_bc_id_missing)
+            {
+              hits.m_bc_id = word & MASK_BCID;
+              hits.m_bc_id_missing = false;
+            }
+            else if (m_debug) WARNING("TrackerDataDecoder::decode :: Repeated BCID detected: " + std::to_string(word & MASK_BCID) );
+            break;
+          case TrackerDataFragment::TRBDATATYPE_TRBERROR:
+            hits.m_trb_error_id = static_cast<uint8_t>(word & MASK_ERROR);
+            hits.m_has_trb_error = true;
+            break;
+          case TrackerDataFragment::TRBDATATYPE_MODULEERROR_LED:
+          case TrackerDataFragment::TRBDATATYPE_MODULEERROR_LEDX:
+          {
+            uint32_t module = (word & MASK_TRBDATA_MODULEID) >> RSHIFT_TRBDATA_MODULEID;
+            uint32_t channel = (word & MASK_TRBDATA_ERRORCHANNEL) >> RSHIFT_TRBDATA_ERRORCHANNEL;
+            uint32_t error = word & MASK_ERROR;
+            hits.m_module_error_ids.push_back( static_cast<uint8_t>((channel << LSHIFT_ERROR_CHANNEL) | (module << LSHIFT_ERROR_MODULE) | error) );
+            break;
+          }
+        }
+        continue;
+
+      default: // module data, LED or LEDX line
+      {
+        uint32_t channel = (word & MASK_MODULEDATA_CHANNEL) >> RSHIFT_MODULEDATA_CHANNEL;
+        uint32_t module = (word & MASK_MODULEDATA_MODULEID) >> RSHIFT_MODULEDATA_MODULEID;
+        m_streams[module*SIDES+channel].push_back(word & MASK_MODULEDATA);
+        continue;
+      }
+    }
+    // only TRB header words that end the fragment get here
+    break;
+  }
+
+  for (uint8_t module = 0; module < TrackerHitBuffer::MODULES; module++)
+  {
+    decodeModule(module, hits);
+  }
+}
+
+inline uint32_t TrackerDataDecoder::firstWord(size_t module, size_t side) const
+{
+  return BitReader(stream(module, side).data(), stream(module, side).size()).GetWord32();
+}
+
+inline bool TrackerDataDecoder::chipIndex(unsigned int chip, TrackerHitBuffer::Module& mod, uint8_t& index) const
+{
+  int8_t entry = m_chipTable[chip & 0xF];
+  if (entry < 0)
+  {
+    std::stringstream s;
+    s << std::hex << (chip | 0x20);
+    mod.complete = false;
+    mod.missingData = true;
+    WARNING("SCTEvent::AddHit :: ERROR: AddHit(): passed chipID is not known! chipID = 0x" + s.str());
+    return false;
+  }
+  index = static_cast<uint8_t>(entry);
+  return true;
+}
+
+inline void TrackerDataDecoder::startModule(uint8_t module, uint32_t begin, unsigned int l1id, unsigned int bcid, TrackerHitBuffer& hits)
+{
+  // Any earlier data of this module is replaced, as for a new SCTEvent
+  hits.chip.resize(begin);
+  hits.strip.resize(begin);
+  hits.pattern.resize(begin);
+  TrackerHitBuffer::Module& mod = hits.modules[module];
+  hits.errorChip.resize(mod.present ? mod.errorBegin : hits.errorChip.size());
+  hits.errorCode.resize(hits.errorChip.size());
+  uint32_t errorBegin = static_cast<uint32_t>(hits.errorChip.size());
+  mod = TrackerHitBuffer::Module{true, true, false, false, false,
+                                 static_cast<uint16_t>(l1id), static_cast<uint16_t>(bcid),
+                                 errorBegin, errorBegin, {}};
+}
+
+inline void TrackerDataDecoder::decodeModule(uint8_t module, TrackerHitBuffer& hits)
+{
+  constexpr uint32_t MASK_MODULE_HEADER = 0xFC002000;
+  constexpr uint32_t TAG_MODULE_HEADER  = 0xE8002000;
+  constexpr uint32_t MASK_MODULE_TRAILER= 0xFFFF0000;
+  constexpr uint32_t TAG_MODULE_TRAILER = 0x80000000;
+  constexpr uint32_t MASK_MODULE_ERROR  = 0xE0200000;
+  constexpr uint32_t TAG_MODULE_ERROR   = 0x00200000;
+  constexpr uint32_t MASK_MODULE_CONFIG = 0xE1C02010;
+  constexpr uint32_t TAG_MODULE_CONFIG  = 0x1C02010;
+  constexpr uint32_t MASK_MODULE_DATA   = 0xC0000000;
+  constexpr uint32_t TAG_MODULE_DATA    = 0x40000000;
+  constexpr uint32_t MASK_MODULE_NODATA = 0xE0000000;
+  constexpr uint32_t TAG_MODULE_NODATA  = 0x20000000;
+  constexpr uint32_t RSHIFT_MODULE_BCID = 14;
+  constexpr uint32_t MASK_MODULE_BCID   = 0xff;
+  constexpr uint32_t RSHIFT_MODULE_L1ID = 22;
+  constexpr uint32_t MASK_MODULE_L1ID   = 0xf;
+  constexpr uint32_t RSHIFT_CHIPADD_ERR  = 25;
+  constexpr uint32_t MASK_CHIPADD_ERR    = 0xF;
+  constexpr uint32_t RSHIFT_ERR          = 22;
+  constexpr uint32_t MASK_ERR            = 0x7;
+  constexpr uint32_t RSHIFT_CHIPADD_DATA = 26;
+  constexpr uint32_t MASK_CHIPADD_DATA   = 0xF;
+  constexpr uint32_t RSHIFT_CHANNEL_DATA = 19;
+  constexpr uint32_t MASK_CHANNEL_DATA   = 0x7F;
+
+  TrackerHitBuffer::Module& mod = hits.modules[module];
+  const uint32_t begin = static_cast<uint32_t>(hits.chip.size());
+
+  for (uint8_t LED = 0; LED < SIDES; LED++)
+  {
+    bool praeambleFound = false;
+    BitReader bitstream(stream(module, LED).data(), stream(module, LED).size());
+    int removedBits = 0;
+    bool first = true;
+    while (bitstream.BitsAvailable())
+    {
+      uint32_t word32 = bitstream.GetWord32();
+      if (first && ((word32 & MASK_MODULE_HEADER) != TAG_MODULE_HEADER))
+      {
+        if (m_debug) WARNING("Did not find header for module "+std::to_string(module)+" LED "+std::to_string(LED));
+        word32 = firstWord(module, 1-LED);
+      }
+      if (first && (LED==0))
+      {
+        uint32_t other = firstWord(module, 1-LED);
+        if ((word32 & 0xFFFFE000) != (other & 0xFFFFE000))
+        {
+          if (m_debug) WARNING("Different headers LED 0/1 for module "+std::to_string(module));
+          word32 = other; //This is targeted to layer 1, module 0 problem
+        }
+      }
+      first = false;
+      if ((word32 & MASK_MODULE_HEADER) == TAG_MODULE_HEADER)
+      {
+        unsigned int l1id = ((word32 >> RSHIFT_MODULE_L1ID)&MASK_MODULE_L1ID);
+        unsigned int bcid = ((word32 >> RSHIFT_MODULE_BCID)&MASK_MODULE_BCID);
+        if (removedBits!=0) WARNING("Had to remove " + std::to_string(removedBits) + " bits to find module header");
+        if (LED==0)
+        {
+          if (mod.present) { ERROR("LED data already existed for this module. This shouldn't happen, and may lead to missing hit data!"); }
+          startModule(module, begin, l1id, bcid, hits);
+        }
+        else if (!mod.present)
+        {
+          startModule(module, begin, l1id, bcid, hits);
+        }
+        removedBits = 0;
+        bitstream.RemoveBits(19);
+        praeambleFound = true;
+        continue;
+      }
+      if (!praeambleFound)
+      {
+        bitstream.RemoveBits(1);
+        removedBits++;
+        continue;
+      }
+      uint32_t current = bitstream.GetWord32();
+      if ((current & MASK_MODULE_ERROR) == TAG_MODULE_ERROR)
+      {
+        unsigned int chip = ((current >> RSHIFT_CHIPADD_ERR)&MASK_CHIPADD_ERR);
+        unsigned int err = ((current >> RSHIFT_ERR)&MASK_ERR);
+        uint8_t index;
+        if (chipIndex(chip, mod, index))
+        {
+          mod.hasError = true;
+          hits.errorChip.push_back(index);
+          hits.errorCode.push_back(static_cast<uint8_t>(err));
+          mod.errorEnd = static_cast<uint32_t>(hits.errorChip.size());
+        }
+        bitstream.RemoveBits(11);
+        continue;
+      }
+      if ((current & MASK_MODULE_CONFIG) == TAG_MODULE_CONFIG)
+      {
+        bitstream.RemoveBits(28);
+        continue;
+      }
+      if ((current & MASK_MODULE_DATA) == TAG_MODULE_DATA)
+      {
+        unsigned int chip = ((current >> RSHIFT_CHIPADD_DATA)&MASK_CHIPADD_DATA);
+        unsigned int channel = ((current >> RSHIFT_CHANNEL_DATA)&MASK_CHANNEL_DATA);
+        bitstream.RemoveBits(13); // after that we expect n-times <1><xxx> => check MSB to be 1
+        uint32_t word = bitstream.GetWord32();
+        if ( (word & 0x80000000) != 0x80000000)
+        {
+          channel |= 0x7; //expect bitflip caused this which might have deleted earlier bits - valid for L1M0
+          word |= 0x80000000;
+        }
+        int cntHits = 0;
+        while ( ((word & 0x80000000) == 0x80000000) )
+        {
+          // Trailer looks the same as a hit, always check for it first
+          if ((bitstream.GetWord32() & MASK_MODULE_TRAILER) == TAG_MODULE_TRAILER) break;
+          cntHits++;
+          unsigned int hit = (bitstream.GetWord32() >> 28) & 0x7;
+          uint8_t index;
+          if (chipIndex(chip, mod, index))
+          {
+            hits.chip.push_back(index);
+            hits.strip.push_back(static_cast<uint8_t>(channel++));
+            hits.pattern.push_back(static_cast<uint8_t>(hit));
+          }
+          bitstream.RemoveBits(4);
+          word = bitstream.GetWord32();
+        }
+        if (cntHits==0) ERROR("No hits found - should not happen");
+        continue;
+      }
+      if ((current & MASK_MODULE_NODATA) == TAG_MODULE_NODATA)
+      {
+        bitstream.RemoveBits(3);
+        continue;
+      }
+      if ((current & MASK_MODULE_TRAILER) == TAG_MODULE_TRAILER) break;
+
+      // data is only valid after a preamble (aka header) was found. Otherwise preamble might be mistaken as an error code
+      if (current!=0 && current!=0x80000000)
+      {
+        std::stringstream s;
+        s << " " << std::dec << std::bitset<32>(current);
+        WARNING("Unable to decode bitstream: "+s.str());
+        //remove leading zero, but 1
+        while ( ((bitstream.GetWord32() & 0xC0000000) != 0x40000000) ) { //Hack based on layer 1, module 0 data
+          if (bitstream.GetWord32()==0) break;
+          bitstream.RemoveBits(1);
+        }
+        continue;
+      }
+      bitstream.RemoveBits(1);
+    }
+  }
+
+  sortModule(module, begin, hits);
+}
+
+inline void TrackerDataDecoder::sortModule(uint8_t module, uint32_t begin, TrackerHitBuffer& hits)
+{
+  // Stable counting sort of the module hits by chip index
+  TrackerHitBuffer::Module& mod = hits.modules[module];
+  const uint32_t end = static_cast<uint32_t>(hits.chip.size());
+  std::array<uint32_t, TrackerHitBuffer::CHIPS+1> counts {};
+  for (uint32_t i = begin; i < end; i++) counts[hits.chip[i]+1u]++;
+  mod.chipBegin[0] = begin;
+  for (size_t c = 0; c < TrackerHitBuffer::CHIPS; c++) mod.chipBegin[c+1] = mod.chipBegin[c] + counts[c+1];
+  if (!mod.present) mod.errorBegin = mod.errorEnd = static_cast<uint32_t>(hits.errorChip.size());
+  if (end - begin < 2) return;
+
+  m_sortChip.assign(hits.chip.begin()+begin, hits.chip.end());
+  m_sortStrip.assign(hits.strip.begin()+begin, hits.strip.end());
+  m_sortPattern.assign(hits.pattern.begin()+begin, hits.pattern.end());
+  std::array<uint32_t, TrackerHitBuffer::CHIPS> next;
+  std::copy(mod.chipBegin.begin(), mod.chipBegin.end()-1, next.begin());
+  for (size_t i = 0; i < m_sortChip.size(); i++)
+  {
+    uint32_t pos = next[m_sortChip[i]]++;
+    hits.chip[pos] = m_sortChip[i];
+    hits.strip[pos] = m_sortStrip[i];
+    hits.pattern[pos] = m_sortPattern[i];
+  }
+}
+
+//
+// Bit reader, follows Bitstream exactly
+//
+inline TrackerDataDecoder::BitReader::BitReader(const uint32_t* data, size_t size)
+  : m_data(data), m_size(size), m_pos(0), m_currentBuffer{0}, m_bitsUsedOfNextWord{0}, m_bitsAvailable{0}
+{
+  if (m_size == 0) return;
+  m_currentBuffer = (m_data[0] << (32 - m_usedBitsPerWord));
+  m_pos = 1;
+  m_bitsAvailable = (32 - m_usedBitsPerWord);
+  if (remaining() == 0) return;
+  m_bitsUsedOfNextWord = (32 - m_usedBitsPerWord);
+  m_currentBuffer |= (m_data[m_pos] >> ( m_usedBitsPerWord-m_bitsUsedOfNextWord ));
+  m_bitsAvailable = 32;
+}
+
+inline void TrackerDataDecoder::BitReader::RemoveBits(unsigned int n)
+{
+  m_currentBuffer <<= n;
+  if (remaining() == 0){
+    m_bitsAvailable -= n;
+    if (m_bitsAvailable < 0) m_bitsAvailable = 0;
+    return;
+  }
+  uint32_t mask = (n >= 32) ? 0xFFFFFFFF : ((n <= 1) ? 1u : ((1u << n) - 1u));
+
+  if ((m_usedBitsPerWord - m_bitsUsedOfNextWord) >= n){ // still enough bits in current word
+    m_currentBuffer |= (m_data[m_pos] >> (m_usedBitsPerWord - (m_bitsUsedOfNextWord + n))) & mask;
+    m_bitsUsedOfNextWord += n;
+    if (m_bitsUsedOfNextWord == m_usedBitsPerWord){ // all bits of word used
+      m_pos++;
+      m_bitsUsedOfNextWord = 0;
+    }
+  } else { // need more bits than in next word available
+    int missingBits = ( static_cast<int>(m_bitsUsedOfNextWord + n) - static_cast<int>(m_usedBitsPerWord));
+    m_currentBuffer |= (m_data[m_pos] << ( missingBits)) & mask;
+    m_pos++;
+    m_bitsUsedOfNextWord = 0;
+    if (remaining() == 0){
+      m_bitsAvailable -= n-(m_usedBitsPerWord-m_bitsUsedOfNextWord) ;
+      if (m_bitsAvailable < 0) m_bitsAvailable = 0;
+      return; // no more data
+    }
+    while (missingBits - static_cast<int>(m_usedBitsPerWord) > 0){
+      m_currentBuffer |= (m_data[m_pos] << (static_cast<uint32_t>(missingBits) - m_usedBitsPerWord) );
+      missingBits -= static_cast<int>(m_usedBitsPerWord);
+      m_pos++;
+      m_bitsUsedOfNextWord = 0;
+      if (remaining() == 0){
+        m_bitsAvailable -= n-(m_usedBitsPerWord-m_bitsUsedOfNextWord) ;
+        if (m_bitsAvailable < 0) m_bitsAvailable = 0;
+        return; // no more data
+      }
+    }
+    m_currentBuffer |= (m_data[m_pos] >> (m_usedBitsPerWord - static_cast<uint32_t>(missingBits) ) );
+    m_bitsUsedOfNextWord += static_cast<uint32_t>(missingBits);
+  }
+}
@@ -0,0 +1,115 @@
+#include "EventFormats/DAQFormats.hpp"
+#include "EventFormats/EventIndex.hpp"
+#include <getopt.h>
+
+using namespace DAQFormats;
+
+static void usage() {
+   std::cout<<"Usage: eventIndex [-o outfile] [-d [-t mask]] <infile>\n"
+              "   -o <outfile>:       write index to outfile (default: <infile>.idx)\n"
+              "   -d                  dump content of existing index instead of creating it\n"
+              "   -t <mask>:          with -d, only show events with (trigger & mask) != 0\n"
+              "                       specify mask in hex format: 0xFF, \n"
+     ;
+   exit(1);
+}
+
+int main(int argc, char **argv) {
+
+  // argument parsing
+  if(argc<2) usage();
+
+  std::string outfilename;
+  bool dump = false;
+  unsigned short mask = 0;
+
+  int opt;
+  while (true) {
+    opt = getopt(argc, argv, "do:t:");
+    if (opt == -1) break;
+    switch ( opt ) {
+    case 'd':
+      dump = true;
+      break;
+    case 'o':
+      outfilename = optarg;
+      break;
+    case 't':
+      sscanf(optarg, "%hx", &mask);
+      break;
+    case ':':
+      std::cout<<"Missing optarg : "<<optopt<<std::endl;
+      break;
+    case '?':  // unknown option...
+      usage();
+      break;
+    }
+  }
+
+  if (optind >= argc) {
+    std::cout<<"ERROR: too few arguments given."<<std::endl;
+    usage();
+  }
+  std::string infilename(argv[optind]);
+  if (outfilename.empty()) outfilename = EventIndex::indexFileName(infilename);
+
+  if (dump) {
+    EventIndex index;
+    if (!index.read(outfilename)) {
+      std::cout << "ERROR: can't read index "<<outfilename<<std::endl;
+      return 1;
+    }
+    std::cout<<"Index file            : "<<outfilename<<std::endl;
+    std::cout<<"Run number            : "<<index.run_number()<<std::endl;
+    std::cout<<"Raw file size         : "<<index.file_size()<<std::endl;
+    std::cout<<"Number of events      : "<<index.size()<<std::endl;
+    std::cout<<"     counter        offset     size   BCID  trigger  status  tag"<<std::endl;
+    for (size_t pos=index.next_triggered(0,mask); pos<index.size(); pos=index.next_triggered(pos+1,mask))
+      std::cout<<index[pos]<<std::endl;
+    return 0;
+  }
+
+  std::cout<<"Reading from file     : "<<infilename<<std::endl;
+  std::cout<<"Writing index to file : "<<outfilename<<std::endl;
+
+  std::ifstream in(infilename, std::ios::binary);
+  if (!in.is_open()){
+    std::cout << "ERROR: can't open file "<<infilename<<std::endl;
+    return 1;
+  }
+
+  // Only event headers are decoded, payloads are skipped over
+  EventIndex index;
+  EventFull event;
+  std::vector<uint8_t> header(event.header_size());
+  uint64_t offset = 0;
+  while(in.good() and in.peek()!=EOF) {
+    try {
+      in.read(reinterpret_cast<char *>(header.data()),static_cast<std::streamsize>(header.size()));
+      if (in.fail()) THROW(EFormatException,"Too small to be event");
+      event.loadHeader(header.data(),header.size());
+      if (event.header_size()!=header.size()) THROW(EFormatException,"Unexpected event header size");
+      in.seekg(event.payload_size(),std::ios::cur);
+      if (in.fail()) THROW(EFormatException,"Event size does not match header information");
+    } catch (EFormatException &e) {
+      std::cout<<"Problem while reading file - "<<e.what()<<std::endl;
+      return 1;
+    }
+    index.add(offset, event.size(), event);
+    offset+=event.size();
+  }
+  in.clear();
+  in.seekg(0,std::ios::end);
+  uint64_t filesize=static_cast<uint64_t>(in.tellg());
+  if (filesize!=offset) {
+    std::cout<<"ERROR: events do not cover full file, expected "<<filesize<<" bytes, found "<<offset<<std::endl;
+    return 1;
+  }
+
+  if (!index.write(outfilename, filesize)) {
+    std::cout << "ERROR: can't write index "<<outfilename<<std::endl;
+    return 1;
+  }
+  std::cout<<"Indexed events        : "<<index.size()<<std::endl;
+  return 0;
+}